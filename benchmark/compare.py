@@ -0,0 +1,63 @@
+#!/usr/bin/env python3
+"""Compare two reports of benchmark_bin and flag slowdowns.
+
+Cases are matched by (name, mesh, threads). A case is flagged if its median
+time grew by more than threshold (relative) or if it failed. Exits with 1 if
+any case was flagged.
+"""
+import argparse
+import json
+import sys
+
+
+def load(path):
+    with open(path) as f:
+        report = json.load(f)
+    return {(r["name"], r["mesh"], r["threads"]): r for r in report["results"]}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("baseline")
+    parser.add_argument("current")
+    parser.add_argument("--threshold", type=float, default=0.1,
+                        help="relative slowdown to flag {0.1}")
+    parser.add_argument("--min-time", type=float, default=1e-3,
+                        help="ignore cases faster than this in both reports "
+                             "(seconds) {0.001}")
+    args = parser.parse_args()
+
+    baseline = load(args.baseline)
+    current = load(args.current)
+    flagged = 0
+    print("%-24s %-10s %7s %12s %12s %8s" %
+          ("name", "mesh", "threads", "baseline", "current", "ratio"))
+    for key in sorted(current):
+        cur = current[key]
+        if key not in baseline:
+            print("%-24s %-10s %7d %12s %12.4g %8s  new" %
+                  (key + ("-", cur["time_median"], "-")))
+            continue
+        base = baseline[key]
+        ratio = cur["time_median"] / max(base["time_median"], 1e-12)
+        note = ""
+        if not cur["ok"]:
+            note = "FAILED"
+        elif (ratio > 1 + args.threshold and
+              max(cur["time_median"], base["time_median"]) >= args.min_time):
+            note = "SLOWER"
+        elif ratio < 1 - args.threshold:
+            note = "faster"
+        if note in ("FAILED", "SLOWER"):
+            flagged += 1
+        print("%-24s %-10s %7d %12.4g %12.4g %8.3f  %s" %
+              (key + (base["time_median"], cur["time_median"], ratio, note)))
+    for key in sorted(set(baseline) - set(current)):
+        print("%-24s %-10s %7d  missing from current report" % key)
+    if flagged:
+        print("%d case(s) regressed" % flagged)
+    return 1 if flagged else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,591 @@
+// Performance suite for core libigl kernels. Each kernel is run on synthetic
+// meshes of several sizes (and optionally on meshes read from file) for each
+// requested number of threads. Results are written as JSON, see README.md and
+// compare.py.
+#include <igl/AABB.h>
+#include <igl/arap.h>
+#include <igl/cotmatrix.h>
+#include <igl/decimate.h>
+#include <igl/dqs.h>
+#include <igl/default_num_threads.h>
+#include <igl/get_seconds.h>
+#include <igl/lbs.h>
+#include <igl/PI.h>
+#include <igl/pathinfo.h>
+#include <igl/read_triangle_mesh.h>
+#include <igl/readOBJ.h>
+#include <igl/signed_distance.h>
+#include <igl/top_k_weights.h>
+#include <igl/writeOBJ.h>
+#ifdef IGL_BENCHMARK_WITH_CGAL
+#  include <igl/copyleft/cgal/mesh_boolean.h>
+#endif
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+#include <Eigen/Sparse>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#if defined(__unix__) || defined(__APPLE__)
+#  include <sys/resource.h>
+#endif
+
+struct Mesh
+{
+  std::string name;
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+};
+
+// A benchmark prepares (untimed) its input for a mesh and returns the timed
+// function together with the number of elements it processes per run.
+// The timed function returns false on failure.
+struct Benchmark
+{
+  std::string name;
+  std::function<std::function<bool()>(const Mesh &, double &)> prepare;
+};
+
+struct Result
+{
+  std::string name, mesh;
+  int vertices, faces, threads, repetitions;
+  double elements, time_min, time_median;
+  long peak_rss_kb;
+  bool ok;
+};
+
+// Closed torus with n*n vertices and 2*n*n faces
+Mesh torus(const std::string & name, const int n)
+{
+  Mesh M;
+  M.name = name;
+  M.V.resize(n*n,3);
+  M.F.resize(2*n*n,3);
+  for(int i = 0;i<n;i++)
+  {
+    for(int j = 0;j<n;j++)
+    {
+      const double u = 2.*igl::PI*i/n;
+      const double v = 2.*igl::PI*j/n;
+      M.V.row(i*n+j) <<
+        (1.+0.4*cos(v))*cos(u), (1.+0.4*cos(v))*sin(u), 0.4*sin(v);
+      const int a = i*n+j;
+      const int b = ((i+1)%n)*n+j;
+      const int c = ((i+1)%n)*n+(j+1)%n;
+      const int d = i*n+(j+1)%n;
+      M.F.row(2*a+0) << a,b,c;
+      M.F.row(2*a+1) << a,c,d;
+    }
+  }
+  return M;
+}
+
+// Random points in the bounding box of V (inflated by 10%)
+Eigen::MatrixXd random_queries(const Eigen::MatrixXd & V, const int n)
+{
+  std::mt19937 gen(0);
+  std::uniform_real_distribution<double> unif(0.,1.);
+  const Eigen::RowVector3d min_V = V.colwise().minCoeff();
+  const Eigen::RowVector3d ext_V = V.colwise().maxCoeff()-min_V;
+  Eigen::MatrixXd P(n,3);
+  for(int i = 0;i<n;i++)
+  {
+    for(int d = 0;d<3;d++)
+    {
+      P(i,d) = min_V(d) + ext_V(d)*(1.1*unif(gen)-0.05);
+    }
+  }
+  return P;
+}
+
+// Number of skinning handles and of weights kept per vertex
+const int num_handles = 100;
+const int num_weights = 4;
+
+// Synthetic single precision skinning rig: handles at evenly spaced vertices,
+// inverse squared distance weights truncated to the num_weights largest.
+struct Rig
+{
+  Eigen::MatrixXf V,W;
+  Eigen::MatrixXi WI;
+};
+
+std::shared_ptr<Rig> skinning_rig(const Eigen::MatrixXd & V)
+{
+  auto R = std::make_shared<Rig>();
+  R->V = V.cast<float>();
+  const int n = V.rows();
+  const int m = std::min(num_handles,n);
+  Eigen::MatrixXd H(m,3);
+  for(int j = 0;j<m;j++)
+  {
+    H.row(j) = V.row((long(j)*n)/m);
+  }
+  const double eps = 1e-4*(V.colwise().maxCoeff()-V.colwise().minCoeff()).
+    squaredNorm();
+  R->W.resize(n,std::min(num_weights,m));
+  R->WI.resize(n,R->W.cols());
+  // dense weights only for a block of vertices at a time
+  const int block = 10000;
+  for(int i0 = 0;i0<n;i0+=block)
+  {
+    const int bn = std::min(block,n-i0);
+    Eigen::MatrixXd D(bn,m);
+    for(int i = 0;i<bn;i++)
+    {
+      for(int j = 0;j<m;j++)
+      {
+        D(i,j) = 1./((V.row(i0+i)-H.row(j)).squaredNorm()+eps);
+      }
+    }
+    Eigen::MatrixXf TW;
+    Eigen::MatrixXi TI;
+    igl::top_k_weights(D,num_weights,TW,TI);
+    R->W.middleRows(i0,bn) = TW;
+    R->WI.middleRows(i0,bn) = TI;
+  }
+  return R;
+}
+
+std::vector<Benchmark> benchmarks()
+{
+  using namespace Eigen;
+  std::vector<Benchmark> B;
+  B.push_back({"AABB_init",[](const Mesh & M, double & elements)
+  {
+    elements = M.F.rows();
+    return std::function<bool()>([&M]()
+    {
+      igl::AABB<MatrixXd,3> tree;
+      tree.init(M.V,M.F);
+      return true;
+    });
+  }});
+  B.push_back({"AABB_squared_distance",[](const Mesh & M, double & elements)
+  {
+    auto tree = std::make_shared<igl::AABB<MatrixXd,3> >();
+    tree->init(M.V,M.F);
+    auto P = std::make_shared<MatrixXd>(random_queries(M.V,M.V.rows()));
+    elements = P->rows();
+    return std::function<bool()>([&M,tree,P]()
+    {
+      VectorXd sqrD;
+      VectorXi I;
+      MatrixXd C;
+      tree->squared_distance(M.V,M.F,*P,sqrD,I,C);
+      return true;
+    });
+  }});
+  B.push_back({"cotmatrix",[](const Mesh & M, double & elements)
+  {
+    elements = M.F.rows();
+    return std::function<bool()>([&M]()
+    {
+      SparseMatrix<double> L;
+      igl::cotmatrix(M.V,M.F,L);
+      return true;
+    });
+  }});
+  B.push_back({"decimate",[](const Mesh & M, double & elements)
+  {
+    elements = M.F.rows();
+    return std::function<bool()>([&M]()
+    {
+      MatrixXd U;
+      MatrixXi G;
+      VectorXi J,I;
+      return igl::decimate(M.V,M.F,M.F.rows()/10,U,G,J,I);
+    });
+  }});
+  B.push_back({"signed_distance",[](const Mesh & M, double & elements)
+  {
+    auto P = std::make_shared<MatrixXd>(random_queries(M.V,M.V.rows()));
+    elements = P->rows();
+    return std::function<bool()>([&M,P]()
+    {
+      VectorXd S;
+      VectorXi I;
+      MatrixXd C,N;
+      igl::signed_distance(
+        *P,M.V,M.F,igl::SIGNED_DISTANCE_TYPE_PSEUDONORMAL,S,I,C,N);
+      return true;
+    });
+  }});
+  B.push_back({"readOBJ",[](const Mesh & M, double & elements)
+  {
+    auto path = std::make_shared<std::string>(
+      "igl_benchmark_" + M.name + ".obj");
+    igl::writeOBJ(*path,M.V,M.F);
+    elements = M.F.rows();
+    return std::function<bool()>([path]()
+    {
+      MatrixXd V;
+      MatrixXi F;
+      return igl::readOBJ(*path,V,F);
+    });
+  }});
+  B.push_back({"arap_solve",[](const Mesh & M, double & elements)
+  {
+    // Fix a few vertices and move one of them
+    auto data = std::make_shared<igl::ARAPData>();
+    data->max_iter = 10;
+    VectorXi b(4);
+    for(int i = 0;i<b.size();i++)
+    {
+      b(i) = (i*M.V.rows())/b.size();
+    }
+    auto bc = std::make_shared<MatrixXd>(b.size(),3);
+    for(int i = 0;i<b.size();i++)
+    {
+      bc->row(i) = M.V.row(b(i));
+    }
+    bc->row(0) += 0.1*RowVector3d(1,1,1);
+    const bool ok = igl::arap_precomputation(M.V,M.F,3,b,*data);
+    elements = data->max_iter*M.V.rows();
+    return std::function<bool()>([&M,data,bc,ok]()
+    {
+      MatrixXd U = M.V;
+      return ok && igl::arap_solve(*bc,*data,U);
+    });
+  }});
+  B.push_back({"lbs",[](const Mesh & M, double & elements)
+  {
+    auto R = skinning_rig(M.V);
+    // a small random affine transformation per handle
+    std::mt19937 gen(0);
+    std::uniform_real_distribution<float> unif(-0.1f,0.1f);
+    auto T = std::make_shared<MatrixXf>(num_handles*4,3);
+    for(int j = 0;j<num_handles;j++)
+    {
+      Matrix<float,4,3> A;
+      A << Matrix3f::Identity(), RowVector3f::Zero();
+      for(int d = 0;d<A.size();d++)
+      {
+        A(d) += unif(gen);
+      }
+      T->block(4*j,0,4,3) = A;
+    }
+    elements = M.V.rows();
+    return std::function<bool()>([R,T]()
+    {
+      MatrixXf U;
+      igl::lbs(R->V,R->W,R->WI,*T,U);
+      return U.rows() == R->V.rows();
+    });
+  }});
+  B.push_back({"dqs",[](const Mesh & M, double & elements)
+  {
+    auto R = skinning_rig(M.V);
+    // a random rotation and a small translation per handle
+    std::mt19937 gen(0);
+    std::uniform_real_distribution<float> unif(-1.f,1.f);
+    auto vQ = std::make_shared<std::vector<
+      Quaternionf,aligned_allocator<Quaternionf> > >(num_handles);
+    auto vT = std::make_shared<std::vector<Vector3f> >(num_handles);
+    for(int j = 0;j<num_handles;j++)
+    {
+      (*vQ)[j] = Quaternionf(1.f,unif(gen),unif(gen),unif(gen)).normalized();
+      (*vT)[j] = 0.1f*Vector3f(unif(gen),unif(gen),unif(gen));
+    }
+    elements = M.V.rows();
+    return std::function<bool()>([R,vQ,vT]()
+    {
+      MatrixXf U;
+      igl::dqs(R->V,R->W,R->WI,*vQ,*vT,U);
+      return U.rows() == R->V.rows();
+    });
+  }});
+#ifdef IGL_BENCHMARK_WITH_CGAL
+  B.push_back({"mesh_boolean",[](const Mesh & M, double & elements)
+  {
+    // Union with a shifted and rotated copy
+    auto VB = std::make_shared<MatrixXd>(M.V.rowwise().reverse());
+    VB->col(0).array() += 0.3;
+    elements = 2*M.F.rows();
+    return std::function<bool()>([&M,VB]()
+    {
+      MatrixXd VC;
+      MatrixXi FC;
+      VectorXi J;
+      return igl::copyleft::cgal::mesh_boolean(
+        M.V,M.F,*VB,M.F,igl::MESH_BOOLEAN_TYPE_UNION,VC,FC,J);
+    });
+  }});
+#endif
+  return B;
+}
+
+// Reset the peak resident set size (if supported)
+void reset_peak_rss()
+{
+#ifdef __linux__
+  std::ofstream clear_refs("/proc/self/clear_refs");
+  if(clear_refs)
+  {
+    clear_refs << "5";
+  }
+#endif
+}
+
+// Peak resident set size in kilobytes since the last reset_peak_rss (on
+// Linux) or since program start, -1 if unknown
+long peak_rss_kb()
+{
+#ifdef __linux__
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while(std::getline(status,line))
+  {
+    if(line.compare(0,6,"VmHWM:") == 0)
+    {
+      return std::atol(line.c_str()+6);
+    }
+  }
+#endif
+#if defined(__unix__) || defined(__APPLE__)
+  struct rusage usage;
+  if(getrusage(RUSAGE_SELF,&usage) == 0)
+  {
+#  ifdef __APPLE__
+    return usage.ru_maxrss/1024;
+#  else
+    return usage.ru_maxrss;
+#  endif
+  }
+#endif
+  return -1;
+}
+
+std::vector<std::string> split(const std::string & s)
+{
+  std::vector<std::string> tokens;
+  std::stringstream ss(s);
+  std::string token;
+  while(std::getline(ss,token,','))
+  {
+    if(!token.empty())
+    {
+      tokens.push_back(token);
+    }
+  }
+  return tokens;
+}
+
+std::string json_string(const std::string & s)
+{
+  std::string out = "\"";
+  for(const char c : s)
+  {
+    if(c == '"' || c == '\\')
+    {
+      out += '\\';
+    }
+    out += c;
+  }
+  return out + "\"";
+}
+
+void usage(const char * argv0)
+{
+  std::cerr<<"Usage:"<<std::endl<<"  "<<argv0<<R"( [options]
+
+Options:
+  --sizes small,medium,large  synthetic mesh sizes to run {small,medium}
+  --mesh path                 also run on mesh read from path (repeatable)
+  --threads 1,2,...           thread counts to run {1,hardware_concurrency}
+  --filter name,...           only run benchmarks whose name contains one of
+                              these substrings
+  --repetitions n             timed runs per case {3}
+  --output path               write JSON to path {stdout}
+  --list                      list benchmarks and exit
+)";
+}
+
+int main(int argc, char * argv[])
+{
+  using namespace std;
+  vector<string> sizes = {"small","medium"};
+  vector<string> mesh_paths;
+  const unsigned int hc = std::max(1u,std::thread::hardware_concurrency());
+  vector<int> threads = {1};
+  if(hc > 1)
+  {
+    threads.push_back(hc);
+  }
+  vector<string> filter;
+  int repetitions = 3;
+  string output;
+  const vector<Benchmark> all = benchmarks();
+  for(int a = 1;a<argc;a++)
+  {
+    const string arg = argv[a];
+    const bool has_value = a+1<argc;
+    if(arg == "--sizes" && has_value)
+    {
+      sizes = split(argv[++a]);
+    }else if(arg == "--mesh" && has_value)
+    {
+      mesh_paths.push_back(argv[++a]);
+    }else if(arg == "--threads" && has_value)
+    {
+      threads.clear();
+      for(const auto & t : split(argv[++a]))
+      {
+        threads.push_back(std::max(1,atoi(t.c_str())));
+      }
+    }else if(arg == "--filter" && has_value)
+    {
+      filter = split(argv[++a]);
+    }else if(arg == "--repetitions" && has_value)
+    {
+      repetitions = std::max(1,atoi(argv[++a]));
+    }else if(arg == "--output" && has_value)
+    {
+      output = argv[++a];
+    }else if(arg == "--list")
+    {
+      for(const auto & b : all)
+      {
+        cout<<b.name<<endl;
+      }
+      return EXIT_SUCCESS;
+    }else
+    {
+      usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Workloads
+  vector<Mesh> meshes;
+  for(const auto & s : sizes)
+  {
+    if(s == "small")
+    {
+      meshes.push_back(torus(s,64));
+    }else if(s == "medium")
+    {
+      meshes.push_back(torus(s,256));
+    }else if(s == "large")
+    {
+      meshes.push_back(torus(s,1024));
+    }else
+    {
+      cerr<<"Unknown size: "<<s<<endl;
+      return EXIT_FAILURE;
+    }
+  }
+  for(const auto & path : mesh_paths)
+  {
+    Mesh M;
+    string d,b,e;
+    igl::pathinfo(path,d,b,e,M.name);
+    if(!igl::read_triangle_mesh(path,M.V,M.F) || M.F.cols() != 3)
+    {
+      cerr<<"Failed to read triangle mesh: "<<path<<endl;
+      return EXIT_FAILURE;
+    }
+    meshes.push_back(M);
+  }
+
+  vector<Result> results;
+  for(const auto & b : all)
+  {
+    if(!filter.empty() && std::none_of(filter.begin(),filter.end(),
+      [&b](const string & f){ return b.name.find(f) != string::npos;}))
+    {
+      continue;
+    }
+    for(const auto & M : meshes)
+    {
+      double elements = 0;
+      const auto run = b.prepare(M,elements);
+      for(const int t : threads)
+      {
+        igl::default_num_threads(t);
+        Result r;
+        r.name = b.name;
+        r.mesh = M.name;
+        r.vertices = M.V.rows();
+        r.faces = M.F.rows();
+        r.threads = t;
+        r.repetitions = repetitions;
+        r.elements = elements;
+        r.ok = true;
+        reset_peak_rss();
+        vector<double> times;
+        for(int k = 0;k<repetitions;k++)
+        {
+          const double t0 = igl::get_seconds();
+          r.ok = run() && r.ok;
+          times.push_back(igl::get_seconds()-t0);
+        }
+        r.peak_rss_kb = peak_rss_kb();
+        std::sort(times.begin(),times.end());
+        r.time_min = times.front();
+        r.time_median = times.size()%2 ? times[times.size()/2] :
+          0.5*(times[times.size()/2-1]+times[times.size()/2]);
+        cerr<<r.name<<" "<<r.mesh<<" threads="<<t<<": "<<r.time_median<<"s"<<
+          (r.ok?"":" (failed)")<<endl;
+        results.push_back(r);
+      }
+      // prepare the next case with the default number of threads
+      igl::default_num_threads(0,true);
+    }
+  }
+  for(const auto & M : meshes)
+  {
+    std::remove(("igl_benchmark_" + M.name + ".obj").c_str());
+  }
+
+  // JSON report
+  stringstream json;
+  json<<"{\n";
+  json<<"  \"hardware_concurrency\": "<<hc<<",\n";
+  json<<"  \"results\": [\n";
+  for(size_t i = 0;i<results.size();i++)
+  {
+    const Result & r = results[i];
+    json<<"    {"<<
+      "\"name\": "<<json_string(r.name)<<", "<<
+      "\"mesh\": "<<json_string(r.mesh)<<", "<<
+      "\"vertices\": "<<r.vertices<<", "<<
+      "\"faces\": "<<r.faces<<", "<<
+      "\"threads\": "<<r.threads<<", "<<
+      "\"repetitions\": "<<r.repetitions<<", "<<
+      "\"time_min\": "<<r.time_min<<", "<<
+      "\"time_median\": "<<r.time_median<<", "<<
+      "\"throughput\": "<<r.elements/std::max(r.time_median,1e-12)<<", "<<
+      "\"peak_rss_kb\": "<<r.peak_rss_kb<<", "<<
+      "\"ok\": "<<(r.ok?"true":"false")<<
+      "}"<<(i+1<results.size()?",":"")<<"\n";
+  }
+  json<<"  ]\n";
+  json<<"}\n";
+  if(output.empty())
+  {
+    cout<<json.str();
+  }else
+  {
+    ofstream out(output);
+    out<<json.str();
+    if(!out)
+    {
+      cerr<<"Failed to write "<<output<<endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
@@ -13,12 +13,15 @@
 #include "point_simplex_squared_distance.h"
 #include "project_to_line_segment.h"
 #include "sort.h"
+#include "spatial_order.h"
 #include "volume.h"
 #include "ray_box_intersect.h"
 #include "ray_mesh_intersect.h"
+#include "parallel_for.h"
 #include <iostream>
 #include <iomanip>
 #include <limits>
+#include <algorithm>
 #include <list>
 #include <queue>
 #include <stack>
@@ -291,6 +294,129 @@ IGL_INLINE std::vector<int> igl::AABB<DerivedV,DIM>::find(
   return left;
 }
 
+namespace igl
+{
+  // Recompute the boxes of a subtree bottom-up
+  template <typename DerivedV, int DIM, typename DerivedEle>
+  IGL_INLINE void AABB_refit_subtree(
+    const Eigen::MatrixBase<DerivedV> & V,
+    const Eigen::MatrixBase<DerivedEle> & Ele,
+    AABB<DerivedV,DIM> * node)
+  {
+    node->m_box.setEmpty();
+    if(node->is_leaf())
+    {
+      for(int c = 0;c<Ele.cols();c++)
+      {
+        node->m_box.extend(V.row(Ele(node->m_primitive,c)).transpose());
+      }
+      return;
+    }
+    if(node->m_left != NULL)
+    {
+      AABB_refit_subtree(V,Ele,node->m_left);
+      node->m_box.extend(node->m_left->m_box);
+    }
+    if(node->m_right != NULL)
+    {
+      AABB_refit_subtree(V,Ele,node->m_right);
+      node->m_box.extend(node->m_right->m_box);
+    }
+  }
+  // Half the surface area (in 3D, perimeter in 2D) of a box
+  template <typename Scalar, int DIM>
+  IGL_INLINE Scalar AABB_half_area(const Eigen::AlignedBox<Scalar,DIM> & box)
+  {
+    if(box.isEmpty())
+    {
+      return 0;
+    }
+    const Eigen::Matrix<Scalar,DIM,1> s = box.sizes();
+    Scalar area = 0;
+    for(int i = 0;i<s.size();i++)
+    {
+      Scalar face = 1;
+      for(int j = 0;j<s.size();j++)
+      {
+        if(j != i) face *= s(j);
+      }
+      area += face;
+    }
+    return area;
+  }
+}
+
+template <typename DerivedV, int DIM>
+template <typename DerivedEle>
+IGL_INLINE void igl::AABB<DerivedV,DIM>::refit(
+  const Eigen::MatrixBase<DerivedV> & V,
+  const Eigen::MatrixBase<DerivedEle> & Ele)
+{
+  // Split the tree into a frontier of independent subtrees (refit in
+  // parallel) and the nodes above it (refit afterwards, children first)
+  const size_t max_frontier = 64;
+  std::vector<AABB*> above;
+  std::vector<AABB*> frontier(1,this);
+  while(frontier.size() < max_frontier)
+  {
+    std::vector<AABB*> next;
+    for(AABB * node : frontier)
+    {
+      if(node->is_leaf() || (node->m_left == NULL && node->m_right == NULL))
+      {
+        next.push_back(node);
+        continue;
+      }
+      above.push_back(node);
+      if(node->m_left != NULL) next.push_back(node->m_left);
+      if(node->m_right != NULL) next.push_back(node->m_right);
+    }
+    if(next.size() == frontier.size())
+    {
+      // only leaves left
+      break;
+    }
+    frontier.swap(next);
+  }
+  const int nf = frontier.size();
+  parallel_for(
+    nf,
+    [&V,&Ele,&frontier](const int i)
+    {
+      AABB_refit_subtree(V,Ele,frontier[i]);
+    },
+    Ele.rows() < 10000 ? nf+1 : 0);
+  for(auto it = above.rbegin();it != above.rend();it++)
+  {
+    AABB * node = *it;
+    node->m_box.setEmpty();
+    if(node->m_left != NULL) node->m_box.extend(node->m_left->m_box);
+    if(node->m_right != NULL) node->m_box.extend(node->m_right->m_box);
+  }
+}
+
+template <typename DerivedV, int DIM>
+IGL_INLINE typename igl::AABB<DerivedV,DIM>::Scalar 
+igl::AABB<DerivedV,DIM>::sah_cost() const
+{
+  const Scalar root_area = AABB_half_area(m_box);
+  if(root_area <= 0)
+  {
+    return 0;
+  }
+  Scalar area = 0;
+  std::vector<const AABB*> stack(1,this);
+  while(!stack.empty())
+  {
+    const AABB * node = stack.back();
+    stack.pop_back();
+    area += AABB_half_area(node->m_box);
+    if(node->m_left != NULL) stack.push_back(node->m_left);
+    if(node->m_right != NULL) stack.push_back(node->m_right);
+  }
+  return area/root_area;
+}
+
 template <typename DerivedV, int DIM>
 IGL_INLINE int igl::AABB<DerivedV,DIM>::subtree_size() const
 {
@@ -401,7 +527,7 @@ igl::AABB<DerivedV,DIM>::squared_distance(
     const auto & look_right = [&]()
     {
       int i_right;
-      Eigen::PlainObjectBase<RowVectorDIMS> c_right = c;
+      RowVectorDIMS c_right = c;
       Scalar sqr_d_right = 
         m_right->squared_distance(V,Ele,p,low_sqr_d,sqr_d,i_right,c_right);
       this->set_min(p,sqr_d_right,i_right,c_right,sqr_d,i,c);
@@ -477,19 +603,90 @@ IGL_INLINE void igl::AABB<DerivedV,DIM>::squared_distance(
   Eigen::PlainObjectBase<DerivedC> & C) const
 {
   assert(P.cols() == V.cols() && "cols in P should match dim of cols in V");
-  sqrD.resize(P.rows(),1);
-  I.resize(P.rows(),1);
+  const int n = P.rows();
+  sqrD.resize(n,1);
+  I.resize(n,1);
   C.resizeLike(P);
-  // O( #P * log #Ele ), where log #Ele is really the depth of this AABB
-  // hierarchy
-  for(int p = 0;p<P.rows();p++)
+  if(n == 0)
   {
-    RowVectorDIMS Pp = P.row(p), c;
-    int Ip;
-    sqrD(p) = squared_distance(V,Ele,Pp,Ip,c);
-    I(p) = Ip;
-    C.row(p).head(DIM) = c;
+    return;
   }
+  // Queries are visited in Morton order and grouped into small chunks of
+  // nearby points. Each chunk first gathers the subtrees of this hierarchy
+  // that could hold the closest primitive of _any_ of its queries, so that
+  // the upper levels of the tree are traversed once per chunk rather than
+  // once per query. Each query is then seeded with the closest primitive of
+  // the previous (neighbouring) query, so that most subtrees are pruned
+  // immediately.
+  Eigen::VectorXi order;
+  spatial_order(
+    Eigen::MatrixXd(P.template cast<double>()),SPATIAL_ORDER_TYPE_MORTON,order);
+  const int chunk_size = 64;
+  const size_t max_frontier = 16;
+  const int num_chunks = (n+chunk_size-1)/chunk_size;
+  parallel_for(num_chunks,[&](const int k)
+  {
+    const int j0 = k*chunk_size;
+    const int j1 = std::min(n,j0+chunk_size);
+    Eigen::AlignedBox<Scalar,DIM> Q;
+    for(int j = j0;j<j1;j++)
+    {
+      const RowVectorDIMS p = P.row(order[j]);
+      Q.extend(p.transpose());
+    }
+    // Full query for the first point
+    int i;
+    RowVectorDIMS c;
+    {
+      const RowVectorDIMS p = P.row(order[j0]);
+      sqrD(order[j0]) = squared_distance(V,Ele,p,i,c);
+      I(order[j0]) = i;
+      C.row(order[j0]).head(DIM) = c;
+    }
+    // No query in the chunk is farther than this from its closest primitive
+    const Scalar up = sqrt(Scalar(sqrD(order[j0]))) + Q.diagonal().norm();
+    const Scalar up_sqr_d = up*up;
+    std::vector<const AABB<DerivedV,DIM>*> frontier(1,this),next;
+    for(bool expanded = true;expanded && frontier.size() < max_frontier;)
+    {
+      expanded = false;
+      next.clear();
+      for(const auto * node : frontier)
+      {
+        if(node->is_leaf())
+        {
+          next.push_back(node);
+          continue;
+        }
+        for(const auto * child : {node->m_left,node->m_right})
+        {
+          if(child->m_box.squaredExteriorDistance(Q) <= up_sqr_d)
+          {
+            next.push_back(child);
+          }
+        }
+        expanded = true;
+      }
+      frontier.swap(next);
+    }
+    for(int j = j0+1;j<j1;j++)
+    {
+      const RowVectorDIMS p = P.row(order[j]);
+      // Seed with the previous query's closest primitive
+      Scalar sqr_d;
+      point_simplex_squared_distance<DIM>(p,V,Ele,i,sqr_d,c);
+      for(const auto * node : frontier)
+      {
+        if(node->m_box.squaredExteriorDistance(p.transpose()) < sqr_d)
+        {
+          sqr_d = node->squared_distance(V,Ele,p,0.0,sqr_d,i,c);
+        }
+      }
+      sqrD(order[j]) = sqr_d;
+      I(order[j]) = i;
+      C.row(order[j]).head(DIM) = c;
+    }
+  },2);
 }
 
 template <typename DerivedV, int DIM>
@@ -1022,6 +1219,16 @@ namespace igl
 #ifdef IGL_STATIC_LIBRARY
 // Explicit template instantiation
 // generated by autoexplicit.sh
+template void igl::AABB<Eigen::Matrix<float, -1, -1, 0, -1, -1>, 2>::init<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&);
+template float igl::AABB<Eigen::Matrix<float, -1, -1, 0, -1, -1>, 2>::squared_distance<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<float, 1, 2, 1, 1, 2> const&, float, float, int&, Eigen::PlainObjectBase<Eigen::Matrix<float, 1, 2, 1, 1, 2> >&) const;
+template void igl::AABB<Eigen::Matrix<float, -1, -1, 0, -1, -1>, 3>::squared_distance<Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<float, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> >&) const;
+template void igl::AABB<Eigen::Matrix<float, -1, -1, 0, -1, -1>, 3>::refit<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&);
+template void igl::AABB<Eigen::Matrix<float, -1, -1, 0, -1, -1>, 3>::init<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&);
+template float igl::AABB<Eigen::Matrix<float, -1, -1, 0, -1, -1>, 3>::squared_distance<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<float, 1, 3, 1, 1, 3> const&, int&, Eigen::PlainObjectBase<Eigen::Matrix<float, 1, 3, 1, 1, 3> >&) const;
+template bool igl::AABB<Eigen::Matrix<float, -1, -1, 0, -1, -1>, 3>::intersect_ray<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<float, 1, 3, 1, 1, 3> const&, Eigen::Matrix<float, 1, 3, 1, 1, 3> const&, std::vector<igl::Hit, std::allocator<igl::Hit> >&) const;
+template bool igl::AABB<Eigen::Matrix<float, -1, -1, 0, -1, -1>, 3>::intersect_ray<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<float, 1, 3, 1, 1, 3> const&, Eigen::Matrix<float, 1, 3, 1, 1, 3> const&, igl::Hit&) const;
+template bool igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>::intersect_ray<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<double, 1, 3, 1, 1, 3> const&, Eigen::Matrix<double, 1, 3, 1, 1, 3> const&, std::vector<igl::Hit, std::allocator<igl::Hit> >&) const;
+template bool igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>::intersect_ray<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<double, 1, 3, 1, 1, 3> const&, Eigen::Matrix<double, 1, 3, 1, 1, 3> const&, igl::Hit&) const;
 template double igl::AABB<Eigen::Matrix<double, -1, 3, 1, -1, 3>, 3>::squared_distance<Eigen::Matrix<int, -1, 3, 1, -1, 3> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 1, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 3, 1, -1, 3> > const&, Eigen::Matrix<double, 1, 3, 1, 1, 3> const&, double, double, int&, Eigen::PlainObjectBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> >&) const;
 // generated by autoexplicit.sh
 template void igl::AABB<Eigen::Matrix<double, -1, 3, 1, -1, 3>, 3>::init<Eigen::Matrix<int, -1, 3, 1, -1, 3> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 1, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 3, 1, -1, 3> > const&);
@@ -1068,4 +1275,10 @@ template void igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>::init<Eigen
 // generated by autoexplicit.sh
 template void igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 2>::init<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&);
 template double igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>::squared_distance<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<double, 1, 3, 1, 1, 3> const&, double, int&, Eigen::PlainObjectBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> >&) const;
+template void igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>::refit<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&);
+template void igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 2>::refit<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&);
+template void igl::AABB<Eigen::Matrix<double, -1, 3, 1, -1, 3>, 3>::refit<Eigen::Matrix<int, -1, 3, 1, -1, 3> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 1, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 3, 1, -1, 3> > const&);
+template double igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>::sah_cost() const;
+template double igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 2>::sah_cost() const;
+template double igl::AABB<Eigen::Matrix<double, -1, 3, 1, -1, 3>, 3>::sah_cost() const;
 #endif
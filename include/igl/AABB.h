@@ -161,6 +161,35 @@ public:
           const Eigen::MatrixBase<Derivedq> & q,
           const bool first=false) const;
 
+      // Refit the boxes of the hierarchy to new vertex positions of the same
+      // mesh, keeping the tree topology. Boxes are recomputed bottom-up, in
+      // parallel over subtrees. This is much cheaper than init, but the tree
+      // quality degrades as the mesh deforms away from its shape at
+      // construction time (see sah_cost).
+      //
+      // Inputs:
+      //   V  #V by dim list of new mesh vertex positions
+      //   Ele  #Ele by dim+1 list of mesh indices into #V. **Should be same as
+      //     used to construct tree.**
+      template <typename DerivedEle>
+      IGL_INLINE void refit(
+          const Eigen::MatrixBase<DerivedV> & V,
+          const Eigen::MatrixBase<DerivedEle> & Ele);
+      // Surface area heuristic cost of the hierarchy: the expected number of
+      // nodes a random ray through the root box visits, i.e., the sum over
+      // all nodes of the surface area of their box relative to the root's.
+      // Comparing the cost after refit to the cost right after init indicates
+      // when a full rebuild pays off, e.g.:
+      //
+      //     tree.init(V,F);
+      //     const double cost0 = tree.sah_cost();
+      //     ...
+      //     tree.refit(V,F);
+      //     if(tree.sah_cost() > 1.5*cost0) tree.init(V,F);
+      //
+      // Returns cost (0 for an empty tree)
+      IGL_INLINE Scalar sah_cost() const;
+
       // If number of elements m then total tree size should be 2*h where h is
       // the deepest depth 2^ceil(log(#Ele*2-1))
       IGL_INLINE int subtree_size() const;
@@ -279,6 +308,12 @@ public:
       //   sqrD  #P list of squared distances
       //   I  #P list of indices into Ele of closest primitives
       //   C  #P by dim list of closest points
+      //
+      // Queries are processed in parallel chunks of spatially nearby points
+      // (Morton order) that share the traversal of the upper levels of the
+      // hierarchy and seed each other's upper bounds. This is much faster
+      // than separate queries when P is spatially coherent (e.g., a grid or
+      // the vertices of another mesh).
       template <
         typename DerivedEle,
         typename DerivedP, 
@@ -0,0 +1,119 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 agent <agent@local>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "CompressedMesh.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+IGL_INLINE igl::CompressedMesh::CompressedMesh():
+  num_vertices(0),
+  num_faces(0),
+  block_size(256),
+  origin(0,0,0),
+  step(0,0,0)
+{
+}
+
+IGL_INLINE int igl::CompressedMesh::num_blocks() const
+{
+  return (num_faces+block_size-1)/block_size;
+}
+
+IGL_INLINE int igl::CompressedMesh::block_rows(const int b) const
+{
+  return std::min(block_size,num_faces-b*block_size);
+}
+
+IGL_INLINE void igl::CompressedMesh::decode_block(const int b, int * F) const
+{
+  assert(b >= 0 && b < num_blocks());
+  const unsigned char * data = face_data.data()+block_offsets[b];
+  const int n = 3*block_rows(b);
+  int prev = 0;
+  for(int k = 0;k<n;k++)
+  {
+    // Little endian base 128, zig-zag mapped difference to previous index
+    std::uint32_t z = 0;
+    int shift = 0;
+    unsigned char byte;
+    do
+    {
+      byte = *data++;
+      z |= std::uint32_t(byte & 0x7f) << shift;
+      shift += 7;
+    }while(byte & 0x80);
+    prev += int(z >> 1) ^ -int(z & 1);
+    F[k] = prev;
+  }
+}
+
+IGL_INLINE Eigen::RowVector3d igl::CompressedMesh::position(const int i) const
+{
+  return Eigen::RowVector3d(
+    origin(0)+step(0)*double(Q[3*i+0]),
+    origin(1)+step(1)*double(Q[3*i+1]),
+    origin(2)+step(2)*double(Q[3*i+2]));
+}
+
+IGL_INLINE Eigen::RowVector3d igl::CompressedMesh::normal(const int i) const
+{
+  return decode_normal(N[i]);
+}
+
+IGL_INLINE std::size_t igl::CompressedMesh::bytes() const
+{
+  return
+    Q.size()*sizeof(std::uint16_t)+
+    N.size()*sizeof(std::uint32_t)+
+    block_offsets.size()*sizeof(std::size_t)+
+    face_data.size();
+}
+
+IGL_INLINE std::uint32_t igl::CompressedMesh::encode_normal(
+  const Eigen::RowVector3d & n)
+{
+  const double l1 = std::abs(n(0))+std::abs(n(1))+std::abs(n(2));
+  double x = 0, y = 0;
+  if(l1 > 0)
+  {
+    x = n(0)/l1;
+    y = n(1)/l1;
+    if(n(2) < 0)
+    {
+      // Fold lower hemisphere over the diagonals
+      const double fx = (1.0-std::abs(y))*(x >= 0 ? 1.0 : -1.0);
+      const double fy = (1.0-std::abs(x))*(y >= 0 ? 1.0 : -1.0);
+      x = fx;
+      y = fy;
+    }
+  }
+  const auto snorm16 = [](const double a)->std::uint32_t
+  {
+    const double c = std::max(-1.0,std::min(1.0,a));
+    return std::uint16_t(std::int16_t(std::round(c*32767.0)));
+  };
+  return snorm16(x) | (snorm16(y) << 16);
+}
+
+IGL_INLINE Eigen::RowVector3d igl::CompressedMesh::decode_normal(
+  const std::uint32_t e)
+{
+  double x = std::max(-1.0,double(std::int16_t(e & 0xffff))/32767.0);
+  double y = std::max(-1.0,double(std::int16_t(e >> 16))/32767.0);
+  const double z = 1.0-std::abs(x)-std::abs(y);
+  if(z < 0)
+  {
+    const double fx = (1.0-std::abs(y))*(x >= 0 ? 1.0 : -1.0);
+    const double fy = (1.0-std::abs(x))*(y >= 0 ? 1.0 : -1.0);
+    x = fx;
+    y = fy;
+  }
+  Eigen::RowVector3d n(x,y,z);
+  const double l = n.norm();
+  return l > 0 ? Eigen::RowVector3d(n/l) : n;
+}
@@ -0,0 +1,77 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 agent <agent@local>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_COMPRESSED_MESH_H
+#define IGL_COMPRESSED_MESH_H
+#include "igl_inline.h"
+#include <Eigen/Core>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace igl
+{
+  // Compact storage of a static triangle mesh (see igl::compress_mesh and
+  // igl::decompress_mesh):
+  //
+  //   - positions are quantized to 16 bits per coordinate over the bounding
+  //     box (6 bytes per vertex instead of 24),
+  //   - optional per-vertex unit normals are stored as octahedral
+  //     coordinates in 2x16 bits (4 bytes instead of 24),
+  //   - faces are stored in independent blocks of block_size faces whose
+  //     indices are delta coded as variable length integers (typically 3 to 5
+  //     bytes per face instead of 12 once the mesh is reordered by
+  //     compress_mesh), so that any block can be decoded on its own and
+  //     blocks can be decoded in parallel.
+  struct CompressedMesh
+  {
+    int num_vertices;
+    int num_faces;
+    int block_size;
+    // 3*num_vertices quantized coordinates: coordinate d of vertex i is at
+    // origin(d) + Q[3*i+d]*step(d)
+    Eigen::RowVector3d origin;
+    Eigen::RowVector3d step;
+    std::vector<std::uint16_t> Q;
+    // Octahedral per-vertex normals (empty if none)
+    std::vector<std::uint32_t> N;
+    // Face block b is stored in face_data[block_offsets[b]] to
+    // face_data[block_offsets[b+1]-1]
+    std::vector<std::size_t> block_offsets;
+    std::vector<unsigned char> face_data;
+
+    IGL_INLINE CompressedMesh();
+    IGL_INLINE int num_blocks() const;
+    // Number of faces in block b
+    IGL_INLINE int block_rows(const int b) const;
+    // Decode the faces of a block
+    //
+    // Inputs:
+    //   b  index of block
+    // Outputs:
+    //   F  3*block_rows(b) list of vertex indices, face after face
+    IGL_INLINE void decode_block(const int b, int * F) const;
+    // Decoded position of vertex i
+    IGL_INLINE Eigen::RowVector3d position(const int i) const;
+    // Decoded unit normal of vertex i (requires !N.empty())
+    IGL_INLINE Eigen::RowVector3d normal(const int i) const;
+    // Number of bytes used by the compressed arrays
+    IGL_INLINE std::size_t bytes() const;
+
+    // Octahedral encoding of a unit vector into two 16-bit signed
+    // coordinates ("A Survey of Efficient Representations for Independent
+    // Unit Vectors" [Cigolle et al. 2014])
+    IGL_INLINE static std::uint32_t encode_normal(const Eigen::RowVector3d & n);
+    IGL_INLINE static Eigen::RowVector3d decode_normal(const std::uint32_t e);
+  };
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "CompressedMesh.cpp"
+#endif
+
+#endif
@@ -0,0 +1,116 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 agent <agent@local>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "UnionFind.h"
+#include "parallel_for.h"
+#include <utility>
+
+IGL_INLINE igl::UnionFind::UnionFind(const int n):
+  m_link(n)
+{
+  for(int i = 0;i<n;i++)
+  {
+    m_link[i].store(std::int64_t(i)<<1,std::memory_order_relaxed);
+  }
+}
+
+IGL_INLINE int igl::UnionFind::size() const
+{
+  return m_link.size();
+}
+
+IGL_INLINE int igl::UnionFind::find(const int x)
+{
+  bool parity;
+  return find(x,parity);
+}
+
+IGL_INLINE int igl::UnionFind::find(const int x, bool & parity)
+{
+  parity = false;
+  int y = x;
+  while(true)
+  {
+    const std::int64_t ly = m_link[y].load(std::memory_order_relaxed);
+    const int p = int(ly>>1);
+    if(p == y)
+    {
+      return y;
+    }
+    const std::int64_t lp = m_link[p].load(std::memory_order_relaxed);
+    const int g = int(lp>>1);
+    if(g != p)
+    {
+      // Path halving: point y to its grandparent. Links only ever move up
+      // the tree, so a stale lp is still an ancestor of y. If another thread
+      // changed y's link in the meantime, just leave it (and keep following
+      // the link that was read).
+      std::int64_t expected = ly;
+      m_link[y].compare_exchange_weak(
+        expected,(std::int64_t(g)<<1)|((ly^lp)&1));
+    }
+    parity ^= bool(ly&1);
+    y = p;
+  }
+}
+
+IGL_INLINE bool igl::UnionFind::unite(int a, int b, const bool parity)
+{
+  // parity of the input a (b) relative to the current a (b)
+  bool pa = false;
+  bool pb = false;
+  while(true)
+  {
+    bool qa,qb;
+    a = find(a,qa);
+    b = find(b,qb);
+    pa ^= qa;
+    pb ^= qb;
+    if(a == b)
+    {
+      return (pa^pb) == parity;
+    }
+    // Keep the smaller root
+    if(a < b)
+    {
+      std::swap(a,b);
+      std::swap(pa,pb);
+    }
+    std::int64_t la = std::int64_t(a)<<1;
+    if(m_link[a].compare_exchange_strong(
+      la,(std::int64_t(b)<<1)|std::int64_t(pa^pb^parity)))
+    {
+      return true;
+    }
+    // a is no longer a root: try again
+  }
+}
+
+IGL_INLINE void igl::UnionFind::labels(
+  Eigen::VectorXi & C,
+  Eigen::VectorXi & counts)
+{
+  const int n = size();
+  C.resize(n);
+  parallel_for(n,[&](const int i){ C(i) = find(i); },1000);
+  // Roots are the smallest elements of their sets
+  std::vector<int> id(n,-1);
+  int num_sets = 0;
+  for(int i = 0;i<n;i++)
+  {
+    if(C(i) == i)
+    {
+      id[i] = num_sets++;
+    }
+  }
+  counts.setZero(num_sets);
+  for(int i = 0;i<n;i++)
+  {
+    C(i) = id[C(i)];
+    counts(C(i))++;
+  }
+}
@@ -0,0 +1,69 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 agent <agent@local>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_UNION_FIND_H
+#define IGL_UNION_FIND_H
+#include "igl_inline.h"
+#include <Eigen/Core>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace igl
+{
+  // Disjoint sets of {0,...,n-1} that may be merged concurrently from many
+  // threads (e.g., inside igl::parallel_for) without locks: links are only
+  // ever changed with compare-and-swap and find compresses paths by halving.
+  //
+  // The root of each set is always its smallest element, so labels() numbers
+  // sets in the order of their first element, just like a breadth first
+  // search started at each not yet visited element in order would.
+  //
+  // Each element also stores a parity relative to the root of its set, so
+  // that constraints of the form "a and b are (not) flipped relative to each
+  // other" can be propagated while merging (e.g., consistent orientation of
+  // neighboring faces, see igl::orientable_patches).
+  class UnionFind
+  {
+    public:
+      // Inputs:
+      //   n  number of elements, each in its own set
+      IGL_INLINE UnionFind(const int n);
+      IGL_INLINE int size() const;
+      // Inputs:
+      //   x  element
+      // Outputs:
+      //   parity  parity of x relative to the root
+      // Returns root of the set containing x
+      IGL_INLINE int find(const int x);
+      IGL_INLINE int find(const int x, bool & parity);
+      // Merge the sets containing a and b
+      //
+      // Inputs:
+      //   a  element
+      //   b  element
+      //   parity  parity of a relative to b
+      // Returns false iff a and b were already in the same set with the
+      // opposite relative parity (nothing is changed in that case)
+      IGL_INLINE bool unite(int a, int b, const bool parity=false);
+      // Should only be called once all unite calls have returned.
+      //
+      // Outputs:
+      //   C  n list of set ids (starting with 0)
+      //   counts  #sets list of number of elements in each set
+      IGL_INLINE void labels(Eigen::VectorXi & C, Eigen::VectorXi & counts);
+    private:
+      // parent << 1 | parity (roots point to themselves with parity 0)
+      std::vector<std::atomic<std::int64_t> > m_link;
+  };
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "UnionFind.cpp"
+#endif
+
+#endif
@@ -363,8 +363,390 @@ IGL_INLINE igl::SolverStatus igl::active_set(
 }
 
 
+template <typename T, typename Derivedknown>
+IGL_INLINE bool igl::active_set_precompute(
+  const Eigen::SparseMatrix<T>& A,
+  const Eigen::MatrixBase<Derivedknown> & known,
+  active_set_data<T> & data)
+{
+  using namespace Eigen;
+  const int n = A.rows();
+  assert(n == A.cols() && "A must be square");
+  data.n = n;
+  data.known = known.template cast<int>();
+  data.A = A;
+  data.max_update = 32;
+  // Unknowns in index order
+  data.position = VectorXi::Zero(n);
+  for(int k = 0;k<data.known.size();k++)
+  {
+    assert(data.known(k) >= 0 && data.known(k) < n);
+    data.position(data.known(k)) = -1;
+  }
+  int nu = 0;
+  for(int i = 0;i<n;i++)
+  {
+    if(data.position(i) >= 0)
+    {
+      data.position(i) = nu++;
+    }
+  }
+  std::vector<Triplet<T> > IJV;
+  IJV.reserve(A.nonZeros());
+  for(int j = 0;j<A.outerSize();j++)
+  {
+    for(typename SparseMatrix<T>::InnerIterator it(A,j);it;++it)
+    {
+      if(data.position(it.row())>=0 && data.position(it.col())>=0)
+      {
+        IJV.emplace_back(
+          data.position(it.row()),data.position(it.col()),it.value());
+      }
+    }
+  }
+  SparseMatrix<T> Auu(nu,nu);
+  Auu.setFromTriplets(IJV.begin(),IJV.end());
+  // Fill-reducing ordering of all unknowns. Restricted to any subset of the
+  // unknowns it remains an elimination ordering with no more fill, so it is
+  // reused for every factorization in active_set_solve.
+  PermutationMatrix<Dynamic,Dynamic,int> Pinv;
+  {
+    SparseMatrix<T> C = Auu.template selfadjointView<Lower>();
+    AMDOrdering<int>()(C,Pinv);
+  }
+  const PermutationMatrix<Dynamic,Dynamic,int> P = Pinv.inverse();
+  data.order.resize(nu);
+  for(int i = 0;i<n;i++)
+  {
+    if(data.position(i) >= 0)
+    {
+      data.position(i) = P.indices()(data.position(i));
+      data.order(data.position(i)) = i;
+    }
+  }
+  data.Auu = Auu.twistedBy(P);
+  data.Auu_ldlt.compute(data.Auu);
+  return data.Auu_ldlt.info() == Eigen::Success;
+}
+
+template <
+  typename T,
+  typename DerivedB,
+  typename DerivedY,
+  typename Derivedlx,
+  typename Derivedux,
+  typename DerivedAS,
+  typename DerivedZ>
+IGL_INLINE igl::SolverStatus igl::active_set_solve(
+  const active_set_data<T> & data,
+  const Eigen::MatrixBase<DerivedB> & B,
+  const Eigen::MatrixBase<DerivedY> & Y,
+  const Eigen::MatrixBase<Derivedlx> & p_lx,
+  const Eigen::MatrixBase<Derivedux> & p_ux,
+  const igl::active_set_params & params,
+  Eigen::PlainObjectBase<DerivedAS> & AS,
+  Eigen::PlainObjectBase<DerivedZ> & Z)
+{
+  using namespace Eigen;
+  using namespace std;
+  typedef Matrix<T,Dynamic,1> VectorXT;
+  typedef typename active_set_data<T>::Solver Solver;
+  const int n = data.n;
+  const int nu = data.order.size();
+  assert(B.rows() == n && B.cols() == 1 && "B must be n by 1");
+  assert(Y.rows() == data.known.size() && "Y must be #known by 1");
+  const VectorXT lx = p_lx.size() == 0 ?
+    VectorXT::Constant(n,-numeric_limits<T>::max()) :
+    VectorXT(p_lx.template cast<T>());
+  const VectorXT ux = p_ux.size() == 0 ?
+    VectorXT::Constant(n,numeric_limits<T>::max()) :
+    VectorXT(p_ux.template cast<T>());
+  assert(lx.rows() == n && "lx must have n rows");
+  assert(ux.rows() == n && "ux must have n rows");
+  assert((ux.array()-lx.array()).minCoeff() > 0 && "ux(i) must be > lx(i)");
+  if(AS.size() != n)
+  {
+    AS.setZero(n,1);
+  }
+  for(int k = 0;k<data.known.size();k++)
+  {
+    AS(data.known(k)) = 0;
+  }
+  if(Z.size() != 0)
+  {
+    assert(Z.rows() == n && "Z must have n rows");
+    assert(Z.cols() == 1 && "Z must be a column vector");
+  }
+
+  // The reference factorization: initially data.Auu_ldlt of all unknowns,
+  // replaced by own factorization of a subset when refactoring
+  Solver own;
+  const Solver * ref = &data.Auu_ldlt;
+  // Positions of unknowns in reference system (and index into it, or -1)
+  vector<int> ref_free(nu);
+  VectorXi ref_map(nu);
+  for(int p = 0;p<nu;p++)
+  {
+    ref_free[p] = p;
+    ref_map(p) = p;
+  }
+  // Current free positions (and index into free_pos, or -1)
+  vector<int> free_pos;
+  VectorXi free_map(nu);
+  // Solution and right-hand side in position order
+  VectorXT r(nu),zu(nu);
+
+  DerivedZ old_Z;
+  old_Z = DerivedZ::Constant(n,1,numeric_limits<typename DerivedZ::Scalar>::max());
+  SolverStatus ret = SOLVER_STATUS_ERROR;
+  int iter = 0;
+  while(true)
+  {
+    // FIND BREACHES OF CONSTRAINTS
+    if(Z.size() > 0)
+    {
+      for(int p = 0;p<nu;p++)
+      {
+        const int z = data.order(p);
+        if(Z(z) < lx(z))
+        {
+          AS(z) = -1;
+        }else if(Z(z) > ux(z))
+        {
+          AS(z) = 1;
+        }
+      }
+      const double diff = (Z-old_Z).squaredNorm();
+      if(diff < params.solution_diff_threshold)
+      {
+        ret = SOLVER_STATUS_CONVERGED;
+        break;
+      }
+      old_Z = Z;
+    }
+
+    // PREPARE FIXED VALUES AND RIGHT HAND SIDE
+    VectorXT Zfixed = VectorXT::Zero(n);
+    for(int k = 0;k<data.known.size();k++)
+    {
+      Zfixed(data.known(k)) = Y(k);
+    }
+    free_pos.clear();
+    for(int p = 0;p<nu;p++)
+    {
+      const int z = data.order(p);
+      free_map(p) = -1;
+      if(AS(z) < 0)
+      {
+        Zfixed(z) = lx(z);
+      }else if(AS(z) > 0)
+      {
+        Zfixed(z) = ux(z);
+      }else
+      {
+        free_map(p) = free_pos.size();
+        free_pos.push_back(p);
+      }
+    }
+    {
+      const VectorXT AZfixed = data.A*Zfixed;
+      for(int p = 0;p<nu;p++)
+      {
+        const int z = data.order(p);
+        r(p) = -(T(B(z,0))+AZfixed(z));
+      }
+    }
+
+    // SOLVE FOR FREE VARIABLES
+    if(!free_pos.empty())
+    {
+      // Reference variables no longer free and free variables not in
+      // reference
+      vector<int> fixed_ref,released;
+      for(int a = 0;a<(int)ref_free.size();a++)
+      {
+        if(free_map(ref_free[a]) < 0)
+        {
+          fixed_ref.push_back(a);
+        }
+      }
+      for(const int p : free_pos)
+      {
+        if(ref_map(p) < 0)
+        {
+          released.push_back(p);
+        }
+      }
+      if(int(fixed_ref.size()+released.size()) > data.max_update)
+      {
+        // Refactor A(free,free): lower triangle of the restriction of Auu
+        const int nf = free_pos.size();
+        SparseMatrix<T> Aff(nf,nf);
+        {
+          VectorXi nnz(nf);
+          for(int f = 0;f<nf;f++)
+          {
+            nnz(f) = data.Auu.col(free_pos[f]).nonZeros();
+          }
+          Aff.reserve(nnz);
+        }
+        for(int f = 0;f<nf;f++)
+        {
+          for(typename SparseMatrix<T>::InnerIterator 
+            it(data.Auu,free_pos[f]);it;++it)
+          {
+            const int g = free_map(it.row());
+            if(g >= f)
+            {
+              Aff.insert(g,f) = it.value();
+            }
+          }
+        }
+        Aff.makeCompressed();
+        own.compute(Aff);
+        if(own.info() != Eigen::Success)
+        {
+          cerr<<"Error: active_set_solve factorization failed."<<endl;
+          ret = SOLVER_STATUS_ERROR;
+          break;
+        }
+        ref = &own;
+        ref_free = free_pos;
+        ref_map = free_map;
+        fixed_ref.clear();
+        released.clear();
+      }
+      const int nr = ref_free.size();
+      VectorXT rr(nr);
+      for(int a = 0;a<nr;a++)
+      {
+        rr(a) = free_map(ref_free[a]) < 0 ? T(0) : r(ref_free[a]);
+      }
+      VectorXT xr;
+      const int nR = released.size();
+      const int k = nR + fixed_ref.size();
+      if(k == 0)
+      {
+        xr = ref->solve(rr);
+      }else
+      {
+        // Bordered system: the reference matrix extended by the released
+        // variables and by Lagrange multipliers fixing the variables that
+        // left the reference set
+        //
+        //   [Arr  ArR  E] [xr]   [rr]
+        //   [ARr  ARR  0] [xR] = [rR]
+        //   [E'   0    0] [mu]   [0 ]
+        //
+        // solved by eliminating xr with the reference factorization
+        SparseMatrix<T> K(nr,k);
+        {
+          std::vector<Triplet<T> > IJV;
+          for(int c = 0;c<nR;c++)
+          {
+            for(typename SparseMatrix<T>::InnerIterator 
+              it(data.Auu,released[c]);it;++it)
+            {
+              if(ref_map(it.row()) >= 0)
+              {
+                IJV.emplace_back(ref_map(it.row()),c,it.value());
+              }
+            }
+          }
+          for(int c = nR;c<k;c++)
+          {
+            IJV.emplace_back(fixed_ref[c-nR],c,T(1));
+          }
+          K.setFromTriplets(IJV.begin(),IJV.end());
+        }
+        VectorXi released_map = VectorXi::Constant(nu,-1);
+        for(int c = 0;c<nR;c++)
+        {
+          released_map(released[c]) = c;
+        }
+        // Schur complement S = [ARR 0;0 0] - K' Arr⁻¹ K, one column at a time
+        Matrix<T,Dynamic,Dynamic> S(k,k);
+        for(int c = 0;c<k;c++)
+        {
+          const VectorXT Xc = ref->solve(VectorXT(K.col(c)));
+          S.col(c) = -(K.transpose()*Xc);
+          if(c < nR)
+          {
+            for(typename SparseMatrix<T>::InnerIterator 
+              it(data.Auu,released[c]);it;++it)
+            {
+              const int d = released_map(it.row());
+              if(d >= 0)
+              {
+                S(d,c) += it.value();
+              }
+            }
+          }
+        }
+        const VectorXT x0 = ref->solve(rr);
+        VectorXT rs = -(K.transpose()*x0);
+        for(int c = 0;c<nR;c++)
+        {
+          rs(c) += r(released[c]);
+        }
+        const VectorXT y = S.fullPivLu().solve(rs);
+        xr = ref->solve(VectorXT(rr - K*y));
+        for(int c = 0;c<nR;c++)
+        {
+          zu(released[c]) = y(c);
+        }
+      }
+      if(ref->info() != Eigen::Success)
+      {
+        cerr<<"Error: active_set_solve solve failed."<<endl;
+        ret = SOLVER_STATUS_ERROR;
+        break;
+      }
+      for(int a = 0;a<nr;a++)
+      {
+        zu(ref_free[a]) = xr(a);
+      }
+    }
+    Z.resize(n,1);
+    for(int i = 0;i<n;i++)
+    {
+      Z(i) = Zfixed(i);
+    }
+    for(const int p : free_pos)
+    {
+      Z(data.order(p)) = zu(p);
+    }
+
+    // Lagrange multipliers of active bounds, release those below threshold
+    const VectorXT G = data.A*Z.template cast<T>() + B.template cast<T>();
+    for(int p = 0;p<nu;p++)
+    {
+      const int z = data.order(p);
+      if(AS(z) != 0)
+      {
+        const T lambda = -0.5*G(z)*(AS(z) < 0 ? -1 : 1);
+        if(lambda < params.inactive_threshold)
+        {
+          AS(z) = 0;
+        }
+      }
+    }
+
+    iter++;
+    if(params.max_iter>0 && iter>=params.max_iter)
+    {
+      ret = SOLVER_STATUS_MAX_ITER;
+      break;
+    }
+  }
+  return ret;
+}
+
+
 #ifdef IGL_STATIC_LIBRARY
 // Explicit template instantiation
 template igl::SolverStatus igl::active_set<double, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, double, Eigen::Matrix<double, -1, 1, 0, -1, 1>, double, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, 1, 0, -1, 1> >(Eigen::SparseMatrix<double, 0, int> const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, Eigen::SparseMatrix<double, 0, int> const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, Eigen::SparseMatrix<double, 0, int> const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, igl::active_set_params const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&);
 template igl::SolverStatus igl::active_set<double, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, double, Eigen::Matrix<double, -1, 1, 0, -1, 1>, double, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::SparseMatrix<double, 0, int> const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::SparseMatrix<double, 0, int> const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, Eigen::SparseMatrix<double, 0, int> const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, igl::active_set_params const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&);
+template bool igl::active_set_precompute<double, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::SparseMatrix<double, 0, int> const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, igl::active_set_data<double>&);
+template igl::SolverStatus igl::active_set_solve<double, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, 1, 0, -1, 1> >(igl::active_set_data<double> const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, igl::active_set_params const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&);
 #endif
@@ -16,6 +16,8 @@
 namespace igl
 {
   struct active_set_params;
+  template <typename T>
+  struct active_set_data;
   // Known Bugs: rows of [Aeq;Aieq] **must** be linearly independent. Should be
   // using QR decomposition otherwise:
   //   http://www.okstate.edu/sas/v8/sashtml/ormp/chap5/sect32.htm
@@ -76,6 +78,72 @@ namespace igl
     const igl::active_set_params & params,
     Eigen::PlainObjectBase<DerivedZ> & Z
     );
+  // ACTIVE_SET_PRECOMPUTE Precompute the factorization of A(unknown,unknown)
+  // shared by all box constrained problems solved with active_set_solve:
+  //
+  // 0.5*Z'*A*Z + Z'*B + C subject to Z(known) = Y and lx <= Z <= ux
+  //
+  // (no linear equality or inequality constraints). Use this instead of
+  // active_set when solving many such problems with the same A and known
+  // (e.g. one per column of B or Y): the fill-reducing ordering and the
+  // factorization are computed once, and each active set iteration only
+  // updates the current factorization (see active_set_solve).
+  //
+  // Templates:
+  //   T  should be a eigen sparse matrix primitive type like double
+  // Inputs:
+  //   A  n by n matrix of quadratic coefficients, A(unknown,unknown) must be
+  //     symmetric positive definite
+  //   known  list of indices to known rows in Z
+  // Outputs:
+  //   data  factorization struct with all necessary information to solve
+  //     using active_set_solve
+  // Returns true on success, false on error
+  template <typename T, typename Derivedknown>
+  IGL_INLINE bool active_set_precompute(
+    const Eigen::SparseMatrix<T>& A,
+    const Eigen::MatrixBase<Derivedknown> & known,
+    active_set_data<T> & data);
+  // ACTIVE_SET_SOLVE Solve a box constrained problem using the precomputed
+  // data. Variables entering or leaving the active set are handled by a
+  // Schur complement (bordered) solve against the current factorization,
+  // which is only replaced by a factorization of the current free variables
+  // when more than data.max_update of them have changed. Multiple calls may
+  // run in parallel on the same data.
+  //
+  // Inputs:
+  //   data  factorization struct created in precomputation
+  //   B  n by 1 column of linear coefficients
+  //   Y  #known by 1 list of fixed values corresponding to known rows in Z
+  //   lx  n by 1 list of lower bounds [] implies -Inf
+  //   ux  n by 1 list of upper bounds [] implies Inf
+  //   params  struct of additional parameters (Auu_pd is ignored)
+  //   AS  n by 1 initial active set: -1 at lower bound, 1 at upper bound, 0
+  //     otherwise (warm start, e.g. the output of a previous solve), []
+  //     implies all 0 (see output)
+  //   Z  if not empty, is taken to be an n by 1 list of initial guess values
+  //     (see output)
+  // Outputs:
+  //   AS  n by 1 final active set
+  //   Z  n by 1 list of solution values
+  // Returns solver status
+  template <
+    typename T,
+    typename DerivedB,
+    typename DerivedY,
+    typename Derivedlx,
+    typename Derivedux,
+    typename DerivedAS,
+    typename DerivedZ>
+  IGL_INLINE igl::SolverStatus active_set_solve(
+    const active_set_data<T> & data,
+    const Eigen::MatrixBase<DerivedB> & B,
+    const Eigen::MatrixBase<DerivedY> & Y,
+    const Eigen::MatrixBase<Derivedlx> & lx,
+    const Eigen::MatrixBase<Derivedux> & ux,
+    const igl::active_set_params & params,
+    Eigen::PlainObjectBase<DerivedAS> & AS,
+    Eigen::PlainObjectBase<DerivedZ> & Z);
 };
 
 #include "EPS.h"
@@ -104,6 +172,31 @@ struct igl::active_set_params
     {};
 };
 
+template <typename T>
+struct igl::active_set_data
+{
+  typedef Eigen::SimplicialLDLT<
+    Eigen::SparseMatrix<T>,Eigen::Lower,Eigen::NaturalOrdering<int> > Solver;
+  // Size of original system: number of unknowns + number of knowns
+  int n;
+  // Indices of known variables
+  Eigen::VectorXi known;
+  // #unknown list of unknown variables in fill-reducing elimination order
+  Eigen::VectorXi order;
+  // n list of positions of variables in order (-1 for known variables)
+  Eigen::VectorXi position;
+  // Quadratic coefficients
+  Eigen::SparseMatrix<T> A;
+  // A(order,order)
+  Eigen::SparseMatrix<T> Auu;
+  // Factorization of Auu
+  Solver Auu_ldlt;
+  // Maximum number of variables entering or leaving the active set handled
+  // by bordered solves before refactoring (may be changed after
+  // precomputation) {32}
+  int max_update;
+};
+
 #ifndef IGL_STATIC_LIBRARY
 #  include "active_set.cpp"
 #endif
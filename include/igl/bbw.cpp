@@ -6,7 +6,6 @@
 // v. 2.0. If a copy of the MPL was not distributed with this file, You can
 // obtain one at http://mozilla.org/MPL/2.0/.
 #include "bbw.h"
-#include "min_quad_with_fixed.h"
 #include "harmonic.h"
 #include "parallel_for.h"
 #include <Eigen/Sparse>
@@ -17,6 +16,7 @@
 igl::BBWData::BBWData():
   partition_unity(false),
   W0(),
+  AS(),
   active_set_params(),
   verbosity(0)
 {
@@ -60,28 +60,25 @@ IGL_INLINE bool igl::bbw(
   W.derived().resize(n,m);
   // No linear terms
   VectorXd c = VectorXd::Zero(n);
-  // No linear constraints
-  SparseMatrix<typename DerivedW::Scalar> A(0,n),Aeq(0,n),Aieq(0,n);
-  VectorXd Beq(0,1),Bieq(0,1);
   // Upper and lower box constraints (Constant bounds)
   VectorXd ux = VectorXd::Ones(n);
   VectorXd lx = VectorXd::Zero(n);
-  active_set_params eff_params = data.active_set_params;
   if(data.verbosity >= 1)
   {
     cout<<"BBW: max_iter: "<<data.active_set_params.max_iter<<endl;
-    cout<<"BBW: eff_max_iter: "<<eff_params.max_iter<<endl;
   }
-  if(data.verbosity >= 1)
+  // One factorization of the bilaplacian shared by all handles
+  active_set_data<typename DerivedV::Scalar> asd;
+  if(!active_set_precompute(Q,b,asd))
+  {
+    cerr<<"active_set_precompute error."<<endl;
+    return false;
+  }
+  const bool use_W0 = data.W0.rows() == n && data.W0.cols() == m;
+  if(data.AS.rows() != n || data.AS.cols() != m)
   {
-    cout<<"BBW: Computing initial weights for "<<m<<" handle"<<
-      (m!=1?"s":"")<<"."<<endl;
+    data.AS.setZero(n,m);
   }
-  min_quad_with_fixed_data<typename DerivedW::Scalar > mqwf;
-  min_quad_with_fixed_precompute(Q,b,Aeq,true,mqwf);
-  min_quad_with_fixed_solve(mqwf,c,bc,Beq,W);
-  // decrement
-  eff_params.max_iter--;
   bool error = false;
   // Loop over handles
   std::mutex critical;
@@ -99,11 +96,15 @@ IGL_INLINE bool igl::bbw(
         "."<<endl;
     }
     VectorXd bci = bc.col(i);
+    VectorXi ASi = data.AS.col(i);
+    // Initial guess or first iteration is the unconstrained solve
     VectorXd Wi;
-    // use initial guess
-    Wi = W.col(i);
-    SolverStatus ret = active_set(
-        Q,c,b,bci,Aeq,Beq,Aieq,Bieq,lx,ux,eff_params,Wi);
+    if(use_W0)
+    {
+      Wi = data.W0.col(i);
+    }
+    SolverStatus ret = active_set_solve(
+        asd,c,bci,lx,ux,data.active_set_params,ASi,Wi);
     switch(ret)
     {
       case SOLVER_STATUS_CONVERGED:
@@ -117,6 +118,7 @@ IGL_INLINE bool igl::bbw(
         error = true;
     }
     W.col(i) = Wi;
+    data.AS.col(i) = ASi;
   };
   parallel_for(m,optimize_weight,2);
   if(error)
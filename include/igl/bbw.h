@@ -21,8 +21,12 @@ namespace igl
       // Enforce partition of unity during optimization (optimize all weight
       // simultaneously)
       bool partition_unity;
-      // Initial guess
+      // Initial guess (used if #V by #W)
       Eigen::MatrixXd W0;
+      // Active sets of each weight (-1 at 0, 1 at 1, 0 otherwise, see
+      // active_set_solve): used as warm start if #V by #W, set to the final
+      // active sets on output
+      Eigen::MatrixXi AS;
       igl::active_set_params active_set_params;
       // Verbosity level
       // 0: quiet
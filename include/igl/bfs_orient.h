@@ -12,7 +12,10 @@
 
 namespace igl
 {
-  // Consistently orient faces in orientable patches using BFS
+  // Consistently orient faces in orientable patches. The first face of each
+  // patch keeps its orientation. The relative orientations are propagated in
+  // parallel while merging the patches (see orientable_patches) instead of
+  // by a breadth first search.
   //
   // F = bfs_orient(F,V);
   //
@@ -0,0 +1,262 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 agent <agent@local>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "blue_noise.h"
+#include "doublearea.h"
+#include "parallel_for.h"
+#include "random_points_on_mesh.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+template <
+  typename DerivedV,
+  typename DerivedF,
+  typename DerivedB,
+  typename DerivedFI,
+  typename DerivedX>
+IGL_INLINE void igl::blue_noise(
+  const int n,
+  const Eigen::PlainObjectBase<DerivedV> & V,
+  const Eigen::PlainObjectBase<DerivedF> & F,
+  const unsigned long long seed,
+  Eigen::PlainObjectBase<DerivedB> & B,
+  Eigen::PlainObjectBase<DerivedFI> & FI,
+  Eigen::PlainObjectBase<DerivedX> & X)
+{
+  assert(V.cols() == 3 && "V should contain 3d points");
+  assert(F.cols() == 3 && "F should contain triangles");
+  if(n <= 0)
+  {
+    B.resize(0,3);
+    FI.resize(0,1);
+    X.resize(0,3);
+    return;
+  }
+  // Candidates
+  const int m = 5*n;
+  Eigen::MatrixXd Bc;
+  Eigen::VectorXi Fc;
+  random_points_on_mesh(m,V,F,true,seed,Bc,Fc);
+  Eigen::MatrixXd P(m,3);
+  parallel_for(m,[&](const int i)
+  {
+    P.row(i) =
+      Bc(i,0)*V.row(F(Fc(i),0)).template cast<double>() +
+      Bc(i,1)*V.row(F(Fc(i),1)).template cast<double>() +
+      Bc(i,2)*V.row(F(Fc(i),2)).template cast<double>();
+  },10000);
+
+  // Radius of n maximally packed disks covering the surface and the
+  // weight limiting radius [Yuksel 2015, Eq. 5 and 6]
+  Eigen::VectorXd dblA;
+  doublearea(V,F,dblA);
+  const double area = 0.5*dblA.sum();
+  const double r_max = std::sqrt(area/(2.*std::sqrt(3.)*n));
+  const double r_min = r_max*(1.-std::pow(double(n)/double(m),1.5))*0.65;
+  const double R = 2.*r_max;
+  const auto weight = [&](const double d)->double
+  {
+    const double w = 1.-std::max(d,r_min)/R;
+    const double w2 = w*w;
+    const double w4 = w2*w2;
+    return w4*w4;
+  };
+
+  // Spatial hash: candidates sorted by the index of their grid cell of size
+  // R, so that all neighbours within R are in the 27 surrounding cells
+  const Eigen::RowVector3d min_P = P.colwise().minCoeff();
+  const Eigen::RowVector3d ext_P = P.colwise().maxCoeff()-min_P;
+  long long dims[3];
+  for(int d = 0;d<3;d++)
+  {
+    dims[d] = (long long)(ext_P(d)/R)+1;
+  }
+  const auto cell = [&](const int i, long long * c)
+  {
+    for(int d = 0;d<3;d++)
+    {
+      c[d] = std::min(dims[d]-1,(long long)((P(i,d)-min_P(d))/R));
+    }
+  };
+  const auto key = [&](const long long * c)->long long
+  {
+    return (c[0]*dims[1]+c[1])*dims[2]+c[2];
+  };
+  std::vector<std::pair<long long,int> > sorted(m);
+  parallel_for(m,[&](const int i)
+  {
+    long long c[3];
+    cell(i,c);
+    sorted[i] = std::make_pair(key(c),i);
+  },10000);
+  std::sort(sorted.begin(),sorted.end());
+  // From here on candidates are numbered in cell order, so that neighbours
+  // are close in memory
+  std::vector<Eigen::Vector3d> Q(m);
+  std::vector<long long> K(m);
+  parallel_for(m,[&](const int k)
+  {
+    Q[k] = P.row(sorted[k].second).transpose();
+    K[k] = sorted[k].first;
+  },10000);
+  // Gather all candidates (and their distances) within R of candidate i
+  typedef std::vector<std::pair<int,double> > Neighbors;
+  const auto gather = [&](const int i, Neighbors & nbrs)
+  {
+    nbrs.clear();
+    long long c[3];
+    cell(sorted[i].second,c);
+    long long o[3];
+    for(o[0] = std::max(0LL,c[0]-1);o[0]<=std::min(dims[0]-1,c[0]+1);o[0]++)
+    for(o[1] = std::max(0LL,c[1]-1);o[1]<=std::min(dims[1]-1,c[1]+1);o[1]++)
+    {
+      // cells along the last dimension have consecutive keys
+      o[2] = std::max(0LL,c[2]-1);
+      const long long k_begin = key(o);
+      o[2] = std::min(dims[2]-1,c[2]+1);
+      const long long k_end = key(o);
+      for(int j = 
+        int(std::lower_bound(K.begin(),K.end(),k_begin)-K.begin());
+        j<m && K[j]<=k_end;j++)
+      {
+        if(j == i)
+        {
+          continue;
+        }
+        const double d = (Q[i]-Q[j]).norm();
+        if(d < R)
+        {
+          nbrs.push_back(std::make_pair(j,d));
+        }
+      }
+    }
+  };
+  // Neighbourhoods in compressed sparse row form (gathered twice: once to
+  // count, once to fill)
+  std::vector<Neighbors> scratch;
+  const auto prep = [&](const size_t nthreads){ scratch.resize(nthreads); };
+  const auto no_op = [](const size_t){};
+  std::vector<int> offsets(m+1,0);
+  parallel_for(m,prep,[&](const int i, const size_t t)
+  {
+    gather(i,scratch[t]);
+    offsets[i+1] = scratch[t].size();
+  },no_op,1000);
+  for(int i = 0;i<m;i++)
+  {
+    offsets[i+1] += offsets[i];
+  }
+  std::vector<int> N(offsets[m]);
+  std::vector<double> D(offsets[m]);
+  std::vector<double> W(m,0);
+  parallel_for(m,prep,[&](const int i, const size_t t)
+  {
+    gather(i,scratch[t]);
+    for(size_t k = 0;k<scratch[t].size();k++)
+    {
+      N[offsets[i]+k] = scratch[t][k].first;
+      D[offsets[i]+k] = scratch[t][k].second;
+      W[i] += weight(scratch[t][k].second);
+    }
+  },no_op,1000);
+
+  // Greedily eliminate the candidate with the largest weight, using a binary
+  // max-heap that tracks the position of each candidate so that weights of
+  // neighbours can be decreased in place. Ties go to the smaller index.
+  std::vector<int> heap(m);
+  std::vector<int> pos(m);
+  const auto before = [&](const int i, const int j)
+  {
+    return W[i] > W[j] || (W[i] == W[j] && i < j);
+  };
+  const auto sift_down = [&](int h)
+  {
+    const int size = (int)heap.size();
+    const int i = heap[h];
+    while(true)
+    {
+      int c = 2*h+1;
+      if(c >= size)
+      {
+        break;
+      }
+      if(c+1 < size && before(heap[c+1],heap[c]))
+      {
+        c++;
+      }
+      if(!before(heap[c],i))
+      {
+        break;
+      }
+      heap[h] = heap[c];
+      pos[heap[h]] = h;
+      h = c;
+    }
+    heap[h] = i;
+    pos[i] = h;
+  };
+  for(int i = 0;i<m;i++)
+  {
+    heap[i] = i;
+    pos[i] = i;
+  }
+  for(int h = m/2-1;h>=0;h--)
+  {
+    sift_down(h);
+  }
+  std::vector<bool> removed(m,false);
+  while((int)heap.size() > n)
+  {
+    const int i = heap[0];
+    removed[i] = true;
+    heap[0] = heap.back();
+    heap.pop_back();
+    if(!heap.empty())
+    {
+      sift_down(0);
+    }
+    for(int a = offsets[i];a<offsets[i+1];a++)
+    {
+      const int j = N[a];
+      if(!removed[j])
+      {
+        // weights only decrease
+        W[j] -= weight(D[a]);
+        sift_down(pos[j]);
+      }
+    }
+  }
+
+  // Survivors in order of their original candidate index
+  std::vector<int> S;
+  S.reserve(n);
+  for(int k = 0;k<m;k++)
+  {
+    if(!removed[k])
+    {
+      S.push_back(sorted[k].second);
+    }
+  }
+  std::sort(S.begin(),S.end());
+  B.resize(n,3);
+  FI.resize(n,1);
+  X.resize(n,3);
+  for(int k = 0;k<n;k++)
+  {
+    B.row(k) = Bc.row(S[k]).template cast<typename DerivedB::Scalar>();
+    FI(k) = Fc(S[k]);
+    X.row(k) = P.row(S[k]).template cast<typename DerivedX::Scalar>();
+  }
+}
+
+#ifdef IGL_STATIC_LIBRARY
+// Explicit template instantiation
+template void igl::blue_noise<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(int, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, unsigned long long, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&);
+#endif
@@ -0,0 +1,56 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 agent <agent@local>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_BLUE_NOISE_H
+#define IGL_BLUE_NOISE_H
+#include "igl_inline.h"
+#include <Eigen/Core>
+
+namespace igl
+{
+  // BLUE_NOISE Sample a mesh (V,F) with n points with a blue noise
+  // (Poisson-disk like) distribution using weighted sample elimination
+  // [Yuksel 2015]: 5n stratified random candidates are drawn (see
+  // random_points_on_mesh), then the candidate with the most crowded
+  // neighbourhood (within a radius found from the mesh area) is removed
+  // repeatedly until n remain. Neighbourhoods are found in parallel with a
+  // spatial hash.
+  //
+  // Inputs:
+  //   n  number of samples
+  //   V  #V by 3 list of mesh vertex positions
+  //   F  #F by 3 list of mesh triangle indices
+  //   seed  seed of the random number generator (output only depends on the
+  //     seed, not on the number of threads)
+  // Outputs:
+  //   B  n by 3 list of barycentric coordinates, ith row are coordinates of
+  //     ith sampled point in face FI(i)
+  //   FI  n list of indices into F
+  //   X  n by 3 list of sample positions
+  //
+  // See also: random_points_on_mesh
+  template <
+    typename DerivedV,
+    typename DerivedF,
+    typename DerivedB,
+    typename DerivedFI,
+    typename DerivedX>
+  IGL_INLINE void blue_noise(
+    const int n,
+    const Eigen::PlainObjectBase<DerivedV> & V,
+    const Eigen::PlainObjectBase<DerivedF> & F,
+    const unsigned long long seed,
+    Eigen::PlainObjectBase<DerivedB> & B,
+    Eigen::PlainObjectBase<DerivedFI> & FI,
+    Eigen::PlainObjectBase<DerivedX> & X);
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "blue_noise.cpp"
+#endif
+
+#endif
@@ -9,11 +9,13 @@
 #include "face_occurrences.h"
 
 // IGL includes
-#include "sort.h"
+#include "list_to_matrix.h"
+#include "matrix_to_list.h"
+#include "parallel_for.h"
 
 // STL includes
-#include <map>
-#include <iostream>
+#include <algorithm>
+#include <cassert>
 
 template <typename IntegerT, typename IntegerF>
 IGL_INLINE void igl::boundary_facets(
@@ -21,100 +23,71 @@ IGL_INLINE void igl::boundary_facets(
   std::vector<std::vector<IntegerF> > & F)
 {
   using namespace std;
-
+  using namespace Eigen;
   if(T.size() == 0)
   {
     F.clear();
     return;
   }
+  // Use the Eigen version
+  Matrix<IntegerT,Dynamic,Dynamic> mT;
+  list_to_matrix(T,mT);
+  Matrix<IntegerF,Dynamic,Dynamic> mF;
+  boundary_facets(mT,mF);
+  matrix_to_list(mF,F);
+}
 
-  int simplex_size = T[0].size();
+template <typename DerivedT, typename DerivedF>
+IGL_INLINE void igl::boundary_facets(
+  const Eigen::PlainObjectBase<DerivedT>& T,
+  Eigen::PlainObjectBase<DerivedF>& F)
+{
+  assert(T.cols() == 0 || T.cols() == 4 || T.cols() == 3);
+  using namespace std;
+  using namespace Eigen;
+  typedef typename DerivedT::Scalar Index;
+  const int simplex_size = T.cols();
+  if(T.rows() == 0)
+  {
+    F.resize(0,std::max(simplex_size-1,0));
+    return;
+  }
+  // Faces of each simplex, in correct order
+  const int tet_faces[4][3] = {{1,3,2},{0,2,3},{0,3,1},{0,1,2}};
+  const int tri_faces[3][2] = {{1,2},{2,0},{0,1}};
   // Get a list of all faces
-  vector<vector<IntegerF> > allF(
-    T.size()*simplex_size,
-    vector<IntegerF>(simplex_size-1));
-
-  // Gather faces, loop over tets
-  for(int i = 0; i< (int)T.size();i++)
+  Matrix<Index,Dynamic,Dynamic> allF(T.rows()*simplex_size,simplex_size-1);
+  parallel_for(T.rows(),[&](const int i)
   {
-    assert((int)T[i].size() == simplex_size);
-    switch(simplex_size)
+    for(int j = 0;j<simplex_size;j++)
     {
-      case 4:
-        // get face in correct order
-        allF[i*simplex_size+0][0] = T[i][1];
-        allF[i*simplex_size+0][1] = T[i][3];
-        allF[i*simplex_size+0][2] = T[i][2];
-        // get face in correct order
-        allF[i*simplex_size+1][0] = T[i][0];
-        allF[i*simplex_size+1][1] = T[i][2];
-        allF[i*simplex_size+1][2] = T[i][3];
-        // get face in correct order
-        allF[i*simplex_size+2][0] = T[i][0];
-        allF[i*simplex_size+2][1] = T[i][3];
-        allF[i*simplex_size+2][2] = T[i][1];
-        // get face in correct order
-        allF[i*simplex_size+3][0] = T[i][0];
-        allF[i*simplex_size+3][1] = T[i][1];
-        allF[i*simplex_size+3][2] = T[i][2];
-        break;
-      case 3:
-        allF[i*simplex_size+0][0] = T[i][1];
-        allF[i*simplex_size+0][1] = T[i][2];
-        allF[i*simplex_size+1][0] = T[i][2];
-        allF[i*simplex_size+1][1] = T[i][0];
-        allF[i*simplex_size+2][0] = T[i][0];
-        allF[i*simplex_size+2][1] = T[i][1];
-        break;
+      for(int c = 0;c<simplex_size-1;c++)
+      {
+        allF(i*simplex_size+j,c) = 
+          T(i,simplex_size == 4 ? tet_faces[j][c] : tri_faces[j][c]);
+      }
     }
-  }
+  },10000);
 
   // Counts
-  vector<int> C;
+  VectorXi C;
   face_occurrences(allF,C);
 
   // Q: Why not just count the number of ones?
   // A: because we are including non-manifold edges as boundary edges
-  int twos = (int) count(C.begin(),C.end(),2);
-  //int ones = (int) count(C.begin(),C.end(),1);
-  // Resize output to fit number of ones
-  F.resize(allF.size() - twos);
-  //F.resize(ones);
+  const int twos = (C.array() == 2).count();
+  F.resize(allF.rows() - twos,simplex_size-1);
   int k = 0;
-  for(int i = 0;i< (int)allF.size();i++)
+  for(int i = 0;i< (int)allF.rows();i++)
   {
-    if(C[i] != 2)
+    if(C(i) != 2)
     {
-      assert(k<(int)F.size());
-      F[k] = allF[i];
+      assert(k<(int)F.rows());
+      F.row(k) = allF.row(i).template cast<typename DerivedF::Scalar>();
       k++;
     }
   }
-  assert(k==(int)F.size());
-  //if(k != F.size())
-  //{
-  //  printf("%d =? %d\n",k,F.size());
-  //}
-
-}
-
-#include "list_to_matrix.h"
-#include "matrix_to_list.h"
-
-template <typename DerivedT, typename DerivedF>
-IGL_INLINE void igl::boundary_facets(
-  const Eigen::PlainObjectBase<DerivedT>& T,
-  Eigen::PlainObjectBase<DerivedF>& F)
-{
-  assert(T.cols() == 0 || T.cols() == 4 || T.cols() == 3);
-  using namespace std;
-  using namespace Eigen;
-  // Cop out: use vector of vectors version
-  vector<vector<typename DerivedT::Scalar> > vT;
-  matrix_to_list(T,vT);
-  vector<vector<typename DerivedF::Scalar> > vF;
-  boundary_facets(vT,vF);
-  list_to_matrix(vF,F);
+  assert(k==(int)F.rows());
 }
 
 template <typename DerivedT, typename Ret>
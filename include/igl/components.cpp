@@ -6,9 +6,8 @@
 // v. 2.0. If a copy of the MPL was not distributed with this file, You can
 // obtain one at http://mozilla.org/MPL/2.0/.
 #include "components.h"
-#include "adjacency_matrix.h"
-#include <queue>
-#include <vector>
+#include "UnionFind.h"
+#include "parallel_for.h"
 
 template <typename AScalar, typename DerivedC, typename Derivedcounts>
 IGL_INLINE void igl::components(
@@ -16,55 +15,25 @@ IGL_INLINE void igl::components(
   Eigen::PlainObjectBase<DerivedC> & C,
   Eigen::PlainObjectBase<Derivedcounts> & counts)
 {
-  using namespace Eigen;
-  using namespace std;
   assert(A.rows() == A.cols() && "A should be square.");
-  const size_t n = A.rows();
-  Array<bool,Dynamic,1> seen = Array<bool,Dynamic,1>::Zero(n,1);
-  C.resize(n,1);
-  typename DerivedC::Scalar id = 0;
-  vector<typename Derivedcounts::Scalar> vcounts;
-  // breadth first search
-  for(int k=0; k<A.outerSize(); ++k)
+  const int n = A.rows();
+  UnionFind U(n);
+  parallel_for(A.outerSize(),[&](const int k)
   {
-    if(seen(k))
-    {
-      continue;
-    }
-    queue<int> Q;
-    Q.push(k);
-    vcounts.push_back(0);
-    while(!Q.empty())
+    for(typename Eigen::SparseMatrix<AScalar>::InnerIterator it (A,k); it; ++it)
     {
-      const int f = Q.front();
-      Q.pop();
-      if(seen(f))
+      if(it.value())
       {
-        continue;
-      }
-      seen(f) = true;
-      C(f,0) = id;
-      vcounts[id]++;
-      // Iterate over inside
-      for(typename SparseMatrix<AScalar>::InnerIterator it (A,f); it; ++it)
-      {
-        const int g = it.index();
-        if(!seen(g) && it.value())
-        {
-          Q.push(g);
-        }
+        U.unite(k,it.index());
       }
     }
-    id++;
-  }
-  assert((size_t) id == vcounts.size());
-  const size_t ncc = vcounts.size();
-  assert((size_t)C.maxCoeff()+1 == ncc);
-  counts.resize(ncc,1);
-  for(size_t i = 0;i<ncc;i++)
-  {
-    counts(i) = vcounts[i];
-  }
+  },1000);
+  Eigen::VectorXi IC,Icounts;
+  U.labels(IC,Icounts);
+  C.resize(n,1);
+  C.array() = IC.array().cast<typename DerivedC::Scalar>();
+  counts.resize(Icounts.rows(),1);
+  counts.array() = Icounts.array().cast<typename Derivedcounts::Scalar>();
 }
 
 template <typename AScalar, typename DerivedC>
@@ -81,9 +50,20 @@ IGL_INLINE void igl::components(
   const Eigen::MatrixBase<DerivedF> & F,
   Eigen::PlainObjectBase<DerivedC> & C)
 {
-  Eigen::SparseMatrix<typename DerivedC::Scalar> A;
-  adjacency_matrix(F,A);
-  return components(A,C);
+  // Same as components(adjacency_matrix(F),C) without building the matrix
+  const int n = F.size() == 0 ? 0 : F.maxCoeff()+1;
+  UnionFind U(n);
+  parallel_for(F.rows(),[&](const int f)
+  {
+    for(int c = 1;c<F.cols();c++)
+    {
+      U.unite(F(f,0),F(f,c));
+    }
+  },1000);
+  Eigen::VectorXi IC,counts;
+  U.labels(IC,counts);
+  C.resize(n,1);
+  C.array() = IC.array().cast<typename DerivedC::Scalar>();
 }
 
 #ifdef IGL_STATIC_LIBRARY
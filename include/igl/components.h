@@ -14,9 +14,11 @@ namespace igl
 {
   // Compute connected components of a graph represented by an adjacency
   // matrix. This version is faster than the previous version using boost.
+  // Components are merged in parallel (see igl::UnionFind) and numbered in
+  // order of their first vertex.
   //
   // Inputs:
-  //   A  n by n adjacency matrix
+  //   A  n by n (symmetric) adjacency matrix
   // Outputs:
   //   C  n list of component ids (starting with 0)
   //   counts  #components list of counts for each component
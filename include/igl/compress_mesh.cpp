@@ -0,0 +1,159 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 agent <agent@local>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "compress_mesh.h"
+#include "parallel_for.h"
+#include "vertex_cache_order.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+template <
+  typename DerivedV,
+  typename DerivedF,
+  typename DerivedN,
+  typename DerivedI,
+  typename DerivedJ>
+IGL_INLINE void igl::compress_mesh(
+  const Eigen::MatrixBase<DerivedV> & V,
+  const Eigen::MatrixBase<DerivedF> & F,
+  const Eigen::MatrixBase<DerivedN> & N,
+  const int block_size,
+  CompressedMesh & C,
+  Eigen::PlainObjectBase<DerivedI> & I,
+  Eigen::PlainObjectBase<DerivedJ> & J)
+{
+  assert(V.rows() == 0 || V.cols() == 3);
+  assert(F.rows() == 0 || F.cols() == 3);
+  assert(N.rows() == 0 || (N.rows() == V.rows() && N.cols() == 3));
+  assert(block_size > 0);
+  const int n = V.rows();
+  const int m = F.rows();
+  C = CompressedMesh();
+  C.num_vertices = n;
+  C.num_faces = m;
+  C.block_size = block_size;
+
+  // Reorder faces, then number vertices in order of first reference
+  Eigen::MatrixXi FF;
+  {
+    Eigen::VectorXi JJ;
+    vertex_cache_order(Eigen::MatrixXi(F.template cast<int>()),FF,JJ);
+    J = JJ.template cast<typename DerivedJ::Scalar>();
+  }
+  Eigen::VectorXi IM = Eigen::VectorXi::Constant(n,-1);
+  I.resize(n);
+  int num_used = 0;
+  for(int f = 0;f<m;f++)
+  {
+    for(int c = 0;c<3;c++)
+    {
+      int & im = IM(FF(f,c));
+      if(im < 0)
+      {
+        I(num_used) = FF(f,c);
+        im = num_used++;
+      }
+      FF(f,c) = im;
+    }
+  }
+  for(int i = 0;i<n;i++)
+  {
+    if(IM(i) < 0)
+    {
+      I(num_used) = i;
+      IM(i) = num_used++;
+    }
+  }
+
+  // Quantize positions and normals
+  if(n > 0)
+  {
+    const Eigen::RowVector3d min_corner =
+      V.colwise().minCoeff().template cast<double>();
+    const Eigen::RowVector3d max_corner =
+      V.colwise().maxCoeff().template cast<double>();
+    C.origin = min_corner;
+    C.step = (max_corner-min_corner)/65535.0;
+  }
+  C.Q.resize(3*n);
+  if(N.rows() > 0)
+  {
+    C.N.resize(n);
+  }
+  parallel_for(n,[&](const int i)
+  {
+    const int old = I(i);
+    for(int d = 0;d<3;d++)
+    {
+      const double q = C.step(d) > 0 ?
+        std::round((double(V(old,d))-C.origin(d))/C.step(d)) : 0;
+      C.Q[3*i+d] = std::uint16_t(std::max(0.0,std::min(65535.0,q)));
+    }
+    if(N.rows() > 0)
+    {
+      C.N[i] = CompressedMesh::encode_normal(
+        N.row(old).template cast<double>());
+    }
+  },1000);
+
+  // Delta code each block on its own
+  const int num_blocks = C.num_blocks();
+  std::vector<std::vector<unsigned char> > blocks(num_blocks);
+  parallel_for(num_blocks,[&](const int b)
+  {
+    std::vector<unsigned char> & data = blocks[b];
+    data.reserve(5*C.block_rows(b));
+    int prev = 0;
+    const int f0 = b*block_size;
+    for(int f = f0;f<f0+C.block_rows(b);f++)
+    {
+      for(int c = 0;c<3;c++)
+      {
+        const int delta = FF(f,c)-prev;
+        prev = FF(f,c);
+        std::uint32_t z =
+          (std::uint32_t(delta) << 1) ^ std::uint32_t(delta >> 31);
+        while(z >= 0x80)
+        {
+          data.push_back((unsigned char)(z | 0x80));
+          z >>= 7;
+        }
+        data.push_back((unsigned char)z);
+      }
+    }
+  },1);
+  C.block_offsets.resize(num_blocks+1);
+  C.block_offsets[0] = 0;
+  for(int b = 0;b<num_blocks;b++)
+  {
+    C.block_offsets[b+1] = C.block_offsets[b]+blocks[b].size();
+  }
+  C.face_data.resize(C.block_offsets[num_blocks]);
+  parallel_for(num_blocks,[&](const int b)
+  {
+    std::copy(
+      blocks[b].begin(),blocks[b].end(),
+      C.face_data.begin()+C.block_offsets[b]);
+  },16);
+}
+
+template <typename DerivedV, typename DerivedF>
+IGL_INLINE void igl::compress_mesh(
+  const Eigen::MatrixBase<DerivedV> & V,
+  const Eigen::MatrixBase<DerivedF> & F,
+  CompressedMesh & C)
+{
+  Eigen::VectorXi I,J;
+  return compress_mesh(V,F,Eigen::MatrixXd(),256,C,I,J);
+}
+
+#ifdef IGL_STATIC_LIBRARY
+// Explicit template instantiation
+template void igl::compress_mesh<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, int, igl::CompressedMesh&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
+template void igl::compress_mesh<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, igl::CompressedMesh&);
+#endif
@@ -0,0 +1,59 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 agent <agent@local>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_COMPRESS_MESH_H
+#define IGL_COMPRESS_MESH_H
+#include "igl_inline.h"
+#include "CompressedMesh.h"
+#include <Eigen/Core>
+
+namespace igl
+{
+  // COMPRESS_MESH Store a triangle mesh in a igl::CompressedMesh. Faces are
+  // first reordered for vertex locality (see igl::vertex_cache_order) and
+  // vertices are renumbered in order of first reference (unreferenced
+  // vertices last), which keeps index deltas small. Positions are quantized
+  // to 16 bits per coordinate over the bounding box: the error is at most
+  // half of (max-min)/65535 per coordinate.
+  //
+  // Inputs:
+  //   V  #V by 3 list of vertex positions
+  //   F  #F by 3 list of triangle indices into V
+  //   N  #V by 3 list of per-vertex unit normals, or empty
+  //   block_size  number of faces per independently decodable block
+  // Outputs:
+  //   C  compressed mesh
+  //   I  #V list of indices into V so that vertex i of C is V.row(I(i))
+  //   J  #F list of indices into F so that face f of C is face J(f) of F
+  //     (reindexed by I)
+  template <
+    typename DerivedV,
+    typename DerivedF,
+    typename DerivedN,
+    typename DerivedI,
+    typename DerivedJ>
+  IGL_INLINE void compress_mesh(
+    const Eigen::MatrixBase<DerivedV> & V,
+    const Eigen::MatrixBase<DerivedF> & F,
+    const Eigen::MatrixBase<DerivedN> & N,
+    const int block_size,
+    CompressedMesh & C,
+    Eigen::PlainObjectBase<DerivedI> & I,
+    Eigen::PlainObjectBase<DerivedJ> & J);
+  // Without normals, blocks of 256 faces
+  template <typename DerivedV, typename DerivedF>
+  IGL_INLINE void compress_mesh(
+    const Eigen::MatrixBase<DerivedV> & V,
+    const Eigen::MatrixBase<DerivedF> & F,
+    CompressedMesh & C);
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "compress_mesh.cpp"
+#endif
+
+#endif
@@ -43,6 +43,15 @@ namespace igl {
     int maxIter;
     bool doHardConstraints;
     
+    // Factorizations of the free-by-free blocks of the global step systems
+    // (and the matching free-by-constrained blocks), reused for as long as
+    // lambda does not change. The sparsity pattern is analyzed only once.
+    Eigen::SimplicialLDLT<Eigen::SparseMatrix<std::complex<typename DerivedV::Scalar> > > solverA, solverB;
+    Eigen::SparseMatrix<std::complex<typename DerivedV::Scalar> > QukA, QukB;
+    bool isAnalyzed;
+    bool isFactored;
+    typename DerivedV::Scalar factoredLambda;
+    
     IGL_INLINE void localStep();
     IGL_INLINE void getPolyCoeffsForLocalSolve(const Eigen::Matrix<typename DerivedV::Scalar, 4, 1> &s,
                                                const Eigen::Matrix<typename DerivedV::Scalar, 4, 1> &z,
@@ -55,6 +64,9 @@ namespace igl {
                                          const Eigen::SparseMatrix<std::complex<typename DerivedV::Scalar> > &f,
                                          const Eigen::VectorXi isConstrained,
                                          const Eigen::Matrix<std::complex<typename DerivedV::Scalar>, Eigen::Dynamic, 1> &xknown,
+                                         const bool refactor,
+                                         Eigen::SparseMatrix<std::complex<typename DerivedV::Scalar> > &Quk,
+                                         Eigen::SimplicialLDLT<Eigen::SparseMatrix<std::complex<typename DerivedV::Scalar> > > &solver,
                                          Eigen::Matrix<std::complex<typename DerivedV::Scalar>, Eigen::Dynamic, 1> &x);
     IGL_INLINE void setFieldFromCoefficients();
     IGL_INLINE void setCoefficientsFromField();
@@ -77,7 +89,10 @@ lambdaOrtho(_lambdaOrtho),
 lambdaInit(_lambdaInit),
 maxIter(_maxIter),
 lambdaMultFactor(_lambdaMultFactor),
-doHardConstraints(_doHardConstraints)
+doHardConstraints(_doHardConstraints),
+isAnalyzed(false),
+isFactored(false),
+factoredLambda(0)
 {
   Acoeff.resize(data.numF,1);
   Bcoeff.resize(data.numF,1);
@@ -174,6 +189,8 @@ globalStep(const Eigen::Matrix<int, Eigen::Dynamic, 1>  &isConstrained,
 {
   setCoefficientsFromField();
   
+  const bool refactor = !isFactored || lambda != factoredLambda;
+  
   Eigen::SparseMatrix<std::complex<typename DerivedV::Scalar> > I;
   igl::speye(data.numF, data.numF, I);
   Eigen::SparseMatrix<std::complex<typename DerivedV::Scalar> > QA = data.DDA+lambda*data.planarityWeight+lambdaOrtho*I;
@@ -184,16 +201,19 @@ globalStep(const Eigen::Matrix<int, Eigen::Dynamic, 1>  &isConstrained,
   
   if(doHardConstraints)
   {
-    minQuadWithKnownMini(QA, fA, isConstrained, Ak, Acoeff);
-    minQuadWithKnownMini(QB, fB, isConstrained, Bk, Bcoeff);
+    minQuadWithKnownMini(QA, fA, isConstrained, Ak, refactor, QukA, solverA, Acoeff);
+    minQuadWithKnownMini(QB, fB, isConstrained, Bk, refactor, QukB, solverB, Bcoeff);
   }
   else
   {
     Eigen::Matrix<int, Eigen::Dynamic, 1>isknown_; isknown_.setZero(data.numF,1);
     Eigen::Matrix<std::complex<typename DerivedV::Scalar>, Eigen::Dynamic, 1> xknown_; xknown_.setZero(0,1);
-    minQuadWithKnownMini(QA, fA, isknown_, xknown_, Acoeff);
-    minQuadWithKnownMini(QB, fB, isknown_, xknown_, Bcoeff);
+    minQuadWithKnownMini(QA, fA, isknown_, xknown_, refactor, QukA, solverA, Acoeff);
+    minQuadWithKnownMini(QB, fB, isknown_, xknown_, refactor, QukB, solverB, Bcoeff);
   }
+  isAnalyzed = true;
+  isFactored = true;
+  factoredLambda = lambda;
   setFieldFromCoefficients();
   
 }
@@ -238,6 +258,9 @@ minQuadWithKnownMini(const Eigen::SparseMatrix<std::complex<typename DerivedV::S
                      const Eigen::SparseMatrix<std::complex<typename DerivedV::Scalar> > &f,
                      const Eigen::VectorXi isConstrained,
                      const Eigen::Matrix<std::complex<typename DerivedV::Scalar>, Eigen::Dynamic, 1> &xknown,
+                     const bool refactor,
+                     Eigen::SparseMatrix<std::complex<typename DerivedV::Scalar> > &Quk,
+                     Eigen::SimplicialLDLT<Eigen::SparseMatrix<std::complex<typename DerivedV::Scalar> > > &solver,
                      Eigen::Matrix<std::complex<typename DerivedV::Scalar>, Eigen::Dynamic, 1> &x)
 {
   int N = Q.rows();
@@ -259,41 +282,38 @@ minQuadWithKnownMini(const Eigen::SparseMatrix<std::complex<typename DerivedV::S
       indu++;
     }
   
-  Eigen::SparseMatrix<std::complex<typename DerivedV::Scalar>> Quu, Quk;
-  
-  igl::slice(Q,unknown, unknown, Quu);
-  igl::slice(Q,unknown, known, Quk);
-  
-  
-  std::vector<typename Eigen::Triplet<std::complex<typename DerivedV::Scalar> > > tripletList;
-  
-  Eigen::SparseMatrix<std::complex<typename DerivedV::Scalar> > fu(N-nc,1);
-  
-  igl::slice(f,unknown, Eigen::VectorXi::Zero(1,1), fu);
-  
-  Eigen::SparseMatrix<std::complex<typename DerivedV::Scalar> > rhs = (Quk*xknown).sparseView()+.5*fu;
-  
-  Eigen::SparseLU< Eigen::SparseMatrix<std::complex<typename DerivedV::Scalar>>> solver;
-  solver.compute(-Quu);
-  if(solver.info()!=Eigen::Success)
+  if(refactor)
   {
-    std::cerr<<"Decomposition failed!"<<std::endl;
-    return;
+    // Q is Hermitian positive (semi-)definite, so Quu can be factored with a
+    // complex LDLT
+    Eigen::SparseMatrix<std::complex<typename DerivedV::Scalar>> Quu;
+    igl::slice(Q,unknown, unknown, Quu);
+    igl::slice(Q,unknown, known, Quk);
+    if(!isAnalyzed)
+      solver.analyzePattern(Quu);
+    solver.factorize(Quu);
   }
-  Eigen::SparseMatrix<std::complex<typename DerivedV::Scalar>>  b  = solver.solve(rhs);
   if(solver.info()!=Eigen::Success)
   {
-    std::cerr<<"Solving failed!"<<std::endl;
+    std::cerr<<"Decomposition failed!"<<std::endl;
     return;
   }
   
+  Eigen::SparseMatrix<std::complex<typename DerivedV::Scalar> > fu(N-nc,1);
+  
+  igl::slice(f,unknown, Eigen::VectorXi::Zero(1,1), fu);
+  
+  // -Quu*b = Quk*xknown+.5*fu
+  Eigen::Matrix<std::complex<typename DerivedV::Scalar>, Eigen::Dynamic, 1> rhs = -(Quk*xknown)-.5*Eigen::Matrix<std::complex<typename DerivedV::Scalar>, Eigen::Dynamic, 1>(fu);
+  Eigen::Matrix<std::complex<typename DerivedV::Scalar>, Eigen::Dynamic, 1> b  = solver.solve(rhs);
+  
   indk = 0, indu = 0;
   x.setZero(N,1);
   for (int i = 0; i<N; ++i)
     if (isConstrained[i])
       x[i] = xknown[indk++];
     else
-      x[i] = b.coeff(indu++,0);
+      x[i] = b(indu++);
   
 }
 
@@ -305,6 +325,9 @@ solve(const Eigen::VectorXi &isConstrained,
       Eigen::PlainObjectBase<DerivedO> &output)
 {
   int numConstrained = isConstrained.sum();
+  // the constrained faces may differ from the previous call
+  isAnalyzed = false;
+  isFactored = false;
   // coefficient values
   Eigen::Matrix<std::complex<typename DerivedV::Scalar>, Eigen::Dynamic, 1> Ak, Bk;
   
@@ -0,0 +1,57 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 agent <agent@local>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "decompress_mesh.h"
+#include "parallel_for.h"
+#include <vector>
+
+template <typename DerivedV, typename DerivedF, typename DerivedN>
+IGL_INLINE void igl::decompress_mesh(
+  const CompressedMesh & C,
+  Eigen::PlainObjectBase<DerivedV> & V,
+  Eigen::PlainObjectBase<DerivedF> & F,
+  Eigen::PlainObjectBase<DerivedN> & N)
+{
+  decompress_mesh(C,V,F);
+  N.resize(C.N.empty() ? 0 : C.num_vertices,3);
+  parallel_for(N.rows(),[&](const int i)
+  {
+    N.row(i) = C.normal(i).cast<typename DerivedN::Scalar>();
+  },1000);
+}
+
+template <typename DerivedV, typename DerivedF>
+IGL_INLINE void igl::decompress_mesh(
+  const CompressedMesh & C,
+  Eigen::PlainObjectBase<DerivedV> & V,
+  Eigen::PlainObjectBase<DerivedF> & F)
+{
+  V.resize(C.num_vertices,3);
+  parallel_for(C.num_vertices,[&](const int i)
+  {
+    V.row(i) = C.position(i).cast<typename DerivedV::Scalar>();
+  },1000);
+  F.resize(C.num_faces,3);
+  parallel_for(C.num_blocks(),[&](const int b)
+  {
+    std::vector<int> Fb(3*C.block_rows(b));
+    C.decode_block(b,Fb.data());
+    for(int k = 0;k<C.block_rows(b);k++)
+    {
+      for(int c = 0;c<3;c++)
+      {
+        F(b*C.block_size+k,c) = Fb[3*k+c];
+      }
+    }
+  },4);
+}
+
+#ifdef IGL_STATIC_LIBRARY
+// Explicit template instantiation
+template void igl::decompress_mesh<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(igl::CompressedMesh const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&);
+template void igl::decompress_mesh<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(igl::CompressedMesh const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&);
+#endif
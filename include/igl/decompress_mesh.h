@@ -0,0 +1,41 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 agent <agent@local>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_DECOMPRESS_MESH_H
+#define IGL_DECOMPRESS_MESH_H
+#include "igl_inline.h"
+#include "CompressedMesh.h"
+#include <Eigen/Core>
+
+namespace igl
+{
+  // DECOMPRESS_MESH Decode a igl::CompressedMesh (blocks in parallel)
+  //
+  // Inputs:
+  //   C  compressed mesh
+  // Outputs:
+  //   V  C.num_vertices by 3 list of dequantized vertex positions
+  //   F  C.num_faces by 3 list of triangle indices into V
+  //   N  C.num_vertices by 3 list of unit normals (empty if C has none)
+  template <typename DerivedV, typename DerivedF, typename DerivedN>
+  IGL_INLINE void decompress_mesh(
+    const CompressedMesh & C,
+    Eigen::PlainObjectBase<DerivedV> & V,
+    Eigen::PlainObjectBase<DerivedF> & F,
+    Eigen::PlainObjectBase<DerivedN> & N);
+  template <typename DerivedV, typename DerivedF>
+  IGL_INLINE void decompress_mesh(
+    const CompressedMesh & C,
+    Eigen::PlainObjectBase<DerivedV> & V,
+    Eigen::PlainObjectBase<DerivedF> & F);
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "decompress_mesh.cpp"
+#endif
+
+#endif
@@ -0,0 +1,40 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 agent <agent@local>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "default_num_threads.h"
+#include <atomic>
+#include <cstdlib>
+#include <thread>
+
+IGL_INLINE unsigned int igl::default_num_threads(
+  const unsigned int force_num_threads,
+  const bool reset)
+{
+  const auto from_environment = []()->unsigned int
+  {
+    if(const char * env = std::getenv("LIBIGL_NUM_THREADS"))
+    {
+      const int n = std::atoi(env);
+      if(n > 0)
+      {
+        return (unsigned int)n;
+      }
+    }
+    const unsigned int hc = std::thread::hardware_concurrency();
+    return hc == 0 ? 8 : hc;
+  };
+  static std::atomic<unsigned int> num_threads(from_environment());
+  if(reset)
+  {
+    num_threads = from_environment();
+  }
+  if(force_num_threads > 0)
+  {
+    num_threads = force_num_threads;
+  }
+  return num_threads;
+}
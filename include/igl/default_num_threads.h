@@ -0,0 +1,39 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 agent <agent@local>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_DEFAULT_NUM_THREADS_H
+#define IGL_DEFAULT_NUM_THREADS_H
+#include "igl_inline.h"
+
+namespace igl
+{
+  // DEFAULT_NUM_THREADS Number of threads used by igl::parallel_for. Unless
+  // forced, this is the value of the LIBIGL_NUM_THREADS environment variable
+  // if set or else std::thread::hardware_concurrency() (8 if unknown). The
+  // environment is read on the first call and again on each reset.
+  //
+  // Inputs:
+  //   force_num_threads  if positive, use this many threads from now on
+  //     (until forced again or reset) {0}
+  //   reset  whether to first discard any forced value and re-read
+  //     LIBIGL_NUM_THREADS and the hardware concurrency {false}
+  // Returns number of threads
+  //
+  // Example:
+  //   igl::default_num_threads(1);      // run serially from now on
+  //   ...
+  //   igl::default_num_threads(0,true); // back to the default
+  IGL_INLINE unsigned int default_num_threads(
+    const unsigned int force_num_threads = 0,
+    const bool reset = false);
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "default_num_threads.cpp"
+#endif
+
+#endif
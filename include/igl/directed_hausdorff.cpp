@@ -0,0 +1,293 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 agent <agent@local>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "directed_hausdorff.h"
+#include "AABB.h"
+#include "parallel_for.h"
+#include "point_simplex_squared_distance.h"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+namespace igl
+{
+  // Triangle (piece of a face of A) with distances of its corners to B, the
+  // closest triangles in B to its corners and an upper bound on the distance
+  // of any of its points to B
+  template <typename Scalar>
+  struct DirectedHausdorffPiece
+  {
+    Eigen::Matrix<Scalar,3,3,Eigen::RowMajor|Eigen::DontAlign> V;
+    Eigen::Matrix<Scalar,3,1,Eigen::DontAlign> d;
+    Eigen::Matrix<int,3,1,Eigen::DontAlign> I;
+    Scalar u;
+  };
+  // Upper bound on the distance to B of any point in the triangle V, given
+  // only the distances d of its corners to B (see igl::hausdorff)
+  template <typename Scalar>
+  IGL_INLINE void directed_hausdorff_upper_bound(
+    DirectedHausdorffPiece<Scalar> & T)
+  {
+    Eigen::Matrix<Scalar,3,1> e;
+    Scalar e_max = 0;
+    for(int i = 0;i<3;i++)
+    {
+      e(i) = (T.V.row((i+1)%3)-T.V.row((i+2)%3)).norm();
+      e_max = std::max(e_max,e(i));
+    }
+    const Scalar s = (e(0)+e(1)+e(2))*0.5;
+    const Scalar A = sqrt(std::max(s*(s-e(0))*(s-e(1))*(s-e(2)),Scalar(0)));
+    // Circumradius and inradius (degenerate triangles fall back to half the
+    // longest edge)
+    const Scalar R = e(0)*e(1)*e(2)/(4.*A);
+    const Scalar r = A/s;
+    Scalar u1 = std::numeric_limits<Scalar>::infinity();
+    Scalar u2 = 0;
+    for(int i = 0;i<3;i++)
+    {
+      u1 = std::min(u1,T.d(i) + std::max(e((i+1)%3),e((i+2)%3)));
+      u2 = std::max(u2,T.d(i));
+    }
+    u2 += (A>0 && s-r>2.*R ? R : 0.5*e_max);
+    T.u = std::min(u1,u2);
+  }
+}
+
+template <
+  typename DerivedVA,
+  typename DerivedFA,
+  typename DerivedVB,
+  typename DerivedFB,
+  typename Scalar>
+IGL_INLINE void igl::directed_hausdorff(
+  const Eigen::PlainObjectBase<DerivedVA> & VA,
+  const Eigen::PlainObjectBase<DerivedFA> & FA,
+  const Eigen::PlainObjectBase<DerivedVB> & VB,
+  const Eigen::PlainObjectBase<DerivedFB> & FB,
+  const Scalar eps,
+  const Scalar threshold,
+  Scalar & l,
+  Scalar & u)
+{
+  typedef igl::AABB<DerivedVB,3> Tree;
+  typedef typename Tree::RowVectorDIMS RowVectorDIMS;
+  typedef DirectedHausdorffPiece<Scalar> Piece;
+  assert(VA.cols() == 3 && "VA should contain 3d points");
+  assert(FA.cols() == 3 && "FA should contain triangles");
+  assert(VB.cols() == 3 && "VB should contain 3d points");
+  assert(FB.cols() == 3 && "FB should contain triangles");
+  assert(eps > 0 && "eps should be positive");
+  const Scalar inf = std::numeric_limits<Scalar>::infinity();
+  const bool use_threshold = threshold < inf;
+  l = 0;
+  u = 0;
+  if(FA.rows() == 0)
+  {
+    return;
+  }
+  if(FB.rows() == 0)
+  {
+    l = u = inf;
+    return;
+  }
+  Tree tree;
+  tree.init(VB,FB);
+  typedef typename Tree::Scalar TreeScalar;
+  // Squared distance to triangle f of B
+  const auto sqr_dist_to_f = [&](const RowVectorDIMS & p, const int f)
+  {
+    TreeScalar sqr_d;
+    RowVectorDIMS c;
+    point_simplex_squared_distance<3>(p,VB,FB,f,sqr_d,c);
+    return sqr_d;
+  };
+  // Distance to B and closest triangle i, warm-started with candidate
+  // triangles (-1 entries are ignored). The AABB search only needs to
+  // consider triangles closer than the best candidate.
+  const auto dist_to_B = [&](
+    const RowVectorDIMS & p, const int * cand, const int ncand, int & i)
+  {
+    TreeScalar up_sqr_d = std::numeric_limits<TreeScalar>::infinity();
+    i = -1;
+    for(int j = 0;j<ncand;j++)
+    {
+      if(cand[j] >= 0 && cand[j] != i)
+      {
+        const TreeScalar sqr_d = sqr_dist_to_f(p,cand[j]);
+        if(sqr_d < up_sqr_d)
+        {
+          up_sqr_d = sqr_d;
+          i = cand[j];
+        }
+      }
+    }
+    int j = -1;
+    RowVectorDIMS c;
+    // inflated slightly so that roundoff never misses the candidate itself
+    const TreeScalar sqr_d = 
+      tree.squared_distance(VB,FB,p,up_sqr_d*(1+1e-8),j,c);
+    if(sqr_d < up_sqr_d)
+    {
+      up_sqr_d = sqr_d;
+      i = j;
+    }
+    return Scalar(sqrt(up_sqr_d));
+  };
+  // Upper bound on distance to B of any point in T: distance to a fixed
+  // triangle of B is convex, so its maximum over T is at a corner.
+  const auto upper_bound = [&](Piece & T)
+  {
+    directed_hausdorff_upper_bound(T);
+    for(int i = 0;i<3;i++)
+    {
+      if(T.I(i) < 0 || (i>0 && T.I(i) == T.I(0)) || (i>1 && T.I(i) == T.I(1)))
+      {
+        continue;
+      }
+      Scalar max_d = T.d(i);
+      for(int j = 0;j<3 && max_d < T.u;j++)
+      {
+        if(j != i)
+        {
+          max_d = std::max(max_d,Scalar(sqrt(
+            sqr_dist_to_f(T.V.row(j).template cast<TreeScalar>(),T.I(i)))));
+        }
+      }
+      T.u = std::min(T.u,max_d);
+    }
+  };
+
+  // Distance of each vertex to B (batched query)
+  Eigen::Matrix<Scalar,Eigen::Dynamic,1> D;
+  Eigen::VectorXi DI;
+  {
+    Eigen::Matrix<TreeScalar,Eigen::Dynamic,1> sqrD;
+    Eigen::Matrix<TreeScalar,Eigen::Dynamic,Eigen::Dynamic> C;
+    tree.squared_distance(
+      VB,FB,VA.template cast<TreeScalar>().eval(),sqrD,DI,C);
+    D = sqrD.array().sqrt().template cast<Scalar>();
+  }
+  // Initial bounds for each face. The lower bound is the largest corner
+  // distance, the upper bound is valid for all of A even if we stop early.
+  std::vector<Piece> faces(FA.rows());
+  Scalar L0 = 0;
+  Scalar U0 = 0;
+  for(int f = 0;f<FA.rows();f++)
+  {
+    for(int c = 0;c<3;c++)
+    {
+      faces[f].V.row(c) = VA.row(FA(f,c)).template cast<Scalar>();
+      faces[f].d(c) = D(FA(f,c));
+      faces[f].I(c) = DI(FA(f,c));
+      L0 = std::max(L0,faces[f].d(c));
+    }
+    upper_bound(faces[f]);
+    U0 = std::max(U0,faces[f].u);
+  }
+  // Faces whose upper bound is not yet within tolerance, largest first so that
+  // the lower bound grows as early as possible
+  std::vector<int> todo;
+  for(int f = 0;f<FA.rows();f++)
+  {
+    if(!(faces[f].u <= L0+eps || (use_threshold && faces[f].u <= threshold)))
+    {
+      todo.push_back(f);
+    }
+  }
+  std::sort(todo.begin(),todo.end(),
+    [&](const int a, const int b){ return faces[a].u > faces[b].u;});
+
+  // Global lower bound shared among threads
+  std::atomic<Scalar> L(L0);
+  std::atomic<bool> exceeded(use_threshold && L0 > threshold);
+  const auto raise_L = [&](const Scalar d)
+  {
+    Scalar cur = L.load();
+    while(d > cur && !L.compare_exchange_weak(cur,d)){}
+    if(use_threshold && d > threshold)
+    {
+      exceeded = true;
+    }
+  };
+  // Per-thread maximum upper bound over pruned pieces and DFS stack
+  std::vector<Scalar> U_t;
+  std::vector<std::vector<Piece> > stacks;
+  Scalar U = L0;
+  parallel_for(
+    (int)todo.size(),
+    [&](const size_t nthreads)
+    {
+      U_t.assign(nthreads,0);
+      stacks.resize(nthreads);
+    },
+    [&](const int k, const size_t t)
+    {
+      std::vector<Piece> & stack = stacks[t];
+      stack.clear();
+      stack.push_back(faces[todo[k]]);
+      while(!stack.empty() && !exceeded)
+      {
+        const Piece T = stack.back();
+        stack.pop_back();
+        if(T.u <= L.load()+eps || (use_threshold && T.u <= threshold))
+        {
+          U_t[t] = std::max(U_t[t],T.u);
+          continue;
+        }
+        // Split at edge midpoints: M.row(i) is opposite corner i
+        Piece C[4];
+        Eigen::Matrix<Scalar,3,3,Eigen::RowMajor> M;
+        Eigen::Matrix<Scalar,3,1> dM;
+        Eigen::Matrix<int,3,1> IM;
+        for(int i = 0;i<3;i++)
+        {
+          M.row(i) = 0.5*(T.V.row((i+1)%3)+T.V.row((i+2)%3));
+          dM(i) = dist_to_B(
+            M.row(i).template cast<TreeScalar>(),T.I.data(),3,IM(i));
+          raise_L(dM(i));
+        }
+        for(int i = 0;i<3;i++)
+        {
+          const int a = (i+1)%3;
+          const int b = (i+2)%3;
+          // corner child at i
+          C[i].V.row(i) = T.V.row(i);
+          C[i].d(i) = T.d(i);
+          C[i].I(i) = T.I(i);
+          C[i].V.row(a) = M.row(b);
+          C[i].d(a) = dM(b);
+          C[i].I(a) = IM(b);
+          C[i].V.row(b) = M.row(a);
+          C[i].d(b) = dM(a);
+          C[i].I(b) = IM(a);
+        }
+        C[3].V = M;
+        C[3].d = dM;
+        C[3].I = IM;
+        for(int c = 0;c<4;c++)
+        {
+          upper_bound(C[c]);
+          stack.push_back(C[c]);
+        }
+      }
+    },
+    [&](const size_t t)
+    {
+      U = std::max(U,U_t[t]);
+    },
+    1);
+  l = L.load();
+  // If stopped early, unvisited pieces are only bounded by their face
+  u = exceeded ? U0 : std::max(U,l);
+}
+
+#ifdef IGL_STATIC_LIBRARY
+// Explicit template instantiation
+template void igl::directed_hausdorff<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, double>(Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, double, double, double&, double&);
+#endif
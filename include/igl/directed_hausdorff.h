@@ -0,0 +1,67 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 agent <agent@local>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_DIRECTED_HAUSDORFF_H
+#define IGL_DIRECTED_HAUSDORFF_H
+#include "igl_inline.h"
+#include <Eigen/Core>
+#include <limits>
+
+namespace igl
+{
+  // DIRECTED_HAUSDORFF Compute lower and upper bounds on the one-sided
+  // (directed) Hausdorff distance from triangle mesh (VA,FA) to triangle mesh
+  // (VB,FB):
+  //
+  // h(A,B) = max min d(a,b)
+  //          a∈A b∈B
+  //
+  // where a ranges over _all_ points on the triangles of A (not just its
+  // vertices). Triangles of A are refined by branch-and-bound: each (sub)
+  // triangle carries a lower bound (distance of its corners to B) and an
+  // upper bound (see igl::hausdorff) and is split into four only if its upper
+  // bound exceeds the current global lower bound by more than eps. Distances
+  // to B are found with an igl::AABB tree and warm-started by the bounds of
+  // the parent triangle. Triangles of A are processed in parallel.
+  //
+  // Inputs:
+  //   VA  #VA by 3 list of vertex positions
+  //   FA  #FA by 3 list of face indices into VA
+  //   VB  #VB by 3 list of vertex positions
+  //   FB  #FB by 3 list of face indices into VB
+  //   eps  positive absolute tolerance on the gap between bounds
+  //   threshold  if finite, stop as soon as h(A,B) is known to be larger than
+  //     threshold (l > threshold) or at most threshold (u <= threshold)
+  //     {infinity}
+  // Outputs:
+  //   l  lower bound on h(A,B)
+  //   u  upper bound on h(A,B), so that u-l <= eps unless stopped early by
+  //     threshold
+  //
+  // See also: hausdorff
+  template <
+    typename DerivedVA,
+    typename DerivedFA,
+    typename DerivedVB,
+    typename DerivedFB,
+    typename Scalar>
+  IGL_INLINE void directed_hausdorff(
+    const Eigen::PlainObjectBase<DerivedVA> & VA,
+    const Eigen::PlainObjectBase<DerivedFA> & FA,
+    const Eigen::PlainObjectBase<DerivedVB> & VB,
+    const Eigen::PlainObjectBase<DerivedFB> & FB,
+    const Scalar eps,
+    const Scalar threshold,
+    Scalar & l,
+    Scalar & u);
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "directed_hausdorff.cpp"
+#endif
+
+#endif
@@ -8,6 +8,7 @@
 #ifndef IGL_DOUBLEAREA_H
 #define IGL_DOUBLEAREA_H
 #include "igl_inline.h"
+#include "CompressedMesh.h"
 #include <Eigen/Dense>
 namespace igl
 {
@@ -33,6 +34,17 @@ namespace igl
     const Eigen::MatrixBase<DerivedV> & V,
     const Eigen::MatrixBase<DerivedF> & F,
     Eigen::PlainObjectBase<DeriveddblA> & dblA);
+  // Compressed mesh version: faces are decoded block by block (in parallel)
+  // without decompressing the whole mesh (see igl::compress_mesh).
+  //
+  // Inputs:
+  //   C  compressed mesh
+  // Outputs:
+  //   dblA  C.num_faces list of triangle double areas
+  template <typename DeriveddblA>
+  IGL_INLINE void doublearea(
+    const CompressedMesh & C,
+    Eigen::PlainObjectBase<DeriveddblA> & dblA);
   // Stream of triangles, computes signed area...
   template <
     typename DerivedA,
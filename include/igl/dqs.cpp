@@ -6,7 +6,46 @@
 // v. 2.0. If a copy of the MPL was not distributed with this file, You can 
 // obtain one at http://mozilla.org/MPL/2.0/.
 #include "dqs.h"
+#include "parallel_for.h"
 #include <Eigen/Geometry>
+
+namespace igl
+{
+  // Convert quats + trans into dual parts
+  template <typename Q, typename QAlloc, typename T>
+  IGL_INLINE void dqs_dual_parts(
+    const std::vector<Q,QAlloc> & vQ,
+    const std::vector<T> & vT,
+    std::vector<Q,QAlloc> & vD)
+  {
+    vD.resize(vQ.size());
+    for(int c = 0;c<(int)vQ.size();c++)
+    {
+      const Q & q = vQ[c];
+      vD[c].w() = -0.5*( vT[c](0)*q.x() + vT[c](1)*q.y() + vT[c](2)*q.z());
+      vD[c].x() =  0.5*( vT[c](0)*q.w() + vT[c](1)*q.z() - vT[c](2)*q.y());
+      vD[c].y() =  0.5*(-vT[c](0)*q.z() + vT[c](1)*q.w() + vT[c](2)*q.x());
+      vD[c].z() =  0.5*( vT[c](0)*q.y() - vT[c](1)*q.x() + vT[c](2)*q.w());
+    }
+  }
+  // Apply the blended dual quaternion (b0,be) to the rest position v
+  template <typename Q, typename T>
+  IGL_INLINE T dqs_apply(const Q & b0, const Q & be, const T & v)
+  {
+    Q ce = be;
+    ce.coeffs() /= b0.norm();
+    Q c0 = b0;
+    c0.coeffs() /= b0.norm();
+    // See algorithm 1 in "Geometric skinning with approximate dual quaternion
+    // blending" by Kavan et al
+    T d0 = c0.vec();
+    T de = ce.vec();
+    typename Q::Scalar a0 = c0.w();
+    typename Q::Scalar ae = ce.w();
+    return v + 2*d0.cross(d0.cross(v) + a0*v) + 2*(a0*de - ae*d0 + d0.cross(de));
+  }
+}
+
 template <
   typename DerivedV,
   typename DerivedW,
@@ -28,21 +67,12 @@ IGL_INLINE void igl::dqs(
   // resize output
   U.resizeLike(V);
 
-  // Convert quats + trans into dual parts
-  vector<Q> vD(vQ.size());
-  for(int c = 0;c<W.cols();c++)
-  {
-    const Q & q = vQ[c];
-    vD[c].w() = -0.5*( vT[c](0)*q.x() + vT[c](1)*q.y() + vT[c](2)*q.z());
-    vD[c].x() =  0.5*( vT[c](0)*q.w() + vT[c](1)*q.z() - vT[c](2)*q.y());
-    vD[c].y() =  0.5*(-vT[c](0)*q.z() + vT[c](1)*q.w() + vT[c](2)*q.x());
-    vD[c].z() =  0.5*( vT[c](0)*q.y() - vT[c](1)*q.x() + vT[c](2)*q.w());
-  }
+  std::vector<Q,QAlloc> vD;
+  dqs_dual_parts(vQ,vT,vD);
 
   // Loop over vertices
   const int nv = V.rows();
-#pragma omp parallel for if (nv>10000)
-  for(int i = 0;i<nv;i++)
+  parallel_for(nv,[&](const int i)
   {
     Q b0(0,0,0,0);
     Q be(0,0,0,0);
@@ -52,23 +82,58 @@ IGL_INLINE void igl::dqs(
       b0.coeffs() += W(i,c) * vQ[c].coeffs();
       be.coeffs() += W(i,c) * vD[c].coeffs();
     }
-    Q ce = be;
-    ce.coeffs() /= b0.norm();
-    Q c0 = b0;
-    c0.coeffs() /= b0.norm();
-    // See algorithm 1 in "Geometric skinning with approximate dual quaternion
-    // blending" by Kavan et al
     T v = V.row(i);
-    T d0 = c0.vec();
-    T de = ce.vec();
-    typename Q::Scalar a0 = c0.w();
-    typename Q::Scalar ae = ce.w();
-    U.row(i) =  v + 2*d0.cross(d0.cross(v) + a0*v) + 2*(a0*de - ae*d0 + d0.cross(de));
-  }
+    U.row(i) = dqs_apply(b0,be,v);
+  },10000);
+}
+
+template <
+  typename DerivedV,
+  typename DerivedW,
+  typename DerivedWI,
+  typename Q,
+  typename QAlloc,
+  typename T,
+  typename DerivedU>
+IGL_INLINE void igl::dqs(
+  const Eigen::PlainObjectBase<DerivedV> & V,
+  const Eigen::PlainObjectBase<DerivedW> & W,
+  const Eigen::PlainObjectBase<DerivedWI> & WI,
+  const std::vector<Q,QAlloc> & vQ,
+  const std::vector<T> & vT,
+  Eigen::PlainObjectBase<DerivedU> & U)
+{
+  assert(V.rows() <= W.rows());
+  assert(W.rows() == WI.rows() && W.cols() == WI.cols());
+  assert(vQ.size() == vT.size());
+  U.resizeLike(V);
+
+  std::vector<Q,QAlloc> vD;
+  dqs_dual_parts(vQ,vT,vD);
 
+  const int nv = V.rows();
+  const int k = W.cols();
+  parallel_for(nv,[&](const int i)
+  {
+    Q b0(0,0,0,0);
+    Q be(0,0,0,0);
+    // Loop over only the k most significant handles
+    for(int j = 0;j<k;j++)
+    {
+      const int c = WI(i,j);
+      if(c < 0) continue;
+      assert(c < (int)vQ.size() && "WI should index into vQ");
+      b0.coeffs() += W(i,j) * vQ[c].coeffs();
+      be.coeffs() += W(i,j) * vD[c].coeffs();
+    }
+    T v = V.row(i);
+    U.row(i) = dqs_apply(b0,be,v);
+  },1000);
 }
 
 #ifdef IGL_STATIC_LIBRARY
 // Explicit template instantiation
 template void igl::dqs<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Quaternion<double, 0>, Eigen::aligned_allocator<Eigen::Quaternion<double, 0> >, Eigen::Matrix<double, 3, 1, 0, 3, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, std::vector<Eigen::Quaternion<double, 0>, Eigen::aligned_allocator<Eigen::Quaternion<double, 0> > > const&, std::vector<Eigen::Matrix<double, 3, 1, 0, 3, 1>, std::allocator<Eigen::Matrix<double, 3, 1, 0, 3, 1> > > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&);
+template void igl::dqs<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Quaternion<double, 0>, Eigen::aligned_allocator<Eigen::Quaternion<double, 0> >, Eigen::Matrix<double, 3, 1, 0, 3, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, std::vector<Eigen::Quaternion<double, 0>, Eigen::aligned_allocator<Eigen::Quaternion<double, 0> > > const&, std::vector<Eigen::Matrix<double, 3, 1, 0, 3, 1>, std::allocator<Eigen::Matrix<double, 3, 1, 0, 3, 1> > > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&);
+template void igl::dqs<Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Quaternion<float, 0>, Eigen::aligned_allocator<Eigen::Quaternion<float, 0> >, Eigen::Matrix<float, 3, 1, 0, 3, 1>, Eigen::Matrix<float, -1, -1, 0, -1, -1> >(Eigen::PlainObjectBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, std::vector<Eigen::Quaternion<float, 0>, Eigen::aligned_allocator<Eigen::Quaternion<float, 0> > > const&, std::vector<Eigen::Matrix<float, 3, 1, 0, 3, 1>, std::allocator<Eigen::Matrix<float, 3, 1, 0, 3, 1> > > const&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> >&);
 #endif
@@ -34,6 +34,33 @@ namespace igl
     const std::vector<Q,QAlloc> & vQ,
     const std::vector<T> & vT,
     Eigen::PlainObjectBase<DerivedU> & U);
+  // Same as above but with a constant number of (sparse) weights per vertex
+  //
+  // Inputs:
+  //   V  #V by 3 list of rest positions
+  //   W  #V by k list of k correspondence weights per vertex
+  //   WI  #V by k list of k correspondence weight indices per vertex, such that
+  //     W(i,j) is the weight of handle WI(i,j) on vertex i (see
+  //     top_k_weights). Negative indices are ignored.
+  //   vQ  #C list of rotation quaternions 
+  //   vT  #C list of translation vectors
+  // Outputs:
+  //   U  #V by 3 list of new positions
+  template <
+    typename DerivedV,
+    typename DerivedW,
+    typename DerivedWI,
+    typename Q,
+    typename QAlloc,
+    typename T,
+    typename DerivedU>
+  IGL_INLINE void dqs(
+    const Eigen::PlainObjectBase<DerivedV> & V,
+    const Eigen::PlainObjectBase<DerivedW> & W,
+    const Eigen::PlainObjectBase<DerivedWI> & WI,
+    const std::vector<Q,QAlloc> & vQ,
+    const std::vector<T> & vT,
+    Eigen::PlainObjectBase<DerivedU> & U);
 };
 
 #ifndef IGL_STATIC_LIBRARY
@@ -7,11 +7,92 @@
 // obtain one at http://mozilla.org/MPL/2.0/.
 #include "eigs.h"
 
-#include "cotmatrix.h"
+#include "parallel_for.h"
 #include "sort.h"
 #include "slice.h"
-#include "massmatrix.h"
+#include <Eigen/Dense>
+#include <Eigen/SparseCholesky>
+#include <algorithm>
 #include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace igl
+{
+  // B-orthonormalize the columns of X (in place) via an eigen decomposition of
+  // the Gram matrix (SVQB), dropping (numerically) linearly dependent
+  // directions.
+  //
+  // Returns number of remaining columns
+  template <typename Scalar, typename MatrixXS>
+  IGL_INLINE int eigs_svqb(
+    const Eigen::SparseMatrix<Scalar> & B,
+    MatrixXS & X)
+  {
+    typedef Eigen::Matrix<Scalar,Eigen::Dynamic,1> VectorXS;
+    if(X.cols() == 0)
+    {
+      return 0;
+    }
+    const MatrixXS G = X.transpose()*(B*X);
+    // Scale to unit diagonal first for better conditioning
+    VectorXS d = G.diagonal();
+    for(int i = 0;i<d.size();i++)
+    {
+      d(i) = d(i) > 0 ? Scalar(1)/std::sqrt(d(i)) : Scalar(0);
+    }
+    Eigen::SelfAdjointEigenSolver<MatrixXS> es(d.asDiagonal()*G*d.asDiagonal());
+    const VectorXS & D = es.eigenvalues();
+    const Scalar tau = 
+      std::numeric_limits<Scalar>::epsilon()*1e3*std::max(D.maxCoeff(),Scalar(0));
+    std::vector<int> keep;
+    for(int i = 0;i<D.size();i++)
+    {
+      if(D(i) > tau)
+      {
+        keep.push_back(i);
+      }
+    }
+    MatrixXS C(X.cols(),keep.size());
+    for(int j = 0;j<(int)keep.size();j++)
+    {
+      C.col(j) = d.asDiagonal()*es.eigenvectors().col(keep[j])/std::sqrt(D(keep[j]));
+    }
+    X = (X*C).eval();
+    return X.cols();
+  }
+
+  // B-orthonormalize the columns of X (in place) via a Cholesky factorization
+  // of the Gram matrix.
+  //
+  // Returns false (leaving X untouched) if X is too close to rank deficient
+  template <typename Scalar, typename MatrixXS>
+  IGL_INLINE bool eigs_cholqr(
+    const Eigen::SparseMatrix<Scalar> & B,
+    MatrixXS & X)
+  {
+    if(X.cols() == 0)
+    {
+      return true;
+    }
+    const MatrixXS G = X.transpose()*(B*X);
+    Eigen::LLT<MatrixXS> llt(G);
+    if(llt.info() != Eigen::Success)
+    {
+      return false;
+    }
+    // Reject ill-conditioned factors
+    const auto & d = llt.matrixLLT().diagonal();
+    if(d.minCoeff() <= 
+      std::sqrt(std::numeric_limits<Scalar>::epsilon())*d.maxCoeff())
+    {
+      return false;
+    }
+    llt.matrixU().template solveInPlace<Eigen::OnTheRight>(X);
+    return true;
+  }
+}
 
 template <
   typename Atype,
@@ -32,131 +113,202 @@ IGL_INLINE bool igl::eigs(
   assert(A.cols() == n && "A should be square.");
   assert(iB.rows() == n && "B should be match A's dims.");
   assert(iB.cols() == n && "B should be square.");
-  assert(type == EIGS_TYPE_SM && "Only low frequencies are supported");
-  DerivedU U(n,k);
-  DerivedS S(k,1);
+  assert(k <= n && "Cannot compute more eigen pairs than rows.");
   typedef Atype Scalar;
-  typedef Eigen::Matrix<typename DerivedU::Scalar,DerivedU::RowsAtCompileTime,1> VectorXS;
+  typedef Eigen::Matrix<Scalar,Eigen::Dynamic,Eigen::Dynamic> MatrixXS;
+  typedef Eigen::Matrix<Scalar,Eigen::Dynamic,1> VectorXS;
   // Rescale B for better numerics
   const Scalar rescale = std::abs(iB.diagonal().maxCoeff());
-  const Eigen::SparseMatrix<Btype> B = iB/rescale;
+  const Eigen::SparseMatrix<Scalar> B = (iB/rescale).template cast<Scalar>();
 
-  Scalar tol = 1e-4;
-  Scalar conv = 1e-14;
-  int max_iter = 100;
-  int i = 0;
-  //std::cout<<"start"<<std::endl;
-  while(true)
+  // Block size: a few guard vectors beyond k speed up convergence of the last
+  // wanted pairs
+  const int p = std::min<int>(n,k + std::max<int>(10,k/10));
+
+  MatrixXS U;
+  VectorXS S;
+  if(3*p >= (int)n)
   {
-    //std::cout<<i<<std::endl;
-    // Random initial guess
-    VectorXS y = VectorXS::Random(n,1);
-    Scalar eff_sigma = 0;
-    if(i>0)
+    // Small problem: dense generalized eigen solver
+    const MatrixXS dA = A;
+    const MatrixXS dB = B;
+    GeneralizedSelfAdjointEigenSolver<MatrixXS> es(dA,dB);
+    if(es.info() != Eigen::Success)
     {
-      eff_sigma = 1e-8+std::abs(S(i-1));
+      cerr<<"Error: Dense eigen solver failed."<<endl;
+      return false;
     }
-    // whether to use rayleigh quotient method
-    bool ray = false;
-    Scalar err = std::numeric_limits<Scalar>::infinity();
-    int iter;
-    Scalar sigma = std::numeric_limits<Scalar>::infinity();
-    VectorXS x;
-    for(iter = 0;iter<max_iter;iter++)
+    // ascending
+    const VectorXS & E = es.eigenvalues();
+    vector<int> I(n);
+    for(int i = 0;i<(int)n;i++) I[i] = i;
+    std::stable_sort(I.begin(),I.end(),[&E,&type](int a,int b)
+    {
+      return type == EIGS_TYPE_SM ?
+        std::abs(E(a)) < std::abs(E(b)) : std::abs(E(a)) > std::abs(E(b));
+    });
+    U.resize(n,k);
+    S.resize(k);
+    for(int i = 0;i<(int)k;i++)
+    {
+      U.col(i) = es.eigenvectors().col(I[i]);
+      S(i) = E(I[i]);
+    }
+  }else
+  {
+    // Shift (slightly below zero so that positive semi-definite A, e.g.
+    // -cotmatrix, yields a positive definite system)
+    Scalar sigma = 0;
+    // Cheap estimate of the scale of A
+    const Scalar Anorm = A.diagonal().cwiseAbs().maxCoeff();
+    SimplicialLDLT<SparseMatrix<Scalar> > solver;
+    switch(type)
     {
-      if(i>0 && !ray)
+      default:
+        assert(false && "Not supported");
+        return false;
+      case EIGS_TYPE_SM:
       {
-        // project-out existing modes
-        for(int j = 0;j<i;j++)
+        sigma = -1e-10*(Anorm == 0 ? Scalar(1) : Anorm);
+        // Factor once
+        solver.compute(A-sigma*B);
+        break;
+      }
+      case EIGS_TYPE_LM:
+        solver.compute(B);
+        break;
+    }
+    switch(solver.info())
+    {
+      case Eigen::Success:
+        break;
+      case Eigen::NumericalIssue:
+        cerr<<"Error: Numerical issue."<<endl;
+        return false;
+      default:
+        cerr<<"Error: Other."<<endl;
+        return false;
+    }
+    // Apply spectral transformation to each column of X
+    const auto & apply = [&](const MatrixXS & X, MatrixXS & Y)
+    {
+      const MatrixXS R = type == EIGS_TYPE_SM ? MatrixXS(B*X) : MatrixXS(A*X);
+      Y.resize(n,X.cols());
+      parallel_for(X.cols(),[&](const int j)
+      {
+        Y.col(j) = solver.solve(R.col(j));
+      },2);
+    };
+    // Sort key: smaller is more wanted
+    const auto & key = [&](const Scalar theta)->Scalar
+    {
+      return type == EIGS_TYPE_SM ?
+        std::abs(theta-sigma) : -std::abs(theta);
+    };
+
+    const Scalar tol = 1e-10;
+    const int max_iter = 1000;
+    // Deterministic initial block
+    MatrixXS X(n,p);
+    {
+      std::mt19937 gen(0);
+      std::uniform_real_distribution<double> unif(-1.,1.);
+      for(int j = 0;j<p;j++)
+      {
+        for(int i = 0;i<(int)n;i++)
         {
-          const VectorXS u = U.col(j);
-          y = (y - u*u.dot(B*y)/u.dot(B * u)).eval();
+          X(i,j) = Scalar(unif(gen));
         }
       }
-      // normalize
-      x = y/sqrt(y.dot(B*y));
-
-      // current guess at eigen value
-      sigma = x.dot(A*x)/x.dot(B*x);
-      //x *= sigma>0?1.:-1.;
-
-      Scalar err_prev = err;
-      err = (A*x-sigma*B*x).array().abs().maxCoeff();
-      if(err<conv)
+    }
+    eigs_svqb(B,X);
+    // Converged (locked) eigen pairs are deflated: they are removed from the
+    // active block and new search directions are kept B-orthogonal to them.
+    MatrixXS Xl(n,0), BXl(n,0);
+    VectorXS Sl(0);
+    MatrixXS P(n,0);
+    int iter;
+    for(iter = 0;iter<max_iter;iter++)
+    {
+      // Search directions: spectral transform of X and previous update P,
+      // B-orthogonalized against locked vectors and X
+      MatrixXS W;
+      apply(X,W);
+      MatrixXS Z(n,W.cols()+P.cols());
+      Z<<W,P;
+      for(int pass = 0;pass<2;pass++)
       {
-        break;
+        Z -= Xl*(BXl.transpose()*Z);
+        Z -= X*(X.transpose()*(B*Z));
+        // The second pass only corrects round-off, so the cheaper Cholesky
+        // orthonormalization is enough unless it breaks down
+        if(pass == 0 || !eigs_cholqr(B,Z))
+        {
+          eigs_svqb(B,Z);
+        }
       }
-      if(ray || err<tol)
+      MatrixXS Q(n,X.cols()+Z.cols());
+      Q<<X,Z;
+      // Rayleigh-Ritz
+      const MatrixXS AQ = A*Q;
+      MatrixXS H = Q.transpose()*AQ;
+      H = 0.5*(H+H.transpose()).eval();
+      SelfAdjointEigenSolver<MatrixXS> es(H);
+      const VectorXS & E = es.eigenvalues();
+      vector<int> I(E.size());
+      for(int i = 0;i<(int)I.size();i++) I[i] = i;
+      std::stable_sort(I.begin(),I.end(),
+        [&E,&key](int a,int b){ return key(E(a)) < key(E(b)); });
+      const int np = std::min<int>(X.cols(),I.size());
+      MatrixXS C(Q.cols(),np);
+      VectorXS theta(np);
+      for(int i = 0;i<np;i++)
       {
-        eff_sigma = sigma;
-        ray = true;
+        C.col(i) = es.eigenvectors().col(I[i]);
+        theta(i) = E(I[i]);
       }
-
-      Scalar tikhonov = std::abs(eff_sigma)<1e-12?1e-10:0;
-      switch(type)
+      const MatrixXS Xnew = Q*C;
+      // Lock the leading wanted pairs whose residuals are small enough
+      int nc = 0;
+      for(;nc<std::min<int>(np,k-Xl.cols());nc++)
       {
-        default:
-          assert(false && "Not supported");
-          break;
-        case EIGS_TYPE_SM:
+        const VectorXS BX = B*Xnew.col(nc);
+        const Scalar r = (AQ*C.col(nc)-theta(nc)*BX).norm();
+        // Relative to the scale of A so that zero eigen values (e.g.,
+        // constant functions in the kernel of -cotmatrix) can converge
+        const Scalar s = 
+          (Anorm + std::abs(theta(nc)))*std::max(BX.norm(),Xnew.col(nc).norm());
+        if(r > tol*s)
         {
-          SimplicialLDLT<SparseMatrix<Scalar> > solver;
-          const SparseMatrix<Scalar> C = A-eff_sigma*B+tikhonov*B;
-          //mw.save(C,"C");
-          //mw.save(eff_sigma,"eff_sigma");
-          //mw.save(tikhonov,"tikhonov");
-          solver.compute(C);
-          switch(solver.info())
-          {
-            case Eigen::Success:
-              break;
-            case Eigen::NumericalIssue:
-              cerr<<"Error: Numerical issue."<<endl;
-              return false;
-            default:
-              cerr<<"Error: Other."<<endl;
-              return false;
-          }
-          const VectorXS rhs = B*x;
-          y = solver.solve(rhs);
-          //mw.save(rhs,"rhs");
-          //mw.save(y,"y");
-          //mw.save(x,"x");
-          //mw.write("eigs.mat");
-          //if(i == 1)
-          //return false;
           break;
         }
       }
+      if(nc > 0)
+      {
+        const int nl = Xl.cols();
+        Xl.conservativeResize(n,nl+nc);
+        Xl.rightCols(nc) = Xnew.leftCols(nc);
+        BXl.conservativeResize(n,nl+nc);
+        BXl.rightCols(nc) = B*Xnew.leftCols(nc);
+        Sl.conservativeResize(nl+nc);
+        Sl.tail(nc) = theta.head(nc);
+      }
+      if(Xl.cols() >= (int)k)
+      {
+        break;
+      }
+      // Previous update direction of the remaining active vectors
+      const MatrixXS Xa = Xnew.rightCols(np-nc);
+      P = Xa - X*(X.transpose()*(B*Xa));
+      X = Xa;
     }
     if(iter == max_iter)
     {
       cerr<<"Failed to converge."<<endl;
       return false;
     }
-    if(
-      i==0 || 
-      (S.head(i).array()-sigma).abs().maxCoeff()>1e-14 ||
-      ((U.leftCols(i).transpose()*B*x).array().abs()<=1e-7).all()
-      )
-    {
-      //cout<<"Found "<<i<<"th mode"<<endl;
-      U.col(i) = x;
-      S(i) = sigma;
-      i++;
-      if(i == k)
-      {
-        break;
-      }
-    }else
-    {
-      //std::cout<<"i: "<<i<<std::endl;
-      //std::cout<<"  "<<S.head(i).transpose()<<" << "<<sigma<<std::endl;
-      //std::cout<<"  "<<(S.head(i).array()-sigma).abs().maxCoeff()<<std::endl;
-      //std::cout<<"  "<<(U.leftCols(i).transpose()*B*x).array().abs().transpose()<<std::endl;
-      // restart with new random guess.
-      cout<<"igl::eigs RESTART"<<endl;
-    }
+    U = Xl.leftCols(k);
+    S = Sl.head(k);
   }
   // finally sort
   VectorXi I;
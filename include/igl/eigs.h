@@ -20,8 +20,14 @@ namespace igl
   //
   // Solutions are approximate and sorted. 
   //
-  // Ideally one should use ARPACK and the Eigen unsupported ARPACK module.
-  // This implementation does simple, naive power iterations.
+  // This implementation uses a block, locally optimal (LOBPCG-style) Krylov
+  // iteration with Rayleigh-Ritz projections in the B-inner product. For
+  // 'sm' the spectral transformation (A - σB)⁻¹B is applied, with σ just below
+  // zero, so A - σB is factorized exactly once. Converged pairs are locked
+  // and deflated from the active block, so later iterations only work on the
+  // pairs still missing. Back-substitutions of the block are spread across
+  // threads. The starting block is seeded deterministically. Small problems
+  // fall back to a dense generalized eigen solver.
   //
   // Inputs:
   //   A  #A by #A symmetric matrix
@@ -33,7 +39,7 @@ namespace igl
   //   sS  k list of sorted eigen values (descending)
   //
   // Known issues:
-  //   - only the 'sm' small magnitude eigen values are well supported
+  //   - 'lm' converges slowly if the largest eigen values are clustered
   //   
   enum EigsType
   {
@@ -23,7 +23,9 @@
 
 #include <embree2/rtcore.h>
 #include <embree2/rtcore_ray.h>
+#include <algorithm>
 #include <iostream>
+#include <mutex>
 #include <vector>
 
 namespace igl
@@ -58,12 +60,15 @@ namespace igl
       //   V  #V by 3 list of vertex positions
       //   F  #F by 3 list of Oriented triangles
       //   isStatic  scene is optimized for static geometry
+      //   isDeformable  vertex positions will be changed with update(), the
+      //     BVH is then refit rather than rebuilt (overrides isStatic)
       // Side effects:
       //   The first time this is ever called the embree engine is initialized.
       inline void init(
         const PointMatrixType& V,
         const FaceMatrixType& F,
-        bool isStatic = false);
+        bool isStatic = false,
+        bool isDeformable = false);
 
       // Initialize with a given mesh.
       //
@@ -72,13 +77,58 @@ namespace igl
       //   F  vector of #F by 3 list of Oriented triangles for each geometry
       //   masks  a 32 bit mask to identify active geometries.
       //   isStatic  scene is optimized for static geometry
+      //   isDeformable  vertex positions will be changed with update(), the
+      //     BVH is then refit rather than rebuilt (overrides isStatic)
       // Side effects:
       //   The first time this is ever called the embree engine is initialized.
       inline void init(
         const std::vector<const PointMatrixType*>& V,
         const std::vector<const FaceMatrixType*>& F,
         const std::vector<int>& masks,
-        bool isStatic = false);
+        bool isStatic = false,
+        bool isDeformable = false);
+
+      // Move the vertices of a mesh initialized with isDeformable = true. The
+      // vertex buffer is rewritten in place and the existing BVH is refit,
+      // which is much cheaper than deinit() followed by init().
+      //
+      // Inputs:
+      //   V  #V by 3 list of new vertex positions (#V must match init)
+      //   g  index of geometry to update {0}
+      inline void update(const PointMatrixType& V, int g = 0);
+      // Move the vertices of all geometries, refitting once.
+      //
+      // Inputs:
+      //   V  vector of #V by 3 list of new vertex positions for each geometry
+      inline void update(const std::vector<const PointMatrixType*>& V);
+
+      // Initialize with instances of a set of sub-meshes. Each sub-mesh is
+      // stored and its BVH built only once, no matter how often it is
+      // instanced. Hits report the instance index in hit.gid and the face
+      // index into the instanced sub-mesh in hit.id.
+      //
+      // Inputs:
+      //   V  vector of #V by 3 list of vertex positions for each sub-mesh
+      //   F  vector of #F by 3 list of Oriented triangles for each sub-mesh
+      //   I  #I list of indices into V and F of the sub-mesh of each instance
+      //   T  #I list of transformations of each instance
+      //   masks  #I list of 32 bit masks to identify active instances
+      // Side effects:
+      //   The first time this is ever called the embree engine is initialized.
+      inline void initInstances(
+        const std::vector<const PointMatrixType*>& V,
+        const std::vector<const FaceMatrixType*>& F,
+        const std::vector<int>& I,
+        const std::vector<
+          Eigen::Affine3f,Eigen::aligned_allocator<Eigen::Affine3f> >& T,
+        const std::vector<int>& masks);
+
+      // Move an instance created with initInstances
+      //
+      // Inputs:
+      //   i  index of instance
+      //   T  new transformation of instance
+      inline void updateInstance(const int i, const Eigen::Affine3f& T);
 
       // Deinitialize embree datasctructures for current mesh.  Also called on
       // destruction: no need to call if you just want to init() once and
@@ -130,7 +180,8 @@ namespace igl
         bool closestHit = true,
         unsigned int samples = 4) const;
 
-      // Given a ray find all hits in order
+      // Given a ray find all hits in order. All hits are collected during a
+      // single traversal by an intersection filter callback.
       //
       // Inputs:
       //   origin     3d origin point of ray
@@ -139,8 +190,8 @@ namespace igl
       //   tfar       end of ray segment
       //   masks      a 32 bit mask to identify active geometries.
       // Output:
-      //   hit        information about hit
-      //   num_rays   number of rays shot (at least one)
+      //   hits       information about hits sorted by t
+      //   num_rays   number of rays shot (always one)
       // Returns true if and only if there was a hit
       inline bool intersectRay(
         const Eigen::RowVector3f& origin,
@@ -165,15 +216,78 @@ namespace igl
         Hit &hit,
         int mask = 0xFFFFFFFF) const;
 
+      // Given a list of rays find the first hit of each. The rays are traced
+      // together through Embree's ray stream interface, which is much faster
+      // than shooting them one at a time. Like all queries this is
+      // thread-safe, so large batches can be split across threads.
+      //
+      // Inputs:
+      //   origins     #R by 3 list of ray origins
+      //   directions  #R by 3 list of (not necessarily normalized) directions
+      //   tnear       start of ray segments
+      //   tfar        end of ray segments
+      //   masks       a 32 bit mask to identify active geometries.
+      // Output:
+      //   hits  #R list of information about hits, hits[r].id = -1 if ray r
+      //     did not hit anything
+      // Returns number of rays that hit
+      inline int intersectRays(
+        const PointMatrixType& origins,
+        const PointMatrixType& directions,
+        std::vector<Hit> &hits,
+        float tnear = 0,
+        float tfar = std::numeric_limits<float>::infinity(),
+        int mask = 0xFFFFFFFF) const;
+
+      // Given a list of rays determine which rays hit anything. Any hit
+      // terminates traversal so this is faster than intersectRays.
+      //
+      // Inputs:
+      //   origins     #R by 3 list of ray origins
+      //   directions  #R by 3 list of (not necessarily normalized) directions
+      //   tnear       start of ray segments
+      //   tfar        end of ray segments
+      //   masks       a 32 bit mask to identify active geometries.
+      // Output:
+      //   occluded  #R list of flags whether ray r hit anything
+      // Returns number of rays that hit
+      inline int occludedRays(
+        const PointMatrixType& origins,
+        const PointMatrixType& directions,
+        std::vector<bool> &occluded,
+        float tnear = 0,
+        float tfar = std::numeric_limits<float>::infinity(),
+        int mask = 0xFFFFFFFF) const;
+
     private:
 
       struct Vertex   {float x,y,z,a;};
       struct Triangle {int v0, v1, v2;};
-
       RTCScene scene;
       unsigned geomID;
-      Vertex* vertices;
-      Triangle* triangles;
+      // geometry ids of meshes (or instances) in scene
+      std::vector<unsigned> geomIDs;
+      // scenes of instanced sub-meshes
+      std::vector<RTCScene> prototypes;
+      // Vertex and index buffers of each mesh (or sub-mesh), shared by all
+      // scenes referring to it
+      std::vector<std::vector<Vertex> > vertexBuffers;
+      std::vector<std::vector<Triangle> > indexBuffers;
+      // Masks of meshes (or instances) in scene
+      std::vector<int> geomMasks;
+      // Sub-mesh and transformation of each instance
+      std::vector<int> instancePrototypes;
+      std::vector<
+        Eigen::Affine3f,Eigen::aligned_allocator<Eigen::Affine3f> >
+        instanceTransforms;
+      RTCSceneFlags sceneFlags;
+      RTCGeometryFlags geometryFlags;
+      // Copy of scene (and prototypes) whose meshes have the filterAllHits
+      // intersection filter installed. Only queries for all hits need it, so
+      // it is built on first use and ordinary queries never invoke a filter.
+      mutable RTCScene allHitsScene;
+      mutable std::vector<RTCScene> allHitsPrototypes;
+      mutable std::mutex allHitsMutex;
       bool initialized;
 
       inline void createRay(
@@ -183,6 +297,37 @@ namespace igl
         float tnear,
         float tfar,
         int mask) const;
+
+      // Copy a triangle mesh into new vertex and index buffers
+      //
+      // Returns index of the buffers
+      inline int addBuffers(
+        const PointMatrixType& V,
+        const FaceMatrixType& F);
+      // Copy vertex positions into the vertex buffer of a mesh
+      inline void setVertices(int b, const PointMatrixType& V);
+      // Add a triangle mesh sharing the buffers b to a scene
+      inline unsigned addMesh(
+        RTCScene s,
+        int b,
+        RTCGeometryFlags flags,
+        int mask,
+        bool allHits) const;
+      // Scene to trace queries for all hits in, built on first call
+      inline RTCScene getAllHitsScene() const;
+      // Copy intersection information of a ray into a hit
+      static inline void fillHit(const RTCRay& ray, Hit& hit);
+
+      // Intersection filter of allHitsScene: records each potential hit in the
+      // std::vector<Hit> pointed to by the userRayExt of the context and
+      // rejects it so that traversal continues.
+      static inline void filterAllHits(
+        int* valid,
+        void* userPtr,
+        const RTCIntersectContext* context,
+        RTCRayN* ray,
+        const RTCHitN* potentialHit,
+        const size_t N);
     };
   }
 }
@@ -226,10 +371,11 @@ inline void igl::embree::EmbreeIntersector::global_deinit()
 
 inline igl::embree::EmbreeIntersector::EmbreeIntersector()
   :
-  //scene(NULL),
+  scene(NULL),
   geomID(0),
-  vertices(NULL),
-  triangles(NULL),
+  sceneFlags(RTC_SCENE_STATIC),
+  geometryFlags(RTC_GEOMETRY_STATIC),
+  allHitsScene(NULL),
   initialized(false)
 {
 }
@@ -237,10 +383,11 @@ inline igl::embree::EmbreeIntersector::EmbreeIntersector()
 inline igl::embree::EmbreeIntersector::EmbreeIntersector(
   const EmbreeIntersector &)
   :// To make -Weffc++ happy
-  //scene(NULL),
+  scene(NULL),
   geomID(0),
-  vertices(NULL),
-  triangles(NULL),
+  sceneFlags(RTC_SCENE_STATIC),
+  geometryFlags(RTC_GEOMETRY_STATIC),
+  allHitsScene(NULL),
   initialized(false)
 {
   assert(false && "Embree: Copying EmbreeIntersector is not allowed");
@@ -257,7 +404,8 @@ inline igl::embree::EmbreeIntersector & igl::embree::EmbreeIntersector::operator
 inline void igl::embree::EmbreeIntersector::init(
   const PointMatrixType& V,
   const FaceMatrixType& F,
-  bool isStatic)
+  bool isStatic,
+  bool isDeformable)
 {
   std::vector<const PointMatrixType*> Vtemp;
   std::vector<const FaceMatrixType*> Ftemp;
@@ -265,14 +413,15 @@ inline void igl::embree::EmbreeIntersector::init(
   Vtemp.push_back(&V);
   Ftemp.push_back(&F);
   masks.push_back(0xFFFFFFFF);
-  init(Vtemp,Ftemp,masks,isStatic);
+  init(Vtemp,Ftemp,masks,isStatic,isDeformable);
 }
 
 inline void igl::embree::EmbreeIntersector::init(
   const std::vector<const PointMatrixType*>& V,
   const std::vector<const FaceMatrixType*>& F,
   const std::vector<int>& masks,
-  bool isStatic)
+  bool isStatic,
+  bool isDeformable)
 {
 
   if(initialized)
@@ -288,51 +437,165 @@ inline void igl::embree::EmbreeIntersector::init(
   }
 
   // create a scene
-  RTCSceneFlags flags = RTC_SCENE_ROBUST | RTC_SCENE_HIGH_QUALITY;
-  if(isStatic)
-    flags = flags | RTC_SCENE_STATIC;
-  scene = rtcNewScene(flags,RTC_INTERSECT1);
+  sceneFlags = RTC_SCENE_ROBUST | RTC_SCENE_HIGH_QUALITY;
+  if(isDeformable)
+    sceneFlags = RTC_SCENE_DYNAMIC | RTC_SCENE_ROBUST;
+  else if(isStatic)
+    sceneFlags = sceneFlags | RTC_SCENE_STATIC;
+  geometryFlags = 
+    isDeformable ? RTC_GEOMETRY_DEFORMABLE : RTC_GEOMETRY_STATIC;
+  scene = rtcNewScene(sceneFlags,RTC_INTERSECT1 | RTC_INTERSECT_STREAM);
 
   for(int g=0;g<(int)V.size();g++)
   {
     // create triangle mesh geometry in that scene
-    geomID = rtcNewTriangleMesh(scene,RTC_GEOMETRY_STATIC,F[g]->rows(),V[g]->rows(),1);
+    const int b = addBuffers(*V[g],*F[g]);
+    geomID = addMesh(scene,b,geometryFlags,masks[g],false);
+    geomIDs.push_back(geomID);
+    geomMasks.push_back(masks[g]);
+  }
 
-    // fill vertex buffer
-    vertices = (Vertex*)rtcMapBuffer(scene,geomID,RTC_VERTEX_BUFFER);
-    for(int i=0;i<(int)V[g]->rows();i++)
-    {
-      vertices[i].x = (float)V[g]->coeff(i,0);
-      vertices[i].y = (float)V[g]->coeff(i,1);
-      vertices[i].z = (float)V[g]->coeff(i,2);
-    }
-    rtcUnmapBuffer(scene,geomID,RTC_VERTEX_BUFFER);
+  rtcCommit(scene);
+
+  if(rtcGetError() != RTC_NO_ERROR)
+      std::cerr << "Embree: An error occured while initializing the provided geometry!" << endl;
+#ifdef IGL_VERBOSE
+  else
+    std::cerr << "Embree: geometry added." << endl;
+#endif
+
+  initialized = true;
+}
 
-    // fill triangle buffer
-    triangles = (Triangle*) rtcMapBuffer(scene,geomID,RTC_INDEX_BUFFER);
-    for(int i=0;i<(int)F[g]->rows();i++)
+inline void igl::embree::EmbreeIntersector::update(
+  const PointMatrixType& V,
+  int g)
+{
+  assert(initialized && prototypes.empty() &&
+    "Embree: update() called before init()");
+  assert(g >= 0 && g < (int)geomIDs.size());
+  setVertices(g,V);
+  rtcUpdateBuffer(scene,geomIDs[g],RTC_VERTEX_BUFFER);
+  rtcCommit(scene);
+  std::lock_guard<std::mutex> lock(allHitsMutex);
+  if(allHitsScene)
+  {
+    rtcUpdateBuffer(allHitsScene,geomIDs[g],RTC_VERTEX_BUFFER);
+    rtcCommit(allHitsScene);
+  }
+  if(rtcGetError() != RTC_NO_ERROR)
+    std::cerr << "Embree: An error occured while updating the geometry!" << std::endl;
+}
+
+inline void igl::embree::EmbreeIntersector::update(
+  const std::vector<const PointMatrixType*>& V)
+{
+  assert(initialized && prototypes.empty() &&
+    "Embree: update() called before init()");
+  assert(V.size() == geomIDs.size());
+  std::lock_guard<std::mutex> lock(allHitsMutex);
+  for(int g = 0;g<(int)V.size();g++)
+  {
+    setVertices(g,*V[g]);
+    rtcUpdateBuffer(scene,geomIDs[g],RTC_VERTEX_BUFFER);
+    if(allHitsScene)
     {
-      triangles[i].v0 = (int)F[g]->coeff(i,0);
-      triangles[i].v1 = (int)F[g]->coeff(i,1);
-      triangles[i].v2 = (int)F[g]->coeff(i,2);
+      rtcUpdateBuffer(allHitsScene,geomIDs[g],RTC_VERTEX_BUFFER);
     }
-    rtcUnmapBuffer(scene,geomID,RTC_INDEX_BUFFER);
+  }
+  rtcCommit(scene);
+  if(allHitsScene)
+  {
+    rtcCommit(allHitsScene);
+  }
+  if(rtcGetError() != RTC_NO_ERROR)
+    std::cerr << "Embree: An error occured while updating the geometry!" << std::endl;
+}
+
+inline void igl::embree::EmbreeIntersector::initInstances(
+  const std::vector<const PointMatrixType*>& V,
+  const std::vector<const FaceMatrixType*>& F,
+  const std::vector<int>& I,
+  const std::vector<
+    Eigen::Affine3f,Eigen::aligned_allocator<Eigen::Affine3f> >& T,
+  const std::vector<int>& masks)
+{
+  if(initialized)
+    deinit();
+
+  using namespace std;
+  global_init();
+
+  if(V.size() == 0 || F.size() == 0 || I.size() == 0)
+  {
+    std::cerr << "Embree: No geometry specified!";
+    return;
+  }
+  assert(V.size() == F.size());
+  assert(I.size() == T.size() && I.size() == masks.size());
 
-    rtcSetMask(scene,geomID,masks[g]);
+  // one scene per sub-mesh
+  for(int p = 0;p<(int)V.size();p++)
+  {
+    RTCScene prototype = rtcNewScene(
+      RTC_SCENE_STATIC | RTC_SCENE_ROBUST | RTC_SCENE_HIGH_QUALITY,
+      RTC_INTERSECT1 | RTC_INTERSECT_STREAM);
+    const int b = addBuffers(*V[p],*F[p]);
+    addMesh(prototype,b,RTC_GEOMETRY_STATIC,0xFFFFFFFF,false);
+    rtcCommit(prototype);
+    prototypes.push_back(prototype);
   }
 
+  // top level scene is dynamic so that instances can be moved
+  sceneFlags = RTC_SCENE_DYNAMIC | RTC_SCENE_ROBUST;
+  scene = rtcNewScene(sceneFlags,RTC_INTERSECT1 | RTC_INTERSECT_STREAM);
+  for(int i = 0;i<(int)I.size();i++)
+  {
+    assert(I[i] >= 0 && I[i] < (int)prototypes.size());
+    geomID = rtcNewInstance2(scene,prototypes[I[i]],1);
+    rtcSetTransform2(
+      scene,geomID,RTC_MATRIX_COLUMN_MAJOR_ALIGNED16,T[i].matrix().data(),0);
+    rtcSetMask(scene,geomID,masks[i]);
+    geomIDs.push_back(geomID);
+    geomMasks.push_back(masks[i]);
+  }
+  instancePrototypes = I;
+  instanceTransforms = T;
   rtcCommit(scene);
 
   if(rtcGetError() != RTC_NO_ERROR)
       std::cerr << "Embree: An error occured while initializing the provided geometry!" << endl;
 #ifdef IGL_VERBOSE
   else
-    std::cerr << "Embree: geometry added." << endl;
+    std::cerr << "Embree: instances added." << endl;
 #endif
 
   initialized = true;
 }
 
+inline void igl::embree::EmbreeIntersector::updateInstance(
+  const int i,
+  const Eigen::Affine3f& T)
+{
+  assert(initialized && !prototypes.empty() &&
+    "Embree: updateInstance() called before initInstances()");
+  assert(i >= 0 && i < (int)geomIDs.size());
+  instanceTransforms[i] = T;
+  rtcSetTransform2(
+    scene,geomIDs[i],RTC_MATRIX_COLUMN_MAJOR_ALIGNED16,T.matrix().data(),0);
+  rtcUpdate(scene,geomIDs[i]);
+  rtcCommit(scene);
+  std::lock_guard<std::mutex> lock(allHitsMutex);
+  if(allHitsScene)
+  {
+    rtcSetTransform2(
+      allHitsScene,geomIDs[i],RTC_MATRIX_COLUMN_MAJOR_ALIGNED16,
+      T.matrix().data(),0);
+    rtcUpdate(allHitsScene,geomIDs[i]);
+    rtcCommit(allHitsScene);
+  }
+}
+
 igl::embree::EmbreeIntersector
 ::~EmbreeIntersector()
 {
@@ -345,6 +608,19 @@ void igl::embree::EmbreeIntersector::deinit()
   if(EmbreeIntersector_inited && scene)
   {
     rtcDeleteScene(scene);
+    if(allHitsScene)
+    {
+      rtcDeleteScene(allHitsScene);
+    }
+    // instances must be deleted before the scenes they refer to
+    for(RTCScene & prototype : prototypes)
+    {
+      rtcDeleteScene(prototype);
+    }
+    for(RTCScene & prototype : allHitsPrototypes)
+    {
+      rtcDeleteScene(prototype);
+    }
 
     if(rtcGetError() != RTC_NO_ERROR)
     {
@@ -357,6 +633,17 @@ void igl::embree::EmbreeIntersector::deinit()
     }
 #endif
   }
+  scene = NULL;
+  allHitsScene = NULL;
+  geomIDs.clear();
+  prototypes.clear();
+  allHitsPrototypes.clear();
+  vertexBuffers.clear();
+  indexBuffers.clear();
+  geomMasks.clear();
+  instancePrototypes.clear();
+  instanceTransforms.clear();
+  initialized = false;
 }
 
 inline bool igl::embree::EmbreeIntersector::intersectRay(
@@ -379,11 +666,7 @@ inline bool igl::embree::EmbreeIntersector::intersectRay(
 
   if((unsigned)ray.geomID != RTC_INVALID_GEOMETRY_ID)
   {
-    hit.id = ray.primID;
-    hit.gid = ray.geomID;
-    hit.u = ray.u;
-    hit.v = ray.v;
-    hit.t = ray.tfar;
+    fillHit(ray,hit);
     return true;
   }
 
@@ -451,92 +734,27 @@ igl::embree::EmbreeIntersector
   float tfar,
   int mask) const
 {
-  using namespace std;
-  num_rays = 0;
+  num_rays = 1;
   hits.clear();
-  int last_id0 = -1;
-  double self_hits = 0;
-  // This epsilon is directly correleated to the number of missed hits, smaller
-  // means more accurate and slower
-  //const double eps = DOUBLE_EPS;
-  const double eps = FLOAT_EPS;
-  double min_t = tnear;
-  bool large_hits_warned = false;
   RTCRay ray;
   createRay(ray,origin,direction,tnear,tfar,mask);
-
-  while(true)
+  // The hit list is passed to the filter through the intersection context,
+  // the filter rejects every hit so the ray never terminates early
+  RTCIntersectContext context;
+  context.flags = RTC_INTERSECT_COHERENT;
+  context.userRayExt = &hits;
+  rtcIntersect1Ex(getAllHitsScene(),&context,ray);
+  // Hits are collected in traversal order
+  std::sort(hits.begin(),hits.end(),[](const Hit & a, const Hit & b)
   {
-    ray.tnear = min_t;
-    ray.tfar = tfar;
-    ray.geomID = RTC_INVALID_GEOMETRY_ID;
-    ray.primID = RTC_INVALID_GEOMETRY_ID;
-    ray.instID = RTC_INVALID_GEOMETRY_ID;
-    num_rays++;
-    rtcIntersect(scene,ray);
-    if((unsigned)ray.geomID != RTC_INVALID_GEOMETRY_ID)
-    {
-      // Hit self again, progressively advance
-      if(ray.primID == last_id0 || ray.tfar <= min_t)
-      {
-        // push min_t a bit more
-        //double t_push = pow(2.0,self_hits-4)*(hit.t<eps?eps:hit.t);
-        double t_push = pow(2.0,self_hits)*eps;
-        #ifdef IGL_VERBOSE
-        std::cerr<<"  t_push: "<<t_push<<endl;
-        #endif
-        //o = o+t_push*d;
-        min_t += t_push;
-        self_hits++;
-      }
-      else
-      {
-        Hit hit;
-        hit.id = ray.primID;
-        hit.gid = ray.geomID;
-        hit.u = ray.u;
-        hit.v = ray.v;
-        hit.t = ray.tfar;
-        hits.push_back(hit);
-#ifdef IGL_VERBOSE
-        std::cerr<<"  t: "<<hit.t<<endl;
-#endif
-        // Instead of moving origin, just change min_t. That way calculations
-        // all use exactly same origin values
-        min_t = ray.tfar;
-
-        // reset t_scale
-        self_hits = 0;
-      }
-      last_id0 = ray.primID;
-    }
-    else
-      break; // no more hits
-
-    if(hits.size()>1000 && !large_hits_warned)
-    {
-      std::cout<<"Warning: Large number of hits..."<<endl;
-      std::cout<<"[ ";
-      for(vector<Hit>::iterator hit = hits.begin(); hit != hits.end();hit++)
-      {
-        std::cout<<(hit->id+1)<<" ";
-      }
-
-      std::cout.precision(std::numeric_limits< double >::digits10);
-      std::cout<<"[ ";
-
-      for(vector<Hit>::iterator hit = hits.begin(); hit != hits.end(); hit++)
-      {
-        std::cout<<(hit->t)<<endl;;
-      }
-
-      std::cout<<"]"<<endl;
-      large_hits_warned = true;
-
-      return hits.empty();
-    }
-  }
-
+    return a.t < b.t || (a.t == b.t && (a.gid < b.gid || 
+      (a.gid == b.gid && a.id < b.id)));
+  });
+  // Spatial splits may reference (and report) a triangle more than once
+  hits.erase(std::unique(hits.begin(),hits.end(),[](const Hit & a, const Hit & b)
+  {
+    return a.id == b.id && a.gid == b.gid;
+  }),hits.end());
   return hits.empty();
 }
 
@@ -551,11 +769,7 @@ igl::embree::EmbreeIntersector
 
   if((unsigned)ray.geomID != RTC_INVALID_GEOMETRY_ID)
   {
-    hit.id = ray.primID;
-    hit.gid = ray.geomID;
-    hit.u = ray.u;
-    hit.v = ray.v;
-    hit.t = ray.tfar;
+    fillHit(ray,hit);
     return true;
   }
 
@@ -581,4 +795,239 @@ igl::embree::EmbreeIntersector
   ray.time = 0.0f;
 }
 
+inline int
+igl::embree::EmbreeIntersector
+::intersectRays(
+  const PointMatrixType& origins,
+  const PointMatrixType& directions,
+  std::vector<Hit> &hits,
+  float tnear,
+  float tfar,
+  int mask) const
+{
+  assert(origins.rows() == directions.rows());
+  const int num_rays = origins.rows();
+  hits.resize(num_rays);
+  if(num_rays == 0)
+  {
+    return 0;
+  }
+  std::vector<RTCRay> rays(num_rays);
+  for(int r = 0;r<num_rays;r++)
+  {
+    createRay(rays[r],origins.row(r),directions.row(r),tnear,tfar,mask);
+  }
+  RTCIntersectContext context;
+  context.flags = RTC_INTERSECT_INCOHERENT;
+  context.userRayExt = NULL;
+  rtcIntersect1M(scene,&context,&rays[0],num_rays,sizeof(RTCRay));
+  int num_hits = 0;
+  for(int r = 0;r<num_rays;r++)
+  {
+    const RTCRay & ray = rays[r];
+    Hit & hit = hits[r];
+    if((unsigned)ray.geomID != RTC_INVALID_GEOMETRY_ID)
+    {
+      fillHit(ray,hit);
+      num_hits++;
+    }else
+    {
+      hit.id = -1;
+      hit.gid = -1;
+      hit.u = 0;
+      hit.v = 0;
+      hit.t = std::numeric_limits<float>::infinity();
+    }
+  }
+  return num_hits;
+}
+
+inline int
+igl::embree::EmbreeIntersector
+::occludedRays(
+  const PointMatrixType& origins,
+  const PointMatrixType& directions,
+  std::vector<bool> &occluded,
+  float tnear,
+  float tfar,
+  int mask) const
+{
+  assert(origins.rows() == directions.rows());
+  const int num_rays = origins.rows();
+  occluded.resize(num_rays);
+  if(num_rays == 0)
+  {
+    return 0;
+  }
+  std::vector<RTCRay> rays(num_rays);
+  for(int r = 0;r<num_rays;r++)
+  {
+    createRay(rays[r],origins.row(r),directions.row(r),tnear,tfar,mask);
+  }
+  RTCIntersectContext context;
+  context.flags = RTC_INTERSECT_INCOHERENT;
+  context.userRayExt = NULL;
+  rtcOccluded1M(scene,&context,&rays[0],num_rays,sizeof(RTCRay));
+  int num_occluded = 0;
+  for(int r = 0;r<num_rays;r++)
+  {
+    // embree sets geomID to 0 for occluded rays
+    occluded[r] = (unsigned)rays[r].geomID != RTC_INVALID_GEOMETRY_ID;
+    num_occluded += occluded[r];
+  }
+  return num_occluded;
+}
+
+inline int
+igl::embree::EmbreeIntersector
+::addBuffers(
+  const PointMatrixType& V,
+  const FaceMatrixType& F)
+{
+  const int b = vertexBuffers.size();
+  vertexBuffers.emplace_back(V.rows());
+  setVertices(b,V);
+  // fill triangle buffer
+  indexBuffers.emplace_back(F.rows());
+  std::vector<Triangle> & triangles = indexBuffers.back();
+  for(int i=0;i<(int)F.rows();i++)
+  {
+    triangles[i].v0 = (int)F.coeff(i,0);
+    triangles[i].v1 = (int)F.coeff(i,1);
+    triangles[i].v2 = (int)F.coeff(i,2);
+  }
+  return b;
+}
+
+inline void
+igl::embree::EmbreeIntersector
+::setVertices(int b, const PointMatrixType& V)
+{
+  // fill vertex buffer
+  std::vector<Vertex> & vertices = vertexBuffers[b];
+  assert(V.rows() == (int)vertices.size());
+  for(int i=0;i<(int)V.rows();i++)
+  {
+    vertices[i].x = (float)V.coeff(i,0);
+    vertices[i].y = (float)V.coeff(i,1);
+    vertices[i].z = (float)V.coeff(i,2);
+  }
+}
+
+inline unsigned
+igl::embree::EmbreeIntersector
+::addMesh(
+  RTCScene s,
+  int b,
+  RTCGeometryFlags flags,
+  int mask,
+  bool allHits) const
+{
+  const std::vector<Vertex> & vertices = vertexBuffers[b];
+  const std::vector<Triangle> & triangles = indexBuffers[b];
+  const unsigned id = 
+    rtcNewTriangleMesh(s,flags,triangles.size(),vertices.size(),1);
+  rtcSetBuffer2(
+    s,id,RTC_VERTEX_BUFFER,vertices.data(),0,sizeof(Vertex),vertices.size());
+  rtcSetBuffer2(
+    s,id,RTC_INDEX_BUFFER,triangles.data(),0,sizeof(Triangle),
+    triangles.size());
+  rtcSetMask(s,id,mask);
+  if(allHits)
+  {
+    rtcSetIntersectionFilterFunctionN(s,id,&filterAllHits);
+  }
+  return id;
+}
+
+inline RTCScene
+igl::embree::EmbreeIntersector
+::getAllHitsScene() const
+{
+  std::lock_guard<std::mutex> lock(allHitsMutex);
+  if(allHitsScene)
+  {
+    return allHitsScene;
+  }
+  // Only the filter differs, the buffers are shared with scene
+  RTCScene s = rtcNewScene(sceneFlags,RTC_INTERSECT1);
+  if(prototypes.empty())
+  {
+    for(int g = 0;g<(int)geomIDs.size();g++)
+    {
+      addMesh(s,g,geometryFlags,geomMasks[g],true);
+    }
+  }else
+  {
+    for(int p = 0;p<(int)prototypes.size();p++)
+    {
+      RTCScene prototype = rtcNewScene(
+        RTC_SCENE_STATIC | RTC_SCENE_ROBUST | RTC_SCENE_HIGH_QUALITY,
+        RTC_INTERSECT1);
+      addMesh(prototype,p,RTC_GEOMETRY_STATIC,0xFFFFFFFF,true);
+      rtcCommit(prototype);
+      allHitsPrototypes.push_back(prototype);
+    }
+    for(int i = 0;i<(int)geomIDs.size();i++)
+    {
+      const unsigned id = 
+        rtcNewInstance2(s,allHitsPrototypes[instancePrototypes[i]],1);
+      rtcSetTransform2(
+        s,id,RTC_MATRIX_COLUMN_MAJOR_ALIGNED16,
+        instanceTransforms[i].matrix().data(),0);
+      rtcSetMask(s,id,geomMasks[i]);
+    }
+  }
+  rtcCommit(s);
+  if(rtcGetError() != RTC_NO_ERROR)
+    std::cerr << "Embree: An error occured while building the all-hits scene!" << std::endl;
+  allHitsScene = s;
+  return allHitsScene;
+}
+
+inline void
+igl::embree::EmbreeIntersector
+::fillHit(const RTCRay& ray, Hit& hit)
+{
+  hit.id = ray.primID;
+  // hits of instanced sub-meshes are identified by their instance
+  hit.gid = 
+    (unsigned)ray.instID != RTC_INVALID_GEOMETRY_ID ? ray.instID : ray.geomID;
+  hit.u = ray.u;
+  hit.v = ray.v;
+  hit.t = ray.tfar;
+}
+
+inline void
+igl::embree::EmbreeIntersector
+::filterAllHits(
+  int* valid,
+  void* /*userPtr*/,
+  const RTCIntersectContext* context,
+  RTCRayN* /*ray*/,
+  const RTCHitN* potentialHit,
+  const size_t N)
+{
+  assert(context != NULL && context->userRayExt != NULL);
+  std::vector<Hit> & hits = *static_cast<std::vector<Hit>*>(context->userRayExt);
+  for(size_t i = 0;i<N;i++)
+  {
+    if(valid[i] == 0)
+    {
+      continue;
+    }
+    Hit hit;
+    const unsigned instID = RTCHitN_instID(potentialHit,N,i);
+    hit.id = RTCHitN_primID(potentialHit,N,i);
+    hit.gid = instID != RTC_INVALID_GEOMETRY_ID ? 
+      instID : RTCHitN_geomID(potentialHit,N,i);
+    hit.u = RTCHitN_u(potentialHit,N,i);
+    hit.v = RTCHitN_v(potentialHit,N,i);
+    hit.t = RTCHitN_t(potentialHit,N,i);
+    hits.push_back(hit);
+    // reject so that traversal continues
+    valid[i] = 0;
+  }
+}
+
 #endif //EMBREE_INTERSECTOR_H
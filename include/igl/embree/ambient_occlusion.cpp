@@ -6,9 +6,10 @@
 // v. 2.0. If a copy of the MPL was not distributed with this file, You can
 // obtain one at http://mozilla.org/MPL/2.0/.
 #include "ambient_occlusion.h"
-#include "../ambient_occlusion.h"
 #include "EmbreeIntersector.h"
-#include "../Hit.h"
+#include "../random_dir.h"
+#include "../parallel_for.h"
+#include <vector>
 
 template <
   typename DerivedP,
@@ -21,15 +22,35 @@ IGL_INLINE void igl::embree::ambient_occlusion(
   const int num_samples,
   Eigen::PlainObjectBase<DerivedS> & S)
 {
-  const auto & shoot_ray = [&ei](
-    const Eigen::Vector3f& s,
-    const Eigen::Vector3f& dir)->bool
+  using namespace Eigen;
+  typedef EmbreeIntersector::PointMatrixType PointMatrixType;
+  const int n = P.rows();
+  // Resize output
+  S.resize(n,1);
+  const MatrixXf D = random_dir_stratified(num_samples).cast<float>();
+  // The samples of each point are traced together as one ray stream
+  const auto & inner = [&](const int p)
   {
-    igl::Hit hit;
+    const RowVector3f origin = P.row(p).template cast<float>();
+    const RowVector3f normal = N.row(p).template cast<float>();
+    PointMatrixType origins(num_samples,3);
+    PointMatrixType directions(num_samples,3);
+    for(int s = 0;s<num_samples;s++)
+    {
+      origins.row(s) = origin;
+      directions.row(s) = D.row(s);
+      if(directions.row(s).dot(normal) < 0)
+      {
+        // reverse ray
+        directions.row(s) *= -1;
+      }
+    }
+    std::vector<bool> occluded;
     const float tnear = 1e-4f;
-    return ei.intersectRay(s,dir,hit,tnear);
+    const int num_hits = ei.occludedRays(origins,directions,occluded,tnear);
+    S(p) = (double)num_hits/(double)num_samples;
   };
-  return igl::ambient_occlusion(shoot_ray,P,N,num_samples,S);
+  parallel_for(n,inner,1000);
 }
 
 template <
@@ -9,8 +9,10 @@
 #include "../project_to_line.h"
 #include "../EPS.h"
 #include "../Hit.h"
-#include "../Timer.h"
+#include "../parallel_for.h"
+#include <algorithm>
 #include <iostream>
+#include <vector>
 
 template <
   typename DerivedV, 
@@ -49,93 +51,92 @@ IGL_INLINE void igl::embree::bone_visible(
 {
   using namespace std;
   using namespace Eigen;
-  flag.resize(V.rows());
+  typedef EmbreeIntersector::PointMatrixType PointMatrixType;
+  const int n = V.rows();
+  flag.resize(n);
   const double sd_norm = (s-d).norm();
-  // Embree seems to be parallel when constructing but not when tracing rays
-#pragma omp parallel for
+  // Segment from the projection of each vertex onto the bone to the vertex
+  PointMatrixType O(n,3),D(n,3);
+  VectorXd sqrd(n);
   // loop over mesh vertices
-  for(int v = 0;v<V.rows();v++)
+  parallel_for(n,[&](const int v)
   {
     const Vector3d Vv = V.row(v);
     // Project vertex v onto line segment sd
-    //embree.intersectSegment
-    double t,sqrd;
+    double t;
     Vector3d projv;
     // degenerate bone, just snap to s
     if(sd_norm < DOUBLE_EPS)
     {
       t = 0;
-      sqrd = (Vv-s).array().pow(2).sum();
+      sqrd(v) = (Vv-s).array().pow(2).sum();
       projv = s;
     }else
     {
       // project onto (infinite) line
       project_to_line(
         Vv(0),Vv(1),Vv(2),s(0),s(1),s(2),d(0),d(1),d(2),
-        projv(0),projv(1),projv(2),t,sqrd);
+        projv(0),projv(1),projv(2),t,sqrd(v));
       // handle projections past endpoints
       if(t<0)
       {
         t = 0;
-        sqrd = (Vv-s).array().pow(2).sum();
+        sqrd(v) = (Vv-s).array().pow(2).sum();
         projv = s;
       } else if(t>1)
       {
         t = 1;
-        sqrd = (Vv-d).array().pow(2).sum();
+        sqrd(v) = (Vv-d).array().pow(2).sum();
         projv = d;
       }
     }
-    igl::Hit hit;
     // perhaps 1.0 should be 1.0-epsilon, or actually since we checking the
     // incident face, perhaps 1.0 should be 1.0+eps
-    const Vector3d dir = (Vv-projv)*1.0;
-    if(ei.intersectSegment(
-       projv.template cast<float>(),
-       dir.template cast<float>(), 
-       hit))
+    O.row(v) = projv.template cast<float>();
+    D.row(v) = ((Vv-projv)*1.0).template cast<float>();
+  },1000);
+  // Trace segments in chunks through the ray stream interface
+  const int chunk_size = 1024;
+  const int num_chunks = (n+chunk_size-1)/chunk_size;
+  parallel_for(num_chunks,[&](const int k)
+  {
+    const int v0 = k*chunk_size;
+    const int nk = std::min(chunk_size,n-v0);
+    vector<igl::Hit> hits;
+    ei.intersectRays(O.middleRows(v0,nk),D.middleRows(v0,nk),hits,0,1.0);
+    for(int i = 0;i<nk;i++)
     {
-      // mod for double sided lighting
-      const int fi = hit.id % F.rows();
-
-      //if(v == 1228-1)
-      //{
-      //  Vector3d bc,P;
-      //  bc << 1 - hit.u - hit.v, hit.u, hit.v; // barycentric
-      //  P = V.row(F(fi,0))*bc(0) + 
-      //      V.row(F(fi,1))*bc(1) + 
-      //      V.row(F(fi,2))*bc(2);
-      //  cout<<(fi+1)<<endl;
-      //  cout<<bc.transpose()<<endl;
-      //  cout<<P.transpose()<<endl;
-      //  cout<<hit.t<<endl;
-      //  cout<<(projv + dir*hit.t).transpose()<<endl;
-      //  cout<<Vv.transpose()<<endl;
-      //}
-
-      // Assume hit is valid, so not visible
-      flag(v) = false;
-      // loop around corners of triangle
-      for(int c = 0;c<F.cols();c++)
+      const int v = v0+i;
+      const igl::Hit & hit = hits[i];
+      if(hit.id >= 0)
       {
-        if(F(fi,c) == v)
+        // mod for double sided lighting
+        const int fi = hit.id % F.rows();
+        // Assume hit is valid, so not visible
+        flag(v) = false;
+        // loop around corners of triangle
+        for(int c = 0;c<F.cols();c++)
+        {
+          if(F(fi,c) == v)
+          {
+            // hit self, so no hits before, so vertex v is visible
+            flag(v) = true;
+            break;
+          }
+        }
+        // Hit is actually past v
+        if(!flag(v) && 
+          (hit.t*hit.t*D.row(v).template cast<double>().squaredNorm())>sqrd(v))
         {
-          // hit self, so no hits before, so vertex v is visible
           flag(v) = true;
-          break;
         }
-      }
-      // Hit is actually past v
-      if(!flag(v) && (hit.t*hit.t*dir.squaredNorm())>sqrd)
+      }else
       {
+        // no hit so vectex v is visible
         flag(v) = true;
       }
-    }else
-    {
-      // no hit so vectex v is visible
-      flag(v) = true;
     }
-  }
+  },2);
 }
 
 #ifdef IGL_STATIC_LIBRARY
@@ -10,6 +10,7 @@
 #include "../doublearea.h"
 #include "../random_dir.h"
 #include "../bfs_orient.h"
+#include "../parallel_for.h"
 #include "EmbreeIntersector.h"
 #include <iostream>
 #include <random>
@@ -154,50 +155,110 @@ IGL_INLINE void igl::embree::reorient_facets_raycast(
   vector<pair<int  , int  >> C_vote_parity(num_cc, make_pair(0, 0));        // sum of parity count for each ray
 
   if (is_verbose) cout << "shooting rays... ";
-#pragma omp parallel for
-  for (int i = 0; i < (int)ray_face.size(); ++i)
+  typedef EmbreeIntersector::PointMatrixType PointMatrixType;
+  const int num_rays = ray_face.size();
+  const int chunk_size = 1024;
+  const int num_chunks = (num_rays+chunk_size-1)/chunk_size;
+  // per-thread votes, accumulated after all rays are shot
+  vector<vector<pair<float, float>>> T_vote_distance;
+  vector<vector<pair<int  , int  >>> T_vote_infinity;
+  vector<vector<pair<int  , int  >>> T_vote_parity;
+  const auto & prep = [&](const size_t nt)
   {
-    int      f = ray_face[i];
-    Vector3f o = ray_ori [i];
-    Vector3f d = ray_dir [i];
-    int c = C(f);
-
-    // shoot ray toward front & back
-    vector<Hit> hits_front;
-    vector<Hit> hits_back;
-    int num_rays_front;
-    int num_rays_back;
-    ei.intersectRay(o,  d, hits_front, num_rays_front);
-    ei.intersectRay(o, -d, hits_back , num_rays_back );
-    if (!hits_front.empty() && hits_front[0].id == f) hits_front.erase(hits_front.begin());
-    if (!hits_back .empty() && hits_back [0].id == f) hits_back .erase(hits_back .begin());
-
+    T_vote_distance.assign(nt,C_vote_distance);
+    T_vote_infinity.assign(nt,C_vote_infinity);
+    T_vote_parity  .assign(nt,C_vote_parity);
+  };
+  const auto & shoot = [&](const int k, const size_t t)
+  {
+    const int i0 = k*chunk_size;
+    const int nk = min(chunk_size,num_rays-i0);
     if (use_parity) {
-#pragma omp atomic
-      C_vote_parity[c].first  += hits_front.size() % 2;
-#pragma omp atomic
-      C_vote_parity[c].second += hits_back .size() % 2;
-
+      for (int i = i0; i < i0+nk; ++i)
+      {
+        int f = ray_face[i];
+        int c = C(f);
+        // shoot ray toward front & back, collecting all hits of each in a
+        // single traversal
+        vector<Hit> hits_front;
+        vector<Hit> hits_back;
+        int num_rays_front;
+        int num_rays_back;
+        ei.intersectRay(ray_ori[i],  ray_dir[i], hits_front, num_rays_front);
+        ei.intersectRay(ray_ori[i], -ray_dir[i], hits_back , num_rays_back );
+        if (!hits_front.empty() && hits_front[0].id == f) hits_front.erase(hits_front.begin());
+        if (!hits_back .empty() && hits_back [0].id == f) hits_back .erase(hits_back .begin());
+        T_vote_parity[t][c].first  += hits_front.size() % 2;
+        T_vote_parity[t][c].second += hits_back .size() % 2;
+      }
     } else {
-      if (hits_front.empty())
+      // only the first hit past the ray's own face matters, so the whole
+      // chunk is shot toward front & back as two ray streams
+      PointMatrixType O(nk,3), D(nk,3);
+      for (int i = 0; i < nk; ++i)
       {
-#pragma omp atomic
-        C_vote_infinity[c].first++;
-      } else {
-#pragma omp atomic
-        C_vote_distance[c].first += hits_front[0].t;
+        O.row(i) = ray_ori[i0+i].transpose();
+        D.row(i) = ray_dir[i0+i].transpose();
       }
-
-      if (hits_back.empty())
+      const PointMatrixType mD = -D;
+      vector<Hit> hits_front;
+      vector<Hit> hits_back;
+      ei.intersectRays(O, D, hits_front);
+      ei.intersectRays(O,mD, hits_back );
+      // If the first hit is the ray's own face, fall back to finding all hits
+      // and skip it
+      const auto & skip_self = [&ei](
+        const int f,
+        const Eigen::RowVector3f & o,
+        const Eigen::RowVector3f & d,
+        Hit & hit)
       {
-#pragma omp atomic
-        C_vote_infinity[c].second++;
-      } else {
-#pragma omp atomic
-        C_vote_distance[c].second += hits_back[0].t;
+        if (hit.id != f) return;
+        vector<Hit> hits;
+        int num_rays_self;
+        ei.intersectRay(o, d, hits, num_rays_self);
+        if (!hits.empty() && hits[0].id == f) hits.erase(hits.begin());
+        if (hits.empty())
+        {
+          hit.id = -1;
+        } else {
+          hit = hits[0];
+        }
+      };
+      for (int i = 0; i < nk; ++i)
+      {
+        int f = ray_face[i0+i];
+        int c = C(f);
+        skip_self(f, O.row(i),  D.row(i), hits_front[i]);
+        skip_self(f, O.row(i), mD.row(i), hits_back [i]);
+        if (hits_front[i].id < 0)
+        {
+          T_vote_infinity[t][c].first++;
+        } else {
+          T_vote_distance[t][c].first += hits_front[i].t;
+        }
+        if (hits_back[i].id < 0)
+        {
+          T_vote_infinity[t][c].second++;
+        } else {
+          T_vote_distance[t][c].second += hits_back[i].t;
+        }
       }
     }
-  }
+  };
+  const auto & accum = [&](const size_t t)
+  {
+    for (int c = 0; c < num_cc; ++c)
+    {
+      C_vote_distance[c].first  += T_vote_distance[t][c].first;
+      C_vote_distance[c].second += T_vote_distance[t][c].second;
+      C_vote_infinity[c].first  += T_vote_infinity[t][c].first;
+      C_vote_infinity[c].second += T_vote_infinity[t][c].second;
+      C_vote_parity  [c].first  += T_vote_parity  [t][c].first;
+      C_vote_parity  [c].second += T_vote_parity  [t][c].second;
+    }
+  };
+  parallel_for(num_chunks,prep,shoot,accum,2);
 
   I.resize(m);
   for(int f = 0; f < m; ++f)
@@ -6,9 +6,11 @@
 // v. 2.0. If a copy of the MPL was not distributed with this file, You can
 // obtain one at http://mozilla.org/MPL/2.0/.
 #include "shape_diameter_function.h"
-#include "../shape_diameter_function.h"
 #include "EmbreeIntersector.h"
 #include "../Hit.h"
+#include "../random_dir.h"
+#include "../parallel_for.h"
+#include <vector>
 
 template <
   typename DerivedP,
@@ -21,21 +23,44 @@ IGL_INLINE void igl::embree::shape_diameter_function(
   const int num_samples,
   Eigen::PlainObjectBase<DerivedS> & S)
 {
-  const auto & shoot_ray = [&ei](
-    const Eigen::Vector3f& s,
-    const Eigen::Vector3f& dir)->double
+  using namespace Eigen;
+  typedef EmbreeIntersector::PointMatrixType PointMatrixType;
+  const int n = P.rows();
+  // Resize output
+  S.resize(n,1);
+  const MatrixXf D = random_dir_stratified(num_samples).cast<float>();
+  // The samples of each point are traced together as one ray stream
+  const auto & inner = [&](const int p)
   {
-    igl::Hit hit;
-    const float tnear = 1e-4f;
-    if(ei.intersectRay(s,dir,hit,tnear))
+    const RowVector3f origin = P.row(p).template cast<float>();
+    const RowVector3f normal = N.row(p).template cast<float>();
+    PointMatrixType origins(num_samples,3);
+    PointMatrixType directions(num_samples,3);
+    for(int s = 0;s<num_samples;s++)
     {
-      return hit.t;
-    }else
+      origins.row(s) = origin;
+      directions.row(s) = D.row(s);
+      // Shoot _inward_
+      if(directions.row(s).dot(normal) > 0)
+      {
+        // reverse ray
+        directions.row(s) *= -1;
+      }
+    }
+    std::vector<igl::Hit> hits;
+    const float tnear = 1e-4f;
+    const int num_hits = ei.intersectRays(origins,directions,hits,tnear);
+    double total_distance = 0;
+    for(const auto & hit : hits)
     {
-      return std::numeric_limits<double>::infinity();
+      if(hit.id >= 0)
+      {
+        total_distance += hit.t;
+      }
     }
+    S(p) = total_distance/(double)num_hits;
   };
-  return igl::shape_diameter_function(shoot_ray,P,N,num_samples,S);
+  parallel_for(n,inner,1000);
 }
 
 template <
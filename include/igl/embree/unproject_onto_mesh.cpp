@@ -53,6 +53,21 @@ IGL_INLINE bool igl::embree::unproject_onto_mesh(
   return true;
 }
 
+IGL_INLINE bool igl::embree::unproject_onto_mesh(
+  const Eigen::Vector2f& pos,
+  const Eigen::MatrixXd& V,
+  const Eigen::MatrixXi& F,
+  const Eigen::Matrix4f& model,
+  const Eigen::Matrix4f& proj,
+  const Eigen::Vector4f& viewport,
+  EmbreeIntersector & ei,
+  int& fid,
+  Eigen::Vector3f& bc)
+{
+  ei.update(V.cast<float>());
+  return igl::embree::unproject_onto_mesh(
+    pos,F,model,proj,viewport,ei,fid,bc);
+}
 
 #ifdef IGL_STATIC_LIBRARY
 // Explicit template instantiation
@@ -65,6 +65,36 @@ namespace igl
       const EmbreeIntersector & ei,
       int& fid,
       int& vid);
+
+    // Unproject a screen location onto a mesh whose vertices move from frame
+    // to frame (e.g., while animating or deforming it). The vertex positions
+    // of ei are first updated to V, which refits its BVH instead of
+    // rebuilding the whole scene.
+    //
+    // Inputs:
+    //    pos        screen space coordinates
+    //    V          #V by 3 list of current vertex positions
+    //    F          #F by 3 face matrix
+    //    model      model matrix
+    //    proj       projection matrix
+    //    viewport   vieweport vector
+    //    ei         EmbreeIntersector initialized with (V0,F) and
+    //      isDeformable = true, for some rest positions V0 with #V0 = #V
+    // Outputs:
+    //    ei         EmbreeIntersector containing (V,F)
+    //    fid        id of the first face hit
+    //    bc         barycentric coordinates of hit
+    // Returns true if there is a hit
+    IGL_INLINE bool unproject_onto_mesh(
+      const Eigen::Vector2f& pos,
+      const Eigen::MatrixXd& V,
+      const Eigen::MatrixXi& F,
+      const Eigen::Matrix4f& model,
+      const Eigen::Matrix4f& proj,
+      const Eigen::Vector4f& viewport,
+      EmbreeIntersector & ei,
+      int& fid,
+      Eigen::Vector3f& bc);
   }
 }
 #ifndef IGL_STATIC_LIBRARY
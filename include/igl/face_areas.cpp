@@ -61,5 +61,6 @@ IGL_INLINE void igl::face_areas(
 #ifdef IGL_STATIC_LIBRARY
 // Explicit template instantiation
 // generated by autoexplicit.sh
+template void igl::face_areas<Eigen::Matrix<float, -1, 6, 0, -1, 6>, Eigen::Matrix<float, -1, 4, 0, -1, 4> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, 6, 0, -1, 6> > const&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, 4, 0, -1, 4> >&);
 template void igl::face_areas<Eigen::Matrix<double, -1, 6, 0, -1, 6>, Eigen::Matrix<double, -1, 4, 0, -1, 4> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, 6, 0, -1, 6> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 4, 0, -1, 4> >&);
 #endif
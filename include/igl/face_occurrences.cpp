@@ -9,6 +9,9 @@
 
 #include <map>
 #include "sort.h"
+#include "parallel_for.h"
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 
 template <typename IntegerF, typename IntegerC>
@@ -50,9 +53,90 @@ IGL_INLINE void igl::face_occurrences(
   }
 }
 
+template <typename DerivedF, typename DerivedC>
+IGL_INLINE void igl::face_occurrences(
+  const Eigen::MatrixBase<DerivedF> & F,
+  Eigen::PlainObjectBase<DerivedC> & C)
+{
+  typedef typename DerivedF::Scalar Index;
+  const int m = F.rows();
+  const int ss = F.cols();
+  assert(ss <= 4 && "Faces should have at most 4 corners");
+  C.resize(m,1);
+  if(m == 0)
+  {
+    return;
+  }
+  // Copy of row f sorted in ascending order
+  const auto sorted_row = [&](const int f, Index * s)
+  {
+    for(int c = 0;c<ss;c++)
+    {
+      s[c] = F(f,c);
+      for(int d = c;d>0 && s[d]<s[d-1];d--)
+      {
+        std::swap(s[d],s[d-1]);
+      }
+    }
+  };
+  const int n = F.maxCoeff()+1;
+  // Bucket faces by their smallest index
+  std::vector<std::atomic<int> > offset(n+1);
+  for(int i = 0;i<=n;i++)
+  {
+    offset[i] = 0;
+  }
+  const auto smallest = [&](const int f)->int
+  {
+    Index s = F(f,0);
+    for(int c = 1;c<ss;c++)
+    {
+      s = std::min(s,(Index)F(f,c));
+    }
+    return s;
+  };
+  parallel_for(m,[&](const int f){ offset[smallest(f)+1]++; },10000);
+  for(int i = 0;i<n;i++)
+  {
+    offset[i+1] += offset[i];
+  }
+  std::vector<int> start(offset.begin(),offset.end());
+  std::vector<int> bucket(m);
+  parallel_for(m,[&](const int f){ bucket[offset[smallest(f)]++] = f; },10000);
+  // Sort each bucket (small) by the remaining indices and count runs of equal
+  // faces
+  parallel_for(n,[&](const int i)
+  {
+    const auto less = [&](const int f, const int g)->bool
+    {
+      Index sf[4],sg[4];
+      sorted_row(f,sf);
+      sorted_row(g,sg);
+      return std::lexicographical_compare(sf,sf+ss,sg,sg+ss);
+    };
+    int * b = bucket.data()+start[i];
+    int * e = bucket.data()+start[i+1];
+    std::sort(b,e,less);
+    while(b != e)
+    {
+      int * r = b+1;
+      while(r != e && !less(*b,*r))
+      {
+        r++;
+      }
+      for(int * f = b;f != r;f++)
+      {
+        C(*f) = r-b;
+      }
+      b = r;
+    }
+  },1000);
+}
+
 #ifdef IGL_STATIC_LIBRARY
 // Explicit template instantiation
 // generated by autoexplicit.sh
 template void igl::face_occurrences<unsigned int, int>(std::vector<std::vector<unsigned int, std::allocator<unsigned int> >, std::allocator<std::vector<unsigned int, std::allocator<unsigned int> > > > const&, std::vector<int, std::allocator<int> >&);
 template void igl::face_occurrences<int, int>(std::vector<std::vector<int, std::allocator<int> >, std::allocator<std::vector<int, std::allocator<int> > > > const&, std::vector<int, std::allocator<int> >&);
+template void igl::face_occurrences<Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
 #endif
@@ -9,6 +9,7 @@
 #define IGL_FACE_OCCURRENCES
 #include "igl_inline.h"
 
+#include <Eigen/Core>
 #include <vector>
 namespace igl
 {
@@ -23,6 +24,17 @@ namespace igl
   IGL_INLINE void face_occurrences(
     const std::vector<std::vector<IntegerF> > & F,
     std::vector<IntegerC> & C);
+  // Faces are bucketed by their smallest index (counting sort) and buckets
+  // are sorted and counted in parallel.
+  //
+  // Inputs:
+  //   F  #F by simplex-size (at most 4) list of face indices
+  // Outputs
+  //   C  #F list of counts
+  template <typename DerivedF, typename DerivedC>
+  IGL_INLINE void face_occurrences(
+    const Eigen::MatrixBase<DerivedF> & F,
+    Eigen::PlainObjectBase<DerivedC> & C);
 }
 
 #ifndef IGL_STATIC_LIBRARY
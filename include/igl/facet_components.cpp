@@ -6,21 +6,55 @@
 // v. 2.0. If a copy of the MPL was not distributed with this file, You can 
 // obtain one at http://mozilla.org/MPL/2.0/.
 #include "facet_components.h"
-#include <igl/triangle_triangle_adjacency.h>
-#include <vector>
-#include <queue>
+#include "UnionFind.h"
+#include "parallel_for.h"
+#include "vertex_triangle_adjacency.h"
 template <typename DerivedF, typename DerivedC>
 IGL_INLINE void igl::facet_components(
   const Eigen::PlainObjectBase<DerivedF> & F,
   Eigen::PlainObjectBase<DerivedC> & C)
 {
-  using namespace std;
-  typedef typename DerivedF::Index Index;
-  vector<vector<vector<Index > > > TT;
-  vector<vector<vector<Index > > > TTi;
-  triangle_triangle_adjacency(F,TT,TTi);
-  Eigen::VectorXi counts;
-  return facet_components(TT,C,counts);
+  assert(F.cols() == 3);
+  // Faces sharing an edge with f are found among the faces incident on its
+  // vertices, so that no per-face adjacency lists need to be built
+  const int m = F.rows();
+  // Rows of a row-major copy are contiguous in memory
+  const Eigen::Matrix<int,Eigen::Dynamic,3,Eigen::RowMajor> RF =
+    F.template cast<int>();
+  Eigen::VectorXi VF,NI;
+  vertex_triangle_adjacency(RF,m == 0 ? 0 : RF.maxCoeff()+1,VF,NI);
+  UnionFind U(m);
+  parallel_for(m,[&](const int f)
+  {
+    for(int c = 0;c<3;c++)
+    {
+      const int i = RF(f,(c+1)%3);
+      const int j = RF(f,(c+2)%3);
+      for(int k = NI(i);k<NI(i+1);k++)
+      {
+        const int g = VF(k);
+        if(g >= f)
+        {
+          // merged from g's side
+          continue;
+        }
+        for(int d = 0;d<3;d++)
+        {
+          const int a = RF(g,(d+1)%3);
+          const int b = RF(g,(d+2)%3);
+          if((a == i && b == j) || (a == j && b == i))
+          {
+            U.unite(f,g);
+            break;
+          }
+        }
+      }
+    }
+  },1000);
+  Eigen::VectorXi IC,counts;
+  U.labels(IC,counts);
+  C.resize(m,1);
+  C.array() = IC.array().cast<typename DerivedC::Scalar>();
 }
 
 template <
@@ -32,56 +66,26 @@ IGL_INLINE void igl::facet_components(
   Eigen::PlainObjectBase<DerivedC> & C,
   Eigen::PlainObjectBase<Derivedcounts> & counts)
 {
-  using namespace std;
-  typedef TTIndex Index;
-  const Index m = TT.size();
-  C.resize(m,1);
-  vector<bool> seen(m,false);
-  Index id = 0;
-  vector<Index> vcounts;
-  for(Index g = 0;g<m;g++)
+  const int m = TT.size();
+  UnionFind U(m);
+  parallel_for(m,[&](const int f)
   {
-    if(seen[g])
-    {
-      continue;
-    }
-    vcounts.push_back(0);
-    queue<Index> Q;
-    Q.push(g);
-    while(!Q.empty())
+    // Face f's neighbor lists opposite opposite each corner
+    for(const auto & c : TT[f])
     {
-      const Index f = Q.front();
-      Q.pop();
-      if(seen[f])
+      // Each neighbor
+      for(const auto & n : c)
       {
-        continue;
-      }
-      seen[f] = true;
-      vcounts[id]++;
-      C(f,0) = id;
-      // Face f's neighbor lists opposite opposite each corner
-      for(const auto & c : TT[f])
-      {
-        // Each neighbor
-        for(const auto & n : c)
-        {
-          if(!seen[n])
-          {
-            Q.push(n);
-          }
-        }
+        U.unite(f,n);
       }
     }
-    id++;
-  }
-  assert((size_t) id == vcounts.size());
-  const size_t ncc = vcounts.size();
-  assert((size_t)C.maxCoeff()+1 == ncc);
-  counts.resize(ncc,1);
-  for(size_t i = 0;i<ncc;i++)
-  {
-    counts(i) = vcounts[i];
-  }
+  },1000);
+  Eigen::VectorXi IC,Icounts;
+  U.labels(IC,Icounts);
+  C.resize(m,1);
+  C.array() = IC.array().cast<typename DerivedC::Scalar>();
+  counts.resize(Icounts.rows(),1);
+  counts.array() = Icounts.array().cast<typename Derivedcounts::Scalar>();
 }
 
 #ifdef IGL_STATIC_LIBRARY
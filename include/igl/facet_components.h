@@ -13,6 +13,8 @@
 namespace igl
 {
   // Compute connected components of facets based on edge-edge adjacency.
+  // Components are merged in parallel (see igl::UnionFind) and numbered in
+  // order of their first facet.
   //
   // Inputs:
   //   F  #F by 3 list of triangle indices
@@ -6,7 +6,9 @@
 // v. 2.0. If a copy of the MPL was not distributed with this file, You can 
 // obtain one at http://mozilla.org/MPL/2.0/.
 #include "hausdorff.h"
+#include "directed_hausdorff.h"
 #include "point_mesh_squared_distance.h"
+#include <limits>
 
 template <
   typename DerivedVA, 
@@ -36,6 +38,39 @@ IGL_INLINE void igl::hausdorff(
   d = sqrt(std::max(dba,dab));
 }
 
+template <
+  typename DerivedVA, 
+  typename DerivedFA,
+  typename DerivedVB,
+  typename DerivedFB,
+  typename Scalar>
+IGL_INLINE void igl::hausdorff(
+  const Eigen::PlainObjectBase<DerivedVA> & VA, 
+  const Eigen::PlainObjectBase<DerivedFA> & FA,
+  const Eigen::PlainObjectBase<DerivedVB> & VB, 
+  const Eigen::PlainObjectBase<DerivedFB> & FB,
+  const Scalar eps,
+  const Scalar threshold,
+  Scalar & l,
+  Scalar & u)
+{
+  Scalar lab,uab;
+  directed_hausdorff(VA,FA,VB,FB,eps,threshold,lab,uab);
+  // No need to look the other way if A alone already exceeds the threshold.
+  // uab only bounds the directed distance from A, nothing is known about the
+  // distance from B.
+  if(lab > threshold)
+  {
+    l = lab;
+    u = std::numeric_limits<Scalar>::infinity();
+    return;
+  }
+  Scalar lba,uba;
+  directed_hausdorff(VB,FB,VA,FA,eps,threshold,lba,uba);
+  l = std::max(lab,lba);
+  u = std::max(uab,uba);
+}
+
 template <
   typename DerivedV,
   typename Scalar>
@@ -86,4 +121,5 @@ IGL_INLINE void igl::hausdorff(
 
 #ifdef IGL_STATIC_LIBRARY
 template void igl::hausdorff<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, double>(Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, double&);
+template void igl::hausdorff<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, double>(Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, double, double, double&, double&);
 #endif
@@ -27,7 +27,8 @@ namespace igl
   // Hausdorff distance between the non-convex, block letter V polygon (with 7
   // vertices) in 2D and its convex hull. The Hausdorff distance is defined by
   // the midpoint in the middle of the segment across the concavity and some
-  // non-vertex point _on the edge_ of the V.
+  // non-vertex point _on the edge_ of the V. Use the overload with eps below
+  // for the exact distance.
   //
   // Inputs:
   //   VA  #VA by 3 list of vertex positions
@@ -51,6 +52,38 @@ namespace igl
     const Eigen::PlainObjectBase<DerivedVB> & VB, 
     const Eigen::PlainObjectBase<DerivedFB> & FB,
     Scalar & d);
+  // Compute lower and upper bounds (l,u) on the exact Hausdorff distance
+  // between mesh (VA,FA) and mesh (VB,FB), considering all points on the
+  // triangles (see directed_hausdorff).
+  //
+  // Inputs:
+  //   VA  #VA by 3 list of vertex positions
+  //   FA  #FA by 3 list of face indices into VA
+  //   VB  #VB by 3 list of vertex positions
+  //   FB  #FB by 3 list of face indices into VB
+  //   eps  positive absolute tolerance on the gap between bounds
+  //   threshold  if finite, stop as soon as d(A,B) is known to be larger than
+  //     threshold (l > threshold) or at most threshold (u <= threshold)
+  // Outputs:
+  //   l  lower bound on Hausdorff distance
+  //   u  upper bound on Hausdorff distance, so that u-l <= eps unless stopped
+  //     early by threshold (infinity if stopped because l > threshold)
+  //
+  template <
+    typename DerivedVA, 
+    typename DerivedFA,
+    typename DerivedVB,
+    typename DerivedFB,
+    typename Scalar>
+  IGL_INLINE void hausdorff(
+    const Eigen::PlainObjectBase<DerivedVA> & VA, 
+    const Eigen::PlainObjectBase<DerivedFA> & FA,
+    const Eigen::PlainObjectBase<DerivedVB> & VB, 
+    const Eigen::PlainObjectBase<DerivedFB> & FB,
+    const Scalar eps,
+    const Scalar threshold,
+    Scalar & l,
+    Scalar & u);
   // Compute lower and upper bounds (l,u) on the Hausdorff distance between a triangle
   // (V) and a pointset (e.g., mesh, triangle soup) given by a distance function
   // handle (dist_to_B).
@@ -0,0 +1,209 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 agent <agent@local>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "heat_geodesics.h"
+#include "avg_edge_length.h"
+#include "boundary_facets.h"
+#include "cotmatrix.h"
+#include "doublearea.h"
+#include "grad.h"
+#include "massmatrix.h"
+#include "unique.h"
+#include <cassert>
+#include <cmath>
+
+template <typename DerivedV, typename DerivedF, typename Scalar>
+IGL_INLINE bool igl::heat_geodesics_precompute(
+  const Eigen::PlainObjectBase<DerivedV> & V,
+  const Eigen::PlainObjectBase<DerivedF> & F,
+  HeatGeodesicsData<Scalar> & data)
+{
+  // default t value
+  const Scalar h = avg_edge_length(V,F);
+  const Scalar t = h*h;
+  return heat_geodesics_precompute(
+    V,F,t,HEAT_GEODESICS_BOUNDARY_AVERAGE,data);
+}
+
+template <typename DerivedV, typename DerivedF, typename Scalar>
+IGL_INLINE bool igl::heat_geodesics_precompute(
+  const Eigen::PlainObjectBase<DerivedV> & V,
+  const Eigen::PlainObjectBase<DerivedF> & F,
+  const Scalar t,
+  const HeatGeodesicsBoundaryType boundary_type,
+  HeatGeodesicsData<Scalar> & data)
+{
+  typedef Eigen::Matrix<Scalar,Eigen::Dynamic,1> VectorXS;
+  assert(F.cols() == 3 && "Only triangles are supported");
+  assert(V.cols() == 3 && "Only 3D meshes are supported");
+  Eigen::SparseMatrix<Scalar> L,M;
+  cotmatrix(V,F,L);
+  massmatrix(V,F,MASSMATRIX_TYPE_DEFAULT,M);
+  {
+    Eigen::SparseMatrix<typename DerivedV::Scalar> G;
+    grad(V,F,G);
+    data.Grad = G.template cast<Scalar>();
+  }
+  // Divergence is the adjoint of the gradient w.r.t. the area-weighted inner
+  // product on faces: L = Div * Grad
+  {
+    VectorXS dblA;
+    doublearea(V,F,dblA);
+    const int m = F.rows();
+    VectorXS A3(3*m);
+    A3 << dblA,dblA,dblA;
+    data.Div = -0.5*data.Grad.transpose()*A3.asDiagonal();
+  }
+
+  data.b.resize(0);
+  {
+    Eigen::MatrixXi O;
+    boundary_facets(Eigen::MatrixXi(F.template cast<int>()),O);
+    if(O.size() > 0)
+    {
+      unique(O,data.b);
+    }
+  }
+  data.boundary_type =
+    data.b.size() == 0 ? HEAT_GEODESICS_BOUNDARY_NEUMANN : boundary_type;
+
+  // Heat flow: (M - t*L) u = u0
+  const Eigen::SparseMatrix<Scalar> Q = M - t*L;
+  const Eigen::SparseMatrix<Scalar> Aeq;
+  if(data.boundary_type != HEAT_GEODESICS_BOUNDARY_DIRICHLET)
+  {
+    if(!min_quad_with_fixed_precompute(
+      Q,Eigen::VectorXi(),Aeq,true,data.Neumann))
+    {
+      return false;
+    }
+  }
+  if(data.boundary_type != HEAT_GEODESICS_BOUNDARY_NEUMANN)
+  {
+    if(!min_quad_with_fixed_precompute(Q,data.b,Aeq,true,data.Dirichlet))
+    {
+      return false;
+    }
+  }
+  // Poisson: L φ = Div X. Pinning a single vertex makes -L positive definite
+  // so that a Cholesky factorization can be used; the arbitrary constant is
+  // removed after each solve.
+  const Eigen::SparseMatrix<Scalar> NL = -L;
+  const Eigen::VectorXi pin = Eigen::VectorXi::Zero(1);
+  if(!min_quad_with_fixed_precompute(NL,pin,Aeq,true,data.Poisson))
+  {
+    return false;
+  }
+  return true;
+}
+
+template <typename Scalar, typename Derivedgamma, typename DerivedD>
+IGL_INLINE void igl::heat_geodesics_solve(
+  const HeatGeodesicsData<Scalar> & data,
+  const Eigen::MatrixBase<Derivedgamma> & gamma,
+  Eigen::PlainObjectBase<DerivedD> & D)
+{
+  Eigen::Vector2i NQ(0,gamma.size());
+  heat_geodesics_solve(data,gamma,NQ,D);
+}
+
+template <
+  typename Scalar,
+  typename Derivedgamma,
+  typename DerivedNQ,
+  typename DerivedD>
+IGL_INLINE void igl::heat_geodesics_solve(
+  const HeatGeodesicsData<Scalar> & data,
+  const Eigen::MatrixBase<Derivedgamma> & gamma,
+  const Eigen::MatrixBase<DerivedNQ> & NQ,
+  Eigen::PlainObjectBase<DerivedD> & D)
+{
+  typedef Eigen::Matrix<Scalar,Eigen::Dynamic,Eigen::Dynamic> MatrixXS;
+  // number of mesh vertices
+  const int n = data.Grad.cols();
+  // number of faces
+  const int m = data.Grad.rows()/3;
+  // number of queries
+  assert(NQ.size() > 0 && "NQ should have #Q+1 entries");
+  const int k = NQ.size()-1;
+  // Set up delta at each gamma (min_quad_with_fixed solves A z = -B)
+  MatrixXS B0 = MatrixXS::Zero(n,k);
+  for(int q = 0;q<k;q++)
+  {
+    for(int g = NQ(q);g<NQ(q+1);g++)
+    {
+      B0(gamma(g),q) = -1;
+    }
+  }
+  const MatrixXS Beq;
+  MatrixXS u;
+  switch(data.boundary_type)
+  {
+    default:
+      assert(false && "Unknown boundary type");
+    case HEAT_GEODESICS_BOUNDARY_NEUMANN:
+      min_quad_with_fixed_solve(data.Neumann,B0,MatrixXS(0,k),Beq,u);
+      break;
+    case HEAT_GEODESICS_BOUNDARY_DIRICHLET:
+      min_quad_with_fixed_solve(
+        data.Dirichlet,B0,MatrixXS::Zero(data.b.size(),k),Beq,u);
+      break;
+    case HEAT_GEODESICS_BOUNDARY_AVERAGE:
+    {
+      MatrixXS uD;
+      min_quad_with_fixed_solve(data.Neumann,B0,MatrixXS(0,k),Beq,u);
+      min_quad_with_fixed_solve(
+        data.Dirichlet,B0,MatrixXS::Zero(data.b.size(),k),Beq,uD);
+      u = 0.5*(u+uD);
+      break;
+    }
+  }
+  // Normalized (negated) gradient: unit vector field pointing away from gamma
+  MatrixXS X = data.Grad*u;
+  for(int q = 0;q<k;q++)
+  {
+    for(int f = 0;f<m;f++)
+    {
+      const Scalar norm = std::sqrt(
+        X(0*m+f,q)*X(0*m+f,q)+
+        X(1*m+f,q)*X(1*m+f,q)+
+        X(2*m+f,q)*X(2*m+f,q));
+      for(int d = 0;d<3;d++)
+      {
+        X(d*m+f,q) = norm == 0 ? 0 : -X(d*m+f,q)/norm;
+      }
+    }
+  }
+  // Solve L φ = Div X, i.e., -L φ = -Div X
+  const MatrixXS divX = data.Div*X;
+  MatrixXS Dk;
+  min_quad_with_fixed_solve(data.Poisson,divX,MatrixXS::Zero(1,k),Beq,Dk);
+  // Shift so that distance is zero at the source
+  for(int q = 0;q<k;q++)
+  {
+    if(NQ(q+1) == NQ(q))
+    {
+      continue;
+    }
+    Scalar shift = 0;
+    for(int g = NQ(q);g<NQ(q+1);g++)
+    {
+      shift += Dk(gamma(g),q);
+    }
+    shift /= Scalar(NQ(q+1)-NQ(q));
+    Dk.col(q).array() -= shift;
+  }
+  D = Dk.template cast<typename DerivedD::Scalar>();
+}
+
+#ifdef IGL_STATIC_LIBRARY
+// Explicit template instantiation
+template bool igl::heat_geodesics_precompute<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, double>(Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, igl::HeatGeodesicsData<double>&);
+template bool igl::heat_geodesics_precompute<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, double>(Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, double, igl::HeatGeodesicsBoundaryType, igl::HeatGeodesicsData<double>&);
+template void igl::heat_geodesics_solve<double, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, 1, 0, -1, 1> >(igl::HeatGeodesicsData<double> const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&);
+template void igl::heat_geodesics_solve<double, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(igl::HeatGeodesicsData<double> const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&);
+#endif
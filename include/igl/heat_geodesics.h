@@ -0,0 +1,115 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 agent <agent@local>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_HEAT_GEODESICS_H
+#define IGL_HEAT_GEODESICS_H
+#include "igl_inline.h"
+#include "min_quad_with_fixed.h"
+#include <Eigen/Core>
+#include <Eigen/Sparse>
+
+namespace igl
+{
+  enum HeatGeodesicsBoundaryType
+  {
+    // Zero normal derivative of the heat at the boundary
+    HEAT_GEODESICS_BOUNDARY_NEUMANN = 0,
+    // Zero heat at the boundary
+    HEAT_GEODESICS_BOUNDARY_DIRICHLET = 1,
+    // Average of the Neumann and Dirichlet solutions (recommended by [Crane et
+    // al. 2013])
+    HEAT_GEODESICS_BOUNDARY_AVERAGE = 2,
+    NUM_HEAT_GEODESICS_BOUNDARY_TYPES = 3
+  };
+  template <typename Scalar>
+  struct HeatGeodesicsData
+  {
+    // Gradient operator (#F*3 by #V)
+    Eigen::SparseMatrix<Scalar> Grad;
+    // Divergence operator (#V by #F*3)
+    Eigen::SparseMatrix<Scalar> Div;
+    // Boundary vertices (empty if mesh is closed)
+    Eigen::VectorXi b;
+    // Boundary condition actually used during solve (AVERAGE and DIRICHLET
+    // fall back to NEUMANN on closed meshes)
+    HeatGeodesicsBoundaryType boundary_type;
+    // Prefactored heat flow system (M - t*L) with Neumann and Dirichlet
+    // boundary conditions, and the Poisson system -L pinned at vertex 0
+    min_quad_with_fixed_data<Scalar> Neumann,Dirichlet,Poisson;
+    HeatGeodesicsData():boundary_type(HEAT_GEODESICS_BOUNDARY_NEUMANN){}
+  };
+  // HEAT_GEODESICS_PRECOMPUTE Precompute factorized solvers for computing a
+  // fast approximation of geodesic distances on a mesh (V,F). [Crane et al.
+  // 2013]
+  //
+  // Inputs:
+  //   V  #V by 3 list of mesh vertex positions
+  //   F  #F by 3 list of mesh face indices into V (mesh should be a single
+  //     connected component)
+  //   t  "heat" parameter (smaller --> more accurate, less stable) {h^2 where h
+  //     is the average edge length}
+  //   boundary_type  which boundary conditions to use for the heat flow (only
+  //     matters if (V,F) has a boundary) {HEAT_GEODESICS_BOUNDARY_AVERAGE}
+  // Outputs:
+  //   data  precomputation data (see heat_geodesics_solve)
+  // Returns true on success, false on error (e.g., failed factorization)
+  //
+  // See also: exact_geodesic, dijkstra
+  template <typename DerivedV, typename DerivedF, typename Scalar>
+  IGL_INLINE bool heat_geodesics_precompute(
+    const Eigen::PlainObjectBase<DerivedV> & V,
+    const Eigen::PlainObjectBase<DerivedF> & F,
+    HeatGeodesicsData<Scalar> & data);
+  template <typename DerivedV, typename DerivedF, typename Scalar>
+  IGL_INLINE bool heat_geodesics_precompute(
+    const Eigen::PlainObjectBase<DerivedV> & V,
+    const Eigen::PlainObjectBase<DerivedF> & F,
+    const Scalar t,
+    const HeatGeodesicsBoundaryType boundary_type,
+    HeatGeodesicsData<Scalar> & data);
+  // HEAT_GEODESICS_SOLVE Compute fast approximate geodesic distances using
+  // precomputed data from a set of selected source vertices (gamma). Only two
+  // back-substitutions are needed per query.
+  //
+  // Inputs:
+  //   data  precomputation data (see heat_geodesics_precompute)
+  //   gamma  #gamma list of indices into V of source vertices
+  // Outputs:
+  //   D  #V list of distances to gamma
+  template <typename Scalar, typename Derivedgamma, typename DerivedD>
+  IGL_INLINE void heat_geodesics_solve(
+    const HeatGeodesicsData<Scalar> & data,
+    const Eigen::MatrixBase<Derivedgamma> & gamma,
+    Eigen::PlainObjectBase<DerivedD> & D);
+  // Batched version answering many independent queries at once. All
+  // right-hand sides are back-substituted together.
+  //
+  // Inputs:
+  //   data  precomputation data (see heat_geodesics_precompute)
+  //   gamma  #gamma list of indices into V of source vertices of all queries
+  //   NQ  #Q+1 list of cumulative sizes of the queries: the sources of query q
+  //     are gamma(NQ(q)), ..., gamma(NQ(q+1)-1)
+  // Outputs:
+  //   D  #V by #Q matrix of distances, D(:,q) are distances to the sources of
+  //     query q
+  template <
+    typename Scalar,
+    typename Derivedgamma,
+    typename DerivedNQ,
+    typename DerivedD>
+  IGL_INLINE void heat_geodesics_solve(
+    const HeatGeodesicsData<Scalar> & data,
+    const Eigen::MatrixBase<Derivedgamma> & gamma,
+    const Eigen::MatrixBase<DerivedNQ> & NQ,
+    Eigen::PlainObjectBase<DerivedD> & D);
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#include "heat_geodesics.cpp"
+#endif
+
+#endif
@@ -0,0 +1,95 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+// 
+// Copyright (C) 2026 agent <agent@local>
+// 
+// This Source Code Form is subject to the terms of the Mozilla Public License 
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can 
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "lbs.h"
+#include "parallel_for.h"
+#include <Eigen/StdVector>
+#include <cassert>
+#include <vector>
+
+namespace igl
+{
+  // Fixed-dimension implementation of lbs
+  template <
+    int DIM,
+    typename DerivedV,
+    typename DerivedW,
+    typename DerivedWI,
+    typename DerivedT,
+    typename DerivedU>
+  IGL_INLINE void lbs_dim(
+    const Eigen::MatrixBase<DerivedV> & V,
+    const Eigen::MatrixBase<DerivedW> & W,
+    const Eigen::MatrixBase<DerivedWI> & WI,
+    const Eigen::MatrixBase<DerivedT> & T,
+    Eigen::PlainObjectBase<DerivedU> & U)
+  {
+    typedef typename DerivedU::Scalar Scalar;
+    // Affine transformation acting on column vectors [v;1]
+    typedef Eigen::Matrix<Scalar,DIM,DIM+1> Affine;
+    const int m = T.rows()/(DIM+1);
+    // Gather handle transformations into fixed-size, aligned storage so
+    // that blending is a handful of packet operations per weight
+    std::vector<Affine,Eigen::aligned_allocator<Affine> > A(m);
+    for(int c = 0;c<m;c++)
+    {
+      A[c] = T.block(c*(DIM+1),0,DIM+1,DIM).transpose().template cast<Scalar>();
+    }
+    const int n = V.rows();
+    const int k = W.cols();
+    U.resize(n,DIM);
+    parallel_for(n,[&](const int i)
+    {
+      Affine B = Affine::Zero();
+      for(int j = 0;j<k;j++)
+      {
+        const int c = WI(i,j);
+        if(c < 0) continue;
+        assert(c < m && "WI should index into T");
+        B.noalias() += Scalar(W(i,j)) * A[c];
+      }
+      Eigen::Matrix<Scalar,DIM,1> v = 
+        V.row(i).transpose().template cast<Scalar>();
+      U.row(i) = (B.template leftCols<DIM>()*v + B.col(DIM)).transpose();
+    },1000);
+  }
+}
+
+template <
+  typename DerivedV,
+  typename DerivedW,
+  typename DerivedWI,
+  typename DerivedT,
+  typename DerivedU>
+IGL_INLINE void igl::lbs(
+  const Eigen::MatrixBase<DerivedV> & V,
+  const Eigen::MatrixBase<DerivedW> & W,
+  const Eigen::MatrixBase<DerivedWI> & WI,
+  const Eigen::MatrixBase<DerivedT> & T,
+  Eigen::PlainObjectBase<DerivedU> & U)
+{
+  const int dim = V.cols();
+  assert(W.rows() >= V.rows() && "W should have a row for each vertex");
+  assert(W.rows() == WI.rows() && W.cols() == WI.cols());
+  assert(T.cols() == dim && "T should be #handles*(dim+1) by dim");
+  assert(T.rows() % (dim+1) == 0 && "T should be #handles*(dim+1) by dim");
+  switch(dim)
+  {
+    case 3:
+      return lbs_dim<3>(V,W,WI,T,U);
+    case 2:
+      return lbs_dim<2>(V,W,WI,T,U);
+    default:
+      assert(false && "dim should be 2 or 3");
+  }
+}
+
+#ifdef IGL_STATIC_LIBRARY
+// Explicit template instantiation
+template void igl::lbs<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&);
+template void igl::lbs<Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> >&);
+#endif
@@ -0,0 +1,49 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+// 
+// Copyright (C) 2026 agent <agent@local>
+// 
+// This Source Code Form is subject to the terms of the Mozilla Public License 
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can 
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_LBS_H
+#define IGL_LBS_H
+#include "igl_inline.h"
+#include <Eigen/Core>
+
+namespace igl
+{
+  // LBS Linear blend skinning with a constant number of (sparse) weights per
+  // vertex. Computes the same result as lbs_matrix(V,W,M); U = M*T; without
+  // forming M: each vertex blends the affine transformations of its k
+  // handles and applies the blended transformation once.
+  //
+  // Inputs:
+  //   V  #V by dim list of rest positions (dim = 2 or 3)
+  //   W  #V by k list of k correspondence weights per vertex
+  //   WI  #V by k list of k correspondence weight indices per vertex, such that
+  //     W(i,j) is the weight of handle WI(i,j) on vertex i (see top_k_weights).
+  //     Negative indices are ignored.
+  //   T  #handles*(dim+1) by dim list of stacked transposed affine
+  //     transformations (see lbs_matrix)
+  // Outputs:
+  //   U  #V by dim list of deformed positions
+  //
+  // See also: lbs_matrix, dqs, top_k_weights
+  template <
+    typename DerivedV,
+    typename DerivedW,
+    typename DerivedWI,
+    typename DerivedT,
+    typename DerivedU>
+  IGL_INLINE void lbs(
+    const Eigen::MatrixBase<DerivedV> & V,
+    const Eigen::MatrixBase<DerivedW> & W,
+    const Eigen::MatrixBase<DerivedWI> & WI,
+    const Eigen::MatrixBase<DerivedT> & T,
+    Eigen::PlainObjectBase<DerivedU> & U);
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "lbs.cpp"
+#endif
+#endif
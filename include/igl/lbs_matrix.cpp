@@ -7,10 +7,11 @@
 // obtain one at http://mozilla.org/MPL/2.0/.
 #include "lbs_matrix.h"
 
+template <typename DerivedV, typename DerivedW, typename DerivedM>
 IGL_INLINE void igl::lbs_matrix(
-  const Eigen::MatrixXd & V, 
-  const Eigen::MatrixXd & W,
-  Eigen::MatrixXd & M)
+  const Eigen::MatrixBase<DerivedV> & V, 
+  const Eigen::MatrixBase<DerivedW> & W,
+  Eigen::PlainObjectBase<DerivedM> & M)
 {
   using namespace Eigen;
   // Number of dimensions
@@ -26,25 +27,27 @@ IGL_INLINE void igl::lbs_matrix(
   M.resize(n,(dim+1)*m);
   for(int j = 0;j<m;j++)
   {
-    VectorXd Wj = W.block(0,j,V.rows(),1);
+    const Matrix<typename DerivedM::Scalar,Dynamic,1> Wj =
+      W.block(0,j,V.rows(),1).template cast<typename DerivedM::Scalar>();
     for(int i = 0;i<(dim+1);i++)
     {
       if(i<dim)
       {
         M.col(i + j*(dim+1)) = 
-          Wj.cwiseProduct(V.col(i));
+          Wj.cwiseProduct(V.col(i).template cast<typename DerivedM::Scalar>());
       }else
       {
-        M.col(i + j*(dim+1)).array() = W.block(0,j,V.rows(),1).array();
+        M.col(i + j*(dim+1)) = Wj;
       }
     }
   }
 }
 
+template <typename DerivedV, typename DerivedW, typename Scalar>
 IGL_INLINE void igl::lbs_matrix_column(
-  const Eigen::MatrixXd & V, 
-  const Eigen::MatrixXd & W,
-  Eigen::SparseMatrix<double>& M)
+  const Eigen::MatrixBase<DerivedV> & V, 
+  const Eigen::MatrixBase<DerivedW> & W,
+  Eigen::SparseMatrix<Scalar>& M)
 {
   // number of mesh vertices
   int n = V.rows();
@@ -68,7 +71,7 @@ IGL_INLINE void igl::lbs_matrix_column(
         // loop over cols of affine transformations
         for(int c = 0; c < (dim+1); c++)
         {
-          double value = W(j,i);
+          Scalar value = W(j,i);
           if(c<dim)
           {
             value *= V(j,c);
@@ -82,10 +85,11 @@ IGL_INLINE void igl::lbs_matrix_column(
   M.makeCompressed();
 }
 
+template <typename DerivedV, typename DerivedW, typename DerivedM>
 IGL_INLINE void igl::lbs_matrix_column(
-  const Eigen::MatrixXd & V, 
-  const Eigen::MatrixXd & W,
-  Eigen::MatrixXd & M)
+  const Eigen::MatrixBase<DerivedV> & V, 
+  const Eigen::MatrixBase<DerivedW> & W,
+  Eigen::PlainObjectBase<DerivedM> & M)
 {
   // number of mesh vertices
   int n = V.rows();
@@ -108,7 +112,7 @@ IGL_INLINE void igl::lbs_matrix_column(
         // loop over cols of affine transformations
         for(int c = 0; c < (dim+1); c++)
         {
-          double value = W(j,i);
+          typename DerivedM::Scalar value = W(j,i);
           if(c<dim)
           {
             value *= V(j,c);
@@ -120,11 +124,16 @@ IGL_INLINE void igl::lbs_matrix_column(
   }
 }
 
+template <
+  typename DerivedV,
+  typename DerivedW,
+  typename DerivedWI,
+  typename Scalar>
 IGL_INLINE void igl::lbs_matrix_column(
-  const Eigen::MatrixXd & V, 
-  const Eigen::MatrixXd & W,
-  const Eigen::MatrixXi & WI,
-  Eigen::SparseMatrix<double>& M)
+  const Eigen::MatrixBase<DerivedV> & V, 
+  const Eigen::MatrixBase<DerivedW> & W,
+  const Eigen::MatrixBase<DerivedWI> & WI,
+  Eigen::SparseMatrix<Scalar>& M)
 {
   // number of mesh vertices
   int n = V.rows();
@@ -152,7 +161,7 @@ IGL_INLINE void igl::lbs_matrix_column(
         // loop over cols of affine transformations
         for(int c = 0; c < (dim+1); c++)
         {
-          double value = W(j,i);
+          Scalar value = W(j,i);
           if(c<dim)
           {
             value *= V(j,c);
@@ -170,15 +179,34 @@ IGL_INLINE void igl::lbs_matrix_column(
 }
 
 
+template <
+  typename DerivedV,
+  typename DerivedW,
+  typename DerivedWI,
+  typename DerivedM>
 IGL_INLINE void igl::lbs_matrix_column(
-  const Eigen::MatrixXd & V, 
-  const Eigen::MatrixXd & W,
-  const Eigen::MatrixXi & WI,
-  Eigen::MatrixXd & M)
+  const Eigen::MatrixBase<DerivedV> & V, 
+  const Eigen::MatrixBase<DerivedW> & W,
+  const Eigen::MatrixBase<DerivedWI> & WI,
+  Eigen::PlainObjectBase<DerivedM> & M)
 {
   // Cheapskate wrapper
   using namespace Eigen;
-  SparseMatrix<double> sM;
+  SparseMatrix<typename DerivedM::Scalar> sM;
   lbs_matrix_column(V,W,WI,sM);
-  M = MatrixXd(sM);
+  M = sM;
 }
+
+#ifdef IGL_STATIC_LIBRARY
+// Explicit template instantiation
+template void igl::lbs_matrix<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&);
+template void igl::lbs_matrix<Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> >&);
+template void igl::lbs_matrix_column<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::SparseMatrix<double, 0, int>&);
+template void igl::lbs_matrix_column<Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1>, float>(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::SparseMatrix<float, 0, int>&);
+template void igl::lbs_matrix_column<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&);
+template void igl::lbs_matrix_column<Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> >&);
+template void igl::lbs_matrix_column<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::SparseMatrix<double, 0, int>&);
+template void igl::lbs_matrix_column<Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, float>(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::SparseMatrix<float, 0, int>&);
+template void igl::lbs_matrix_column<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&);
+template void igl::lbs_matrix_column<Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> >&);
+#endif
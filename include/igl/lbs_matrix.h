@@ -29,10 +29,11 @@ namespace igl
   //
   // In MATLAB:
   //   kron(ones(1,size(W,2)),[V ones(size(V,1),1)]).*kron(W,ones(1,size(V,2)+1))
+  template <typename DerivedV, typename DerivedW, typename DerivedM>
   IGL_INLINE void lbs_matrix(
-    const Eigen::MatrixXd & V, 
-    const Eigen::MatrixXd & W,
-    Eigen::MatrixXd & M);
+    const Eigen::MatrixBase<DerivedV> & V, 
+    const Eigen::MatrixBase<DerivedW> & W,
+    Eigen::PlainObjectBase<DerivedM> & M);
   // LBS_MATRIX  construct a matrix that when multiplied against a column of
   // affine transformation entries computes new coordinates of the vertices
   //
@@ -51,14 +52,16 @@ namespace igl
   //       reshape(permute(Astack,[3 1 2]),n*dim*(dim+1),1)
   //     or A = [Lxx;Lyx;Lxy;Lyy;tx;ty], and likewise for other dim
   //     if Astack(:,:,i) is the dim by (dim+1) transformation at handle i
+  template <typename DerivedV, typename DerivedW, typename Scalar>
   IGL_INLINE void lbs_matrix_column(
-    const Eigen::MatrixXd & V, 
-    const Eigen::MatrixXd & W,
-    Eigen::SparseMatrix<double>& M);
+    const Eigen::MatrixBase<DerivedV> & V, 
+    const Eigen::MatrixBase<DerivedW> & W,
+    Eigen::SparseMatrix<Scalar>& M);
+  template <typename DerivedV, typename DerivedW, typename DerivedM>
   IGL_INLINE void lbs_matrix_column(
-    const Eigen::MatrixXd & V, 
-    const Eigen::MatrixXd & W,
-    Eigen::MatrixXd & M);
+    const Eigen::MatrixBase<DerivedV> & V, 
+    const Eigen::MatrixBase<DerivedW> & W,
+    Eigen::PlainObjectBase<DerivedM> & M);
   // Same as LBS_MATRIX above but instead of giving W as a full matrix of weights
   // (each vertex has #handles weights), a constant number of weights are given
   // for each vertex.
@@ -77,16 +80,26 @@ namespace igl
   //     or A = [Lxx;Lyx;Lxy;Lyy;tx;ty], and likewise for other dim
   //     if Astack(:,:,i) is the dim by (dim+1) transformation at handle i
   //
+  template <
+    typename DerivedV,
+    typename DerivedW,
+    typename DerivedWI,
+    typename Scalar>
   IGL_INLINE void lbs_matrix_column(
-    const Eigen::MatrixXd & V, 
-    const Eigen::MatrixXd & W,
-    const Eigen::MatrixXi & WI,
-    Eigen::SparseMatrix<double>& M);
+    const Eigen::MatrixBase<DerivedV> & V, 
+    const Eigen::MatrixBase<DerivedW> & W,
+    const Eigen::MatrixBase<DerivedWI> & WI,
+    Eigen::SparseMatrix<Scalar>& M);
+  template <
+    typename DerivedV,
+    typename DerivedW,
+    typename DerivedWI,
+    typename DerivedM>
   IGL_INLINE void lbs_matrix_column(
-    const Eigen::MatrixXd & V, 
-    const Eigen::MatrixXd & W,
-    const Eigen::MatrixXi & WI,
-    Eigen::MatrixXd & M);
+    const Eigen::MatrixBase<DerivedV> & V, 
+    const Eigen::MatrixBase<DerivedW> & W,
+    const Eigen::MatrixBase<DerivedWI> & WI,
+    Eigen::PlainObjectBase<DerivedM> & M);
 }
 #ifndef IGL_STATIC_LIBRARY
 #include "lbs_matrix.cpp"
@@ -9,6 +9,7 @@
 #include "loop.h"
 
 #include <igl/adjacency_list.h>
+#include <igl/subdivide.h>
 #include <igl/triangle_triangle_adjacency.h>
 #include <igl/unique.h>
 
@@ -156,16 +157,12 @@ IGL_INLINE void igl::loop(
   Eigen::PlainObjectBase<DerivedNF>& NF,
   const int number_of_subdivs)
 {
-  NV = V;
-  NF = F;
-  for(int i=0; i<number_of_subdivs; ++i) 
-  {
-    DerivedNF tempF = NF;
-    Eigen::SparseMatrix<typename DerivedV::Scalar> S;
-    loop(NV.rows(), tempF, S, NF);
-    // This .eval is super important
-    NV = (S*NV).eval();
-  }
+  // Topology of each level is derived from the previous one, no
+  // intermediate subdivision matrices
+  subdivide_data<typename DerivedV::Scalar> data;
+  subdivide_precompute(V.rows(),F,SUBDIVISION_TYPE_LOOP,number_of_subdivs,false,data);
+  subdivide(data,V,NV);
+  NF = data.F.template cast<typename DerivedNF::Scalar>();
 }
 
 #ifdef IGL_STATIC_LIBRARY
@@ -13,6 +13,7 @@
 #include "nchoosek.h"
 #include "slice.h"
 #include "polyroots.h"
+#include "parallel_for.h"
 #include "igl_inline.h"
 #include <Eigen/Sparse>
 
@@ -43,29 +44,15 @@ namespace igl {
     DerivedV B1, B2, FN;
 
     IGL_INLINE void computek();
-    IGL_INLINE void setFieldFromGeneralCoefficients(const  std::vector<Eigen::Matrix<std::complex<typename DerivedV::Scalar>, Eigen::Dynamic,1> > &coeffs,
-                                                    std::vector<Eigen::Matrix<typename DerivedV::Scalar, Eigen::Dynamic, 2> > &pv);
     IGL_INLINE void computeCoefficientLaplacian(int n, Eigen::SparseMatrix<std::complex<typename DerivedV::Scalar> > &D);
-    IGL_INLINE void getGeneralCoeffConstraints(const Eigen::VectorXi &isConstrained,
-                                    const Eigen::Matrix<typename DerivedV::Scalar, Eigen::Dynamic, Eigen::Dynamic> &cfW,
-                                    int k,
-                                    Eigen::Matrix<std::complex<typename DerivedV::Scalar>, Eigen::Dynamic,1> &Ck);
     IGL_INLINE void precomputeInteriorEdges();
 
-
-    IGL_INLINE void minQuadWithKnownMini(const Eigen::SparseMatrix<std::complex<typename DerivedV::Scalar> > &Q,
-                                         const Eigen::SparseMatrix<std::complex<typename DerivedV::Scalar> > &f,
-                                         const Eigen::VectorXi isConstrained,
-                                         const Eigen::Matrix<std::complex<typename DerivedV::Scalar>, Eigen::Dynamic, 1> &xknown,
-                                         Eigen::Matrix<std::complex<typename DerivedV::Scalar>, Eigen::Dynamic, 1> &x);
-
   public:
     IGL_INLINE PolyVectorFieldFinder(const Eigen::PlainObjectBase<DerivedV> &_V,
                                      const Eigen::PlainObjectBase<DerivedF> &_F,
                                      const int &_n);
-    IGL_INLINE bool solve(const Eigen::VectorXi &isConstrained,
-               const Eigen::Matrix<typename DerivedV::Scalar, Eigen::Dynamic, Eigen::Dynamic> &cfW,
-               Eigen::Matrix<typename DerivedV::Scalar, Eigen::Dynamic, Eigen::Dynamic> &output);
+    IGL_INLINE bool precompute(const Eigen::VectorXi &b,
+                               NPolyVectorData &data);
 
   };
 }
@@ -130,179 +117,58 @@ precomputeInteriorEdges()
 
 
 template<typename DerivedV, typename DerivedF>
-IGL_INLINE void igl::PolyVectorFieldFinder<DerivedV, DerivedF>::
-minQuadWithKnownMini(const Eigen::SparseMatrix<std::complex<typename DerivedV::Scalar> > &Q,
-                          const Eigen::SparseMatrix<std::complex<typename DerivedV::Scalar> > &f,
-                     const Eigen::VectorXi isConstrained,
-                          const Eigen::Matrix<std::complex<typename DerivedV::Scalar>, Eigen::Dynamic, 1> &xknown,
-                          Eigen::Matrix<std::complex<typename DerivedV::Scalar>, Eigen::Dynamic, 1> &x)
+IGL_INLINE bool igl::PolyVectorFieldFinder<DerivedV, DerivedF>::
+                     precompute(const Eigen::VectorXi &b,
+                                NPolyVectorData &data)
 {
-  int N = Q.rows();
-
-  int nc = xknown.rows();
-  Eigen::VectorXi known; known.setZero(nc,1);
-  Eigen::VectorXi unknown; unknown.setZero(N-nc,1);
-
+  typedef std::complex<typename DerivedV::Scalar> Complex;
+  data.n = n;
+  data.B1 = B1;
+  data.B2 = B2;
+
+  // Constrained faces (later rows of b take precedence) and free faces
+  Eigen::VectorXi row = Eigen::VectorXi::Constant(numF,-1);
+  for (int i = 0; i<b.size(); ++i)
+    row[b[i]] = i;
+  const int nc = (row.array()>=0).count();
+  data.known.resize(nc);
+  data.known_row.resize(nc);
+  data.unknown.resize(numF-nc);
   int indk = 0, indu = 0;
-  for (int i = 0; i<N; ++i)
-    if (isConstrained[i])
+  for (int i = 0; i<numF; ++i)
+    if (row[i]>=0)
     {
-      known[indk] = i;
+      data.known[indk] = i;
+      data.known_row[indk] = row[i];
       indk++;
     }
     else
-    {
-      unknown[indu] = i;
-      indu++;
-    }
-
-  Eigen::SparseMatrix<std::complex<typename DerivedV::Scalar> > Quu, Quk;
-
-  igl::slice(Q,unknown, unknown, Quu);
-  igl::slice(Q,unknown, known, Quk);
-
-
-  std::vector<typename Eigen::Triplet<std::complex<typename DerivedV::Scalar> > > tripletList;
-
-  Eigen::SparseMatrix<std::complex<typename DerivedV::Scalar> > fu(N-nc,1);
-
-  igl::slice(f,unknown, Eigen::VectorXi::Zero(1,1), fu);
-
-  Eigen::SparseMatrix<std::complex<typename DerivedV::Scalar> > rhs = (Quk*xknown).sparseView()+.5*fu;
-
-  Eigen::SparseLU< Eigen::SparseMatrix<std::complex<typename DerivedV::Scalar> > > solver;
-  solver.compute(-Quu);
-  if(solver.info()!=Eigen::Success)
-  {
-    std::cerr<<"Decomposition failed!"<<std::endl;
-    return;
-  }
-  Eigen::SparseMatrix<std::complex<typename DerivedV::Scalar> >  b  = solver.solve(rhs);
-  if(solver.info()!=Eigen::Success)
-  {
-    std::cerr<<"Solving failed!"<<std::endl;
-    return;
-  }
-
-  indk = 0, indu = 0;
-  x.setZero(N,1);
-  for (int i = 0; i<N; ++i)
-    if (isConstrained[i])
-      x[i] = xknown[indk++];
-    else
-      x[i] = b.coeff(indu++,0);
-
-}
-
-
-
-template<typename DerivedV, typename DerivedF>
-IGL_INLINE bool igl::PolyVectorFieldFinder<DerivedV, DerivedF>::
-                     solve(const Eigen::VectorXi &isConstrained,
-                           const Eigen::Matrix<typename DerivedV::Scalar, Eigen::Dynamic, Eigen::Dynamic> &cfW,
-                           Eigen::Matrix<typename DerivedV::Scalar, Eigen::Dynamic, Eigen::Dynamic> &output)
-{
-
-  // polynomial is of the form:
-  // (-1)^0 z^(2n) +
-  // (-1)^1 c[0]z^(2n-2) +
-  // (-1)^2 c[1]z^(2n-4) +
-  // (-1)^3 c[2]z^(2n-6) +
-  // ... +
-  // (-1)^n c[n-1]
-
-  std::vector<Eigen::Matrix<std::complex<typename DerivedV::Scalar>, Eigen::Dynamic,1> > coeffs(n,Eigen::Matrix<std::complex<typename DerivedV::Scalar>, Eigen::Dynamic,1>::Zero(numF, 1));
+      data.unknown[indu++] = i;
 
+  // The coefficient Laplacians are Hermitian positive semi-definite, so the
+  // free-by-free blocks can be factored with a complex LDLT
+  data.Quk.resize(n);
+  data.solver.resize(n);
+  bool success = true;
   for (int i =0; i<n; ++i)
   {
-    int degree = 2*(i+1);
-
-    Eigen::Matrix<std::complex<typename DerivedV::Scalar>, Eigen::Dynamic,1> Ck;
-    getGeneralCoeffConstraints(isConstrained,
-                               cfW,
-                               i,
-                               Ck);
-
-    Eigen::SparseMatrix<std::complex<typename DerivedV::Scalar> > DD;
-    computeCoefficientLaplacian(degree, DD);
-    Eigen::SparseMatrix<std::complex<typename DerivedV::Scalar> > f; f.resize(numF,1);
-
-    minQuadWithKnownMini(DD, f, isConstrained, Ck, coeffs[i]);
-  }
-
-  std::vector<Eigen::Matrix<typename DerivedV::Scalar, Eigen::Dynamic, 2> > pv;
-  setFieldFromGeneralCoefficients(coeffs, pv);
-
-  output.setZero(numF,3*n);
-  for (int fi=0; fi<numF; ++fi)
-  {
-    const Eigen::Matrix<typename DerivedV::Scalar, 1, 3> &b1 = B1.row(fi);
-    const Eigen::Matrix<typename DerivedV::Scalar, 1, 3> &b2 = B2.row(fi);
-    for (int i=0; i<n; ++i)
-      output.block(fi,3*i, 1, 3) = pv[i](fi,0)*b1 + pv[i](fi,1)*b2;
-  }
-  return true;
-}
-
-template<typename DerivedV, typename DerivedF>
-IGL_INLINE void igl::PolyVectorFieldFinder<DerivedV, DerivedF>::setFieldFromGeneralCoefficients(const  std::vector<Eigen::Matrix<std::complex<typename DerivedV::Scalar>, Eigen::Dynamic,1> > &coeffs,
-                                                            std::vector<Eigen::Matrix<typename DerivedV::Scalar, Eigen::Dynamic, 2> > &pv)
-{
-  pv.assign(n, Eigen::Matrix<typename DerivedV::Scalar, Eigen::Dynamic, 2>::Zero(numF, 2));
-  for (int i = 0; i <numF; ++i)
-  {
-
-    //    poly coefficients: 1, 0, -Acoeff, 0, Bcoeff
-    //    matlab code from roots (given there are no trailing zeros in the polynomial coefficients)
-    Eigen::Matrix<std::complex<typename DerivedV::Scalar>, Eigen::Dynamic,1> polyCoeff;
-    polyCoeff.setZero(2*n+1,1);
-    polyCoeff[0] = 1.;
-    int sign = 1;
-    for (int k =0; k<n; ++k)
-    {
-      sign = -sign;
-      int degree = 2*(k+1);
-      polyCoeff[degree] = (1.*sign)*coeffs[k](i);
-    }
-
-    Eigen::Matrix<std::complex<typename DerivedV::Scalar>, Eigen::Dynamic,1> roots;
-    igl::polyRoots<std::complex<typename DerivedV::Scalar>, typename DerivedV::Scalar >(polyCoeff,roots);
-
-    Eigen::VectorXi done; done.setZero(2*n,1);
-
-    Eigen::Matrix<std::complex<typename DerivedV::Scalar>, Eigen::Dynamic,1> u(n,1);
-    int ind =0;
-    for (int k=0; k<2*n; ++k)
-    {
-      if (done[k])
-        continue;
-      u[ind] = roots[k];
-      done[k] = 1;
-
-      int mini = -1;
-      double mind = 1e10;
-      for (int l =k+1; l<2*n; ++l)
-      {
-        double dist = abs(roots[l]+u[ind]);
-        if (dist<mind)
-        {
-          mind = dist;
-          mini = l;
-        }
-      }
-      done[mini] = 1;
-      ind ++;
-    }
-    for (int k=0; k<n; ++k)
+    data.solver[i].reset(new Eigen::SimplicialLDLT<Eigen::SparseMatrix<Complex> >());
+    if (data.unknown.size() == 0)
+      continue;
+    Eigen::SparseMatrix<Complex> DD, Quu;
+    computeCoefficientLaplacian(2*(i+1), DD);
+    igl::slice(DD,data.unknown, data.unknown, Quu);
+    igl::slice(DD,data.unknown, data.known, data.Quk[i]);
+    data.solver[i]->compute(Quu);
+    if(data.solver[i]->info()!=Eigen::Success)
     {
-      pv[k](i,0) = real(u[k]);
-      pv[k](i,1) = imag(u[k]);
+      std::cerr<<"Decomposition failed!"<<std::endl;
+      success = false;
     }
   }
-
+  return success;
 }
 
-
 template<typename DerivedV, typename DerivedF>
 IGL_INLINE void igl::PolyVectorFieldFinder<DerivedV, DerivedF>::computeCoefficientLaplacian(int n, Eigen::SparseMatrix<std::complex<typename DerivedV::Scalar> > &D)
 {
@@ -335,57 +201,6 @@ IGL_INLINE void igl::PolyVectorFieldFinder<DerivedV, DerivedF>::computeCoefficie
   D.setFromTriplets(tripletList.begin(), tripletList.end());
 
 
-}
-
-template<typename DerivedV, typename DerivedF>
-IGL_INLINE void igl::PolyVectorFieldFinder<DerivedV, DerivedF>::getGeneralCoeffConstraints(const Eigen::VectorXi &isConstrained,
-                                                       const Eigen::Matrix<typename DerivedV::Scalar, Eigen::Dynamic, Eigen::Dynamic> &cfW,
-                                                       int k,
-                                                       Eigen::Matrix<std::complex<typename DerivedV::Scalar>, Eigen::Dynamic,1> &Ck)
-{
-  int numConstrained = isConstrained.sum();
-  Ck.resize(numConstrained,1);
-  int n = cfW.cols()/3;
-
-  Eigen::MatrixXi allCombs;
-  {
-    Eigen::VectorXi V = igl::LinSpaced<Eigen::VectorXi >(n,0,n-1);
-    igl::nchoosek(V,k+1,allCombs);
-  }
-
-
-  int ind = 0;
-  for (int fi = 0; fi <numF; ++fi)
-  {
-    const Eigen::Matrix<typename DerivedV::Scalar, 1, 3> &b1 = B1.row(fi);
-    const Eigen::Matrix<typename DerivedV::Scalar, 1, 3> &b2 = B2.row(fi);
-    if(isConstrained[fi])
-    {
-      std::complex<typename DerivedV::Scalar> ck(0);
-
-      for (int j = 0; j < allCombs.rows(); ++j)
-      {
-        std::complex<typename DerivedV::Scalar> tk(1.);
-        //collect products
-        for (int i = 0; i < allCombs.cols(); ++i)
-        {
-          int index = allCombs(j,i);
-
-          const Eigen::Matrix<typename DerivedV::Scalar, 1, 3> &w = cfW.block(fi,3*index,1,3);
-          typename DerivedV::Scalar w0 = w.dot(b1);
-          typename DerivedV::Scalar w1 = w.dot(b2);
-          std::complex<typename DerivedV::Scalar> u(w0,w1);
-          tk*= u*u;
-        }
-        //collect sum
-        ck += tk;
-      }
-      Ck(ind) = ck;
-      ind ++;
-    }
-  }
-
-
 }
 
 template<typename DerivedV, typename DerivedF>
@@ -487,29 +302,185 @@ IGL_INLINE void igl::PolyVectorFieldFinder<DerivedV, DerivedF>::computek()
 }
 
 
-IGL_INLINE void igl::n_polyvector(const Eigen::MatrixXd &V,
-                             const Eigen::MatrixXi &F,
-                             const Eigen::VectorXi& b,
-                             const Eigen::MatrixXd& bc,
-                             Eigen::MatrixXd &output)
+namespace igl
 {
-  Eigen::VectorXi isConstrained = Eigen::VectorXi::Constant(F.rows(),0);
-  Eigen::MatrixXd cfW = Eigen::MatrixXd::Constant(F.rows(),bc.cols(),0);
+  // Value of the kth coefficient of the polynomial at each constrained face
+  IGL_INLINE void n_polyvector_constraint_coefficients(const NPolyVectorData &data,
+                                                       const Eigen::MatrixXd &bc,
+                                                       int k,
+                                                       Eigen::Matrix<std::complex<double>, Eigen::Dynamic,1> &Ck)
+  {
+    const int n = data.n;
+    Ck.resize(data.known.size(),1);
+
+    Eigen::MatrixXi allCombs;
+    {
+      Eigen::VectorXi V = igl::LinSpaced<Eigen::VectorXi >(n,0,n-1);
+      igl::nchoosek(V,k+1,allCombs);
+    }
 
-  for(unsigned i=0; i<b.size();++i)
+    for (int ind = 0; ind <data.known.size(); ++ind)
+    {
+      const int fi = data.known[ind];
+      const Eigen::RowVector3d &b1 = data.B1.row(fi);
+      const Eigen::RowVector3d &b2 = data.B2.row(fi);
+      std::complex<double> ck(0);
+
+      for (int j = 0; j < allCombs.rows(); ++j)
+      {
+        std::complex<double> tk(1.);
+        //collect products
+        for (int i = 0; i < allCombs.cols(); ++i)
+        {
+          int index = allCombs(j,i);
+
+          const Eigen::RowVector3d &w = bc.block(data.known_row[ind],3*index,1,3);
+          double w0 = w.dot(b1);
+          double w1 = w.dot(b2);
+          std::complex<double> u(w0,w1);
+          tk*= u*u;
+        }
+        //collect sum
+        ck += tk;
+      }
+      Ck(ind) = ck;
+    }
+  }
+
+  // Recover the vectors of each face (in the local basis) as the roots of the
+  // polynomial with the given coefficients
+  IGL_INLINE void n_polyvector_field_from_coefficients(const int n,
+                                                       const std::vector<Eigen::Matrix<std::complex<double>, Eigen::Dynamic,1> > &coeffs,
+                                                       std::vector<Eigen::Matrix<double, Eigen::Dynamic, 2> > &pv)
   {
-    isConstrained(b(i)) = 1;
-    cfW.row(b(i)) << bc.row(i);
+    const int numF = coeffs[0].rows();
+    pv.assign(n, Eigen::Matrix<double, Eigen::Dynamic, 2>::Zero(numF, 2));
+    igl::parallel_for(numF,[&](const int i)
+    {
+      //    poly coefficients: 1, 0, -Acoeff, 0, Bcoeff
+      //    matlab code from roots (given there are no trailing zeros in the polynomial coefficients)
+      Eigen::Matrix<std::complex<double>, Eigen::Dynamic,1> polyCoeff;
+      polyCoeff.setZero(2*n+1,1);
+      polyCoeff[0] = 1.;
+      int sign = 1;
+      for (int k =0; k<n; ++k)
+      {
+        sign = -sign;
+        int degree = 2*(k+1);
+        polyCoeff[degree] = (1.*sign)*coeffs[k](i);
+      }
+
+      Eigen::Matrix<std::complex<double>, Eigen::Dynamic,1> roots;
+      igl::polyRoots<std::complex<double>, double >(polyCoeff,roots);
+
+      Eigen::VectorXi done; done.setZero(2*n,1);
+
+      Eigen::Matrix<std::complex<double>, Eigen::Dynamic,1> u(n,1);
+      int ind =0;
+      for (int k=0; k<2*n; ++k)
+      {
+        if (done[k])
+          continue;
+        u[ind] = roots[k];
+        done[k] = 1;
+
+        int mini = -1;
+        double mind = 1e10;
+        for (int l =k+1; l<2*n; ++l)
+        {
+          double dist = abs(roots[l]+u[ind]);
+          if (dist<mind)
+          {
+            mind = dist;
+            mini = l;
+          }
+        }
+        done[mini] = 1;
+        ind ++;
+      }
+      for (int k=0; k<n; ++k)
+      {
+        pv[k](i,0) = real(u[k]);
+        pv[k](i,1) = imag(u[k]);
+      }
+    },1000);
   }
-  if (b.size() == F.rows())
+}
+
+IGL_INLINE bool igl::n_polyvector_precompute(const Eigen::MatrixXd &V,
+                                             const Eigen::MatrixXi &F,
+                                             const Eigen::VectorXi& b,
+                                             const int n,
+                                             NPolyVectorData &data)
+{
+  igl::PolyVectorFieldFinder<Eigen::MatrixXd, Eigen::MatrixXi> pvff(V,F,n);
+  return pvff.precompute(b, data);
+}
+
+IGL_INLINE void igl::n_polyvector_solve(const NPolyVectorData &data,
+                                        const Eigen::MatrixXd& bc,
+                                        Eigen::MatrixXd &output)
+{
+  const int n = data.n;
+  const int numF = data.B1.rows();
+  if (data.unknown.size() == 0)
   {
-    output = cfW;
+    output.setZero(numF,bc.cols());
+    for (int i = 0; i<data.known.size(); ++i)
+      output.row(data.known[i]) = bc.row(data.known_row[i]);
     return;
   }
 
-  int n = cfW.cols()/3;
-  igl::PolyVectorFieldFinder<Eigen::MatrixXd, Eigen::MatrixXi> pvff(V,F,n);
-  pvff.solve(isConstrained, cfW, output);
+  // polynomial is of the form:
+  // (-1)^0 z^(2n) +
+  // (-1)^1 c[0]z^(2n-2) +
+  // (-1)^2 c[1]z^(2n-4) +
+  // (-1)^3 c[2]z^(2n-6) +
+  // ... +
+  // (-1)^n c[n-1]
+  std::vector<Eigen::Matrix<std::complex<double>, Eigen::Dynamic,1> > coeffs(n,Eigen::Matrix<std::complex<double>, Eigen::Dynamic,1>::Zero(numF, 1));
+  for (int i =0; i<n; ++i)
+  {
+    // coefficients stay zero if the factorization failed
+    if(data.solver[i]->info()!=Eigen::Success)
+      continue;
+    Eigen::Matrix<std::complex<double>, Eigen::Dynamic,1> Ck;
+    n_polyvector_constraint_coefficients(data, bc, i, Ck);
+    // minimize x'*Q*x with x(known) = Ck: Quu*x(unknown) = -Quk*Ck
+    const Eigen::Matrix<std::complex<double>, Eigen::Dynamic,1> xu =
+      data.solver[i]->solve(-(data.Quk[i]*Ck));
+    for (int k = 0; k<data.known.size(); ++k)
+      coeffs[i][data.known[k]] = Ck[k];
+    for (int k = 0; k<data.unknown.size(); ++k)
+      coeffs[i][data.unknown[k]] = xu[k];
+  }
+
+  std::vector<Eigen::Matrix<double, Eigen::Dynamic, 2> > pv;
+  n_polyvector_field_from_coefficients(n, coeffs, pv);
+
+  output.setZero(numF,3*n);
+  for (int fi=0; fi<numF; ++fi)
+  {
+    const Eigen::RowVector3d &b1 = data.B1.row(fi);
+    const Eigen::RowVector3d &b2 = data.B2.row(fi);
+    for (int i=0; i<n; ++i)
+      output.block(fi,3*i, 1, 3) = pv[i](fi,0)*b1 + pv[i](fi,1)*b2;
+  }
+}
+
+IGL_INLINE bool igl::n_polyvector(const Eigen::MatrixXd &V,
+                             const Eigen::MatrixXi &F,
+                             const Eigen::VectorXi& b,
+                             const Eigen::MatrixXd& bc,
+                             Eigen::MatrixXd &output)
+{
+  igl::NPolyVectorData data;
+  if(!igl::n_polyvector_precompute(V,F,b,bc.cols()/3,data))
+  {
+    return false;
+  }
+  igl::n_polyvector_solve(data,bc,output);
+  return true;
 }
 
 
@@ -11,6 +11,9 @@
 #include "igl_inline.h"
 
 #include <Eigen/Core>
+#include <Eigen/Sparse>
+#include <complex>
+#include <memory>
 #include <vector>
 
 namespace igl {
@@ -23,13 +26,62 @@ namespace igl {
   // Output:
   //                  3 by 3 rotation matrix that takes v0 to v1
   //
+  // Returns true on success, false if a factorization failed (see
+  // n_polyvector_precompute)
 
-  IGL_INLINE void n_polyvector(const Eigen::MatrixXd& V,
+  IGL_INLINE bool n_polyvector(const Eigen::MatrixXd& V,
                                const Eigen::MatrixXi& F,
                                const Eigen::VectorXi& b,
                                const Eigen::MatrixXd& bc,
                                Eigen::MatrixXd &output);
 
+  // Precomputed data for repeatedly solving for an n-polyvector field with the
+  // same constrained faces but different constraint values
+  struct NPolyVectorData
+  {
+    // number of vectors per face
+    int n;
+    // #F by 3 local bases
+    Eigen::MatrixXd B1, B2;
+    // constrained and free faces (in increasing order) and, for each
+    // constrained face, its row in bc
+    Eigen::VectorXi known, unknown, known_row;
+    // for each of the n coefficients, the free-by-constrained block of the
+    // coefficient Laplacian and the (Hermitian) factorization of the
+    // free-by-free block
+    std::vector<Eigen::SparseMatrix<std::complex<double> > > Quk;
+    std::vector<std::shared_ptr<
+      Eigen::SimplicialLDLT<Eigen::SparseMatrix<std::complex<double> > > > >
+      solver;
+  };
+  // Precompute the factorizations needed by n_polyvector_solve. Only the
+  // constrained faces (not the constraint values) are needed, so that the
+  // constraint values may be changed (e.g., interactively) at the cost of a
+  // back-substitution per solve.
+  //
+  // Inputs:
+  //   V  #V by 3 list of mesh vertex positions
+  //   F  #F by 3 list of mesh triangle indices
+  //   b  #B list of constrained face indices
+  //   n  number of vectors per face
+  // Outputs:
+  //   data  precomputed data
+  // Returns true on success, false if a factorization failed (e.g., if some
+  // connected component has no constrained face)
+  IGL_INLINE bool n_polyvector_precompute(const Eigen::MatrixXd& V,
+                                          const Eigen::MatrixXi& F,
+                                          const Eigen::VectorXi& b,
+                                          const int n,
+                                          NPolyVectorData &data);
+  // Inputs:
+  //   data  precomputed data (see n_polyvector_precompute)
+  //   bc  #B by 3*n list of constraint values, matching b
+  // Outputs:
+  //   output  #F by 3*n list of the n vectors on each face
+  IGL_INLINE void n_polyvector_solve(const NPolyVectorData &data,
+                                     const Eigen::MatrixXd& bc,
+                                     Eigen::MatrixXd &output);
+
 };
 
 
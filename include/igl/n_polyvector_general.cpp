@@ -13,10 +13,11 @@
 #include "nchoosek.h"
 #include "slice.h"
 #include "polyroots.h"
+#include "parallel_for.h"
 #include <Eigen/Sparse>
 #include <Eigen/Geometry>
 #include <iostream>
-#include <iostream>
+#include <complex>
 
 namespace igl {
   template <typename DerivedV, typename DerivedF>
@@ -41,31 +42,15 @@ namespace igl {
     DerivedV B1, B2, FN;
 
     IGL_INLINE void computek();
-    IGL_INLINE void setFieldFromGeneralCoefficients(const  std::vector<Eigen::Matrix<std::complex<typename DerivedV::Scalar>, Eigen::Dynamic,1>> &coeffs,
-                                                    std::vector<Eigen::Matrix<typename DerivedV::Scalar, Eigen::Dynamic, 2> > &pv);
     IGL_INLINE void computeCoefficientLaplacian(int n, Eigen::SparseMatrix<std::complex<typename DerivedV::Scalar> > &D);
-    IGL_INLINE void getGeneralCoeffConstraints(const Eigen::VectorXi &isConstrained,
-                                    const Eigen::Matrix<typename DerivedV::Scalar, Eigen::Dynamic, Eigen::Dynamic> &cfW,
-                                    int k,
-                                    const Eigen::VectorXi &rootsIndex,
-                                    Eigen::Matrix<std::complex<typename DerivedV::Scalar>, Eigen::Dynamic,1> &Ck);
     IGL_INLINE void precomputeInteriorEdges();
 
-
-    IGL_INLINE void minQuadWithKnownMini(const Eigen::SparseMatrix<std::complex<typename DerivedV::Scalar> > &Q,
-                                         const Eigen::SparseMatrix<std::complex<typename DerivedV::Scalar> > &f,
-                                         const Eigen::VectorXi isConstrained,
-                                         const Eigen::Matrix<std::complex<typename DerivedV::Scalar>, Eigen::Dynamic, 1> &xknown,
-                                         Eigen::Matrix<std::complex<typename DerivedV::Scalar>, Eigen::Dynamic, 1> &x);
-
   public:
     IGL_INLINE GeneralPolyVectorFieldFinder(const Eigen::PlainObjectBase<DerivedV> &_V,
                                      const Eigen::PlainObjectBase<DerivedF> &_F,
                                      const int &_n);
-    IGL_INLINE bool solve(const Eigen::VectorXi &isConstrained,
-               const Eigen::Matrix<typename DerivedV::Scalar, Eigen::Dynamic, Eigen::Dynamic> &cfW,
-               const Eigen::VectorXi &rootsIndex,
-               Eigen::Matrix<typename DerivedV::Scalar, Eigen::Dynamic, Eigen::Dynamic> &output);
+    IGL_INLINE bool precompute(const Eigen::VectorXi &b,
+                               NPolyVectorData &data);
 
   };
 }
@@ -130,152 +115,58 @@ precomputeInteriorEdges()
 
 
 template<typename DerivedV, typename DerivedF>
-IGL_INLINE void igl::GeneralPolyVectorFieldFinder<DerivedV, DerivedF>::
-minQuadWithKnownMini(const Eigen::SparseMatrix<std::complex<typename DerivedV::Scalar> > &Q,
-                          const Eigen::SparseMatrix<std::complex<typename DerivedV::Scalar> > &f,
-                     const Eigen::VectorXi isConstrained,
-                          const Eigen::Matrix<std::complex<typename DerivedV::Scalar>, Eigen::Dynamic, 1> &xknown,
-                          Eigen::Matrix<std::complex<typename DerivedV::Scalar>, Eigen::Dynamic, 1> &x)
+IGL_INLINE bool igl::GeneralPolyVectorFieldFinder<DerivedV, DerivedF>::
+                     precompute(const Eigen::VectorXi &b,
+                                NPolyVectorData &data)
 {
-  int N = Q.rows();
-
-  int nc = xknown.rows();
-  Eigen::VectorXi known; known.setZero(nc,1);
-  Eigen::VectorXi unknown; unknown.setZero(N-nc,1);
-
+  typedef std::complex<typename DerivedV::Scalar> Complex;
+  data.n = n;
+  data.B1 = B1;
+  data.B2 = B2;
+
+  // Constrained faces (later rows of b take precedence) and free faces
+  Eigen::VectorXi row = Eigen::VectorXi::Constant(numF,-1);
+  for (int i = 0; i<b.size(); ++i)
+    row[b[i]] = i;
+  const int nc = (row.array()>=0).count();
+  data.known.resize(nc);
+  data.known_row.resize(nc);
+  data.unknown.resize(numF-nc);
   int indk = 0, indu = 0;
-  for (int i = 0; i<N; ++i)
-    if (isConstrained[i])
+  for (int i = 0; i<numF; ++i)
+    if (row[i]>=0)
     {
-      known[indk] = i;
+      data.known[indk] = i;
+      data.known_row[indk] = row[i];
       indk++;
     }
     else
-    {
-      unknown[indu] = i;
-      indu++;
-    }
-
-  Eigen::SparseMatrix<std::complex<typename DerivedV::Scalar>> Quu, Quk;
+      data.unknown[indu++] = i;
 
-  igl::slice(Q,unknown, unknown, Quu);
-  igl::slice(Q,unknown, known, Quk);
-
-
-  std::vector<typename Eigen::Triplet<std::complex<typename DerivedV::Scalar> > > tripletList;
-
-  Eigen::SparseMatrix<std::complex<typename DerivedV::Scalar> > fu(N-nc,1);
-
-  igl::slice(f,unknown, Eigen::VectorXi::Zero(1,1), fu);
-
-  Eigen::SparseMatrix<std::complex<typename DerivedV::Scalar> > rhs = (Quk*xknown).sparseView()+.5*fu;
-
-  Eigen::SparseLU< Eigen::SparseMatrix<std::complex<typename DerivedV::Scalar>>> solver;
-  solver.compute(-Quu);
-  if(solver.info()!=Eigen::Success)
-  {
-    std::cerr<<"Decomposition failed!"<<std::endl;
-    return;
-  }
-  Eigen::SparseMatrix<std::complex<typename DerivedV::Scalar>>  b  = solver.solve(rhs);
-  if(solver.info()!=Eigen::Success)
-  {
-    std::cerr<<"Solving failed!"<<std::endl;
-    return;
-  }
-
-  indk = 0, indu = 0;
-  x.setZero(N,1);
-  for (int i = 0; i<N; ++i)
-    if (isConstrained[i])
-      x[i] = xknown[indk++];
-    else
-      x[i] = b.coeff(indu++,0);
-
-}
-
-
-
-template<typename DerivedV, typename DerivedF>
-IGL_INLINE bool igl::GeneralPolyVectorFieldFinder<DerivedV, DerivedF>::
-                     solve(const Eigen::VectorXi &isConstrained,
-                           const Eigen::Matrix<typename DerivedV::Scalar, Eigen::Dynamic, Eigen::Dynamic> &cfW,
-                           const Eigen::VectorXi &rootsIndex,
-                           Eigen::Matrix<typename DerivedV::Scalar, Eigen::Dynamic, Eigen::Dynamic> &output)
-{
-  // polynomial is of the form:
-  // z^(2n) +
-  // -c[0]z^(2n-1) +
-  // c[1]z^(2n-2) +
-  // -c[2]z^(2n-3) +
-  // ... +
-  // (-1)^n c[n-1]
-  std::vector<Eigen::Matrix<std::complex<typename DerivedV::Scalar>, Eigen::Dynamic,1>> coeffs(n,Eigen::Matrix<std::complex<typename DerivedV::Scalar>, Eigen::Dynamic,1>::Zero(numF, 1));
+  // The coefficient Laplacians are Hermitian positive semi-definite, so the
+  // free-by-free blocks can be factored with a complex LDLT
+  data.Quk.resize(n);
+  data.solver.resize(n);
+  bool success = true;
   for (int i =0; i<n; ++i)
   {
-    int degree = i+1;
-    Eigen::Matrix<std::complex<typename DerivedV::Scalar>, Eigen::Dynamic,1> Ck;
-    getGeneralCoeffConstraints(isConstrained,
-                               cfW,
-                               i,
-                               rootsIndex,
-                               Ck);
-
-    Eigen::SparseMatrix<std::complex<typename DerivedV::Scalar> > DD;
-    computeCoefficientLaplacian(degree, DD);
-    Eigen::SparseMatrix<std::complex<typename DerivedV::Scalar> > f; f.resize(numF,1);
-
-    if (isConstrained.sum() == numF)
-      coeffs[i] = Ck;
-    else
-      minQuadWithKnownMini(DD, f, isConstrained, Ck, coeffs[i]);
-  }
-  std::vector<Eigen::Matrix<typename DerivedV::Scalar, Eigen::Dynamic, 2> > pv;
-  setFieldFromGeneralCoefficients(coeffs, pv);
-  output.setZero(numF,3*n);
-  for (int fi=0; fi<numF; ++fi)
-  {
-    const Eigen::Matrix<typename DerivedV::Scalar, 1, 3> &b1 = B1.row(fi);
-    const Eigen::Matrix<typename DerivedV::Scalar, 1, 3> &b2 = B2.row(fi);
-    for (int i=0; i<n; ++i)
-      output.block(fi,3*i, 1, 3) = pv[i](fi,0)*b1 + pv[i](fi,1)*b2;
-  }
-  return true;
-}
-
-template<typename DerivedV, typename DerivedF>
-IGL_INLINE void igl::GeneralPolyVectorFieldFinder<DerivedV, DerivedF>::setFieldFromGeneralCoefficients(const  std::vector<Eigen::Matrix<std::complex<typename DerivedV::Scalar>, Eigen::Dynamic,1>> &coeffs,
-                                                            std::vector<Eigen::Matrix<typename DerivedV::Scalar, Eigen::Dynamic, 2>> &pv)
-{
-  pv.assign(n, Eigen::Matrix<typename DerivedV::Scalar, Eigen::Dynamic, 2>::Zero(numF, 2));
-  for (int i = 0; i <numF; ++i)
-  {
-
-    //    poly coefficients: 1, 0, -Acoeff, 0, Bcoeff
-    //    matlab code from roots (given there are no trailing zeros in the polynomial coefficients)
-    Eigen::Matrix<std::complex<typename DerivedV::Scalar>, Eigen::Dynamic,1> polyCoeff;
-    polyCoeff.setZero(n+1,1);
-    polyCoeff[0] = 1.;
-    int sign = 1;
-    for (int k =0; k<n; ++k)
-    {
-      sign = -sign;
-      int degree = k+1;
-      polyCoeff[degree] = (1.*sign)*coeffs[k](i);
-    }
-
-    Eigen::Matrix<std::complex<typename DerivedV::Scalar>, Eigen::Dynamic,1> roots;
-    igl::polyRoots<std::complex<typename DerivedV::Scalar>, typename DerivedV::Scalar >(polyCoeff,roots);
-    for (int k=0; k<n; ++k)
+    data.solver[i].reset(new Eigen::SimplicialLDLT<Eigen::SparseMatrix<Complex> >());
+    if (data.unknown.size() == 0)
+      continue;
+    Eigen::SparseMatrix<Complex> DD, Quu;
+    computeCoefficientLaplacian(i+1, DD);
+    igl::slice(DD,data.unknown, data.unknown, Quu);
+    igl::slice(DD,data.unknown, data.known, data.Quk[i]);
+    data.solver[i]->compute(Quu);
+    if(data.solver[i]->info()!=Eigen::Success)
     {
-      pv[k](i,0) = real(roots[k]);
-      pv[k](i,1) = imag(roots[k]);
+      std::cerr<<"Decomposition failed!"<<std::endl;
+      success = false;
     }
   }
-
+  return success;
 }
 
-
 template<typename DerivedV, typename DerivedF>
 IGL_INLINE void igl::GeneralPolyVectorFieldFinder<DerivedV, DerivedF>::computeCoefficientLaplacian(int n, Eigen::SparseMatrix<std::complex<typename DerivedV::Scalar> > &D)
 {
@@ -308,63 +199,6 @@ IGL_INLINE void igl::GeneralPolyVectorFieldFinder<DerivedV, DerivedF>::computeCo
   D.setFromTriplets(tripletList.begin(), tripletList.end());
 
 
-}
-
-//this gives the coefficients without the (-1)^k that multiplies them
-template<typename DerivedV, typename DerivedF>
-IGL_INLINE void igl::GeneralPolyVectorFieldFinder<DerivedV, DerivedF>::getGeneralCoeffConstraints(const Eigen::VectorXi &isConstrained,
-                                                       const Eigen::Matrix<typename DerivedV::Scalar, Eigen::Dynamic, Eigen::Dynamic> &cfW,
-                                                       int k,
-                                                       const Eigen::VectorXi &rootsIndex,
-                                                       Eigen::Matrix<std::complex<typename DerivedV::Scalar>, Eigen::Dynamic,1> &Ck)
-{
-  int numConstrained = isConstrained.sum();
-  Ck.resize(numConstrained,1);
-  // int n = rootsIndex.cols();
-
-  Eigen::MatrixXi allCombs;
-  {
-    Eigen::VectorXi V = igl::LinSpaced<Eigen::VectorXi >(n,0,n-1);
-    igl::nchoosek(V,k+1,allCombs);
-  }
-
-  int ind = 0;
-  for (int fi = 0; fi <numF; ++fi)
-  {
-    const Eigen::Matrix<typename DerivedV::Scalar, 1, 3> &b1 = B1.row(fi);
-    const Eigen::Matrix<typename DerivedV::Scalar, 1, 3> &b2 = B2.row(fi);
-    if(isConstrained[fi])
-    {
-      std::complex<typename DerivedV::Scalar> ck(0);
-
-      for (int j = 0; j < allCombs.rows(); ++j)
-      {
-        std::complex<typename DerivedV::Scalar> tk(1.);
-        //collect products
-        for (int i = 0; i < allCombs.cols(); ++i)
-        {
-          int index = allCombs(j,i);
-
-          int ri = rootsIndex[index];
-          Eigen::Matrix<typename DerivedV::Scalar, 1, 3> w;
-          if (ri>0)
-            w = cfW.block(fi,3*(ri-1),1,3);
-          else
-            w = -cfW.block(fi,3*(-ri-1),1,3);
-          typename DerivedV::Scalar w0 = w.dot(b1);
-          typename DerivedV::Scalar w1 = w.dot(b2);
-          std::complex<typename DerivedV::Scalar> u(w0,w1);
-          tk*= u;
-        }
-        //collect sum
-        ck += tk;
-      }
-      Ck(ind) = ck;
-      ind ++;
-    }
-  }
-
-
 }
 
 template<typename DerivedV, typename DerivedF>
@@ -466,24 +300,161 @@ IGL_INLINE void igl::GeneralPolyVectorFieldFinder<DerivedV, DerivedF>::computek(
 }
 
 
-IGL_INLINE void igl::n_polyvector_general(const Eigen::MatrixXd &V,
+namespace igl
+{
+  // Value of the kth coefficient of the polynomial at each constrained face
+  // (without the (-1)^k that multiplies it)
+  IGL_INLINE void n_polyvector_general_constraint_coefficients(const NPolyVectorData &data,
+                                                               const Eigen::MatrixXd &bc,
+                                                               const Eigen::VectorXi &rootsIndex,
+                                                               int k,
+                                                               Eigen::Matrix<std::complex<double>, Eigen::Dynamic,1> &Ck)
+  {
+    const int n = data.n;
+    Ck.resize(data.known.size(),1);
+
+    Eigen::MatrixXi allCombs;
+    {
+      Eigen::VectorXi V = igl::LinSpaced<Eigen::VectorXi >(n,0,n-1);
+      igl::nchoosek(V,k+1,allCombs);
+    }
+
+    for (int ind = 0; ind <data.known.size(); ++ind)
+    {
+      const int fi = data.known[ind];
+      const Eigen::RowVector3d &b1 = data.B1.row(fi);
+      const Eigen::RowVector3d &b2 = data.B2.row(fi);
+      std::complex<double> ck(0);
+
+      for (int j = 0; j < allCombs.rows(); ++j)
+      {
+        std::complex<double> tk(1.);
+        //collect products
+        for (int i = 0; i < allCombs.cols(); ++i)
+        {
+          int index = allCombs(j,i);
+
+          int ri = rootsIndex[index];
+          Eigen::RowVector3d w;
+          if (ri>0)
+            w = bc.block(data.known_row[ind],3*(ri-1),1,3);
+          else
+            w = -bc.block(data.known_row[ind],3*(-ri-1),1,3);
+          double w0 = w.dot(b1);
+          double w1 = w.dot(b2);
+          std::complex<double> u(w0,w1);
+          tk*= u;
+        }
+        //collect sum
+        ck += tk;
+      }
+      Ck(ind) = ck;
+    }
+  }
+
+  // Recover the vectors of each face (in the local basis) as the roots of the
+  // polynomial with the given coefficients
+  IGL_INLINE void n_polyvector_general_field_from_coefficients(const int n,
+                                                               const std::vector<Eigen::Matrix<std::complex<double>, Eigen::Dynamic,1> > &coeffs,
+                                                               std::vector<Eigen::Matrix<double, Eigen::Dynamic, 2> > &pv)
+  {
+    const int numF = coeffs[0].rows();
+    pv.assign(n, Eigen::Matrix<double, Eigen::Dynamic, 2>::Zero(numF, 2));
+    igl::parallel_for(numF,[&](const int i)
+    {
+      //    poly coefficients: 1, 0, -Acoeff, 0, Bcoeff
+      //    matlab code from roots (given there are no trailing zeros in the polynomial coefficients)
+      Eigen::Matrix<std::complex<double>, Eigen::Dynamic,1> polyCoeff;
+      polyCoeff.setZero(n+1,1);
+      polyCoeff[0] = 1.;
+      int sign = 1;
+      for (int k =0; k<n; ++k)
+      {
+        sign = -sign;
+        int degree = k+1;
+        polyCoeff[degree] = (1.*sign)*coeffs[k](i);
+      }
+
+      Eigen::Matrix<std::complex<double>, Eigen::Dynamic,1> roots;
+      igl::polyRoots<std::complex<double>, double >(polyCoeff,roots);
+      for (int k=0; k<n; ++k)
+      {
+        pv[k](i,0) = real(roots[k]);
+        pv[k](i,1) = imag(roots[k]);
+      }
+    },1000);
+  }
+}
+
+IGL_INLINE bool igl::n_polyvector_general_precompute(const Eigen::MatrixXd &V,
+                                                     const Eigen::MatrixXi &F,
+                                                     const Eigen::VectorXi& b,
+                                                     const int n,
+                                                     NPolyVectorData &data)
+{
+  igl::GeneralPolyVectorFieldFinder<Eigen::MatrixXd, Eigen::MatrixXi> pvff(V,F,n);
+  return pvff.precompute(b, data);
+}
+
+IGL_INLINE void igl::n_polyvector_general_solve(const NPolyVectorData &data,
+                                                const Eigen::MatrixXd& bc,
+                                                const Eigen::VectorXi &I,
+                                                Eigen::MatrixXd &output)
+{
+  const int n = data.n;
+  const int numF = data.B1.rows();
+
+  // polynomial is of the form:
+  // z^(2n) +
+  // -c[0]z^(2n-1) +
+  // c[1]z^(2n-2) +
+  // -c[2]z^(2n-3) +
+  // ... +
+  // (-1)^n c[n-1]
+  std::vector<Eigen::Matrix<std::complex<double>, Eigen::Dynamic,1> > coeffs(n,Eigen::Matrix<std::complex<double>, Eigen::Dynamic,1>::Zero(numF, 1));
+  for (int i =0; i<n; ++i)
+  {
+    Eigen::Matrix<std::complex<double>, Eigen::Dynamic,1> Ck;
+    n_polyvector_general_constraint_coefficients(data, bc, I, i, Ck);
+    for (int k = 0; k<data.known.size(); ++k)
+      coeffs[i][data.known[k]] = Ck[k];
+    // free coefficients stay zero if the factorization failed
+    if (data.unknown.size() == 0 || data.solver[i]->info()!=Eigen::Success)
+      continue;
+    // minimize x'*Q*x with x(known) = Ck: Quu*x(unknown) = -Quk*Ck
+    const Eigen::Matrix<std::complex<double>, Eigen::Dynamic,1> xu =
+      data.solver[i]->solve(-(data.Quk[i]*Ck));
+    for (int k = 0; k<data.unknown.size(); ++k)
+      coeffs[i][data.unknown[k]] = xu[k];
+  }
+
+  std::vector<Eigen::Matrix<double, Eigen::Dynamic, 2> > pv;
+  n_polyvector_general_field_from_coefficients(n, coeffs, pv);
+
+  output.setZero(numF,3*n);
+  for (int fi=0; fi<numF; ++fi)
+  {
+    const Eigen::RowVector3d &b1 = data.B1.row(fi);
+    const Eigen::RowVector3d &b2 = data.B2.row(fi);
+    for (int i=0; i<n; ++i)
+      output.block(fi,3*i, 1, 3) = pv[i](fi,0)*b1 + pv[i](fi,1)*b2;
+  }
+}
+
+IGL_INLINE bool igl::n_polyvector_general(const Eigen::MatrixXd &V,
                              const Eigen::MatrixXi &F,
                              const Eigen::VectorXi& b,
                              const Eigen::MatrixXd& bc,
                              const Eigen::VectorXi &I,
                              Eigen::MatrixXd &output)
 {
-  Eigen::VectorXi isConstrained = Eigen::VectorXi::Constant(F.rows(),0);
-  Eigen::MatrixXd cfW = Eigen::MatrixXd::Constant(F.rows(),bc.cols(),0);
-
-  for(unsigned i=0; i<b.size();++i)
+  igl::NPolyVectorData data;
+  if(!igl::n_polyvector_general_precompute(V,F,b,I.rows(),data))
   {
-    isConstrained(b(i)) = 1;
-    cfW.row(b(i)) << bc.row(i);
+    return false;
   }
-  int n = I.rows();
-  igl::GeneralPolyVectorFieldFinder<Eigen::MatrixXd, Eigen::MatrixXi> pvff(V,F,n);
-  pvff.solve(isConstrained, cfW, I, output);
+  igl::n_polyvector_general_solve(data,bc,I,output);
+  return true;
 }
 
 
@@ -9,6 +9,7 @@
 #ifndef IGL_N_POLYVECTOR_GENERAL
 #define IGL_N_POLYVECTOR_GENERAL
 #include "igl_inline.h"
+#include "n_polyvector.h"
 
 #include <Eigen/Core>
 
@@ -22,14 +23,44 @@ namespace igl {
   // Output:
   //                  3 by 3 rotation matrix that takes v0 to v1
   //
+  // Returns true on success, false if a factorization failed (see
+  // n_polyvector_general_precompute)
 
-  IGL_INLINE void n_polyvector_general(const Eigen::MatrixXd& V,
+  IGL_INLINE bool n_polyvector_general(const Eigen::MatrixXd& V,
                                const Eigen::MatrixXi& F,
                                const Eigen::VectorXi& b,
                                const Eigen::MatrixXd& bc,
                                const Eigen::VectorXi &I,
                                Eigen::MatrixXd &output);
 
+  // Precompute the factorizations needed by n_polyvector_general_solve. Only
+  // the constrained faces (not the constraint values) are needed.
+  //
+  // Inputs:
+  //   V  #V by 3 list of mesh vertex positions
+  //   F  #F by 3 list of mesh triangle indices
+  //   b  #B list of constrained face indices
+  //   n  number of vectors per face
+  // Outputs:
+  //   data  precomputed data (same as for n_polyvector_solve)
+  // Returns true on success, false if a factorization failed (e.g., if some
+  // connected component has no constrained face)
+  IGL_INLINE bool n_polyvector_general_precompute(const Eigen::MatrixXd& V,
+                                                  const Eigen::MatrixXi& F,
+                                                  const Eigen::VectorXi& b,
+                                                  const int n,
+                                                  NPolyVectorData &data);
+  // Inputs:
+  //   data  precomputed data (see n_polyvector_general_precompute)
+  //   bc  #B by 3*m list of constraint values, matching b
+  //   I  n list of (1-based, signed) indices into the m vectors of bc
+  // Outputs:
+  //   output  #F by 3*n list of the n vectors on each face
+  IGL_INLINE void n_polyvector_general_solve(const NPolyVectorData &data,
+                                             const Eigen::MatrixXd& bc,
+                                             const Eigen::VectorXi &I,
+                                             Eigen::MatrixXd &output);
+
 };
 
 
@@ -9,6 +9,7 @@
 #include "per_face_normals.h"
 #include "barycenter.h"
 #include "doublearea.h"
+#include "parallel_for.h"
 #include <iostream>
 
 template <
@@ -79,13 +80,13 @@ IGL_INLINE void igl::orient_outward(
     }
   }
   // flip according to I
-  for(int f = 0;f<m;f++)
+  parallel_for(m,[&](const int f)
   {
     if(I(C(f)))
     {
       FF.row(f) = FF.row(f).reverse().eval();
     }
-  }
+  },1000);
 }
 
 #ifdef IGL_STATIC_LIBRARY
@@ -9,6 +9,9 @@
 #include "components.h"
 #include "sort.h"
 #include "unique_rows.h"
+#include "UnionFind.h"
+#include "parallel_for.h"
+#include "vertex_triangle_adjacency.h"
 #include <vector>
 #include <iostream>
 
@@ -89,17 +92,95 @@ IGL_INLINE void igl::orientable_patches(
 
 }
 
+template <typename DerivedF, typename DerivedC, typename DerivedI>
+IGL_INLINE void igl::orientable_patches(
+  const Eigen::PlainObjectBase<DerivedF> & F,
+  Eigen::PlainObjectBase<DerivedC> & C,
+  Eigen::PlainObjectBase<DerivedI> & I)
+{
+  assert(F.cols() == 3);
+  const int m = F.rows();
+  // Rows of a row-major copy are contiguous in memory
+  const Eigen::Matrix<int,Eigen::Dynamic,3,Eigen::RowMajor> RF =
+    F.template cast<int>();
+  Eigen::VectorXi VF,NI;
+  vertex_triangle_adjacency(RF,m == 0 ? 0 : RF.maxCoeff()+1,VF,NI);
+  // Parity of a face relative to the root of its patch tells whether it
+  // must be reversed
+  UnionFind U(m);
+  parallel_for(m,[&](const int f)
+  {
+    for(int c = 0;c<3;c++)
+    {
+      // Half-edge i-->j of face f
+      const int i = RF(f,(c+1)%3);
+      const int j = RF(f,(c+2)%3);
+      // Other faces on the edge {i,j}
+      int num_other = 0;
+      int other = -1;
+      bool same_direction = false;
+      for(int k = NI(i);k<NI(i+1);k++)
+      {
+        const int g = VF(k);
+        // VF is sorted so repeated faces (degenerate) are consecutive
+        if(g == f || (k > NI(i) && VF(k-1) == g))
+        {
+          continue;
+        }
+        bool incident = false;
+        bool same = false;
+        for(int d = 0;d<3;d++)
+        {
+          const int a = RF(g,(d+1)%3);
+          const int b = RF(g,(d+2)%3);
+          if(a == i && b == j)
+          {
+            incident = same = true;
+          }else if(a == j && b == i)
+          {
+            incident = true;
+          }
+        }
+        if(incident)
+        {
+          num_other++;
+          other = g;
+          same_direction = same;
+        }
+      }
+      // Only manifold edges connect patches. Each edge is seen from both
+      // sides: merge once.
+      if(num_other == 1 && other < f)
+      {
+        U.unite(f,other,same_direction);
+      }
+    }
+  },1000);
+  Eigen::VectorXi IC,counts;
+  U.labels(IC,counts);
+  C.resize(m,1);
+  C.array() = IC.array().cast<typename DerivedC::Scalar>();
+  I.resize(m,1);
+  parallel_for(m,[&](const int f)
+  {
+    bool parity;
+    U.find(f,parity);
+    I(f) = parity;
+  },1000);
+}
+
 template <typename DerivedF, typename DerivedC>
 IGL_INLINE void igl::orientable_patches(
   const Eigen::PlainObjectBase<DerivedF> & F,
   Eigen::PlainObjectBase<DerivedC> & C)
 {
-  Eigen::SparseMatrix<typename DerivedF::Scalar> A;
-  return orientable_patches(F,C,A);
+  Eigen::VectorXi I;
+  return orientable_patches(F,C,I);
 }
 
 #ifdef IGL_STATIC_LIBRARY
 // Explicit template instantiation
 template void igl::orientable_patches<Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, int>(Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::SparseMatrix<int, 0, int>&);
+template void igl::orientable_patches<Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
 template void igl::orientable_patches<Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&);
 #endif
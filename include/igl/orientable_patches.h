@@ -30,6 +30,20 @@ namespace igl
     const Eigen::PlainObjectBase<DerivedF> & F,
     Eigen::PlainObjectBase<DerivedC> & C,
     Eigen::SparseMatrix<AScalar> & A);
+  // Ditto, but instead of the adjacency matrix output the relative
+  // orientation of the faces of each patch. Patches are merged in parallel
+  // (see igl::UnionFind) directly from the faces incident on each vertex, so
+  // this is much faster than building A.
+  //
+  //  Outputs:
+  //    I  #F list of whether each face must be reversed to agree with the
+  //      orientation of the first face of its patch (only meaningful if the
+  //      patch is orientable)
+  template <typename DerivedF, typename DerivedC, typename DerivedI>
+  IGL_INLINE void orientable_patches(
+    const Eigen::PlainObjectBase<DerivedF> & F,
+    Eigen::PlainObjectBase<DerivedC> & C,
+    Eigen::PlainObjectBase<DerivedI> & I);
   template <typename DerivedF, typename DerivedC>
   IGL_INLINE void orientable_patches(
     const Eigen::PlainObjectBase<DerivedF> & F,
@@ -8,6 +8,7 @@
 #ifndef IGL_PARALLEL_FOR_H
 #define IGL_PARALLEL_FOR_H
 #include "igl_inline.h"
+#include <cstddef>
 #include <functional>
 
 //#warning "Defining IGL_PARALLEL_FOR_FORCE_SERIAL"
@@ -26,8 +27,9 @@ namespace igl
   //     }
   //
   // then `parallel_for(loop_size,func,min_parallel)` will use as many threads as
-  // available on the current hardware to parallelize this for loop so long as
-  // loop_size<min_parallel, otherwise it will just use a serial for loop.
+  // available on the current hardware (see igl::default_num_threads) to
+  // parallelize this for loop so long as loop_size<min_parallel, otherwise it
+  // will just use a serial for loop.
   //
   // Inputs:
   //   loop_size  number of iterations. I.e. for(int i = 0;i<loop_size;i++) ...
@@ -91,6 +93,7 @@ namespace igl
 
 #include <cmath>
 #include <cassert>
+#include "default_num_threads.h"
 #include <thread>
 #include <vector>
 #include <algorithm>
@@ -123,14 +126,12 @@ inline bool igl::parallel_for(
 {
   assert(loop_size>=0);
   if(loop_size==0) return false;
-  // Estimate number of threads in the pool
-  // http://ideone.com/Z7zldb
-  const static size_t sthc = std::thread::hardware_concurrency();
+  // Number of threads in the pool
   const size_t nthreads = 
 #ifdef IGL_PARALLEL_FOR_FORCE_SERIAL
     0;
 #else
-    loop_size<min_parallel?0:(sthc==0?8:sthc);
+    loop_size<min_parallel?0:default_num_threads();
 #endif
   if(nthreads==0)
   {
@@ -6,7 +6,9 @@
 // v. 2.0. If a copy of the MPL was not distributed with this file, You can
 // obtain one at http://mozilla.org/MPL/2.0/.
 #include "per_face_normals.h"
+#include "parallel_for.h"
 #include <Eigen/Geometry>
+#include <vector>
 
 #define SQRT_ONE_OVER_THREE 0.57735026918962573
 template <typename DerivedV, typename DerivedF, typename DerivedZ, typename DerivedN>
@@ -47,6 +49,29 @@ IGL_INLINE void igl::per_face_normals(
   return per_face_normals(V,F,Z,N);
 }
 
+template <typename DerivedN>
+IGL_INLINE void igl::per_face_normals(
+  const CompressedMesh & C,
+  Eigen::PlainObjectBase<DerivedN> & N)
+{
+  typedef Eigen::Matrix<typename DerivedN::Scalar,1,3> RowVectorN3;
+  N.resize(C.num_faces,3);
+  parallel_for(C.num_blocks(),[&](const int b)
+  {
+    std::vector<int> Fb(3*C.block_rows(b));
+    C.decode_block(b,Fb.data());
+    for(int k = 0;k<C.block_rows(b);k++)
+    {
+      const Eigen::RowVector3d p0 = C.position(Fb[3*k+0]);
+      const Eigen::RowVector3d n =
+        (C.position(Fb[3*k+1])-p0).cross(C.position(Fb[3*k+2])-p0);
+      const double r = n.norm();
+      N.row(b*C.block_size+k) = r == 0 ?
+        RowVectorN3::Zero() : RowVectorN3((n/r).cast<typename DerivedN::Scalar>());
+    }
+  },4);
+}
+
 template <typename DerivedV, typename DerivedF, typename DerivedN>
 IGL_INLINE void igl::per_face_normals_stable(
   const Eigen::MatrixBase<DerivedV>& V,
@@ -106,6 +131,8 @@ IGL_INLINE void igl::per_face_normals_stable(
 #ifdef IGL_STATIC_LIBRARY
 // Explicit template instantiation
 // generated by autoexplicit.sh
+template void igl::per_face_normals<Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, 3, 0, -1, 3> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, 3, 0, -1, 3> >&);
+template void igl::per_face_normals<Eigen::Matrix<double, -1, -1, 0, -1, -1> >(igl::CompressedMesh const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&);
 template void igl::per_face_normals<Eigen::Matrix<float, -1, 3, 0, -1, 3>, Eigen::Matrix<int, -1, 3, 0, -1, 3>, Eigen::Matrix<float, -1, 3, 0, -1, 3> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, 3, 0, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 3, 0, -1, 3> > const&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, 3, 0, -1, 3> >&);
 // generated by autoexplicit.sh
 template void igl::per_face_normals<Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> >&);
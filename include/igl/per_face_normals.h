@@ -8,6 +8,7 @@
 #ifndef IGL_PER_FACE_NORMALS_H
 #define IGL_PER_FACE_NORMALS_H
 #include "igl_inline.h"
+#include "CompressedMesh.h"
 #include <Eigen/Core>
 namespace igl
 {
@@ -35,6 +36,17 @@ namespace igl
     const Eigen::MatrixBase<DerivedV>& V,
     const Eigen::MatrixBase<DerivedF>& F,
     Eigen::PlainObjectBase<DerivedN> & N);
+  // Compressed mesh version: faces are decoded block by block (in parallel)
+  // without decompressing the whole mesh (see igl::compress_mesh).
+  //
+  // Inputs:
+  //   C  compressed mesh
+  // Outputs:
+  //   N  C.num_faces by 3 list of face normals (zero for degenerate faces)
+  template <typename DerivedN>
+  IGL_INLINE void per_face_normals(
+    const CompressedMesh & C,
+    Eigen::PlainObjectBase<DerivedN> & N);
   // Special version where order of face indices is guaranteed not to effect
   // output.
   template <typename DerivedV, typename DerivedF, typename DerivedN>
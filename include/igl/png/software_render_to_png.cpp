@@ -0,0 +1,42 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+// 
+// Copyright (C) 2026 agent <agent@local>
+// 
+// This Source Code Form is subject to the terms of the Mozilla Public License 
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can 
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "software_render_to_png.h"
+#include "writePNG.h"
+#include "../software_render.h"
+
+IGL_INLINE bool igl::png::software_render_to_png(
+  const std::string png_file,
+  const int width,
+  const int height,
+  const Eigen::MatrixXd & V,
+  const Eigen::MatrixXi & F,
+  const Eigen::MatrixXd & N,
+  const Eigen::MatrixXd & Ka,
+  const Eigen::MatrixXd & Kd,
+  const Eigen::MatrixXd & Ks,
+  const Eigen::MatrixXd & lines,
+  const Eigen::MatrixXd & points,
+  const Eigen::Matrix4f & view,
+  const Eigen::Matrix4f & proj,
+  const igl::software_render_params & params,
+  const bool alpha)
+{
+  Eigen::Matrix<unsigned char,Eigen::Dynamic,Eigen::Dynamic> 
+    R(width,height), G(width,height), B(width,height), A(width,height);
+  igl::software_render(
+    V,F,N,Ka,Kd,Ks,lines,points,view,proj,params,R,G,B,A);
+  if(!alpha)
+  {
+    A.setConstant(255);
+  }
+  return igl::png::writePNG(R,G,B,A,png_file);
+}
+
+#ifdef IGL_STATIC_LIBRARY
+// Explicit template instantiation
+#endif
@@ -0,0 +1,56 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+// 
+// Copyright (C) 2026 agent <agent@local>
+// 
+// This Source Code Form is subject to the terms of the Mozilla Public License 
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can 
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_PNG_SOFTWARE_RENDER_TO_PNG_H
+#define IGL_PNG_SOFTWARE_RENDER_TO_PNG_H
+#include <igl/igl_inline.h>
+#include <igl/software_render.h>
+#include <Eigen/Core>
+
+#include <string>
+namespace igl
+{
+  namespace png
+  {
+    // Render a mesh with overlays to .png file with igl::software_render
+    // (without OpenGL)
+    //
+    // Inputs:
+    //   png_file  path to output .png file
+    //   width  width of resulting image
+    //   height height of resulting image
+    //   V,F,N,Ka,Kd,Ks,lines,points,view,proj,params  see
+    //     igl::software_render
+    //   alpha  whether to include alpha channel (otherwise background is
+    //     opaque params.background_color)
+    // Returns true only if no errors occured
+    //
+    // See also: igl/software_render, igl/png/render_to_png
+    IGL_INLINE bool software_render_to_png(
+      const std::string png_file,
+      const int width,
+      const int height,
+      const Eigen::MatrixXd & V,
+      const Eigen::MatrixXi & F,
+      const Eigen::MatrixXd & N,
+      const Eigen::MatrixXd & Ka,
+      const Eigen::MatrixXd & Kd,
+      const Eigen::MatrixXd & Ks,
+      const Eigen::MatrixXd & lines,
+      const Eigen::MatrixXd & points,
+      const Eigen::Matrix4f & view,
+      const Eigen::Matrix4f & proj,
+      const igl::software_render_params & params,
+      const bool alpha = true);
+  }
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "software_render_to_png.cpp"
+#endif
+
+#endif
@@ -6,19 +6,19 @@
 // v. 2.0. If a copy of the MPL was not distributed with this file, You can
 // obtain one at http://mozilla.org/MPL/2.0/.
 #include "principal_curvature.h"
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
-#include <queue>
-#include <list>
 #include <cmath>
 #include <limits>
+#include <utility>
 
 #include <Eigen/SparseCholesky>
 
 // Lib IGL includes
-#include <igl/adjacency_list.h>
+#include <igl/parallel_for.h>
 #include <igl/per_face_normals.h>
 #include <igl/per_vertex_normals.h>
 #include <igl/avg_edge_length.h>
@@ -39,14 +39,15 @@ typedef enum
 class CurvatureCalculator
 {
 public:
-  /* Row number i represents the i-th vertex, whose columns are:
-   curv[i][0] : K2
-   curv[i][1] : K1
-   curvDir[i][0] : PD1
-   curvDir[i][1] : PD2
+  /* Row number k represents the k-th computed vertex (the k-th entry of the
+   list passed to computeCurvature), whose columns are:
+   curv(k,0) : K2
+   curv(k,1) : K1
+   curvDir[0].row(k) : PD1
+   curvDir[1].row(k) : PD2
    */
-  std::vector< std::vector<double> > curv;
-  std::vector< std::vector<Eigen::Vector3d> > curvDir;
+  Eigen::MatrixXd curv;
+  Eigen::MatrixXd curvDir[2];
   bool curvatureComputed;
   class Quadric
   {
@@ -105,7 +106,7 @@ public:
     }
 
 
-    IGL_INLINE static Quadric fit(std::vector<Eigen::Vector3d> &VV, bool zeroDetCheck, bool svd)
+    IGL_INLINE static Quadric fit(const std::vector<Eigen::Vector3d> &VV, bool zeroDetCheck, bool svd)
     {
       using namespace std;
       assert(VV.size() >= 5);
@@ -115,28 +116,53 @@ public:
         exit(0);
       }
 
-      Eigen::MatrixXd A(VV.size(),5);
-      Eigen::MatrixXd b(VV.size(),1);
-      Eigen::MatrixXd sol(5,1);
-
+      // Least squares fit via the 5x5 normal equations, so that the solve is
+      // a fixed size (allocation free) problem regardless of the size of the
+      // neighbourhood. Coordinates are first scaled to [-1,1] to keep the
+      // normal equations well conditioned.
+      double s = 0;
       for(unsigned int c=0; c < VV.size(); ++c)
       {
-        double u = VV[c][0];
-        double v = VV[c][1];
-        double n = VV[c][2];
-
-        A(c,0) = u*u;
-        A(c,1) = u*v;
-        A(c,2) = v*v;
-        A(c,3) = u;
-        A(c,4) = v;
-
-        b(c) = n;
+        s = std::max(s,std::max(std::abs(VV[c][0]),std::abs(VV[c][1])));
+      }
+      if (s == 0)
+      {
+        s = 1;
+      }
+      typedef Eigen::Matrix<double,5,5> Matrix5d;
+      typedef Eigen::Matrix<double,5,1> Vector5d;
+      Matrix5d AtA = Matrix5d::Zero();
+      Vector5d Atb = Vector5d::Zero();
+      for(unsigned int c=0; c < VV.size(); ++c)
+      {
+        double u = VV[c][0]/s;
+        double v = VV[c][1]/s;
+        double n = VV[c][2]/s;
+
+        Vector5d A;
+        A << u*u, u*v, v*v, u, v;
+        AtA.selfadjointView<Eigen::Lower>().rankUpdate(A);
+        Atb += n*A;
       }
+      AtA.triangularView<Eigen::StrictlyUpper>() = AtA.transpose();
 
-      sol=A.jacobiSvd(Eigen::ComputeThinU | Eigen::ComputeThinV).solve(b);
+      Vector5d sol;
+      Eigen::LDLT<Matrix5d> ldlt(AtA);
+      const double dmax = ldlt.vectorD().cwiseAbs().maxCoeff();
+      if (ldlt.info() == Eigen::Success &&
+        ldlt.vectorD().minCoeff() > 1e-10*dmax)
+      {
+        sol = ldlt.solve(Atb);
+      }
+      else
+      {
+        // Rank deficient neighbourhood (e.g., collinear samples): minimum
+        // norm solution
+        sol = AtA.jacobiSvd(Eigen::ComputeFullU | Eigen::ComputeFullV).solve(Atb);
+      }
 
-      return Quadric(sol(0),sol(1),sol(2),sol(3),sol(4));
+      // Undo scaling: n = s*n', u = s*u', v = s*v'
+      return Quadric(sol(0)/s,sol(1)/s,sol(2)/s,sol(3),sol(4));
     }
   };
 
@@ -147,7 +173,11 @@ public:
   // The i-th row contains the indices of the vertices that forms the i-th face in ccw order
   Eigen::MatrixXi faces;
 
-  std::vector<std::vector<int> > vertex_to_vertices;
+  // Vertex-vertex adjacency in compressed sparse row form: the neighbours of
+  // vertex i are vertex_to_vertices[vertex_to_vertices_offsets[i]] through
+  // vertex_to_vertices[vertex_to_vertices_offsets[i+1]-1] (sorted)
+  std::vector<int> vertex_to_vertices_offsets;
+  std::vector<int> vertex_to_vertices;
   std::vector<std::vector<int> > vertex_to_faces;
   std::vector<std::vector<int> > vertex_to_faces_index;
   Eigen::MatrixXd face_normals;
@@ -176,20 +206,47 @@ public:
   int step;  /* If expStep==false, by how much rhe radius increases on every step */
   int maxSize; /* The maximum limit of the radius in the benchmark */
 
+  // Per-thread workspace, reused across vertices so that gathering a
+  // neighbourhood costs time proportional to its size rather than to #V
+  struct Scratch
+  {
+    // visited[v] is true iff v was reached by the current search, all false
+    // in between searches
+    std::vector<char> visited;
+    // vertices marked in visited during the current search
+    std::vector<int> touched;
+    std::vector<std::pair<int,int> > queue;
+    std::vector<std::pair<int,double> > extra_candidates;
+    std::vector<int> vv;
+    std::vector<int> vvtmp;
+    std::vector<Eigen::Vector3d> points;
+    // number of vertices for which curvature could not be computed
+    int failed;
+  };
+
   IGL_INLINE CurvatureCalculator();
   IGL_INLINE void init(const Eigen::MatrixXd& V, const Eigen::MatrixXi& F);
 
-  IGL_INLINE void finalEigenStuff (int, std::vector<Eigen::Vector3d>, Quadric );
-  IGL_INLINE void fitQuadric (Eigen::Vector3d, std::vector<Eigen::Vector3d> ref, const  std::vector<int>& , Quadric *);
-  IGL_INLINE void applyProjOnPlane(Eigen::Vector3d, std::vector<int>, std::vector<int>&);
-  IGL_INLINE void getSphere(const int, const double, std::vector<int>&, int min);
-  IGL_INLINE void getKRing(const int, const double,std::vector<int>&);
-  IGL_INLINE Eigen::Vector3d project(Eigen::Vector3d, Eigen::Vector3d, Eigen::Vector3d);
-  IGL_INLINE void computeReferenceFrame(int, Eigen::Vector3d, std::vector<Eigen::Vector3d>&);
-  IGL_INLINE void getAverageNormal(int, std::vector<int>, Eigen::Vector3d&);
-  IGL_INLINE void getProjPlane(int, std::vector<int>, Eigen::Vector3d&);
-  IGL_INLINE void applyMontecarlo(std::vector<int>&,std::vector<int>*);
+  IGL_INLINE void finalEigenStuff (int, const Eigen::Matrix3d&, const Quadric&);
+  IGL_INLINE void fitQuadric (const Eigen::Vector3d&, const Eigen::Matrix3d& ref, const std::vector<int>& , std::vector<Eigen::Vector3d>&, Quadric *);
+  IGL_INLINE void applyProjOnPlane(const Eigen::Vector3d&, const std::vector<int>&, std::vector<int>&);
+  IGL_INLINE void getSphere(const int, const double, std::vector<int>&, int min, Scratch&);
+  IGL_INLINE void getKRing(const int, const double,std::vector<int>&, Scratch&);
+  IGL_INLINE Eigen::Vector3d project(const Eigen::Vector3d&, const Eigen::Vector3d&, const Eigen::Vector3d&);
+  IGL_INLINE void computeReferenceFrame(int, const Eigen::Vector3d&, Eigen::Matrix3d&);
+  IGL_INLINE void getAverageNormal(int, const std::vector<int>&, Eigen::Vector3d&);
+  IGL_INLINE void getProjPlane(int, const std::vector<int>&, Eigen::Vector3d&);
+  IGL_INLINE void applyMontecarlo(const std::vector<int>&,std::vector<int>*);
+  // Compute curvature of all vertices
   IGL_INLINE void computeCurvature();
+  // Compute curvature of a list of vertices (in parallel)
+  //
+  // Inputs:
+  //   I  #I list of vertex indices
+  IGL_INLINE void computeCurvature(const std::vector<int>& I);
+  // Compute curvature of vertex i and store it in row k of the output
+  // Returns false if the neighbourhood is too small
+  IGL_INLINE bool computeCurvature(const int i, const int k, Scratch& s);
   IGL_INLINE void printCurvature(std::string outpath);
   IGL_INLINE double getAverageEdge();
 
@@ -331,16 +388,59 @@ IGL_INLINE void CurvatureCalculator::init(const Eigen::MatrixXd& V, const Eigen:
 //  vertices = vertices.array() * (1.0/igl::avg_edge_length(V,F));
 
   faces = F;
-  igl::adjacency_list(F, vertex_to_vertices);
-  igl::vertex_triangle_adjacency(V, F, vertex_to_faces, vertex_to_faces_index);
+  // Build sorted, duplicate free vertex-vertex adjacency directly in CSR form
+  const int n = V.rows();
+  std::vector<int> count(n+1,0);
+  for (int f = 0; f<F.rows(); f++)
+  {
+    for (int j = 0; j<F.cols(); j++)
+    {
+      count[F(f,j)+1] += 2;
+    }
+  }
+  for (int i = 0; i<n; i++)
+  {
+    count[i+1] += count[i];
+  }
+  std::vector<int> all(count[n]);
+  {
+    std::vector<int> next(count.begin(),count.end()-1);
+    for (int f = 0; f<F.rows(); f++)
+    {
+      for (int j = 0; j<F.cols(); j++)
+      {
+        const int s = F(f,j);
+        const int d = F(f,(j+1)%F.cols());
+        all[next[s]++] = d;
+        all[next[d]++] = s;
+      }
+    }
+  }
+  vertex_to_vertices_offsets.resize(n+1);
+  vertex_to_vertices_offsets[0] = 0;
+  int m = 0;
+  for (int i = 0; i<n; i++)
+  {
+    std::sort(all.begin()+count[i],all.begin()+count[i+1]);
+    const int end = std::unique(all.begin()+count[i],all.begin()+count[i+1])-all.begin();
+    for (int a = count[i]; a<end; a++)
+    {
+      all[m++] = all[a];
+    }
+    vertex_to_vertices_offsets[i+1] = m;
+  }
+  all.resize(m);
+  vertex_to_vertices.swap(all);
+  // Only needed for PROJ_PLANE normals, gathered in computeCurvature
+  vertex_to_faces.clear();
+  vertex_to_faces_index.clear();
   igl::per_face_normals(V, F, face_normals);
   igl::per_vertex_normals(V, F, face_normals, vertex_normals);
 }
 
-IGL_INLINE void CurvatureCalculator::fitQuadric (Eigen::Vector3d v, std::vector<Eigen::Vector3d> ref, const std::vector<int>& vv, Quadric *q)
+IGL_INLINE void CurvatureCalculator::fitQuadric (const Eigen::Vector3d& v, const Eigen::Matrix3d& ref, const std::vector<int>& vv, std::vector<Eigen::Vector3d>& points, Quadric *q)
 {
-  std::vector<Eigen::Vector3d> points;
-  points.reserve (vv.size());
+  points.clear();
 
   for (unsigned int i = 0; i < vv.size(); ++i) {
 
@@ -349,22 +449,20 @@ IGL_INLINE void CurvatureCalculator::fitQuadric (Eigen::Vector3d v, std::vector<
     // vtang non e` il v tangente!!!
     Eigen::Vector3d  vTang = cp - v;
 
-    double x = vTang.dot(ref[0]);
-    double y = vTang.dot(ref[1]);
-    double z = vTang.dot(ref[2]);
-    points.push_back(Eigen::Vector3d (x,y,z));
+    // coordinates in the reference frame
+    points.push_back(ref.transpose()*vTang);
   }
   *q = Quadric::fit (points, zeroDetCheck, svd);
 }
 
-IGL_INLINE void CurvatureCalculator::finalEigenStuff (int i, std::vector<Eigen::Vector3d> ref, Quadric q)
+IGL_INLINE void CurvatureCalculator::finalEigenStuff (int i, const Eigen::Matrix3d& ref, const Quadric& q)
 {
 
-  double a = q.a();
-  double b = q.b();
-  double c = q.c();
-  double d = q.d();
-  double e = q.e();
+  double a = q.data[0];
+  double b = q.data[1];
+  double c = q.data[2];
+  double d = q.data[3];
+  double e = q.data[4];
 
 //  if (fabs(a) < 10e-8 || fabs(b) < 10e-8)
 //  {
@@ -391,28 +489,11 @@ IGL_INLINE void CurvatureCalculator::finalEigenStuff (int i, std::vector<Eigen::
   Eigen::Vector2d c_val = eig.eigenvalues();
   Eigen::Matrix2d c_vec = eig.eigenvectors();
 
-  // std::cerr << "c_val:" << c_val << std::endl;
-  // std::cerr << "c_vec:" << c_vec << std::endl;
-
-  // std::cerr << "c_vec:" << c_vec(0) << " "  << c_vec(1) << std::endl;
-
   c_val = -c_val;
 
-  Eigen::Vector3d v1, v2;
-  v1[0] = c_vec(0);
-  v1[1] = c_vec(1);
-  v1[2] = 0; //d * v1[0] + e * v1[1];
-
-  v2[0] = c_vec(2);
-  v2[1] = c_vec(3);
-  v2[2] = 0; //d * v2[0] + e * v2[1];
-
-
-  // v1 = v1.normalized();
-  // v2 = v2.normalized();
-
-  Eigen::Vector3d v1global = ref[0] * v1[0] + ref[1] * v1[1] + ref[2] * v1[2];
-  Eigen::Vector3d v2global = ref[0] * v2[0] + ref[1] * v2[1] + ref[2] * v2[2];
+  // Eigenvectors lie in the tangent plane (third local coordinate is 0)
+  Eigen::Vector3d v1global = ref.col(0) * c_vec(0) + ref.col(1) * c_vec(1);
+  Eigen::Vector3d v2global = ref.col(0) * c_vec(2) + ref.col(1) * c_vec(3);
 
   v1global.normalize();
   v2global.normalize();
@@ -422,131 +503,136 @@ IGL_INLINE void CurvatureCalculator::finalEigenStuff (int i, std::vector<Eigen::
 
   if (c_val[0] > c_val[1])
   {
-    curv[i]=std::vector<double>(2);
-    curv[i][0]=c_val(1);
-    curv[i][1]=c_val(0);
-    curvDir[i]=std::vector<Eigen::Vector3d>(2);
-    curvDir[i][0]=v2global;
-    curvDir[i][1]=v1global;
+    curv(i,0)=c_val(1);
+    curv(i,1)=c_val(0);
+    curvDir[0].row(i)=v2global;
+    curvDir[1].row(i)=v1global;
   }
   else
   {
-    curv[i]=std::vector<double>(2);
-    curv[i][0]=c_val(0);
-    curv[i][1]=c_val(1);
-    curvDir[i]=std::vector<Eigen::Vector3d>(2);
-    curvDir[i][0]=v1global;
-    curvDir[i][1]=v2global;
+    curv(i,0)=c_val(0);
+    curv(i,1)=c_val(1);
+    curvDir[0].row(i)=v1global;
+    curvDir[1].row(i)=v2global;
   }
   // ---- end Eigen stuff
 }
 
-IGL_INLINE void CurvatureCalculator::getKRing(const int start, const double r, std::vector<int>&vv)
+IGL_INLINE void CurvatureCalculator::getKRing(const int start, const double r, std::vector<int>&vv, Scratch& s)
 {
-  int bufsize=vertices.rows();
-  vv.reserve(bufsize);
-  std::list<std::pair<int,int> > queue;
-  bool* visited = (bool*)calloc(bufsize,sizeof(bool));
+  std::vector<std::pair<int,int> >& queue = s.queue;
+  queue.clear();
+  s.touched.clear();
   queue.push_back(std::pair<int,int>(start,0));
-  visited[start]=true;
-  while (!queue.empty())
+  s.visited[start]=true;
+  s.touched.push_back(start);
+  for (size_t h=0; h<queue.size(); h++)
   {
-    int toVisit=queue.front().first;
-    int distance=queue.front().second;
-    queue.pop_front();
+    int toVisit=queue[h].first;
+    int distance=queue[h].second;
     vv.push_back(toVisit);
     if (distance<(int)r)
     {
-      for (unsigned int i=0; i<vertex_to_vertices[toVisit].size(); i++)
+      for (int a=vertex_to_vertices_offsets[toVisit]; a<vertex_to_vertices_offsets[toVisit+1]; a++)
       {
-        int neighbor=vertex_to_vertices[toVisit][i];
-        if (!visited[neighbor])
+        int neighbor=vertex_to_vertices[a];
+        if (!s.visited[neighbor])
         {
           queue.push_back(std::pair<int,int> (neighbor,distance+1));
-          visited[neighbor]=true;
+          s.visited[neighbor]=true;
+          s.touched.push_back(neighbor);
         }
       }
     }
   }
-  free(visited);
-  return;
+  for (size_t t=0; t<s.touched.size(); t++)
+    s.visited[s.touched[t]]=false;
 }
 
 
-IGL_INLINE void CurvatureCalculator::getSphere(const int start, const double r, std::vector<int> &vv, int min)
+IGL_INLINE void CurvatureCalculator::getSphere(const int start, const double r, std::vector<int> &vv, int min, Scratch& s)
 {
-  int bufsize=vertices.rows();
-  vv.reserve(bufsize);
-  std::list<int>* queue= new std::list<int>();
-  bool* visited = (bool*)calloc(bufsize,sizeof(bool));
-  queue->push_back(start);
-  visited[start]=true;
+  // Breadth first search through vertices closer than r, queue[h].first are
+  // the visited vertices in order
+  std::vector<std::pair<int,int> >& queue = s.queue;
+  queue.clear();
+  s.touched.clear();
+  queue.push_back(std::pair<int,int>(start,0));
+  s.visited[start]=true;
+  s.touched.push_back(start);
   Eigen::Vector3d me=vertices.row(start);
-  std::priority_queue<std::pair<int, double>, std::vector<std::pair<int, double> >, comparer >* extra_candidates= new  std::priority_queue<std::pair<int, double>, std::vector<std::pair<int, double> >, comparer >();
-  while (!queue->empty())
+  // min-heap w.r.t. distance
+  std::vector<std::pair<int, double> >& extra_candidates = s.extra_candidates;
+  extra_candidates.clear();
+  for (size_t h=0; h<queue.size(); h++)
   {
-    int toVisit=queue->front();
-    queue->pop_front();
+    int toVisit=queue[h].first;
     vv.push_back(toVisit);
-    for (unsigned int i=0; i<vertex_to_vertices[toVisit].size(); i++)
+    for (int a=vertex_to_vertices_offsets[toVisit]; a<vertex_to_vertices_offsets[toVisit+1]; a++)
     {
-      int neighbor=vertex_to_vertices[toVisit][i];
-      if (!visited[neighbor])
+      int neighbor=vertex_to_vertices[a];
+      if (!s.visited[neighbor])
       {
         Eigen::Vector3d neigh=vertices.row(neighbor);
         float distance=(me-neigh).norm();
         if (distance<r)
-          queue->push_back(neighbor);
+          queue.push_back(std::pair<int,int>(neighbor,0));
         else if ((int)vv.size()<min)
-          extra_candidates->push(std::pair<int,double>(neighbor,distance));
-        visited[neighbor]=true;
+        {
+          extra_candidates.push_back(std::pair<int,double>(neighbor,distance));
+          std::push_heap(extra_candidates.begin(),extra_candidates.end(),comparer());
+        }
+        s.visited[neighbor]=true;
+        s.touched.push_back(neighbor);
       }
     }
   }
-  while (!extra_candidates->empty() && (int)vv.size()<min)
+  while (!extra_candidates.empty() && (int)vv.size()<min)
   {
-    std::pair<int, double> cand=extra_candidates->top();
-    extra_candidates->pop();
+    std::pop_heap(extra_candidates.begin(),extra_candidates.end(),comparer());
+    std::pair<int, double> cand=extra_candidates.back();
+    extra_candidates.pop_back();
     vv.push_back(cand.first);
-    for (unsigned int i=0; i<vertex_to_vertices[cand.first].size(); i++)
+    for (int a=vertex_to_vertices_offsets[cand.first]; a<vertex_to_vertices_offsets[cand.first+1]; a++)
     {
-      int neighbor=vertex_to_vertices[cand.first][i];
-      if (!visited[neighbor])
+      int neighbor=vertex_to_vertices[a];
+      if (!s.visited[neighbor])
       {
         Eigen::Vector3d neigh=vertices.row(neighbor);
         float distance=(me-neigh).norm();
-        extra_candidates->push(std::pair<int,double>(neighbor,distance));
-        visited[neighbor]=true;
+        extra_candidates.push_back(std::pair<int,double>(neighbor,distance));
+        std::push_heap(extra_candidates.begin(),extra_candidates.end(),comparer());
+        s.visited[neighbor]=true;
+        s.touched.push_back(neighbor);
       }
     }
   }
-  free(extra_candidates);
-  free(queue);
-  free(visited);
+  for (size_t t=0; t<s.touched.size(); t++)
+    s.visited[s.touched[t]]=false;
 }
 
-IGL_INLINE Eigen::Vector3d CurvatureCalculator::project(Eigen::Vector3d v, Eigen::Vector3d  vp, Eigen::Vector3d ppn)
+IGL_INLINE Eigen::Vector3d CurvatureCalculator::project(const Eigen::Vector3d& v, const Eigen::Vector3d& vp, const Eigen::Vector3d& ppn)
 {
   return (vp - (ppn * ((vp - v).dot(ppn))));
 }
 
-IGL_INLINE void CurvatureCalculator::computeReferenceFrame(int i, Eigen::Vector3d normal, std::vector<Eigen::Vector3d>& ref )
+IGL_INLINE void CurvatureCalculator::computeReferenceFrame(int i, const Eigen::Vector3d& normal, Eigen::Matrix3d& ref )
 {
 
   Eigen::Vector3d longest_v=Eigen::Vector3d::Zero();
-  longest_v=Eigen::Vector3d(vertices.row(vertex_to_vertices[i][0]));
+  longest_v=Eigen::Vector3d(vertices.row(vertex_to_vertices[vertex_to_vertices_offsets[i]]));
 
   longest_v=(project(vertices.row(i),longest_v,normal)-Eigen::Vector3d(vertices.row(i))).normalized();
 
   /* L'ultimo asse si ottiene come prodotto vettoriale tra i due
    * calcolati */
   Eigen::Vector3d y_axis=(normal.cross(longest_v)).normalized();
-  ref[0]=longest_v;
-  ref[1]=y_axis;
-  ref[2]=normal;
+  ref.col(0)=longest_v;
+  ref.col(1)=y_axis;
+  ref.col(2)=normal;
 }
 
-IGL_INLINE void CurvatureCalculator::getAverageNormal(int j, std::vector<int> vv, Eigen::Vector3d& normal)
+IGL_INLINE void CurvatureCalculator::getAverageNormal(int j, const std::vector<int>& vv, Eigen::Vector3d& normal)
 {
   normal=(vertex_normals.row(j)).normalized();
   if (localMode)
@@ -559,7 +645,7 @@ IGL_INLINE void CurvatureCalculator::getAverageNormal(int j, std::vector<int> vv
   normal.normalize();
 }
 
-IGL_INLINE void CurvatureCalculator::getProjPlane(int j, std::vector<int> vv, Eigen::Vector3d& ppn)
+IGL_INLINE void CurvatureCalculator::getProjPlane(int j, const std::vector<int>& vv, Eigen::Vector3d& ppn)
 {
   int nr;
   float a, b, c;
@@ -623,14 +709,14 @@ IGL_INLINE double CurvatureCalculator::getAverageEdge()
 }
 
 
-IGL_INLINE void CurvatureCalculator::applyProjOnPlane(Eigen::Vector3d ppn, std::vector<int> vin, std::vector<int> &vout)
+IGL_INLINE void CurvatureCalculator::applyProjOnPlane(const Eigen::Vector3d& ppn, const std::vector<int>& vin, std::vector<int> &vout)
 {
-  for (std::vector<int>::iterator vpi = vin.begin(); vpi != vin.end(); ++vpi)
-    if (vertex_normals.row(*vpi) * ppn > 0.0f)
+  for (std::vector<int>::const_iterator vpi = vin.begin(); vpi != vin.end(); ++vpi)
+    if (vertex_normals.row(*vpi).dot(ppn) > 0.0f)
       vout.push_back (*vpi);
 }
 
-IGL_INLINE void CurvatureCalculator::applyMontecarlo(std::vector<int>& vin, std::vector<int> *vout)
+IGL_INLINE void CurvatureCalculator::applyMontecarlo(const std::vector<int>& vin, std::vector<int> *vout)
 {
   if (montecarloN >= vin.size ())
   {
@@ -639,7 +725,7 @@ IGL_INLINE void CurvatureCalculator::applyMontecarlo(std::vector<int>& vin, std:
   }
 
   float p = ((float) montecarloN) / (float) vin.size();
-  for (std::vector<int>::iterator vpi = vin.begin(); vpi != vin.end(); ++vpi)
+  for (std::vector<int>::const_iterator vpi = vin.begin(); vpi != vin.end(); ++vpi)
   {
     float r;
     if ((r = ((float)rand () / RAND_MAX)) < p)
@@ -649,99 +735,132 @@ IGL_INLINE void CurvatureCalculator::applyMontecarlo(std::vector<int>& vin, std:
   }
 }
 
-IGL_INLINE void CurvatureCalculator::computeCurvature()
+IGL_INLINE bool CurvatureCalculator::computeCurvature(const int i, const int k, Scratch& s)
 {
-  using namespace std;
-
-  //CHECK che esista la mesh
-  size_t vertices_count=vertices.rows() ;
+  std::vector<int>& vv = s.vv;
+  std::vector<int>& vvtmp = s.vvtmp;
+  vv.clear();
+  vvtmp.clear();
+  Eigen::Vector3d me=vertices.row(i);
+  switch (st)
+  {
+    case SPHERE_SEARCH:
+      getSphere(i,scaledRadius,vv,6,s);
+      break;
+    case K_RING_SEARCH:
+      getKRing(i,kRing,vv,s);
+      break;
+  }
 
-  if (vertices_count <=0)
-    return;
+  if (vv.size()<6)
+    return false;
 
-  curvDir=std::vector< std::vector<Eigen::Vector3d> >(vertices_count);
-  curv=std::vector<std::vector<double> >(vertices_count);
+  if (projectionPlaneCheck)
+  {
+    applyProjOnPlane (vertex_normals.row(i), vv, vvtmp);
+    if (vvtmp.size() >= 6 && vvtmp.size()<vv.size())
+      vv.swap(vvtmp);
+  }
 
+  Eigen::Vector3d normal;
+  switch (nt)
+  {
+    case AVERAGE:
+      getAverageNormal(i,vv,normal);
+      break;
+    case PROJ_PLANE:
+      getProjPlane(i,vv,normal);
+      break;
+  }
+  if (montecarlo)
+  {
+    if(montecarloN<6)
+      return false;
+    vvtmp.clear();
+    applyMontecarlo(vv,&vvtmp);
+    vv.swap(vvtmp);
+  }
 
+  if (vv.size()<6)
+    return false;
+  Eigen::Matrix3d ref;
+  computeReferenceFrame(i,normal,ref);
 
-  scaledRadius=getAverageEdge()*sphereRadius;
+  Quadric q;
+  fitQuadric (me, ref, vv, s.points, &q);
+  finalEigenStuff(k,ref,q);
+  return true;
+}
 
-  std::vector<int> vv;
-  std::vector<int> vvtmp;
-  Eigen::Vector3d normal;
+IGL_INLINE void CurvatureCalculator::computeCurvature()
+{
+  std::vector<int> I(vertices.rows());
+  for (int i=0; i<(int)I.size(); i++)
+    I[i]=i;
+  computeCurvature(I);
+}
 
-  //double time_spent;
-  //double searchtime=0, ref_time=0, fit_time=0, final_time=0;
+IGL_INLINE void CurvatureCalculator::computeCurvature(const std::vector<int>& I)
+{
+  using namespace std;
 
-  for (size_t i=0; i<vertices_count; ++i)
-  {
-    vv.clear();
-    vvtmp.clear();
-    Eigen::Vector3d me=vertices.row(i);
-    switch (st)
-    {
-      case SPHERE_SEARCH:
-        getSphere(i,scaledRadius,vv,6);
-        break;
-      case K_RING_SEARCH:
-        getKRing(i,kRing,vv);
-        break;
-      default:
-        fprintf(stderr,"Error: search type not recognized");
-        return;
-    }
+  //CHECK che esista la mesh
+  size_t vertices_count=vertices.rows() ;
 
-    std::vector<Eigen::Vector3d> ref(3);
-    if (vv.size()<6)
-    {
-      std::cerr << "Could not compute curvature of radius " << scaledRadius << endl;
-      return;
-    }
+  if (vertices_count <=0)
+    return;
 
+  if (st != SPHERE_SEARCH && st != K_RING_SEARCH)
+  {
+    fprintf(stderr,"Error: search type not recognized");
+    return;
+  }
+  if (nt != AVERAGE && nt != PROJ_PLANE)
+  {
+    fprintf(stderr,"Error: normal type not recognized");
+    return;
+  }
 
-    if (projectionPlaneCheck)
-    {
-      vvtmp.reserve (vv.size ());
-      applyProjOnPlane (vertex_normals.row(i), vv, vvtmp);
-      if (vvtmp.size() >= 6 && vvtmp.size()<vv.size())
-	  vv = vvtmp;
+  // Vertices for which curvature cannot be computed are left zero
+  curv.setZero(I.size(),2);
+  curvDir[0].setZero(I.size(),3);
+  curvDir[1].setZero(I.size(),3);
 
-    }
+  if (nt == PROJ_PLANE && localMode && vertex_to_faces.empty())
+    igl::vertex_triangle_adjacency(vertices, faces, vertex_to_faces, vertex_to_faces_index);
 
+  scaledRadius=getAverageEdge()*sphereRadius;
 
-    switch (nt)
+  // Each thread gets its own workspace, neighbourhoods are gathered and fit
+  // independently for each vertex
+  std::vector<Scratch> scratch;
+  int failed = 0;
+  igl::parallel_for(
+    (int)I.size(),
+    [&](const size_t nthreads)
     {
-      case AVERAGE:
-        getAverageNormal(i,vv,normal);
-        break;
-      case PROJ_PLANE:
-        getProjPlane(i,vv,normal);
-        break;
-      default:
-        fprintf(stderr,"Error: normal type not recognized");
-        return;
-    }
-    if (vv.size()<6)
+      scratch.resize(nthreads);
+      for (size_t t=0; t<nthreads; t++)
+        scratch[t].failed = 0;
+    },
+    [&](const int k, const size_t t)
     {
-      std::cerr << "Could not compute curvature of radius " << scaledRadius << endl;
-      return;
-    }
-    if (montecarlo)
+      Scratch& s = scratch[t];
+      if (s.visited.size() != vertices_count)
+        s.visited.assign(vertices_count,false);
+      if (!computeCurvature(I[k],k,s))
+        s.failed++;
+    },
+    [&](const size_t t)
     {
-      if(montecarloN<6)
-        break;
-      vvtmp.reserve(vv.size());
-      applyMontecarlo(vv,&vvtmp);
-      vv=vvtmp;
-    }
-
-    if (vv.size()<6)
-      return;
-    computeReferenceFrame(i,normal,ref);
+      failed += scratch[t].failed;
+    },
+    1000);
 
-    Quadric q;
-    fitQuadric (me, ref, vv, &q);
-    finalEigenStuff(i,ref,q);
+  if (failed > 0)
+  {
+    std::cerr << "Could not compute curvature of radius " << scaledRadius <<
+      " at " << failed << " vertices" << endl;
   }
 
   lastRadius=sphereRadius;
@@ -763,12 +882,12 @@ IGL_INLINE void CurvatureCalculator::printCurvature(std::string outpath)
     return;
   }
 
-  int vertices_count=vertices.rows();
+  int vertices_count=curv.rows();
   of << vertices_count << endl;
   for (int i=0; i<vertices_count; i++)
   {
-    of << curv[i][0] << " " << curv[i][1] << " " << curvDir[i][0][0] << " " << curvDir[i][0][1] << " " << curvDir[i][0][2] << " " <<
-    curvDir[i][1][0] << " " << curvDir[i][1][1] << " " << curvDir[i][1][2] << endl;
+    of << curv(i,0) << " " << curv(i,1) << " " << curvDir[0](i,0) << " " << curvDir[0](i,1) << " " << curvDir[0](i,2) << " " <<
+    curvDir[1](i,0) << " " << curvDir[1](i,1) << " " << curvDir[1](i,2) << endl;
   }
 
   of.close();
@@ -791,6 +910,29 @@ IGL_INLINE void igl::principal_curvature(
   Eigen::PlainObjectBase<DerivedPV2>& PV2,
   unsigned radius,
   bool useKring)
+{
+  const Eigen::VectorXi I = Eigen::VectorXi::LinSpaced(V.rows(),0,V.rows()-1);
+  principal_curvature(V,F,I,PD1,PD2,PV1,PV2,radius,useKring);
+}
+
+template <
+  typename DerivedV,
+  typename DerivedF,
+  typename DerivedI,
+  typename DerivedPD1,
+  typename DerivedPD2,
+  typename DerivedPV1,
+  typename DerivedPV2>
+IGL_INLINE void igl::principal_curvature(
+  const Eigen::PlainObjectBase<DerivedV>& V,
+  const Eigen::PlainObjectBase<DerivedF>& F,
+  const Eigen::MatrixBase<DerivedI>& I,
+  Eigen::PlainObjectBase<DerivedPD1>& PD1,
+  Eigen::PlainObjectBase<DerivedPD2>& PD2,
+  Eigen::PlainObjectBase<DerivedPV1>& PV1,
+  Eigen::PlainObjectBase<DerivedPV2>& PV2,
+  unsigned radius,
+  bool useKring)
 {
   using namespace std;
 
@@ -800,13 +942,14 @@ IGL_INLINE void igl::principal_curvature(
     cout << "WARNING: igl::principal_curvature needs a radius >= 2, fixing it to 2." << endl;
   }
 
+  const int n = I.size();
   // Preallocate memory
-  PD1.resize(V.rows(),3);
-  PD2.resize(V.rows(),3);
+  PD1.resize(n,3);
+  PD2.resize(n,3);
 
   // Preallocate memory
-  PV1.resize(V.rows(),1);
-  PV2.resize(V.rows(),1);
+  PV1.resize(n,1);
+  PV2.resize(n,1);
 
   // Precomputation
   CurvatureCalculator cc;
@@ -820,15 +963,16 @@ IGL_INLINE void igl::principal_curvature(
   }
 
   // Compute
-  cc.computeCurvature();
+  std::vector<int> vI(n);
+  for (int i=0; i<n; i++)
+    vI[i] = I(i);
+  cc.computeCurvature(vI);
 
   // Copy it back
-  for (unsigned i=0; i<V.rows(); i++)
+  for (int i=0; i<n; i++)
   {
-    Eigen::Vector3d d1;
-    Eigen::Vector3d d2;
-    PD1.row(i) << cc.curvDir[i][0][0], cc.curvDir[i][0][1], cc.curvDir[i][0][2];
-    PD2.row(i) << cc.curvDir[i][1][0], cc.curvDir[i][1][1], cc.curvDir[i][1][2];
+    PD1.row(i) << cc.curvDir[0](i,0), cc.curvDir[0](i,1), cc.curvDir[0](i,2);
+    PD2.row(i) << cc.curvDir[1](i,0), cc.curvDir[1](i,1), cc.curvDir[1](i,2);
     PD1.row(i).normalize();
     PD2.row(i).normalize();
 
@@ -838,12 +982,12 @@ IGL_INLINE void igl::principal_curvature(
       PD2.row(i) << 0,0,0;
     }
 
-    PV1(i) = cc.curv[i][0];
-    PV2(i) = cc.curv[i][1];
+    PV1(i) = cc.curv(i,0);
+    PV2(i) = cc.curv(i,1);
 
     if (PD1.row(i) * PD2.row(i).transpose() > 10e-6)
     {
-      cerr << "PRINCIPAL_CURVATURE: Something is wrong with vertex: i" << endl;
+      cerr << "PRINCIPAL_CURVATURE: Something is wrong with vertex: " << I(i) << endl;
       PD1.row(i) *= 0;
       PD2.row(i) *= 0;
     }
@@ -857,4 +1001,5 @@ IGL_INLINE void igl::principal_curvature(
 template void igl::principal_curvature<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, 1, 0, -1, 1> >(Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&, unsigned int, bool);
 template void igl::principal_curvature<Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Matrix<int, -1, 3, 0, -1, 3>, Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, 1, 0, -1, 1> >(Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 3, 0, -1, 3> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&, unsigned int, bool);
 template void igl::principal_curvature<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, unsigned int, bool);
+template void igl::principal_curvature<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, 1, 0, -1, 1> >(Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&, unsigned int, bool);
 #endif
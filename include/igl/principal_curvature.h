@@ -42,9 +42,44 @@ namespace igl
   // Efficient Multi-scale Curvature and Crease Estimation
   // Daniele Panozzo, Enrico Puppo, Luigi Rocca
   // GraVisMa, 2010
+  //
+  // Vertices are processed in parallel.
+template <
+  typename DerivedV, 
+  typename DerivedF,
+  typename DerivedPD1, 
+  typename DerivedPD2, 
+  typename DerivedPV1, 
+  typename DerivedPV2>
+IGL_INLINE void principal_curvature(
+  const Eigen::PlainObjectBase<DerivedV>& V,
+  const Eigen::PlainObjectBase<DerivedF>& F,
+  Eigen::PlainObjectBase<DerivedPD1>& PD1,
+  Eigen::PlainObjectBase<DerivedPD2>& PD2,
+  Eigen::PlainObjectBase<DerivedPV1>& PV1,
+  Eigen::PlainObjectBase<DerivedPV2>& PV2,
+  unsigned radius = 5,
+  bool useKring = true);
+
+  // Compute the principal curvature directions and magnitude only at a subset
+  // of the vertices. Neighbourhoods are still gathered from the whole mesh.
+  //
+  // Inputs:
+  //   V       eigen matrix #V by 3
+  //   F       #F by 3 list of mesh faces (must be triangles)
+  //   I       #I list of indices into V of vertices at which to compute
+  //     curvature
+  //   radius  controls the size of the neighbourhood used, 1 = average edge lenght
+  //
+  // Outputs:
+  //   PD1 #I by 3 maximal curvature direction for each vertex in I.
+  //   PD2 #I by 3 minimal curvature direction for each vertex in I.
+  //   PV1 #I by 1 maximal curvature value for each vertex in I.
+  //   PV2 #I by 1 minimal curvature value for each vertex in I.
 template <
   typename DerivedV, 
   typename DerivedF,
+  typename DerivedI,
   typename DerivedPD1, 
   typename DerivedPD2, 
   typename DerivedPV1, 
@@ -52,6 +87,7 @@ template <
 IGL_INLINE void principal_curvature(
   const Eigen::PlainObjectBase<DerivedV>& V,
   const Eigen::PlainObjectBase<DerivedF>& F,
+  const Eigen::MatrixBase<DerivedI>& I,
   Eigen::PlainObjectBase<DerivedPD1>& PD1,
   Eigen::PlainObjectBase<DerivedPD2>& PD2,
   Eigen::PlainObjectBase<DerivedPV1>& PV1,
@@ -9,8 +9,11 @@
 #include "doublearea.h"
 #include "cumsum.h"
 #include "histc.h"
+#include "parallel_for.h"
+#include <algorithm>
 #include <iostream>
 #include <cassert>
+#include <cmath>
 
 template <typename DerivedV, typename DerivedF, typename DerivedB, typename DerivedFI>
 IGL_INLINE void igl::random_points_on_mesh(
@@ -76,8 +79,63 @@ IGL_INLINE void igl::random_points_on_mesh(
   B.setFromTriplets(BIJV.begin(),BIJV.end());
 }
 
+template <typename DerivedV, typename DerivedF, typename DerivedB, typename DerivedFI>
+IGL_INLINE void igl::random_points_on_mesh(
+  const int n,
+  const Eigen::PlainObjectBase<DerivedV > & V,
+  const Eigen::PlainObjectBase<DerivedF > & F,
+  const bool stratified,
+  const unsigned long long seed,
+  Eigen::PlainObjectBase<DerivedB > & B,
+  Eigen::PlainObjectBase<DerivedFI > & FI)
+{
+  typedef typename DerivedV::Scalar Scalar;
+  typedef Eigen::Matrix<Scalar,Eigen::Dynamic,1> VectorXs;
+  assert(F.cols() == 3);
+  VectorXs A;
+  doublearea(V,F,A);
+  // Area CDF: C(f) is the total area of faces before f
+  std::vector<double> C(F.rows()+1);
+  C[0] = 0;
+  for(int f = 0;f<F.rows();f++)
+  {
+    C[f+1] = C[f] + A(f);
+  }
+  const double total = C[F.rows()];
+  // Counter-based uniform random number in [0,1): the ith number of the
+  // stream seed (splitmix64 finalizer), so that samples can be generated
+  // independently in parallel
+  const auto uniform = [&seed](const unsigned long long i)->double
+  {
+    unsigned long long z = 
+      seed*0xD1B54A32D192ED03ULL + (i+1)*0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z = z ^ (z >> 31);
+    return double(z >> 11) * (1.0/9007199254740992.0);
+  };
+  B.resize(n,3);
+  FI.resize(n,1);
+  parallel_for(n,[&](const int s)
+  {
+    const unsigned long long i = 3*(unsigned long long)s;
+    const double r = uniform(i);
+    const double u = total * (stratified ? (s+r)/double(n) : r);
+    // Face whose CDF interval contains u
+    const int f = std::max(0,std::min<int>(F.rows()-1,
+      int(std::upper_bound(C.begin(),C.end(),u)-C.begin())-1));
+    FI(s) = f;
+    const double S = uniform(i+1);
+    const double T = std::sqrt(uniform(i+2));
+    B(s,0) = 1.-T;
+    B(s,1) = (1.-S)*T;
+    B(s,2) = S*T;
+  },10000);
+}
+
 #ifdef IGL_STATIC_LIBRARY
 // Explicit template instantiation
 template void igl::random_points_on_mesh<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, double, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(int, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::SparseMatrix<double, 0, int>&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&);
 template void igl::random_points_on_mesh<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, double, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(int, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::SparseMatrix<double, 0, int>&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
+template void igl::random_points_on_mesh<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(int, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, bool, unsigned long long, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
 #endif
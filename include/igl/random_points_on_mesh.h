@@ -23,7 +23,7 @@ namespace igl
   // Outputs:
   //   B  n by 3 list of barycentric coordinates, ith row are coordinates of
   //     ith sampled point in face FI(i)
-  //   FI  n list of indices into F 
+  //   FI  n list of indices into F
   //
   template <typename DerivedV, typename DerivedF, typename DerivedB, typename DerivedFI>
   IGL_INLINE void random_points_on_mesh(
@@ -41,6 +41,32 @@ namespace igl
     const Eigen::PlainObjectBase<DerivedF > & F,
     Eigen::SparseMatrix<ScalarB > & B,
     Eigen::PlainObjectBase<DerivedFI > & FI);
+  // Seeded, parallel version. The result only depends on the seed (not on the
+  // number of threads or on the global state of rand()).
+  //
+  // Inputs:
+  //   n  number of samples
+  //   V  #V by dim list of mesh vertex positions
+  //   F  #F by 3 list of mesh triangle indices
+  //   stratified  whether to stratify the samples: the ith sample is drawn
+  //     from the ith of n equal-area strata of the mesh, so that the number
+  //     of samples in each face differs from its expected number by less than
+  //     two (much lower variance than independent samples)
+  //   seed  seed of the random number generator
+  // Outputs:
+  //   B  n by 3 list of barycentric coordinates, ith row are coordinates of
+  //     ith sampled point in face FI(i)
+  //   FI  n list of indices into F
+  //
+  template <typename DerivedV, typename DerivedF, typename DerivedB, typename DerivedFI>
+  IGL_INLINE void random_points_on_mesh(
+    const int n,
+    const Eigen::PlainObjectBase<DerivedV > & V,
+    const Eigen::PlainObjectBase<DerivedF > & F,
+    const bool stratified,
+    const unsigned long long seed,
+    Eigen::PlainObjectBase<DerivedB > & B,
+    Eigen::PlainObjectBase<DerivedFI > & FI);
 }
 
 #ifndef IGL_STATIC_LIBRARY
@@ -0,0 +1,81 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 agent <agent@local>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "reorder_mesh.h"
+#include "parallel_for.h"
+#include "vertex_cache_order.h"
+
+template <
+  typename DerivedV,
+  typename DerivedF,
+  typename DerivedI,
+  typename DerivedVV,
+  typename DerivedFF,
+  typename DerivedJ>
+IGL_INLINE void igl::reorder_mesh(
+  const Eigen::MatrixBase<DerivedV> & V,
+  const Eigen::MatrixBase<DerivedF> & F,
+  const Eigen::MatrixBase<DerivedI> & I,
+  Eigen::PlainObjectBase<DerivedVV> & VV,
+  Eigen::PlainObjectBase<DerivedFF> & FF,
+  Eigen::PlainObjectBase<DerivedJ> & J)
+{
+  assert(I.size() == V.rows() && "I should be a permutation of V's rows");
+  const int n = V.rows();
+  Eigen::VectorXi IM(n);
+  for(int i = 0;i<n;i++)
+  {
+    IM(I(i)) = i;
+  }
+  // Renumber the faces, then sort them
+  Eigen::MatrixXi G(F.rows(),F.cols());
+  parallel_for(F.rows(),[&](const int f)
+  {
+    for(int c = 0;c<F.cols();c++)
+    {
+      G(f,c) = IM(F(f,c));
+    }
+  },10000);
+  Eigen::MatrixXi GG;
+  Eigen::VectorXi JJ;
+  vertex_cache_order(G,GG,JJ);
+  FF = GG.template cast<typename DerivedFF::Scalar>();
+  J = JJ.template cast<typename DerivedJ::Scalar>();
+  VV.resize(n,V.cols());
+  parallel_for(n,[&](const int i)
+  {
+    VV.row(i) = V.row(I(i)).template cast<typename DerivedVV::Scalar>();
+  },10000);
+}
+
+template <
+  typename DerivedV,
+  typename DerivedF,
+  typename DerivedVV,
+  typename DerivedFF,
+  typename DerivedI,
+  typename DerivedJ>
+IGL_INLINE void igl::reorder_mesh(
+  const Eigen::MatrixBase<DerivedV> & V,
+  const Eigen::MatrixBase<DerivedF> & F,
+  const SpatialOrderType type,
+  Eigen::PlainObjectBase<DerivedVV> & VV,
+  Eigen::PlainObjectBase<DerivedFF> & FF,
+  Eigen::PlainObjectBase<DerivedI> & I,
+  Eigen::PlainObjectBase<DerivedJ> & J)
+{
+  Eigen::VectorXi II;
+  spatial_order(Eigen::MatrixXd(V.template cast<double>()),type,II);
+  I = II.template cast<typename DerivedI::Scalar>();
+  return reorder_mesh(V,F,II,VV,FF,J);
+}
+
+#ifdef IGL_STATIC_LIBRARY
+// Explicit template instantiation
+template void igl::reorder_mesh<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
+template void igl::reorder_mesh<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, igl::SpatialOrderType, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
+#endif
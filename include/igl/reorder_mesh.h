@@ -0,0 +1,76 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 agent <agent@local>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_REORDER_MESH_H
+#define IGL_REORDER_MESH_H
+#include "igl_inline.h"
+#include "spatial_order.h"
+#include <Eigen/Core>
+
+namespace igl
+{
+  // REORDER_MESH Reorder the vertices of a triangle mesh and then its faces
+  // for the vertex cache (see igl::vertex_cache_order), so that loops over
+  // faces gather nearby vertices and sparse matrices built from the mesh
+  // (cotmatrix, massmatrix, ...) have their nonzeros close to the diagonal.
+  //
+  // Other attributes follow the same permutations: per-vertex attributes
+  // as A(I,:) and per-face attributes as A(J,:) (see igl::slice); old
+  // vertex indices map to new ones through IM with IM(I) = 0:#V-1.
+  //
+  // Inputs:
+  //   V  #V by dim list of vertex positions
+  //   F  #F by 3 list of triangle indices into V
+  //   I  #V list of indices into V: new vertex order (e.g., from
+  //     igl::spatial_order or from igl::sparse_order of the mesh's
+  //     adjacency matrix)
+  // Outputs:
+  //   VV  #V by dim list of vertex positions, VV = V(I,:)
+  //   FF  #F by 3 list of triangle indices into VV
+  //   J  #F list of indices into F so that FF = IM(F(J,:))
+  template <
+    typename DerivedV,
+    typename DerivedF,
+    typename DerivedI,
+    typename DerivedVV,
+    typename DerivedFF,
+    typename DerivedJ>
+  IGL_INLINE void reorder_mesh(
+    const Eigen::MatrixBase<DerivedV> & V,
+    const Eigen::MatrixBase<DerivedF> & F,
+    const Eigen::MatrixBase<DerivedI> & I,
+    Eigen::PlainObjectBase<DerivedVV> & VV,
+    Eigen::PlainObjectBase<DerivedFF> & FF,
+    Eigen::PlainObjectBase<DerivedJ> & J);
+  // Vertices are ordered along a space filling curve
+  //
+  // Inputs:
+  //   type  space filling curve
+  // Outputs:
+  //   I  #V list of indices into V, VV = V(I,:)
+  template <
+    typename DerivedV,
+    typename DerivedF,
+    typename DerivedVV,
+    typename DerivedFF,
+    typename DerivedI,
+    typename DerivedJ>
+  IGL_INLINE void reorder_mesh(
+    const Eigen::MatrixBase<DerivedV> & V,
+    const Eigen::MatrixBase<DerivedF> & F,
+    const SpatialOrderType type,
+    Eigen::PlainObjectBase<DerivedVV> & VV,
+    Eigen::PlainObjectBase<DerivedFF> & FF,
+    Eigen::PlainObjectBase<DerivedI> & I,
+    Eigen::PlainObjectBase<DerivedJ> & J);
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "reorder_mesh.cpp"
+#endif
+
+#endif
@@ -6,10 +6,8 @@
 // v. 2.0. If a copy of the MPL was not distributed with this file, You can 
 // obtain one at http://mozilla.org/MPL/2.0/.
 #include "slice_tets.h"
-#include "LinSpaced.h"
-#include "sort.h"
-#include "cat.h"
-#include "per_face_normals.h"
+#include "parallel_for.h"
+#include <Eigen/Geometry>
 #include <cassert>
 #include <algorithm>
 #include <vector>
@@ -38,18 +36,12 @@ IGL_INLINE void igl::slice_tets(
   assert(plane.size() == 4 && "Plane equation should be 4 coefficients");
 
   // number of tets
-  const size_t m = T.rows();
+  const int m = T.rows();
 
   typedef typename DerivedV::Scalar Scalar;
   typedef typename DerivedT::Scalar Index;
   typedef Matrix<Scalar,Dynamic,1> VectorXS;
-  typedef Matrix<Scalar,Dynamic,4> MatrixX4S;
-  typedef Matrix<Scalar,Dynamic,3> MatrixX3S;
-  typedef Matrix<Scalar,Dynamic,2> MatrixX2S;
-  typedef Matrix<Index,Dynamic,4> MatrixX4I;
-  typedef Matrix<Index,Dynamic,3> MatrixX3I;
-  typedef Matrix<Index,Dynamic,1> VectorXI;
-  typedef Matrix<bool,Dynamic,1> VectorXb;
+  typedef Matrix<Scalar,1,3> RowVector3S;
   
   // Value of plane's implicit function at all vertices
   VectorXS IV = 
@@ -57,174 +49,127 @@ IGL_INLINE void igl::slice_tets(
      V.col(1)*plane(1) + 
      V.col(2)*plane(2)).array()
     + plane(3);
-  MatrixX4S IT(m,4);
-  for(size_t t = 0;t<m;t++)
+
+  // Classify tets: one vertex below the plane (13), one vertex above (31) or
+  // two below (22). With vertices on the plane a tet may be in more than one
+  // class. K(t,k) is the index of tet t among the tets of class k or -1.
+  Matrix<int,Dynamic,3> K(m,3);
+  parallel_for(m,[&](const int t)
+  {
+    int below = 0, above = 0;
+    for(int c = 0;c<4;c++)
+    {
+      below += IV(T(t,c))<0;
+      above += IV(T(t,c))>0;
+    }
+    K(t,0) = below==1;
+    K(t,1) = above==1;
+    K(t,2) = below==2;
+  },10000);
+  int num[3] = {0,0,0};
+  for(int t = 0;t<m;t++)
   {
-    for(size_t c = 0;c<4;c++)
+    for(int k = 0;k<3;k++)
     {
-      IT(t,c) = IV(T(t,c));
+      K(t,k) = K(t,k) ? num[k]++ : -1;
     }
   }
+  const int m13 = num[0], m31 = num[1], m22 = num[2];
+  // Rows of BC (and U) and G of each class
+  const int u31 = 3*m13, u22 = 3*m13+3*m31;
+  const int g31 = m13, g22 = m13+m31;
+  const int nu = 3*m13+3*m31+4*m22;
+  const int ng = m13+m31+2*m22;
 
-  const auto & extract_rows = [](
-    const PlainObjectBase<DerivedT> & T,
-    const MatrixX4S & IT,
-    const VectorXb & I,
-    MatrixX4I  & TI,
-    MatrixX4S & ITI,
-    VectorXI & JI)
+  // Each row of BC has exactly two entries: row r is stored in IJV[2*r] and
+  // IJV[2*r+1]
+  vector<Triplet<BCType> > IJV(2*nu);
+  U.resize(nu,3);
+  G.resize(ng,3);
+  J.resize(ng);
+  const auto set_row = [&](const int r, const Index a, const Index b, const Scalar lambda)
   {
-    const Index num_I = std::count(I.data(),I.data()+I.size(),true);
-    TI.resize(num_I,4);
-    ITI.resize(num_I,4);
-    JI.resize(num_I,1);
+    IJV[2*r+0] = Triplet<BCType>(r,a,  lambda);
+    IJV[2*r+1] = Triplet<BCType>(r,b,1-lambda);
+    U.row(r) = lambda*V.row(a) + (1-lambda)*V.row(b);
+  };
+  parallel_for(m,[&](const int t)
+  {
+    // Corners sorted by (sign*) value of the implicit function (stable)
+    const auto sort_corners = [&](const Scalar sign, Scalar * sIT, Index * sT)
     {
-      size_t k = 0;
-      for(size_t t = 0;t<(size_t)T.rows();t++)
+      for(int c = 0;c<4;c++)
       {
-        if(I(t))
+        sIT[c] = sign*IV(T(t,c));
+        sT[c] = T(t,c);
+        for(int d = c;d>0 && sIT[d]<sIT[d-1];d--)
         {
-          TI.row(k) = T.row(t);
-          ITI.row(k) = IT.row(t);
-          JI(k) = t;
-          k++;
+          std::swap(sIT[d],sIT[d-1]);
+          std::swap(sT[d],sT[d-1]);
         }
       }
-      assert(k == num_I);
-    }
-  };
-
-  VectorXb I13 = (IT.array()<0).rowwise().count()==1;
-  VectorXb I31 = (IT.array()>0).rowwise().count()==1;
-  VectorXb I22 = (IT.array()<0).rowwise().count()==2;
-  MatrixX4I T13,T31,T22;
-  MatrixX4S IT13,IT31,IT22;
-  VectorXI J13,J31,J22;
-  extract_rows(T,IT,I13,T13,IT13,J13);
-  extract_rows(T,IT,I31,T31,IT31,J31);
-  extract_rows(T,IT,I22,T22,IT22,J22);
-
-  const auto & apply_sort = [] (
-     const MatrixX4I & T, 
-     const MatrixX4I & sJ, 
-     MatrixX4I & sT)
-  {
-    sT.resize(T.rows(),4);
-    for(size_t t = 0;t<(size_t)T.rows();t++)
+    };
+    Scalar sIT[4];
+    Index sT[4];
+    // One vertex below (or above)
+    for(int k = 0;k<2;k++)
     {
-      for(size_t c = 0;c<4;c++)
+      if(K(t,k) < 0)
       {
-        sT(t,c) = T(t,sJ(t,c));
+        continue;
       }
-    }
-  };
-
-  const auto & one_below = [&V,&apply_sort](
-    const MatrixX4I & T,
-    const MatrixX4S & IT,
-    MatrixX3I & G,
-    SparseMatrix<BCType> & BC)
-  {
-    // Number of tets
-    const size_t m = T.rows();
-    MatrixX4S sIT;
-    MatrixX4I sJ;
-    sort(IT,2,true,sIT,sJ);
-    MatrixX4I sT;
-    apply_sort(T,sJ,sT);
-    MatrixX3S lambda = 
-      sIT.rightCols(3).array() /
-      (sIT.rightCols(3).colwise()-sIT.col(0)).array();
-    vector<Triplet<BCType> > IJV;
-    IJV.reserve(m*3*2);
-    for(size_t c = 0;c<3;c++)
-    {
-      for(size_t t = 0;t<(size_t)m;t++)
+      const int mk = k==0 ? m13 : m31;
+      const int u0 = k==0 ? 0 : u31;
+      const int i = K(t,k);
+      sort_corners(k==0 ? 1 : -1,sIT,sT);
+      for(int c = 0;c<3;c++)
       {
-        IJV.push_back(Triplet<BCType>(c*m+t,  sT(t,0),  lambda(t,c)));
-        IJV.push_back(Triplet<BCType>(c*m+t,sT(t,c+1),1-lambda(t,c)));
+        set_row(
+          u0+c*mk+i,sT[0],sT[c+1],sIT[c+1]/(sIT[c+1]-sIT[0]));
       }
+      const int g = (k==0 ? 0 : g31) + i;
+      G.row(g) << u0+i, u0+mk+i, u0+2*mk+i;
+      J(g) = t;
     }
-    BC.resize(m*3,V.rows());
-    BC.reserve(m*3*2);
-    BC.setFromTriplets(IJV.begin(),IJV.end());
-    G.resize(m,3);
-    for(size_t c = 0;c<3;c++)
-    {
-      G.col(c) = 
-        igl::LinSpaced<
-        Eigen::Matrix<typename DerivedG::Scalar,Eigen::Dynamic,1> >
-        (m,0+c*m,(m-1)+c*m);
-    }
-  };
-
-  const auto & two_below = [&V,&apply_sort](
-    const MatrixX4I & T,
-    const MatrixX4S & IT,
-    MatrixX3I & G,
-    SparseMatrix<BCType> & BC)
-  {
-    // Number of tets
-    const size_t m = T.rows();
-    MatrixX4S sIT;
-    MatrixX4I sJ;
-    sort(IT,2,true,sIT,sJ);
-    MatrixX4I sT;
-    apply_sort(T,sJ,sT);
-    MatrixX2S lambda = 
-      sIT.rightCols(2).array() /
-      (sIT.rightCols(2).colwise()-sIT.col(0)).array();
-    MatrixX2S gamma = 
-      sIT.rightCols(2).array() /
-      (sIT.rightCols(2).colwise()-sIT.col(1)).array();
-    vector<Triplet<BCType> > IJV;
-    IJV.reserve(m*4*2);
-    for(size_t c = 0;c<2;c++)
+    // Two vertices below
+    if(K(t,2) >= 0)
     {
-      for(size_t t = 0;t<(size_t)m;t++)
+      const int i = K(t,2);
+      sort_corners(1,sIT,sT);
+      for(int c = 0;c<2;c++)
       {
-        IJV.push_back(Triplet<BCType>(0*2*m+c*m+t,  sT(t,0),  lambda(t,c)));
-        IJV.push_back(Triplet<BCType>(0*2*m+c*m+t,sT(t,c+2),1-lambda(t,c)));
-        IJV.push_back(Triplet<BCType>(1*2*m+c*m+t,  sT(t,1),   gamma(t,c)));
-        IJV.push_back(Triplet<BCType>(1*2*m+c*m+t,sT(t,c+2),1- gamma(t,c)));
+        set_row(
+          u22+c*m22+i,sT[0],sT[c+2],sIT[c+2]/(sIT[c+2]-sIT[0]));
+        set_row(
+          u22+2*m22+c*m22+i,sT[1],sT[c+2],sIT[c+2]/(sIT[c+2]-sIT[1]));
       }
+      G.row(g22+i) << u22+i, u22+m22+i, u22+3*m22+i;
+      G.row(g22+m22+i) << u22+i, u22+3*m22+i, u22+2*m22+i;
+      J(g22+i) = t;
+      J(g22+m22+i) = t;
     }
-    BC.resize(m*4,V.rows());
-    BC.reserve(m*4*2);
-    BC.setFromTriplets(IJV.begin(),IJV.end());
-    G.resize(2*m,3);
-    G.block(0,0,m,1) = igl::LinSpaced<VectorXI >(m,0+0*m,(m-1)+0*m);
-    G.block(0,1,m,1) = igl::LinSpaced<VectorXI >(m,0+1*m,(m-1)+1*m);
-    G.block(0,2,m,1) = igl::LinSpaced<VectorXI >(m,0+3*m,(m-1)+3*m);
-    G.block(m,0,m,1) = igl::LinSpaced<VectorXI >(m,0+0*m,(m-1)+0*m);
-    G.block(m,1,m,1) = igl::LinSpaced<VectorXI >(m,0+3*m,(m-1)+3*m);
-    G.block(m,2,m,1) = igl::LinSpaced<VectorXI >(m,0+2*m,(m-1)+2*m);
-  };
-
-  MatrixX3I G13,G31,G22;
-  SparseMatrix<BCType> BC13,BC31,BC22;
-  one_below(T13,IT13,G13,BC13);
-  one_below(T31,-IT31,G31,BC31);
-  two_below(T22,IT22,G22,BC22);
+  },1000);
+  BC.resize(nu,V.rows());
+  BC.reserve(2*nu);
+  BC.setFromTriplets(IJV.begin(),IJV.end());
 
-  BC = cat(1,cat(1,BC13,BC31),BC22);
-  U = BC*V;
-  G.resize(G13.rows()+G31.rows()+G22.rows(),3);
-  G<<G13,(G31.array()+BC13.rows()),(G22.array()+BC13.rows()+BC31.rows());
-  MatrixX3S N;
-  per_face_normals(U,G,N);
-  Matrix<Scalar,1,3> planeN(plane(0),plane(1),plane(2));
-  VectorXb flip = (N.array().rowwise() * planeN.array()).rowwise().sum()<0;
-  for(size_t g = 0;g<(size_t)G.rows();g++)
+  // Orient triangles to agree with the plane's normal
+  const RowVector3S planeN(plane(0),plane(1),plane(2));
+  parallel_for(ng,[&](const int g)
   {
-    if(flip(g))
+    const RowVector3S v1 = U.row(G(g,1))-U.row(G(g,0));
+    const RowVector3S v2 = U.row(G(g,2))-U.row(G(g,0));
+    RowVector3S N = v1.cross(v2);
+    const Scalar r = N.norm();
+    if(r != 0)
+    {
+      N /= r;
+    }
+    if(N.dot(planeN)<0)
     {
       G.row(g) = G.row(g).reverse().eval();
     }
-  }
-
-  J.resize(G.rows());
-  J<<J13,J31,J22,J22;
+  },10000);
 }
 
 #ifdef IGL_STATIC_LIBRARY
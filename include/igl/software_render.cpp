@@ -0,0 +1,609 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 agent <agent@local>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "software_render.h"
+#include "parallel_for.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace igl
+{
+  typedef Eigen::Matrix<float,3,1,Eigen::DontAlign> SoftwareRenderVector3;
+  typedef Eigen::Matrix<float,4,1,Eigen::DontAlign> SoftwareRenderVector4;
+  // Triangle or line corner: clip coordinates and (for triangles) the
+  // inputs of the mesh fragment shader, or (for lines) the color in Kd
+  struct SoftwareRenderCorner
+  {
+    SoftwareRenderVector4 clip;
+    SoftwareRenderVector3 eye,normal;
+    SoftwareRenderVector4 Ka,Kd,Ks;
+    static SoftwareRenderCorner lerp(
+      const SoftwareRenderCorner & a,
+      const SoftwareRenderCorner & b,
+      const float t)
+    {
+      SoftwareRenderCorner c;
+      c.clip = a.clip+t*(b.clip-a.clip);
+      c.eye = a.eye+t*(b.eye-a.eye);
+      c.normal = a.normal+t*(b.normal-a.normal);
+      c.Ka = a.Ka+t*(b.Ka-a.Ka);
+      c.Kd = a.Kd+t*(b.Kd-a.Kd);
+      c.Ks = a.Ks+t*(b.Ks-a.Ks);
+      return c;
+    }
+  };
+  // Clip the polygon P (n corners) against the near plane (z >= -w).
+  // Returns number of corners in the clipped polygon Q (at most n+1).
+  IGL_INLINE int software_render_clip_near(
+    const SoftwareRenderCorner * P,
+    const int n,
+    SoftwareRenderCorner * Q)
+  {
+    int m = 0;
+    for(int i = 0;i<n;i++)
+    {
+      const SoftwareRenderCorner & a = P[i];
+      const SoftwareRenderCorner & b = P[(i+1)%n];
+      const float da = a.clip(2)+a.clip(3);
+      const float db = b.clip(2)+b.clip(3);
+      if(da >= 0)
+      {
+        Q[m++] = a;
+      }
+      if((da >= 0) != (db >= 0))
+      {
+        Q[m++] = SoftwareRenderCorner::lerp(a,b,da/(da-db));
+      }
+    }
+    return m;
+  }
+  // Screen position (pixels, y up), depth in [0,1] and 1/w of a corner
+  IGL_INLINE SoftwareRenderVector4 software_render_window(
+    const SoftwareRenderCorner & c,
+    const int width,
+    const int height)
+  {
+    const float inv_w = 1.f/c.clip(3);
+    return SoftwareRenderVector4(
+      (c.clip(0)*inv_w*0.5f+0.5f)*width,
+      (c.clip(1)*inv_w*0.5f+0.5f)*height,
+      c.clip(2)*inv_w*0.5f+0.5f,
+      inv_w);
+  }
+  // Bin primitives 0..n-1 into tiles of a tile_size grid (nx by ny tiles).
+  // bbox(i,x0,y0,x1,y1) returns false if primitive i is not visible and
+  // otherwise its screen bounding box in pixels. Each tile's list is in
+  // increasing primitive order (threads bin contiguous ranges, listed in
+  // thread order).
+  template <typename BoxFunc>
+  IGL_INLINE void software_render_bin(
+    const int n,
+    const int tile_size,
+    const int nx,
+    const int ny,
+    const BoxFunc & bbox,
+    std::vector<std::vector<std::vector<int> > > & bins)
+  {
+    bins.clear();
+    parallel_for(
+      n,
+      [&](const size_t nthreads)
+      {
+        bins.resize(nthreads,std::vector<std::vector<int> >(nx*ny));
+      },
+      [&](const int i, const size_t t)
+      {
+        float x0,y0,x1,y1;
+        if(!bbox(i,x0,y0,x1,y1))
+        {
+          return;
+        }
+        const int tx0 = std::max(0,(int)std::floor(x0/tile_size));
+        const int ty0 = std::max(0,(int)std::floor(y0/tile_size));
+        const int tx1 = std::min(nx-1,(int)std::floor(x1/tile_size));
+        const int ty1 = std::min(ny-1,(int)std::floor(y1/tile_size));
+        for(int ty = ty0;ty<=ty1;ty++)
+        {
+          for(int tx = tx0;tx<=tx1;tx++)
+          {
+            bins[t][ty*nx+tx].push_back(i);
+          }
+        }
+      },
+      [](const size_t){},
+      1000);
+  }
+}
+
+IGL_INLINE void igl::software_render(
+  const Eigen::MatrixXd & V,
+  const Eigen::MatrixXi & F,
+  const Eigen::MatrixXd & N,
+  const Eigen::MatrixXd & Ka,
+  const Eigen::MatrixXd & Kd,
+  const Eigen::MatrixXd & Ks,
+  const Eigen::MatrixXd & lines,
+  const Eigen::MatrixXd & points,
+  const Eigen::Matrix4f & view,
+  const Eigen::Matrix4f & proj,
+  const software_render_params & params,
+  Eigen::Matrix<unsigned char,Eigen::Dynamic,Eigen::Dynamic>& R,
+  Eigen::Matrix<unsigned char,Eigen::Dynamic,Eigen::Dynamic>& G,
+  Eigen::Matrix<unsigned char,Eigen::Dynamic,Eigen::Dynamic>& B,
+  Eigen::Matrix<unsigned char,Eigen::Dynamic,Eigen::Dynamic>& A)
+{
+  using namespace Eigen;
+  using namespace std;
+  typedef SoftwareRenderCorner Corner;
+  typedef SoftwareRenderVector3 Vector3;
+  typedef SoftwareRenderVector4 Vector4;
+  assert(R.rows() == G.rows() && G.rows() == B.rows() && B.rows() == A.rows());
+  assert(R.cols() == G.cols() && G.cols() == B.cols() && B.cols() == A.cols());
+  const int width = R.rows();
+  const int height = R.cols();
+  if(width == 0 || height == 0)
+  {
+    return;
+  }
+
+  const Matrix3f normal_matrix =
+    (params.invert_normals?-1.f:1.f)*view.topLeftCorner<3,3>();
+  const Vector3f & light_eye = params.light_position;
+
+  // Frame buffer (pixel (x,y) at y*width+x), cleared to the background
+  vector<float> color(4*width*height);
+  vector<float> depth(width*height,1.f);
+  for(int p = 0;p<width*height;p++)
+  {
+    for(int k = 0;k<3;k++)
+    {
+      color[4*p+k] = params.background_color(k);
+    }
+    color[4*p+3] = 0;
+  }
+  // Blend (GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA) a fragment with depth z
+  // into pixel p if it passes the depth test (if any)
+  const auto fragment = [&](
+    const int p, const float z, const bool test, const Vector4f & c)
+  {
+    if(test)
+    {
+      if(!(z < depth[p]))
+      {
+        return;
+      }
+      depth[p] = z;
+    }
+    const Vector4f s = c.cwiseMax(0.f).cwiseMin(1.f);
+    for(int k = 0;k<4;k++)
+    {
+      color[4*p+k] = s(k)*s(3) + color[4*p+k]*(1.f-s(3));
+    }
+  };
+
+  // Vertices in eye and clip coordinates
+  const int nv = V.rows();
+  vector<Vector3> V_eye(nv);
+  vector<Vector4> V_clip(nv);
+  parallel_for(nv,[&](const int v)
+  {
+    const Vector4f e = view*Vector4f(V(v,0),V(v,1),V(v,2),1);
+    V_eye[v] = e.head<3>();
+    V_clip[v] = proj*e;
+  },10000);
+  const auto material = [](const MatrixXd & K, const int i)->Vector4
+  {
+    Vector4 k(0,0,0,1);
+    for(int c = 0;c<std::min<int>(K.cols(),4);c++)
+    {
+      k(c) = K(i,c);
+    }
+    return k;
+  };
+  const bool per_corner_normals = N.rows() == 3*F.rows();
+  // Corner c of face f with the attributes of the viewer's mesh shader
+  const auto face_corner = [&](const int f, const int c)->Corner
+  {
+    const int v = F(f,c);
+    Corner k;
+    k.clip = V_clip[v];
+    k.eye = V_eye[v];
+    Vector3f n;
+    if(params.face_based)
+    {
+      const int i = per_corner_normals ? 3*f+c : f;
+      n = N.row(i).transpose().cast<float>();
+      k.Ka = material(Ka,f);
+      k.Kd = material(Kd,f);
+      k.Ks = material(Ks,f);
+    }else
+    {
+      n = N.row(v).transpose().cast<float>();
+      k.Ka = material(Ka,v);
+      k.Kd = material(Kd,v);
+      k.Ks = material(Ks,v);
+    }
+    k.normal = (normal_matrix*n).normalized();
+    return k;
+  };
+  // Overlay line or point corner from a position and a color
+  const auto overlay_corner = [&](
+    const RowVector3d & x, const RowVector3d & rgb)->Corner
+  {
+    Corner k;
+    const Vector4f e = view*Vector4f(x(0),x(1),x(2),1);
+    k.eye = e.head<3>();
+    k.clip = proj*e;
+    k.Kd = Vector4(rgb(0),rgb(1),rgb(2),1);
+    return k;
+  };
+  // Mesh fragment shader
+  const auto shade = [&](const Corner & k)->Vector4f
+  {
+    const Vector3f Ia = k.Ka.head<3>();
+    const Vector3f L = (light_eye - Vector3f(k.eye)).normalized();
+    const Vector3f N = k.normal;
+    const float dot_prod = L.dot(N);
+    const Vector3f Id = k.Kd.head<3>()*std::max(dot_prod,0.f);
+    const Vector3f reflection = -L + 2.f*dot_prod*N;
+    const Vector3f to_viewer = (-Vector3f(k.eye)).normalized();
+    const float dot_prod_specular =
+      dot_prod >= 0 ? std::max(reflection.dot(to_viewer),0.f) : 0.f;
+    const Vector3f Is =
+      k.Ks.head<3>()*std::pow(dot_prod_specular,params.shininess);
+    Vector4f out;
+    out.head<3>() =
+      params.lighting_factor*(Is+Id) + Ia +
+      (1.f-params.lighting_factor)*k.Kd.head<3>();
+    out(3) = (k.Ka(3)+k.Ks(3)+k.Kd(3))/3.f;
+    return out;
+  };
+
+  // Tiles
+  const int tile_size = 32;
+  const int nx = (width+tile_size-1)/tile_size;
+  const int ny = (height+tile_size-1)/tile_size;
+  // Visible part of face f (near clipped) in window coordinates, returns
+  // number of corners
+  const auto face_polygon = [&](const int f, Corner * Q, Vector4 * W)->int
+  {
+    Corner P[3];
+    for(int c = 0;c<3;c++)
+    {
+      P[c] = face_corner(f,c);
+    }
+    const int m = software_render_clip_near(P,3,Q);
+    for(int c = 0;c<m;c++)
+    {
+      W[c] = software_render_window(Q[c],width,height);
+    }
+    return m;
+  };
+  // Near clipped segment in window coordinates, returns false if invisible
+  const auto segment = [&](Corner * P, Vector4 * W)->bool
+  {
+    for(int c = 0;c<2;c++)
+    {
+      if(P[c].clip(2)+P[c].clip(3) < 0)
+      {
+        const float da = P[c].clip(2)+P[c].clip(3);
+        const float db = P[1-c].clip(2)+P[1-c].clip(3);
+        if(db < 0)
+        {
+          return false;
+        }
+        P[c] = Corner::lerp(P[c],P[1-c],da/(da-db));
+      }
+    }
+    for(int c = 0;c<2;c++)
+    {
+      W[c] = software_render_window(P[c],width,height);
+    }
+    return true;
+  };
+  const auto polygon_box = [](
+    const Vector4 * W, const int m, const float pad,
+    float & x0, float & y0, float & x1, float & y1)
+  {
+    x0 = y0 = std::numeric_limits<float>::infinity();
+    x1 = y1 = -std::numeric_limits<float>::infinity();
+    for(int c = 0;c<m;c++)
+    {
+      x0 = std::min(x0,W[c](0)-pad);
+      y0 = std::min(y0,W[c](1)-pad);
+      x1 = std::max(x1,W[c](0)+pad);
+      y1 = std::max(y1,W[c](1)+pad);
+    }
+  };
+  const bool show_mesh =
+    nv > 0 && F.rows() > 0 && (params.show_faces || params.show_lines);
+  const float wire_half_width = 0.5f*std::max(params.line_width,1.f);
+  const float overlay_half_width = 0.5f*std::max(params.overlay_line_width,1.f);
+  const float point_radius = 0.5f*params.point_size;
+  vector<vector<vector<int> > > face_bins,line_bins,point_bins;
+  if(show_mesh)
+  {
+    software_render_bin(F.rows(),tile_size,nx,ny,
+      [&](const int f, float & x0, float & y0, float & x1, float & y1)
+      {
+        Corner Q[4];
+        Vector4 W[4];
+        const int m = face_polygon(f,Q,W);
+        polygon_box(W,m,wire_half_width,x0,y0,x1,y1);
+        return m > 0;
+      },face_bins);
+  }
+  if(params.show_overlay)
+  {
+    software_render_bin(lines.rows(),tile_size,nx,ny,
+      [&](const int l, float & x0, float & y0, float & x1, float & y1)
+      {
+        Corner P[2] = {
+          overlay_corner(lines.block<1,3>(l,0),lines.block<1,3>(l,6)),
+          overlay_corner(lines.block<1,3>(l,3),lines.block<1,3>(l,6))};
+        Vector4 W[2];
+        if(!segment(P,W))
+        {
+          return false;
+        }
+        polygon_box(W,2,overlay_half_width,x0,y0,x1,y1);
+        return true;
+      },line_bins);
+    software_render_bin(points.rows(),tile_size,nx,ny,
+      [&](const int i, float & x0, float & y0, float & x1, float & y1)
+      {
+        const Corner P =
+          overlay_corner(points.block<1,3>(i,0),points.block<1,3>(i,3));
+        if(P.clip(2)+P.clip(3) < 0)
+        {
+          return false;
+        }
+        const Vector4 W = software_render_window(P,width,height);
+        polygon_box(&W,1,point_radius,x0,y0,x1,y1);
+        return true;
+      },point_bins);
+  }
+
+  // Rasterize each tile: filled faces, wireframe, overlay lines, overlay
+  // points (the order of ViewerCore::draw)
+  parallel_for(nx*ny,[&](const int tile)
+  {
+    const int tx0 = (tile%nx)*tile_size;
+    const int ty0 = (tile/nx)*tile_size;
+    const int tx1 = std::min(tx0+tile_size,width);
+    const int ty1 = std::min(ty0+tile_size,height);
+    // Pixels of the tile whose centers are in [x0,x1]x[y0,y1]
+    const auto pixel_range = [&](
+      float x0, float y0, float x1, float y1,
+      int & px0, int & py0, int & px1, int & py1)
+    {
+      px0 = std::max(tx0,(int)std::ceil(x0-0.5f));
+      py0 = std::max(ty0,(int)std::ceil(y0-0.5f));
+      px1 = std::min(tx1-1,(int)std::floor(x1-0.5f));
+      py1 = std::min(ty1-1,(int)std::floor(y1-0.5f));
+    };
+    // Thick segment from W[0] to W[1] with color c
+    const auto draw_segment = [&](
+      const Vector4 * W, const float half_width, const bool test,
+      const Vector4f & c)
+    {
+      float x0,y0,x1,y1;
+      polygon_box(W,2,half_width,x0,y0,x1,y1);
+      int px0,py0,px1,py1;
+      pixel_range(x0,y0,x1,y1,px0,py0,px1,py1);
+      const Vector2f a = W[0].head<2>();
+      const Vector2f d = W[1].head<2>()-a;
+      const float dd = d.squaredNorm();
+      for(int y = py0;y<=py1;y++)
+      {
+        for(int x = px0;x<=px1;x++)
+        {
+          const Vector2f q = Vector2f(x+0.5f,y+0.5f)-a;
+          const float t = dd > 0 ? q.dot(d)/dd : 0.f;
+          if(t < 0 || t > 1 || (q-t*d).squaredNorm() > half_width*half_width)
+          {
+            continue;
+          }
+          const float z = W[0](2)+t*(W[1](2)-W[0](2));
+          if(z < 0 || z > 1)
+          {
+            continue;
+          }
+          fragment(y*width+x,z,test,c);
+        }
+      }
+    };
+    // Filled triangles (fan of the clipped polygon)
+    if(show_mesh && params.show_faces)
+    {
+      for(const auto & bin : face_bins)
+      {
+        for(const int f : bin[tile])
+        {
+          Corner Q[4];
+          Vector4 W[4];
+          const int m = face_polygon(f,Q,W);
+          for(int s = 1;s+1<m;s++)
+          {
+            const int I[3] = {0,s,s+1};
+            // Edge functions (positive inside for counter-clockwise order)
+            const float area =
+              (W[I[1]](0)-W[I[0]](0))*(W[I[2]](1)-W[I[0]](1))-
+              (W[I[2]](0)-W[I[0]](0))*(W[I[1]](1)-W[I[0]](1));
+            if(area == 0 || !std::isfinite(area))
+            {
+              continue;
+            }
+            const float sign = area > 0 ? 1.f : -1.f;
+            // Depth gradient for glPolygonOffset(1,1)
+            const float dzdx = (
+              (W[I[1]](2)-W[I[0]](2))*(W[I[2]](1)-W[I[0]](1))-
+              (W[I[2]](2)-W[I[0]](2))*(W[I[1]](1)-W[I[0]](1)))/area;
+            const float dzdy = (
+              (W[I[2]](2)-W[I[0]](2))*(W[I[1]](0)-W[I[0]](0))-
+              (W[I[1]](2)-W[I[0]](2))*(W[I[2]](0)-W[I[0]](0)))/area;
+            const float offset =
+              std::max(std::abs(dzdx),std::abs(dzdy)) + 1.f/(1<<24);
+            float x0,y0,x1,y1;
+            const Vector4 Wt[3] = {W[I[0]],W[I[1]],W[I[2]]};
+            polygon_box(Wt,3,0,x0,y0,x1,y1);
+            int px0,py0,px1,py1;
+            pixel_range(x0,y0,x1,y1,px0,py0,px1,py1);
+            // Top-left fill rule: pixels on an edge belong to the triangle
+            // if the edge is a left edge or a horizontal top edge
+            bool top_left[3];
+            for(int e = 0;e<3;e++)
+            {
+              const Vector4 & a = Wt[(e+1)%3];
+              const Vector4 & b = Wt[(e+2)%3];
+              const float dx = sign*(b(0)-a(0));
+              const float dy = sign*(b(1)-a(1));
+              top_left[e] = dy < 0 || (dy == 0 && dx < 0);
+            }
+            for(int y = py0;y<=py1;y++)
+            {
+              for(int x = px0;x<=px1;x++)
+              {
+                const float qx = x+0.5f;
+                const float qy = y+0.5f;
+                float b[3];
+                bool inside = true;
+                for(int e = 0;e<3 && inside;e++)
+                {
+                  const Vector4 & a = Wt[(e+1)%3];
+                  const Vector4 & c = Wt[(e+2)%3];
+                  b[e] = sign*((c(0)-a(0))*(qy-a(1))-(qx-a(0))*(c(1)-a(1)));
+                  inside = b[e] > 0 || (b[e] == 0 && top_left[e]);
+                }
+                if(!inside)
+                {
+                  continue;
+                }
+                const float sum = b[0]+b[1]+b[2];
+                const float z =
+                  (b[0]*Wt[0](2)+b[1]*Wt[1](2)+b[2]*Wt[2](2))/sum + offset;
+                if(z < 0 || z > 1)
+                {
+                  continue;
+                }
+                // Perspective correct interpolation
+                float w[3];
+                float wsum = 0;
+                for(int c = 0;c<3;c++)
+                {
+                  w[c] = b[c]*Wt[c](3);
+                  wsum += w[c];
+                }
+                Corner k = Q[I[0]];
+                k.eye *= w[0]/wsum;
+                k.normal *= w[0]/wsum;
+                k.Ka *= w[0]/wsum;
+                k.Kd *= w[0]/wsum;
+                k.Ks *= w[0]/wsum;
+                for(int c = 1;c<3;c++)
+                {
+                  const Corner & qc = Q[I[c]];
+                  k.eye += w[c]/wsum*qc.eye;
+                  k.normal += w[c]/wsum*qc.normal;
+                  k.Ka += w[c]/wsum*qc.Ka;
+                  k.Kd += w[c]/wsum*qc.Kd;
+                  k.Ks += w[c]/wsum*qc.Ks;
+                }
+                fragment(y*width+x,z,params.depth_test,shade(k));
+              }
+            }
+          }
+        }
+      }
+    }
+    // Wireframe
+    if(show_mesh && params.show_lines)
+    {
+      const Vector4f c(
+        params.line_color(0),params.line_color(1),params.line_color(2),1.f);
+      for(const auto & bin : face_bins)
+      {
+        for(const int f : bin[tile])
+        {
+          for(int e = 0;e<3;e++)
+          {
+            Corner P[2] = {face_corner(f,e),face_corner(f,(e+1)%3)};
+            Vector4 W[2];
+            if(segment(P,W))
+            {
+              draw_segment(W,wire_half_width,params.depth_test,c);
+            }
+          }
+        }
+      }
+    }
+    if(params.show_overlay)
+    {
+      for(const auto & bin : line_bins)
+      {
+        for(const int l : bin[tile])
+        {
+          Corner P[2] = {
+            overlay_corner(lines.block<1,3>(l,0),lines.block<1,3>(l,6)),
+            overlay_corner(lines.block<1,3>(l,3),lines.block<1,3>(l,6))};
+          Vector4 W[2];
+          if(segment(P,W))
+          {
+            draw_segment(
+              W,overlay_half_width,params.overlay_depth,Vector4f(P[0].Kd));
+          }
+        }
+      }
+      for(const auto & bin : point_bins)
+      {
+        for(const int i : bin[tile])
+        {
+          const Corner P =
+            overlay_corner(points.block<1,3>(i,0),points.block<1,3>(i,3));
+          const Vector4 W = software_render_window(P,width,height);
+          if(W(2) < 0 || W(2) > 1)
+          {
+            continue;
+          }
+          float x0,y0,x1,y1;
+          polygon_box(&W,1,point_radius,x0,y0,x1,y1);
+          int px0,py0,px1,py1;
+          pixel_range(x0,y0,x1,y1,px0,py0,px1,py1);
+          for(int y = py0;y<=py1;y++)
+          {
+            for(int x = px0;x<=px1;x++)
+            {
+              if((Vector2f(x+0.5f,y+0.5f)-W.head<2>()).squaredNorm() <=
+                point_radius*point_radius)
+              {
+                fragment(y*width+x,W(2),params.overlay_depth,Vector4f(P.Kd));
+              }
+            }
+          }
+        }
+      }
+    }
+  },1);
+
+  for(int y = 0;y<height;y++)
+  {
+    for(int x = 0;x<width;x++)
+    {
+      const float * c = &color[4*(y*width+x)];
+      const auto to_byte = [](const float v)->unsigned char
+      {
+        return (unsigned char)std::round(255.f*std::max(0.f,std::min(1.f,v)));
+      };
+      R(x,y) = to_byte(c[0]);
+      G(x,y) = to_byte(c[1]);
+      B(x,y) = to_byte(c[2]);
+      A(x,y) = to_byte(c[3]);
+    }
+  }
+}
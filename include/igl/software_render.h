@@ -0,0 +1,120 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 agent <agent@local>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_SOFTWARE_RENDER_H
+#define IGL_SOFTWARE_RENDER_H
+#include "igl_inline.h"
+#include <Eigen/Core>
+
+namespace igl
+{
+  struct software_render_params;
+  // SOFTWARE_RENDER Render a triangle mesh with overlay lines and points into
+  // an image on the CPU, without OpenGL (no context, window or display
+  // needed). Primitives are binned into screen tiles which are rasterized in
+  // parallel. Shading follows igl::viewer's shaders: Phong lighting with
+  // per-vertex or per-face ambient, diffuse and specular materials,
+  // wireframe lines (polygon offset), overlay lines and round overlay points,
+  // depth testing and alpha blending, drawn in that order.
+  //
+  // Inputs:
+  //   V  #V by 3 list of mesh vertex positions
+  //   F  #F by 3 list of triangle indices into V
+  //   N  #V by 3 list of vertex normals, or if params.face_based, #F by 3
+  //     list of face normals or 3*#F by 3 list of corner normals (corner c
+  //     of face f at 3*f+c)
+  //   Ka  #V (or #F if params.face_based) by 3 or 4 list of ambient colors
+  //     (alpha defaults to 1)
+  //   Kd  #V (or #F) by 3 or 4 list of diffuse colors
+  //   Ks  #V (or #F) by 3 or 4 list of specular colors
+  //   lines  #lines by 9 list of overlay segments [start end rgb]
+  //   points  #points by 6 list of overlay points [position rgb]
+  //   view  4 by 4 model-view matrix (e.g., from igl::look_at)
+  //   proj  4 by 4 projection matrix (e.g., from igl::frustum or igl::ortho)
+  //   params  struct of shading and visibility options (see below)
+  //   R,G,B,A  width by height images
+  // Outputs:
+  //   R,G,B,A  rendered image, first column is the bottom row (as in
+  //     png::writePNG); background has alpha 0
+  //
+  // See also: png::software_render_to_png, viewer::software_render
+  IGL_INLINE void software_render(
+    const Eigen::MatrixXd & V,
+    const Eigen::MatrixXi & F,
+    const Eigen::MatrixXd & N,
+    const Eigen::MatrixXd & Ka,
+    const Eigen::MatrixXd & Kd,
+    const Eigen::MatrixXd & Ks,
+    const Eigen::MatrixXd & lines,
+    const Eigen::MatrixXd & points,
+    const Eigen::Matrix4f & view,
+    const Eigen::Matrix4f & proj,
+    const software_render_params & params,
+    Eigen::Matrix<unsigned char,Eigen::Dynamic,Eigen::Dynamic>& R,
+    Eigen::Matrix<unsigned char,Eigen::Dynamic,Eigen::Dynamic>& G,
+    Eigen::Matrix<unsigned char,Eigen::Dynamic,Eigen::Dynamic>& B,
+    Eigen::Matrix<unsigned char,Eigen::Dynamic,Eigen::Dynamic>& A);
+}
+
+struct igl::software_render_params
+{
+  // Input parameters for software_render (defaults match
+  // igl::viewer::ViewerCore):
+  //   face_based  whether N and materials are per face {false}
+  //   show_faces  whether to draw filled faces {true}
+  //   show_lines  whether to draw the wireframe {true}
+  //   show_overlay  whether to draw lines and points {true}
+  //   depth_test  whether faces and wireframe are depth tested {true}
+  //   overlay_depth  whether lines and points are depth tested {true}
+  //   invert_normals  whether to flip N {false}
+  //   light_position  position of the light in eye coordinates {(0,0.3,0)}
+  //   lighting_factor  blend between Phong (1) and flat diffuse (0) {1}
+  //   shininess  specular exponent {35}
+  //   background_color  rgb of the cleared image {(0.3,0.3,0.5)}
+  //   line_color  rgb of the wireframe {(0,0,0)}
+  //   line_width  wireframe width in pixels (at least 1) {0.5}
+  //   overlay_line_width  overlay line width in pixels (at least 1) {1.6}
+  //   point_size  overlay point diameter in pixels {30}
+  bool face_based;
+  bool show_faces;
+  bool show_lines;
+  bool show_overlay;
+  bool depth_test;
+  bool overlay_depth;
+  bool invert_normals;
+  Eigen::Vector3f light_position;
+  float lighting_factor;
+  float shininess;
+  Eigen::Vector3f background_color;
+  Eigen::Vector3f line_color;
+  float line_width;
+  float overlay_line_width;
+  float point_size;
+  software_render_params():
+    face_based(false),
+    show_faces(true),
+    show_lines(true),
+    show_overlay(true),
+    depth_test(true),
+    overlay_depth(true),
+    invert_normals(false),
+    light_position(0.f,0.3f,0.f),
+    lighting_factor(1.f),
+    shininess(35.f),
+    background_color(0.3f,0.3f,0.5f),
+    line_color(0.f,0.f,0.f),
+    line_width(0.5f),
+    overlay_line_width(1.6f),
+    point_size(30.f)
+    {};
+};
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "software_render.cpp"
+#endif
+
+#endif
@@ -0,0 +1,167 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 agent <agent@local>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "sparse_order.h"
+#include <Eigen/OrderingMethods>
+#include <algorithm>
+#include <vector>
+
+template <typename Scalar, typename DerivedI>
+IGL_INLINE void igl::sparse_order(
+  const Eigen::SparseMatrix<Scalar> & A,
+  const SparseOrderType type,
+  Eigen::PlainObjectBase<DerivedI> & I)
+{
+  assert(A.rows() == A.cols() && "A should be square");
+  const int n = A.rows();
+  I.resize(n);
+  // Pattern of A+A' with full diagonal (Eigen's AMD needs the diagonal)
+  Eigen::SparseMatrix<int> S(n,n);
+  {
+    std::vector<Eigen::Triplet<int> > IJV;
+    IJV.reserve(2*A.nonZeros()+n);
+    for(int k = 0;k<A.outerSize();k++)
+    {
+      for(typename Eigen::SparseMatrix<Scalar>::InnerIterator it(A,k);it;++it)
+      {
+        IJV.emplace_back(it.row(),it.col(),1);
+        IJV.emplace_back(it.col(),it.row(),1);
+      }
+    }
+    for(int i = 0;i<n;i++)
+    {
+      IJV.emplace_back(i,i,1);
+    }
+    S.setFromTriplets(IJV.begin(),IJV.end());
+  }
+  switch(type)
+  {
+    default:
+      assert(false && "Unknown sparse order type");
+    case SPARSE_ORDER_TYPE_APPROXIMATE_MINIMUM_DEGREE:
+    {
+      // Eigen's ordering maps new indices to old ones
+      Eigen::AMDOrdering<int> amd;
+      Eigen::PermutationMatrix<Eigen::Dynamic,Eigen::Dynamic,int> P;
+      amd(S,P);
+      for(int i = 0;i<n;i++)
+      {
+        I(i) = P.indices()(i);
+      }
+      return;
+    }
+    case SPARSE_ORDER_TYPE_REVERSE_CUTHILL_MCKEE:
+    {
+      // Off-diagonal adjacency
+      std::vector<int> offsets(n+1,0);
+      std::vector<int> adj;
+      adj.reserve(S.nonZeros()-n);
+      for(int k = 0;k<n;k++)
+      {
+        for(Eigen::SparseMatrix<int>::InnerIterator it(S,k);it;++it)
+        {
+          if(it.row() != k)
+          {
+            adj.push_back(it.row());
+          }
+        }
+        offsets[k+1] = adj.size();
+      }
+      const auto degree = [&offsets](const int i)->int
+      {
+        return offsets[i+1]-offsets[i];
+      };
+      std::vector<int> level(n,-1);
+      // Breadth first search from s over not yet ordered vertices (level
+      // -1), neighbours in increasing degree. Appends to order (unless !keep),
+      // outputs the number of levels and returns the vertex of smallest degree
+      // in the last level
+      std::vector<int> order;
+      order.reserve(n);
+      std::vector<int> neighbours;
+      const auto bfs = [&](const int s, const bool keep, int & depth)->int
+      {
+        const size_t begin = order.size();
+        order.push_back(s);
+        level[s] = 0;
+        int last = s;
+        for(size_t h = begin;h<order.size();h++)
+        {
+          const int v = order[h];
+          neighbours.clear();
+          for(int k = offsets[v];k<offsets[v+1];k++)
+          {
+            if(level[adj[k]] < 0)
+            {
+              level[adj[k]] = level[v]+1;
+              neighbours.push_back(adj[k]);
+            }
+          }
+          std::sort(neighbours.begin(),neighbours.end(),
+            [&degree](const int a, const int b)
+            {
+              return degree(a) < degree(b) || (degree(a) == degree(b) && a<b);
+            });
+          order.insert(order.end(),neighbours.begin(),neighbours.end());
+          // Last level vertex of smallest degree
+          if(level[order.back()] > level[last] ||
+            (level[order.back()] == level[last] &&
+             degree(order.back()) < degree(last)))
+          {
+            last = order.back();
+          }
+        }
+        depth = level[order.back()];
+        if(!keep)
+        {
+          for(size_t h = begin;h<order.size();h++)
+          {
+            level[order[h]] = -1;
+          }
+          order.resize(begin);
+        }
+        return last;
+      };
+      for(int s = 0;s<n;s++)
+      {
+        if(level[s] >= 0)
+        {
+          continue;
+        }
+        // Pseudo-peripheral start vertex: restart from the far end of the
+        // search while the number of levels grows
+        int start = s;
+        int depth;
+        int far = bfs(start,false,depth);
+        for(int iter = 0;iter<8;iter++)
+        {
+          int far_depth;
+          const int far_far = bfs(far,false,far_depth);
+          if(far_depth <= depth)
+          {
+            break;
+          }
+          start = far;
+          depth = far_depth;
+          far = far_far;
+        }
+        bfs(start,true,depth);
+      }
+      for(int i = 0;i<n;i++)
+      {
+        I(i) = order[n-1-i];
+      }
+      return;
+    }
+  }
+}
+
+#ifdef IGL_STATIC_LIBRARY
+// Explicit template instantiation
+template void igl::sparse_order<double, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::SparseMatrix<double, 0, int> const&, igl::SparseOrderType, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
+template void igl::sparse_order<int, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::SparseMatrix<int, 0, int> const&, igl::SparseOrderType, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
+#endif
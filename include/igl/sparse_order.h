@@ -0,0 +1,46 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 agent <agent@local>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_SPARSE_ORDER_H
+#define IGL_SPARSE_ORDER_H
+#include "igl_inline.h"
+#include <Eigen/Core>
+#include <Eigen/Sparse>
+
+namespace igl
+{
+  enum SparseOrderType
+  {
+    // Reverse Cuthill-McKee: small bandwidth, good memory locality for
+    // sparse matrix products and iterative solvers
+    SPARSE_ORDER_TYPE_REVERSE_CUTHILL_MCKEE = 0,
+    // Approximate minimum degree: small fill-in of sparse Cholesky/LDLT
+    // factors (the ordering Eigen's simplicial solvers use by default)
+    SPARSE_ORDER_TYPE_APPROXIMATE_MINIMUM_DEGREE = 1,
+    NUM_SPARSE_ORDER_TYPES = 2
+  };
+  // SPARSE_ORDER Symmetric permutation of the rows and columns of a sparse
+  // matrix (or of the vertices of a graph, e.g., the adjacency matrix of a
+  // mesh, see igl::reorder_mesh).
+  //
+  // Inputs:
+  //   A  n by n sparse matrix, only the pattern of A+A' is used
+  //   type  ordering method
+  // Outputs:
+  //   I  n list of indices so that A(I,I) is the reordered matrix
+  template <typename Scalar, typename DerivedI>
+  IGL_INLINE void sparse_order(
+    const Eigen::SparseMatrix<Scalar> & A,
+    const SparseOrderType type,
+    Eigen::PlainObjectBase<DerivedI> & I);
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "sparse_order.cpp"
+#endif
+
+#endif
@@ -0,0 +1,128 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 agent <agent@local>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "spatial_order.h"
+#include "parallel_for.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+template <typename DerivedP, typename DerivedI>
+IGL_INLINE void igl::spatial_order(
+  const Eigen::MatrixBase<DerivedP> & P,
+  const SpatialOrderType type,
+  Eigen::PlainObjectBase<DerivedI> & I)
+{
+  typedef std::uint64_t Code;
+  const int n = P.rows();
+  const int dim = P.cols();
+  assert((n == 0 || dim == 2 || dim == 3) && "P.cols() should be 2 or 3");
+  // Spread the bits of x so that there are dim-1 zeros between them
+  const auto spread = [dim](Code x)->Code
+  {
+    if(dim == 3)
+    {
+      x &= 0x1fffffULL;
+      x = (x | x << 32) & 0x1f00000000ffffULL;
+      x = (x | x << 16) & 0x1f0000ff0000ffULL;
+      x = (x | x << 8) & 0x100f00f00f00f00fULL;
+      x = (x | x << 4) & 0x10c30c30c30c30c3ULL;
+      x = (x | x << 2) & 0x1249249249249249ULL;
+    }else
+    {
+      x &= 0xffffffffULL;
+      x = (x | x << 16) & 0x0000ffff0000ffffULL;
+      x = (x | x << 8) & 0x00ff00ff00ff00ffULL;
+      x = (x | x << 4) & 0x0f0f0f0f0f0f0f0fULL;
+      x = (x | x << 2) & 0x3333333333333333ULL;
+      x = (x | x << 1) & 0x5555555555555555ULL;
+    }
+    return x;
+  };
+  const int bits = dim == 3 ? 21 : 32;
+  const double max_q = std::pow(2.0,bits)-1;
+  std::vector<std::pair<Code,int> > codes(n);
+  if(n > 0)
+  {
+    const Eigen::RowVectorXd min_P =
+      P.colwise().minCoeff().template cast<double>();
+    const Eigen::RowVectorXd ext_P =
+      P.colwise().maxCoeff().template cast<double>()-min_P;
+    parallel_for(n,[&](const int i)
+    {
+      std::uint32_t X[3] = {0,0,0};
+      for(int d = 0;d<dim;d++)
+      {
+        const double t =
+          ext_P(d) > 0 ? (double(P(i,d))-min_P(d))/ext_P(d) : 0.0;
+        X[d] = std::uint32_t(t*max_q);
+      }
+      if(type == SPATIAL_ORDER_TYPE_HILBERT)
+      {
+        // Coordinates to "transposed" Hilbert index ("Programming the
+        // Hilbert curve" [Skilling 2004])
+        const std::uint32_t M = std::uint32_t(1) << (bits-1);
+        for(std::uint32_t Q = M;Q>1;Q >>= 1)
+        {
+          const std::uint32_t R = Q-1;
+          for(int d = 0;d<dim;d++)
+          {
+            if(X[d] & Q)
+            {
+              X[0] ^= R;
+            }else
+            {
+              const std::uint32_t t = (X[0]^X[d]) & R;
+              X[0] ^= t;
+              X[d] ^= t;
+            }
+          }
+        }
+        for(int d = 1;d<dim;d++)
+        {
+          X[d] ^= X[d-1];
+        }
+        std::uint32_t t = 0;
+        for(std::uint32_t Q = M;Q>1;Q >>= 1)
+        {
+          if(X[dim-1] & Q)
+          {
+            t ^= Q-1;
+          }
+        }
+        for(int d = 0;d<dim;d++)
+        {
+          X[d] ^= t;
+        }
+        // Most significant bit of each group comes from X[0]
+        std::reverse(X,X+dim);
+      }
+      Code code = 0;
+      for(int d = 0;d<dim;d++)
+      {
+        code |= spread(X[d]) << d;
+      }
+      codes[i] = std::make_pair(code,i);
+    },10000);
+  }
+  std::sort(codes.begin(),codes.end());
+  I.resize(n);
+  for(int i = 0;i<n;i++)
+  {
+    I(i) = codes[i].second;
+  }
+}
+
+#ifdef IGL_STATIC_LIBRARY
+// Explicit template instantiation
+template void igl::spatial_order<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, igl::SpatialOrderType, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
+template void igl::spatial_order<Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> > const&, igl::SpatialOrderType, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
+template void igl::spatial_order<Eigen::Matrix<float, -1, 3, 0, -1, 3>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, 3, 0, -1, 3> > const&, igl::SpatialOrderType, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
+#endif
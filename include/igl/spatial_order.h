@@ -0,0 +1,44 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 agent <agent@local>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_SPATIAL_ORDER_H
+#define IGL_SPATIAL_ORDER_H
+#include "igl_inline.h"
+#include <Eigen/Core>
+
+namespace igl
+{
+  enum SpatialOrderType
+  {
+    // Z-order curve
+    SPATIAL_ORDER_TYPE_MORTON = 0,
+    // Hilbert curve: consecutive points are always neighbours on the curve,
+    // slightly better locality than Morton order
+    SPATIAL_ORDER_TYPE_HILBERT = 1,
+    NUM_SPATIAL_ORDER_TYPES = 2
+  };
+  // SPATIAL_ORDER Order points along a space filling curve through their
+  // bounding box, so that points close in space end up close in memory
+  // (e.g., to reorder mesh vertices, see igl::reorder_mesh).
+  //
+  // Inputs:
+  //   P  #P by dim (2 or 3) list of points
+  //   type  space filling curve
+  // Outputs:
+  //   I  #P list of indices into P so that P(I,:) is sorted along the curve
+  template <typename DerivedP, typename DerivedI>
+  IGL_INLINE void spatial_order(
+    const Eigen::MatrixBase<DerivedP> & P,
+    const SpatialOrderType type,
+    Eigen::PlainObjectBase<DerivedI> & I);
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "spatial_order.cpp"
+#endif
+
+#endif
@@ -0,0 +1,403 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 agent <agent@local>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "subdivide.h"
+#include "parallel_for.h"
+#include "triangle_triangle_adjacency.h"
+#include <algorithm>
+#include <utility>
+
+namespace igl
+{
+  // Vertex rings of a triangle mesh given as half-edges h = 3*f+j (from
+  // F[h] to F[3*f+(j+1)%3]) and their twins (-1 on the boundary)
+  struct subdivide_rings
+  {
+    // Neighbors of vertex v are ring[offsets[v]...offsets[v+1]-1] (sorted)
+    std::vector<int> offsets;
+    std::vector<int> ring;
+    // Neighbors along the boundary (-1 for interior vertices): target of an
+    // outgoing and source of an incoming boundary half-edge
+    std::vector<int> front;
+    std::vector<int> back;
+  };
+
+  inline void subdivide_compute_rings(
+    const int nv,
+    const std::vector<int> & F,
+    const std::vector<int> & TW,
+    subdivide_rings & R)
+  {
+    const int nh = F.size();
+    // Outgoing half-edges of each vertex (counting sort)
+    std::vector<int> out_offsets(nv+1,0);
+    for(int h = 0;h<nh;h++)
+    {
+      out_offsets[F[h]+1]++;
+    }
+    for(int v = 0;v<nv;v++)
+    {
+      out_offsets[v+1] += out_offsets[v];
+    }
+    std::vector<int> out(nh);
+    {
+      std::vector<int> fill(out_offsets.begin(),out_offsets.end()-1);
+      for(int h = 0;h<nh;h++)
+      {
+        out[fill[F[h]]++] = h;
+      }
+    }
+    const auto next = [](const int h){ return h - h%3 + (h%3+1)%3; };
+    const auto prev = [](const int h){ return h - h%3 + (h%3+2)%3; };
+    R.front.assign(nv,-1);
+    R.back.assign(nv,-1);
+    // Gather neighbors of v into scratch
+    const auto gather = [&](const int v, std::vector<int> & scratch)
+    {
+      scratch.clear();
+      for(int o = out_offsets[v];o<out_offsets[v+1];o++)
+      {
+        const int h = out[o];
+        scratch.push_back(F[next(h)]);
+        if(TW[h] < 0 && R.front[v] < 0)
+        {
+          R.front[v] = F[next(h)];
+        }
+        // incoming half-edge of the same face
+        const int p = prev(h);
+        if(TW[p] < 0)
+        {
+          scratch.push_back(F[p]);
+          if(R.back[v] < 0)
+          {
+            R.back[v] = F[p];
+          }
+        }
+      }
+      std::sort(scratch.begin(),scratch.end());
+      scratch.erase(std::unique(scratch.begin(),scratch.end()),scratch.end());
+    };
+    std::vector<std::vector<int> > scratch;
+    const auto prep = [&](const size_t nthreads){ scratch.resize(nthreads); };
+    const auto no_op = [](const size_t){};
+    R.offsets.assign(nv+1,0);
+    parallel_for(nv,prep,[&](const int v, const size_t t)
+    {
+      gather(v,scratch[t]);
+      R.offsets[v+1] = scratch[t].size();
+    },no_op,1000);
+    for(int v = 0;v<nv;v++)
+    {
+      R.offsets[v+1] += R.offsets[v];
+    }
+    R.ring.resize(R.offsets[nv]);
+    parallel_for(nv,prep,[&](const int v, const size_t t)
+    {
+      gather(v,scratch[t]);
+      std::copy(scratch[t].begin(),scratch[t].end(),R.ring.begin()+R.offsets[v]);
+    },no_op,1000);
+  }
+
+  // Fill the rows of a stencil: row(i,I,W) writes the (unsorted) entries of
+  // row i to I and W and returns their number; size(i) bounds that number.
+  template <typename Scalar, typename SizeFunc, typename RowFunc>
+  inline void subdivide_fill_stencil(
+    const int n_in,
+    const int n_out,
+    const SizeFunc & size,
+    const RowFunc & row,
+    typename subdivide_data<Scalar>::Stencil & S)
+  {
+    S.n_in = n_in;
+    S.offsets.assign(n_out+1,0);
+    for(int i = 0;i<n_out;i++)
+    {
+      S.offsets[i+1] = S.offsets[i] + size(i);
+    }
+    S.indices.resize(S.offsets[n_out]);
+    S.weights.resize(S.offsets[n_out]);
+    parallel_for(n_out,[&](const int i)
+    {
+      int * I = S.indices.data()+S.offsets[i];
+      Scalar * W = S.weights.data()+S.offsets[i];
+      const int n = row(i,I,W);
+      assert(n == S.offsets[i+1]-S.offsets[i]);
+      // Sort by index (insertion sort: rows are short), so that entries are
+      // accumulated in the same order as a column major sparse product
+      for(int k = 1;k<n;k++)
+      {
+        for(int l = k;l>0 && I[l-1] > I[l];l--)
+        {
+          std::swap(I[l-1],I[l]);
+          std::swap(W[l-1],W[l]);
+        }
+      }
+    },1000);
+  }
+}
+
+template <typename DerivedF, typename Scalar>
+IGL_INLINE void igl::subdivide_precompute(
+  const int n_verts,
+  const Eigen::MatrixBase<DerivedF> & F0,
+  const SubdivisionType type,
+  const int number_of_subdivs,
+  const bool limit,
+  subdivide_data<Scalar> & data)
+{
+  using namespace std;
+  assert(F0.cols() == 3 && "F should contain triangles");
+  typedef typename subdivide_data<Scalar>::Stencil Stencil;
+  const bool loop = type == SUBDIVISION_TYPE_LOOP;
+  data.stencils.clear();
+  data.stencils.reserve(number_of_subdivs+1);
+
+  // Current level: number of vertices, half-edges h = 3*f+j from F[h] to
+  // F[3*f+(j+1)%3] and their twins
+  int nv = n_verts;
+  vector<int> F(F0.rows()*3);
+  vector<int> TW(F0.rows()*3);
+  {
+    Eigen::MatrixXi F0i = F0.template cast<int>();
+    Eigen::MatrixXi FF,FFi;
+    triangle_triangle_adjacency(F0i,FF,FFi);
+    parallel_for(F0i.rows(),[&](const int f)
+    {
+      for(int j = 0;j<3;j++)
+      {
+        F[3*f+j] = F0i(f,j);
+        TW[3*f+j] = FF(f,j) < 0 ? -1 : 3*FF(f,j)+FFi(f,j);
+      }
+    },10000);
+  }
+
+  subdivide_rings R;
+  for(int level = 0;level<number_of_subdivs;level++)
+  {
+    const int m = F.size()/3;
+    const int nh = F.size();
+    // Edge vertices: numbered in order of their first half-edge (the one
+    // with the smaller index, or the only one on the boundary)
+    vector<int> EV(nh);
+    int ne = 0;
+    for(int h = 0;h<nh;h++)
+    {
+      if(TW[h] < 0 || h < TW[h])
+      {
+        EV[h] = ne++;
+      }
+    }
+    vector<int> owner(ne);
+    parallel_for(nh,[&](const int h)
+    {
+      if(TW[h] < 0 || h < TW[h])
+      {
+        owner[EV[h]] = h;
+      }else
+      {
+        EV[h] = EV[TW[h]];
+      }
+    },10000);
+
+    // Stencils
+    data.stencils.push_back(Stencil());
+    Stencil & S = data.stencils.back();
+    if(loop)
+    {
+      subdivide_compute_rings(nv,F,TW,R);
+    }
+    const auto size = [&](const int i)->int
+    {
+      if(i < nv)
+      {
+        if(!loop)
+        {
+          return 1;
+        }
+        if(R.front[i] >= 0)
+        {
+          return 3;
+        }
+        return R.offsets[i+1]-R.offsets[i]+1;
+      }
+      const int h = owner[i-nv];
+      return loop && TW[h] >= 0 ? 4 : 2;
+    };
+    const auto row = [&](const int i, int * I, Scalar * W)->int
+    {
+      if(i < nv)
+      {
+        // Old vertices
+        if(!loop)
+        {
+          I[0] = i; W[0] = 1.;
+          return 1;
+        }
+        if(R.front[i] >= 0)
+        {
+          I[0] = R.front[i]; W[0] = 1./8.;
+          I[1] = R.back[i]; W[1] = 1./8.;
+          I[2] = i; W[2] = 3./4.;
+          return 3;
+        }
+        const int n = R.offsets[i+1]-R.offsets[i];
+        if(n == 0)
+        {
+          // unreferenced
+          I[0] = i; W[0] = 1.;
+          return 1;
+        }
+        const Scalar dn = n;
+        const Scalar beta = n==3 ? Scalar(3./16.) : Scalar(3./8./dn);
+        for(int k = 0;k<n;k++)
+        {
+          I[k] = R.ring[R.offsets[i]+k]; W[k] = beta;
+        }
+        I[n] = i; W[n] = 1.-dn*beta;
+        return n+1;
+      }
+      // New vertices on edges
+      const int h = owner[i-nv];
+      const int a = F[h];
+      const int b = F[h - h%3 + (h%3+1)%3];
+      if(!loop || TW[h] < 0)
+      {
+        I[0] = a; W[0] = 1./2.;
+        I[1] = b; W[1] = 1./2.;
+        return 2;
+      }
+      const int t = TW[h];
+      I[0] = a; W[0] = 3./8.;
+      I[1] = b; W[1] = 3./8.;
+      I[2] = F[h - h%3 + (h%3+2)%3]; W[2] = 1./8.;
+      I[3] = F[t - t%3 + (t%3+2)%3]; W[3] = 1./8.;
+      return 4;
+    };
+    subdivide_fill_stencil<Scalar>(nv,nv+ne,size,row,S);
+
+    // Next level: every face is replaced by four (same order as igl::loop
+    // and igl::upsample), twins follow from the previous level's twins
+    vector<int> NF(4*nh);
+    vector<int> NTW(4*nh);
+    // Half-edges (child*3+side within the four children) that are the start
+    // and end half of each side of the parent
+    const int start[3] = {0*3+0,1*3+0,3*3+1};
+    const int end[3] = {1*3+2,3*3+0,0*3+2};
+    parallel_for(m,[&](const int f)
+    {
+      const int a = F[3*f+0], b = F[3*f+1], c = F[3*f+2];
+      const int e0 = nv+EV[3*f+0], e1 = nv+EV[3*f+1], e2 = nv+EV[3*f+2];
+      int * C = NF.data()+12*f;
+      C[0] = a;  C[1] = e0; C[2] = e2;
+      C[3] = b;  C[4] = e1; C[5] = e0;
+      C[6] = e0; C[7] = e1; C[8] = e2;
+      C[9] = e1; C[10]= c;  C[11]= e2;
+      int * T = NTW.data()+12*f;
+      for(int j = 0;j<3;j++)
+      {
+        const int t = TW[3*f+j];
+        if(t < 0)
+        {
+          T[start[j]] = -1;
+          T[end[j]] = -1;
+        }else
+        {
+          const int g = t/3, k = t%3;
+          T[start[j]] = 12*g+end[k];
+          T[end[j]] = 12*g+start[k];
+        }
+      }
+      T[0*3+1] = 12*f+2*3+2; T[2*3+2] = 12*f+0*3+1;
+      T[1*3+1] = 12*f+2*3+0; T[2*3+0] = 12*f+1*3+1;
+      T[3*3+2] = 12*f+2*3+1; T[2*3+1] = 12*f+3*3+2;
+    },10000);
+    nv += ne;
+    F.swap(NF);
+    TW.swap(NTW);
+  }
+
+  if(limit && loop)
+  {
+    // Loop limit masks: interior vertices of valence n move to
+    // (1-n*chi)*v + chi*sum(neighbors), chi = 1/(3/(8*beta)+n); boundary
+    // vertices to (1/6, 2/3, 1/6) of their boundary neighbors
+    subdivide_compute_rings(nv,F,TW,R);
+    data.stencils.push_back(Stencil());
+    const auto size = [&](const int i)->int
+    {
+      return R.front[i] >= 0 ? 3 : R.offsets[i+1]-R.offsets[i]+1;
+    };
+    const auto row = [&](const int i, int * I, Scalar * W)->int
+    {
+      if(R.front[i] >= 0)
+      {
+        I[0] = R.front[i]; W[0] = 1./6.;
+        I[1] = R.back[i]; W[1] = 1./6.;
+        I[2] = i; W[2] = 2./3.;
+        return 3;
+      }
+      const int n = R.offsets[i+1]-R.offsets[i];
+      if(n == 0)
+      {
+        I[0] = i; W[0] = 1.;
+        return 1;
+      }
+      const Scalar dn = n;
+      const Scalar beta = n==3 ? Scalar(3./16.) : Scalar(3./8./dn);
+      const Scalar chi = 1./(3./(8.*beta)+dn);
+      for(int k = 0;k<n;k++)
+      {
+        I[k] = R.ring[R.offsets[i]+k]; W[k] = chi;
+      }
+      I[n] = i; W[n] = 1.-dn*chi;
+      return n+1;
+    };
+    subdivide_fill_stencil<Scalar>(nv,nv,size,row,data.stencils.back());
+  }
+
+  data.F.resize(F.size()/3,3);
+  parallel_for(data.F.rows(),[&](const int f)
+  {
+    for(int j = 0;j<3;j++)
+    {
+      data.F(f,j) = F[3*f+j];
+    }
+  },10000);
+}
+
+template <typename Scalar, typename DerivedV, typename DerivedNV>
+IGL_INLINE void igl::subdivide(
+  const subdivide_data<Scalar> & data,
+  const Eigen::MatrixBase<DerivedV> & V,
+  Eigen::PlainObjectBase<DerivedNV> & NV)
+{
+  typedef Eigen::Matrix<Scalar,Eigen::Dynamic,Eigen::Dynamic> MatrixS;
+  MatrixS X = V.template cast<Scalar>();
+  MatrixS Y;
+  for(const auto & S : data.stencils)
+  {
+    assert(X.rows() == S.n_in && "V should match stencils");
+    const int n_out = S.offsets.size()-1;
+    Y.resize(n_out,X.cols());
+    parallel_for(n_out,[&](const int i)
+    {
+      Y.row(i).setZero();
+      for(int k = S.offsets[i];k<S.offsets[i+1];k++)
+      {
+        Y.row(i) += S.weights[k]*X.row(S.indices[k]);
+      }
+    },1000);
+    X.swap(Y);
+  }
+  NV = X.template cast<typename DerivedNV::Scalar>();
+}
+
+#ifdef IGL_STATIC_LIBRARY
+// Explicit template instantiation
+template void igl::subdivide_precompute<Eigen::Matrix<int, -1, -1, 0, -1, -1>, double>(int, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, igl::SubdivisionType, int, bool, igl::subdivide_data<double>&);
+template void igl::subdivide<double, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(igl::subdivide_data<double> const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&);
+#endif
@@ -0,0 +1,95 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 agent <agent@local>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_SUBDIVIDE_H
+#define IGL_SUBDIVIDE_H
+#include "igl_inline.h"
+#include <Eigen/Core>
+#include <vector>
+
+namespace igl
+{
+  enum SubdivisionType
+  {
+    // Edge midpoints, vertices stay put (see igl::upsample)
+    SUBDIVISION_TYPE_UPSAMPLE = 0,
+    // Loop subdivision (see igl::loop)
+    SUBDIVISION_TYPE_LOOP = 1,
+    NUM_SUBDIVISION_TYPES = 2
+  };
+  template <typename Scalar>
+  struct subdivide_data;
+  // SUBDIVIDE_PRECOMPUTE Precompute the topology and the vertex stencils of
+  // several levels of 1-to-4 subdivision of a triangle mesh, so that the
+  // scheme can be applied to new vertex positions (e.g., every frame of an
+  // animated cage) with igl::subdivide. Each level's face adjacency is
+  // derived directly from the previous level's (only the input mesh's is
+  // computed from scratch), and the stencils are stored in compressed row
+  // form instead of as sparse subdivision matrices.
+  //
+  // The result is identical to igl::loop/igl::upsample (same faces, same
+  // vertex order, same arithmetic).
+  //
+  // Inputs:
+  //   n_verts  number of mesh vertices
+  //   F  #F by 3 list of triangle indices into vertices
+  //   type  subdivision scheme
+  //   number_of_subdivs  number of subdivision levels
+  //   limit  whether to append a final stencil moving all vertices of the
+  //     last level to their limit positions (Loop limit masks; vertices stay
+  //     put for upsample). With number_of_subdivs = 0 this only evaluates the
+  //     limit positions of the input vertices.
+  // Outputs:
+  //   data  precomputed stencils and the faces of the last level in data.F
+  //
+  // Known issues:
+  //   - assumes F is edge-manifold (as igl::loop and igl::upsample).
+  template <typename DerivedF, typename Scalar>
+  IGL_INLINE void subdivide_precompute(
+    const int n_verts,
+    const Eigen::MatrixBase<DerivedF> & F,
+    const SubdivisionType type,
+    const int number_of_subdivs,
+    const bool limit,
+    subdivide_data<Scalar> & data);
+  // SUBDIVIDE Apply precomputed subdivision stencils to vertex positions
+  //
+  // Inputs:
+  //   data  precomputed stencils (see subdivide_precompute)
+  //   V  n_verts by dim list of vertex positions
+  // Outputs:
+  //   NV  #NV by dim list of subdivided vertex positions (faces are data.F)
+  template <typename Scalar, typename DerivedV, typename DerivedNV>
+  IGL_INLINE void subdivide(
+    const subdivide_data<Scalar> & data,
+    const Eigen::MatrixBase<DerivedV> & V,
+    Eigen::PlainObjectBase<DerivedNV> & NV);
+}
+
+template <typename Scalar>
+struct igl::subdivide_data
+{
+  // Weights of output vertex i are weights[offsets[i]...offsets[i+1]-1] of
+  // input vertices indices[offsets[i]...offsets[i+1]-1] (sorted)
+  struct Stencil
+  {
+    int n_in;
+    std::vector<int> offsets;
+    std::vector<int> indices;
+    std::vector<Scalar> weights;
+  };
+  // One stencil per level (and one for the limit positions, if requested)
+  std::vector<Stencil> stencils;
+  // Faces of the last level
+  Eigen::MatrixXi F;
+};
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "subdivide.cpp"
+#endif
+
+#endif
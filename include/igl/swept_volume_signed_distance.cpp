@@ -10,6 +10,8 @@
 #include "flood_fill.h"
 #include "signed_distance.h"
 #include "AABB.h"
+#include "parallel_for.h"
+#include "point_simplex_squared_distance.h"
 #include "pseudonormal_test.h"
 #include "per_face_normals.h"
 #include "per_vertex_normals.h"
@@ -17,6 +19,7 @@
 #include <Eigen/Geometry>
 #include <cmath>
 #include <algorithm>
+#include <vector>
 
 IGL_INLINE void igl::swept_volume_signed_distance(
   const Eigen::MatrixXd & V,
@@ -50,45 +53,123 @@ IGL_INLINE void igl::swept_volume_signed_distance(
     V,F,PER_EDGE_NORMALS_WEIGHTING_TYPE_UNIFORM,FN,EN,E,EMAP);
   AABB<MatrixXd,3> tree;
   tree.init(V,F);
+  // Inverse rigid transformations (transform need not be thread-safe):
+  // grid point g at time t(ti) is (GV.row(g)-T[ti])*R[ti] in the reference
+  // pose
+  vector<Matrix3d> R(t.size());
+  vector<RowVector3d> T(t.size());
   for(int ti = 0;ti<t.size();ti++)
   {
     const Affine3d At = transform(t(ti));
-    for(int g = 0;g<GV.rows();g++)
+    R[ti] = At.linear();
+    T[ti] = At.translation().transpose();
+  }
+  // Only distances less than cap affect S
+  const double cap = 
+    finite_iso ? sqrt(3.)*h+isolevel : numeric_limits<double>::infinity();
+  const double cap_sqrd = cap*cap;
+  // Each grid point visits the time steps in order (so the result is the
+  // same as visiting all grid points one time step at a time). The signed
+  // distance to (V,F) is 1-Lipschitz, so the value at a time step is bounded
+  // by the value at the last evaluated step and the distance the grid point
+  // moved since (in the reference pose). Steps that cannot decrease S(g) are
+  // skipped. Blocks of consecutive grid points are processed in parallel,
+  // one time step at a time so that queries of neighbouring grid points are
+  // coherent.
+  const int block = 256;
+  const int num_blocks = (GV.rows()+block-1)/block;
+  parallel_for(num_blocks,[&](const int bi)
+  {
+    const int g0 = bi*block;
+    const int g1 = std::min<int>(g0+block,GV.rows());
+    // Per grid point: whether it is done (deep inside), last evaluated
+    // position, lower bound on the signed distance there and closest face
+    vector<bool> done(g1-g0,false);
+    vector<RowVector3d> ref(g1-g0);
+    vector<double> s_ref(g1-g0,-numeric_limits<double>::infinity());
+    vector<int> i_prev(g1-g0,-1);
+    for(int ti = 0;ti<t.size();ti++)
     {
-      // Don't bother finding out how deep inside points are.
-      if(finite_iso && S(g)==S(g) && S(g)<isolevel-sqrt(3.0)*h)
+      for(int g = g0;g<g1;g++)
       {
-        continue;
-      }
-      const RowVector3d gv = 
-        (GV.row(g) - At.translation().transpose())*At.linear();
-      // If outside of extended box, then consider it "far away enough"
-      if(finite_iso && !box.contains(gv.transpose()))
-      {
-        continue;
-      }
-      RowVector3d c,n;
-      int i;
-      double sqrd,s;
-      //signed_distance_pseudonormal(tree,V,F,FN,VN,EN,EMAP,gv,s,sqrd,i,c,n);
-      const double min_sqrd = 
-        finite_iso ? 
-        pow(sqrt(3.)*h+isolevel,2) : 
-        numeric_limits<double>::infinity();
-      sqrd = tree.squared_distance(V,F,gv,min_sqrd,i,c);
-      if(sqrd<min_sqrd)
-      {
-        pseudonormal_test(V,F,FN,VN,EN,EMAP,gv,i,c,s,n);
-        if(S(g) == S(g))
+        const int k = g-g0;
+        if(done[k])
+        {
+          continue;
+        }
+        // Don't bother finding out how deep inside points are. (S(g) only
+        // decreases so this holds for all remaining steps.)
+        if(finite_iso && S(g)==S(g) && S(g)<isolevel-sqrt(3.0)*h)
+        {
+          done[k] = true;
+          continue;
+        }
+        const RowVector3d gv = (GV.row(g) - T[ti])*R[ti];
+        // If outside of extended box, then consider it "far away enough"
+        if(finite_iso && !box.contains(gv.transpose()))
         {
-          S(g) = std::min(S(g),s*sqrt(sqrd));
-        }else
+          continue;
+        }
+        if(S(g)==S(g) && s_ref[k]-(gv-ref[k]).norm() >= S(g))
         {
-          S(g) = s*sqrt(sqrd);
+          continue;
+        }
+        // Closest point, warm-started with the closest face of the last
+        // evaluated step
+        RowVector3d c,n;
+        int i = -1;
+        double sqrd = cap_sqrd;
+        if(i_prev[k] >= 0)
+        {
+          double sqrd_prev;
+          RowVector3d c_prev;
+          point_simplex_squared_distance<3>(gv,V,F,i_prev[k],sqrd_prev,c_prev);
+          if(sqrd_prev < sqrd)
+          {
+            sqrd = sqrd_prev;
+            i = i_prev[k];
+            c = c_prev;
+          }
+        }
+        {
+          int j = -1;
+          RowVector3d cj;
+          // inflated slightly so that roundoff never misses the warm start
+          const double sqrdj = tree.squared_distance(
+            V,F,gv,i>=0 ? sqrd*(1+1e-8) : sqrd,j,cj);
+          if(j >= 0 && sqrdj < sqrd)
+          {
+            sqrd = sqrdj;
+            i = j;
+            c = cj;
+          }
+        }
+        ref[k] = gv;
+        s_ref[k] = -numeric_limits<double>::infinity();
+        if(i >= 0)
+        {
+          i_prev[k] = i;
+          const double d = sqrt(sqrd);
+          s_ref[k] = -d;
+          // The sign only matters if -d could decrease S(g)
+          if(S(g) == S(g) && -d >= S(g))
+          {
+            continue;
+          }
+          double s;
+          pseudonormal_test(V,F,FN,VN,EN,EMAP,gv,i,c,s,n);
+          s_ref[k] = s*d;
+          if(S(g) == S(g))
+          {
+            S(g) = std::min(S(g),s_ref[k]);
+          }else
+          {
+            S(g) = s_ref[k];
+          }
         }
       }
     }
-  }
+  },2);
 
   if(finite_iso)
   {
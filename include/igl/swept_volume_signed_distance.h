@@ -15,7 +15,10 @@ namespace igl
 {
   // Compute the signed distance to a sweep surface of a mesh under-going
   // an arbitrary motion V(t) discretely sampled at `steps`-many moments in
-  // time at a grid.
+  // time at a grid. Grid points are processed in parallel; time steps at
+  // which a grid point cannot have moved close enough to decrease its value
+  // are skipped (this assumes (V,F) is closed so that its signed distance is
+  // 1-Lipschitz).
   //
   // Inputs:
   //   V  #V by 3 list of mesh positions in reference pose
@@ -0,0 +1,85 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 agent <agent@local>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "tet_quality.h"
+#include "parallel_for.h"
+#include <Eigen/Geometry>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+template <
+  typename DerivedV,
+  typename DerivedT,
+  typename Derivedvol,
+  typename Derivedtheta,
+  typename Derivedrho>
+IGL_INLINE void igl::tet_quality(
+  const Eigen::MatrixBase<DerivedV>& V,
+  const Eigen::MatrixBase<DerivedT>& T,
+  Eigen::PlainObjectBase<Derivedvol>& vol,
+  Eigen::PlainObjectBase<Derivedtheta>& theta,
+  Eigen::PlainObjectBase<Derivedrho>& rho)
+{
+  typedef typename DerivedV::Scalar Scalar;
+  typedef Eigen::Matrix<Scalar,1,3> RowVector3S;
+  assert(V.cols() == 3 && "V should be #V by 3");
+  assert(T.cols() == 4 && "T should be #T by 4");
+  const int m = T.rows();
+  vol.resize(m,1);
+  theta.resize(m,6);
+  rho.resize(m,1);
+  // Faces opposite each corner, consistently oriented (see boundary_facets)
+  const int faces[4][3] = {{1,3,2},{0,2,3},{0,3,1},{0,1,2}};
+  // Pairs of faces meeting at each edge (see dihedral_angles_intrinsic)
+  const int pairs[6][2] = {{1,2},{2,0},{0,1},{3,0},{3,1},{3,2}};
+  parallel_for(m,[&](const int t)
+  {
+    RowVector3S p[4];
+    for(int c = 0;c<4;c++)
+    {
+      p[c] = V.row(T(t,c));
+    }
+    const RowVector3S a = p[0]-p[3];
+    const RowVector3S b = p[1]-p[3];
+    const RowVector3S c = p[2]-p[3];
+    const Scalar six_vol = -a.dot(b.cross(c));
+    vol(t) = six_vol/6.;
+    // Face area vectors (twice the area)
+    RowVector3S N[4];
+    Scalar dblA[4];
+    Scalar sum_dblA = 0;
+    for(int f = 0;f<4;f++)
+    {
+      N[f] = 
+        (p[faces[f][1]]-p[faces[f][0]]).cross(p[faces[f][2]]-p[faces[f][0]]);
+      dblA[f] = N[f].norm();
+      sum_dblA += dblA[f];
+    }
+    for(int e = 0;e<6;e++)
+    {
+      const int f = pairs[e][0];
+      const int g = pairs[e][1];
+      const Scalar cos_theta = 
+        -N[f].dot(N[g])/(dblA[f]*dblA[g]);
+      theta(t,e) = acos(std::max(Scalar(-1),std::min(Scalar(1),cos_theta)));
+    }
+    // inradius r = 3*vol/area = 6*vol/sum_dblA and circumradius
+    // R = |num|/(12*vol), so that 3*r/R = 6*(6*vol)²/(sum_dblA*|num|)
+    const RowVector3S num = 
+      a.squaredNorm()*b.cross(c) + 
+      b.squaredNorm()*c.cross(a) + 
+      c.squaredNorm()*a.cross(b);
+    const Scalar den = sum_dblA*num.norm();
+    rho(t) = den > 0 ? 6.*six_vol*six_vol/den : 0;
+  },1000);
+}
+
+#ifdef IGL_STATIC_LIBRARY
+// Explicit template instantiation
+template void igl::tet_quality<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&);
+#endif
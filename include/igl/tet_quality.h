@@ -0,0 +1,47 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 agent <agent@local>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_TET_QUALITY_H
+#define IGL_TET_QUALITY_H
+#include "igl_inline.h"
+#include <Eigen/Core>
+namespace igl
+{
+  // TET_QUALITY Compute common quality measures for all tets of a given tet
+  // mesh (V,T) in a single parallel pass (without the intermediate edge
+  // length and face area matrices of dihedral_angles).
+  //
+  // Inputs:
+  //   V  #V by 3 list of vertex positions
+  //   T  #T by 4 list of tet indices
+  // Outputs:
+  //   vol  #T list of signed volumes (see volume)
+  //   theta  #T by 6 list of dihedral angles (in radians), in the same order
+  //     as dihedral_angles
+  //   rho  #T list of radius ratios 3*inradius/circumradius: 1 for a regular
+  //     tet, 0 for a degenerate tet
+  //
+  // See also: volume, dihedral_angles
+  template <
+    typename DerivedV,
+    typename DerivedT,
+    typename Derivedvol,
+    typename Derivedtheta,
+    typename Derivedrho>
+  IGL_INLINE void tet_quality(
+    const Eigen::MatrixBase<DerivedV>& V,
+    const Eigen::MatrixBase<DerivedT>& T,
+    Eigen::PlainObjectBase<Derivedvol>& vol,
+    Eigen::PlainObjectBase<Derivedtheta>& theta,
+    Eigen::PlainObjectBase<Derivedrho>& rho);
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "tet_quality.cpp"
+#endif
+
+#endif
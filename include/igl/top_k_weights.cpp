@@ -0,0 +1,77 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+// 
+// Copyright (C) 2026 agent <agent@local>
+// 
+// This Source Code Form is subject to the terms of the Mozilla Public License 
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can 
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "top_k_weights.h"
+#include "parallel_for.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+template <typename DerivedW, typename DerivedTW, typename DerivedTI>
+IGL_INLINE void igl::top_k_weights(
+  const Eigen::MatrixBase<DerivedW> & W,
+  const int k_in,
+  const bool normalize,
+  Eigen::PlainObjectBase<DerivedTW> & TW,
+  Eigen::PlainObjectBase<DerivedTI> & TI)
+{
+  typedef typename DerivedTW::Scalar TWScalar;
+  typedef typename DerivedTI::Scalar TIScalar;
+  const int n = W.rows();
+  const int m = W.cols();
+  const int k = std::max(std::min(k_in,m),0);
+  TW.resize(n,k);
+  TI.resize(n,k);
+  // per-thread scratch of column indices
+  std::vector<std::vector<int> > S;
+  parallel_for(
+    n,
+    [&S,&m](const size_t nt){ S.resize(nt,std::vector<int>(m)); },
+    [&](const int i,const size_t t)
+    {
+      std::vector<int> & I = S[t];
+      for(int c = 0;c<m;c++) I[c] = c;
+      // largest magnitude first, ties broken by index for determinism
+      std::partial_sort(I.begin(),I.begin()+k,I.end(),
+        [&W,&i](const int a,const int b)
+        {
+          const auto wa = std::abs(W(i,a));
+          const auto wb = std::abs(W(i,b));
+          return wa > wb || (wa == wb && a < b);
+        });
+      TWScalar sum = 0;
+      for(int j = 0;j<k;j++)
+      {
+        TW(i,j) = TWScalar(W(i,I[j]));
+        TI(i,j) = TIScalar(I[j]);
+        sum += TW(i,j);
+      }
+      if(normalize && sum != 0)
+      {
+        for(int j = 0;j<k;j++) TW(i,j) /= sum;
+      }
+    },
+    [](const size_t){},
+    1000);
+}
+
+template <typename DerivedW, typename DerivedTW, typename DerivedTI>
+IGL_INLINE void igl::top_k_weights(
+  const Eigen::MatrixBase<DerivedW> & W,
+  const int k,
+  Eigen::PlainObjectBase<DerivedTW> & TW,
+  Eigen::PlainObjectBase<DerivedTI> & TI)
+{
+  return top_k_weights(W,k,true,TW,TI);
+}
+
+#ifdef IGL_STATIC_LIBRARY
+// Explicit template instantiation
+template void igl::top_k_weights<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, int, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&);
+template void igl::top_k_weights<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, int, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&);
+template void igl::top_k_weights<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, int, bool, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&);
+#endif
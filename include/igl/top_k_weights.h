@@ -0,0 +1,48 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+// 
+// Copyright (C) 2026 agent <agent@local>
+// 
+// This Source Code Form is subject to the terms of the Mozilla Public License 
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can 
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_TOP_K_WEIGHTS_H
+#define IGL_TOP_K_WEIGHTS_H
+#include "igl_inline.h"
+#include <Eigen/Core>
+
+namespace igl
+{
+  // TOP_K_WEIGHTS Truncate a dense matrix of per-vertex weights (e.g.,
+  // skinning weights) to the k weights of largest absolute value per vertex.
+  //
+  // Inputs:
+  //   W  #V by #handles list of weights
+  //   k  number of weights to keep per vertex (clamped to #handles)
+  //   normalize  whether to rescale the kept weights of each vertex to sum to
+  //     one {true}
+  // Outputs:
+  //   TW  #V by k list of weights per vertex, sorted by decreasing absolute
+  //     value (ties broken by increasing column index)
+  //   TI  #V by k list of indices into columns of W such that
+  //     TW(i,j) = W(i,TI(i,j)) (up to normalization)
+  //
+  // See also: lbs, dqs, lbs_matrix_column
+  template <typename DerivedW, typename DerivedTW, typename DerivedTI>
+  IGL_INLINE void top_k_weights(
+    const Eigen::MatrixBase<DerivedW> & W,
+    const int k,
+    const bool normalize,
+    Eigen::PlainObjectBase<DerivedTW> & TW,
+    Eigen::PlainObjectBase<DerivedTI> & TI);
+  template <typename DerivedW, typename DerivedTW, typename DerivedTI>
+  IGL_INLINE void top_k_weights(
+    const Eigen::MatrixBase<DerivedW> & W,
+    const int k,
+    Eigen::PlainObjectBase<DerivedTW> & TW,
+    Eigen::PlainObjectBase<DerivedTI> & TI);
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "top_k_weights.cpp"
+#endif
+#endif
@@ -7,6 +7,7 @@
 // obtain one at http://mozilla.org/MPL/2.0/.
 #include "upsample.h"
 
+#include "subdivide.h"
 #include "triangle_triangle_adjacency.h"
 
 
@@ -112,16 +113,12 @@ IGL_INLINE void igl::upsample(
   Eigen::PlainObjectBase<DerivedNF>& NF,
   const int number_of_subdivs)
 {
-  NV = V;
-  NF = F;
-  for(int i=0; i<number_of_subdivs; ++i) 
-  {
-    DerivedNF tempF = NF;
-    Eigen::SparseMatrix<typename DerivedV::Scalar >S;
-    upsample(NV.rows(), tempF, S, NF);
-    // This .eval is super important
-    NV = (S*NV).eval();
-  }
+  // Topology of each level is derived from the previous one, no
+  // intermediate subdivision matrices
+  subdivide_data<typename DerivedV::Scalar> data;
+  subdivide_precompute(V.rows(),F,SUBDIVISION_TYPE_UPSAMPLE,number_of_subdivs,false,data);
+  subdivide(data,V,NV);
+  NF = data.F.template cast<typename DerivedNF::Scalar>();
 }
 
 template <
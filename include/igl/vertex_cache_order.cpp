@@ -0,0 +1,156 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 agent <agent@local>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "vertex_cache_order.h"
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+template <typename DerivedF, typename DerivedFF, typename DerivedJ>
+IGL_INLINE void igl::vertex_cache_order(
+  const Eigen::MatrixBase<DerivedF> & F,
+  const int cache_size,
+  Eigen::PlainObjectBase<DerivedFF> & FF,
+  Eigen::PlainObjectBase<DerivedJ> & J)
+{
+  assert((F.rows() == 0 || F.cols() == 3) && "F should contain triangles");
+  const int m = F.rows();
+  const int n = m == 0 ? 0 : F.maxCoeff()+1;
+  // Vertex-face incidence in compressed row form
+  std::vector<int> offsets(n+1,0);
+  for(int f = 0;f<m;f++)
+  {
+    for(int c = 0;c<3;c++)
+    {
+      offsets[F(f,c)+1]++;
+    }
+  }
+  for(int i = 0;i<n;i++)
+  {
+    offsets[i+1] += offsets[i];
+  }
+  std::vector<int> incident(offsets[n]);
+  {
+    std::vector<int> fill(offsets.begin(),offsets.end()-1);
+    for(int f = 0;f<m;f++)
+    {
+      for(int c = 0;c<3;c++)
+      {
+        incident[fill[F(f,c)]++] = f;
+      }
+    }
+  }
+  // Number of not yet emitted faces incident on each vertex
+  std::vector<int> live(n);
+  for(int i = 0;i<n;i++)
+  {
+    live[i] = offsets[i+1]-offsets[i];
+  }
+  // Time stamp of each vertex's entry into the cache
+  std::vector<int> stamp(n,0);
+  std::vector<bool> emitted(m,false);
+  // Recently referenced vertices, to restart from after a dead end
+  std::vector<int> dead_end;
+  std::vector<int> candidates;
+  J.resize(m);
+  int num_emitted = 0;
+  int time = cache_size+1;
+  int cursor = 0;
+  int fan = n > 0 ? 0 : -1;
+  while(fan >= 0)
+  {
+    candidates.clear();
+    // Emit all remaining faces around the fanning vertex
+    for(int k = offsets[fan];k<offsets[fan+1];k++)
+    {
+      const int f = incident[k];
+      if(emitted[f])
+      {
+        continue;
+      }
+      for(int c = 0;c<3;c++)
+      {
+        const int v = F(f,c);
+        dead_end.push_back(v);
+        candidates.push_back(v);
+        live[v]--;
+        if(time-stamp[v] > cache_size)
+        {
+          stamp[v] = time++;
+        }
+      }
+      emitted[f] = true;
+      J(num_emitted++) = f;
+    }
+    // Next fanning vertex: the candidate staying longest in the cache after
+    // emitting its remaining faces
+    int best = -1;
+    int best_priority = -1;
+    for(const int v : candidates)
+    {
+      if(live[v] <= 0)
+      {
+        continue;
+      }
+      int priority = 0;
+      if(time-stamp[v]+2*live[v] <= cache_size)
+      {
+        priority = time-stamp[v];
+      }
+      if(priority > best_priority)
+      {
+        best_priority = priority;
+        best = v;
+      }
+    }
+    if(best < 0)
+    {
+      // Dead end: most recently referenced vertex with faces left, otherwise
+      // the next vertex in input order
+      while(!dead_end.empty())
+      {
+        const int v = dead_end.back();
+        dead_end.pop_back();
+        if(live[v] > 0)
+        {
+          best = v;
+          break;
+        }
+      }
+      while(best < 0 && cursor < n)
+      {
+        if(live[cursor] > 0)
+        {
+          best = cursor;
+        }
+        cursor++;
+      }
+    }
+    fan = best;
+  }
+  assert(num_emitted == m);
+  FF.resize(m,F.cols());
+  for(int f = 0;f<m;f++)
+  {
+    FF.row(f) = F.row(J(f));
+  }
+}
+
+template <typename DerivedF, typename DerivedFF, typename DerivedJ>
+IGL_INLINE void igl::vertex_cache_order(
+  const Eigen::MatrixBase<DerivedF> & F,
+  Eigen::PlainObjectBase<DerivedFF> & FF,
+  Eigen::PlainObjectBase<DerivedJ> & J)
+{
+  return vertex_cache_order(F,16,FF,J);
+}
+
+#ifdef IGL_STATIC_LIBRARY
+// Explicit template instantiation
+template void igl::vertex_cache_order<Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, int, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
+template void igl::vertex_cache_order<Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
+#endif
@@ -0,0 +1,46 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 agent <agent@local>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_VERTEX_CACHE_ORDER_H
+#define IGL_VERTEX_CACHE_ORDER_H
+#include "igl_inline.h"
+#include <Eigen/Core>
+
+namespace igl
+{
+  // VERTEX_CACHE_ORDER Reorder the faces of a triangle mesh so that
+  // consecutive faces reuse recently referenced vertices ("Fast
+  // Triangle Reordering for Vertex Locality and Reduced Overdraw" [Sander et
+  // al. 2007]). Besides the post-transform vertex cache of the GPU, this
+  // improves the memory locality of any per-face loop gathering vertex data
+  // and makes consecutive indices small deltas of each other.
+  //
+  // Inputs:
+  //   F  #F by 3 list of triangle indices
+  //   cache_size  size of the simulated FIFO vertex cache
+  // Outputs:
+  //   FF  #F by 3 list of reordered triangles so that FF = F(J,:)
+  //   J  #F list of indices into F
+  template <typename DerivedF, typename DerivedFF, typename DerivedJ>
+  IGL_INLINE void vertex_cache_order(
+    const Eigen::MatrixBase<DerivedF> & F,
+    const int cache_size,
+    Eigen::PlainObjectBase<DerivedFF> & FF,
+    Eigen::PlainObjectBase<DerivedJ> & J);
+  // Default cache size of 16
+  template <typename DerivedF, typename DerivedFF, typename DerivedJ>
+  IGL_INLINE void vertex_cache_order(
+    const Eigen::MatrixBase<DerivedF> & F,
+    Eigen::PlainObjectBase<DerivedFF> & FF,
+    Eigen::PlainObjectBase<DerivedJ> & J);
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "vertex_cache_order.cpp"
+#endif
+
+#endif
@@ -43,6 +43,22 @@ namespace igl
     const Eigen::PlainObjectBase<DerivedF>& F,
     std::vector<std::vector<IndexType> >& VF,
     std::vector<std::vector<IndexType> >& VFi);
+  // Compressed version: all lists are stored one after another in a single
+  // array (two passes over F and no per-vertex allocations)
+  //
+  // Inputs:
+  //   F  #F by dim list of mesh faces
+  //   n  number of vertices #V (e.g. `F.maxCoeff()+1` or `V.rows()`)
+  // Outputs:
+  //   VF  #F*dim list of face indices so that VF(NI(i)) ... VF(NI(i+1)-1) are
+  //     the faces incident on vertex i (in increasing order)
+  //   NI  #V+1 list of offsets into VF (NI(0) = 0, NI(#V) = #F*dim)
+  template <typename DerivedF, typename DerivedVF, typename DerivedNI>
+  IGL_INLINE void vertex_triangle_adjacency(
+    const Eigen::MatrixBase<DerivedF> & F,
+    const int n,
+    Eigen::PlainObjectBase<DerivedVF> & VF,
+    Eigen::PlainObjectBase<DerivedNI> & NI);
 }
 
 #ifndef IGL_STATIC_LIBRARY
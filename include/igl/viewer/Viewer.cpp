@@ -785,6 +785,7 @@ namespace viewer
         return;
 
     core.draw(data,opengl);
+    scene.draw(core,opengl);
 
     if (callback_post_draw)
       if (callback_post_draw(*this))
@@ -1027,6 +1028,7 @@ namespace viewer
 
   IGL_INLINE void Viewer::launch_shut()
   {
+    scene.free();
     opengl.free();
     core.shut();
 
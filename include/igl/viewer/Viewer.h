@@ -25,6 +25,7 @@
 #include "OpenGL_state.h"
 #include "ViewerCore.h"
 #include "ViewerData.h"
+#include "ViewerScene.h"
 #include "ViewerPlugin.h"
 
 #define IGL_MOD_SHIFT           0x0001
@@ -64,6 +65,9 @@ namespace viewer
     // Stores the vbos indices and opengl related settings
     OpenGL_state opengl;
 
+    // Additional mesh instances drawn after data (sharing opengl's shaders)
+    ViewerScene scene;
+
     // List of registered plugins
     std::vector<ViewerPlugin*> plugins;
     IGL_INLINE void init_plugins();
@@ -93,6 +93,47 @@ IGL_INLINE void igl::viewer::ViewerCore::clear_framebuffers()
   glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 }
 
+IGL_INLINE void igl::viewer::ViewerCore::compute_matrices()
+{
+  model = Eigen::Matrix4f::Identity();
+  view  = Eigen::Matrix4f::Identity();
+  proj  = Eigen::Matrix4f::Identity();
+
+  // Set view
+  look_at( camera_eye, camera_center, camera_up, view);
+
+  float width  = viewport(2);
+  float height = viewport(3);
+
+  // Set projection
+  if (orthographic)
+  {
+    float length = (camera_eye - camera_center).norm();
+    float h = tan(camera_view_angle/360.0 * igl::PI) * (length);
+    ortho(-h*width/height, h*width/height, -h, h, camera_dnear, camera_dfar,proj);
+  }
+  else
+  {
+    float fH = tan(camera_view_angle / 360.0 * igl::PI) * camera_dnear;
+    float fW = fH * (double)width/(double)height;
+    frustum(-fW, fW, -fH, fH, camera_dnear, camera_dfar,proj);
+  }
+  // end projection
+
+  // Set model transformation
+  float mat[16];
+  igl::quat_to_mat(trackball_angle.coeffs().data(), mat);
+
+  for (unsigned i=0;i<4;++i)
+    for (unsigned j=0;j<4;++j)
+      model(i,j) = mat[i+4*j];
+
+  // Why not just use Eigen::Transform<double,3,Projective> for model...?
+  model.topLeftCorner(3,3)*=camera_zoom;
+  model.topLeftCorner(3,3)*=model_zoom;
+  model.col(3).head(3) += model.topLeftCorner(3,3)*model_translation;
+}
+
 IGL_INLINE void igl::viewer::ViewerCore::draw(
   ViewerData& data,
   OpenGL_state& opengl,
@@ -122,43 +163,7 @@ IGL_INLINE void igl::viewer::ViewerCore::draw(
 
   if(update_matrices)
   {
-    model = Eigen::Matrix4f::Identity();
-    view  = Eigen::Matrix4f::Identity();
-    proj  = Eigen::Matrix4f::Identity();
-
-    // Set view
-    look_at( camera_eye, camera_center, camera_up, view);
-
-    float width  = viewport(2);
-    float height = viewport(3);
-
-    // Set projection
-    if (orthographic)
-    {
-      float length = (camera_eye - camera_center).norm();
-      float h = tan(camera_view_angle/360.0 * igl::PI) * (length);
-      ortho(-h*width/height, h*width/height, -h, h, camera_dnear, camera_dfar,proj);
-    }
-    else
-    {
-      float fH = tan(camera_view_angle / 360.0 * igl::PI) * camera_dnear;
-      float fW = fH * (double)width/(double)height;
-      frustum(-fW, fW, -fH, fH, camera_dnear, camera_dfar,proj);
-    }
-    // end projection
-
-    // Set model transformation
-    float mat[16];
-    igl::quat_to_mat(trackball_angle.coeffs().data(), mat);
-
-    for (unsigned i=0;i<4;++i)
-      for (unsigned j=0;j<4;++j)
-        model(i,j) = mat[i+4*j];
-
-    // Why not just use Eigen::Transform<double,3,Projective> for model...?
-    model.topLeftCorner(3,3)*=camera_zoom;
-    model.topLeftCorner(3,3)*=model_zoom;
-    model.col(3).head(3) += model.topLeftCorner(3,3)*model_translation;
+    compute_matrices();
   }
 
   // Send transformations to the GPU
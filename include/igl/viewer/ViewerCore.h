@@ -72,6 +72,9 @@ public:
   // Clear the frame buffers
   IGL_INLINE void clear_framebuffers();
 
+  // Set view, proj and model from the camera, trackball and viewport
+  IGL_INLINE void compute_matrices();
+
   // Draw everything
   IGL_INLINE void draw(ViewerData& data, OpenGL_state& opengl, bool update_matrices = true);
   IGL_INLINE void draw_buffer(
@@ -0,0 +1,200 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 agent <agent@local>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "ViewerScene.h"
+#include <igl/decimate.h>
+#include <igl/is_edge_manifold.h>
+#include <igl/parallel_for.h>
+#include <igl/PI.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+IGL_INLINE igl::viewer::ViewerScene::ViewerScene():
+  lod_pixels_per_face(4.0f)
+{
+}
+
+IGL_INLINE int igl::viewer::ViewerScene::add_mesh(
+  const Eigen::MatrixXd & V,
+  const Eigen::MatrixXi & F,
+  const int num_levels)
+{
+  instances.push_back(Instance());
+  const int i = instances.size()-1;
+  Instance & instance = instances[i];
+  instance.lod.resize(1);
+  instance.lod[0].set_mesh(V,F);
+  if(num_levels > 1 && F.rows() > 0 && F.cols() == 3 && is_edge_manifold(F))
+  {
+    // Each level is decimated from the previous one
+    while((int)instance.lod.size() < num_levels)
+    {
+      const ViewerData & prev = instance.lod.back();
+      const size_t max_m = prev.F.rows()/4;
+      if(max_m < 16)
+      {
+        break;
+      }
+      Eigen::MatrixXd U;
+      Eigen::MatrixXi G;
+      Eigen::VectorXi J;
+      decimate(prev.V,prev.F,max_m,U,G,J);
+      if(G.rows() == 0 || G.rows() >= prev.F.rows())
+      {
+        break;
+      }
+      instance.lod.push_back(ViewerData());
+      instance.lod.back().set_mesh(U,G);
+    }
+  }
+  update_bounding_box(i);
+  return i;
+}
+
+IGL_INLINE void igl::viewer::ViewerScene::update_bounding_box(const int i)
+{
+  Instance & instance = instances[i];
+  const Eigen::MatrixXd & V = instance.lod[0].V;
+  if(V.rows() == 0)
+  {
+    instance.bbox_min.setZero();
+    instance.bbox_max.setZero();
+    return;
+  }
+  instance.bbox_min = V.colwise().minCoeff().transpose().cast<float>();
+  instance.bbox_max = V.colwise().maxCoeff().transpose().cast<float>();
+}
+
+IGL_INLINE void igl::viewer::ViewerScene::select(const ViewerCore & core)
+{
+  using namespace Eigen;
+  const Matrix4f view_model = core.view*core.model;
+  const Matrix4f proj = core.proj;
+  const float height = core.viewport(3);
+  parallel_for(instances.size(),[&](const int i)
+  {
+    Instance & instance = instances[i];
+    instance.current_lod = -1;
+    if(!instance.visible || instance.lod.empty() ||
+      instance.lod[0].F.rows() == 0)
+    {
+      return;
+    }
+    const Matrix4f eye = view_model*instance.transform;
+    const Matrix4f clip = proj*eye;
+
+    // Frustum culling: the box is outside if all 8 corners are outside of
+    // the same clipping plane
+    int outside[6] = {0,0,0,0,0,0};
+    for(int c = 0;c<8;c++)
+    {
+      const Vector4f corner(
+        c&1 ? instance.bbox_max(0) : instance.bbox_min(0),
+        c&2 ? instance.bbox_max(1) : instance.bbox_min(1),
+        c&4 ? instance.bbox_max(2) : instance.bbox_min(2),
+        1);
+      const Vector4f p = clip*corner;
+      for(int d = 0;d<3;d++)
+      {
+        outside[2*d+0] += p(d) < -p(3);
+        outside[2*d+1] += p(d) >  p(3);
+      }
+    }
+    for(int k = 0;k<6;k++)
+    {
+      if(outside[k] == 8)
+      {
+        return;
+      }
+    }
+
+    // Level of detail: projected area of the bounding sphere in pixels
+    const Vector3f center = 0.5f*(instance.bbox_min+instance.bbox_max);
+    const Vector3f center_eye =
+      (eye*Vector4f(center(0),center(1),center(2),1)).head<3>();
+    float scale = 0;
+    for(int d = 0;d<3;d++)
+    {
+      scale = std::max(scale,eye.block<3,1>(0,d).norm());
+    }
+    const float r = 0.5f*scale*(instance.bbox_max-instance.bbox_min).norm();
+    float area = std::numeric_limits<float>::infinity();
+    if(core.orthographic)
+    {
+      const float r_px = r*proj(1,1)*0.5f*height;
+      area = float(igl::PI)*r_px*r_px;
+    }else if(-center_eye(2) > r)
+    {
+      const float r_px = r*proj(1,1)/(-center_eye(2))*0.5f*height;
+      area = float(igl::PI)*r_px*r_px;
+    }
+    const int num_levels = instance.lod.size();
+    instance.current_lod = num_levels-1;
+    for(int l = 0;l<num_levels;l++)
+    {
+      if(instance.lod[l].F.rows()*lod_pixels_per_face <= area)
+      {
+        instance.current_lod = l;
+        break;
+      }
+    }
+  },1000);
+}
+
+IGL_INLINE void igl::viewer::ViewerScene::draw(
+  ViewerCore & core,
+  const OpenGL_state & shaders)
+{
+  if(instances.empty())
+  {
+    return;
+  }
+  core.compute_matrices();
+  select(core);
+  const Eigen::Matrix4f model = core.model;
+  for(auto & instance : instances)
+  {
+    const int l = instance.current_lod;
+    if(l < 0)
+    {
+      continue;
+    }
+    // Value initialization zeros the buffer names: 0 is never generated by
+    // OpenGL so it marks buffers that do not exist yet
+    instance.opengl.resize(instance.lod.size(),OpenGL_state());
+    OpenGL_state & opengl = instance.opengl[l];
+    if(opengl.vao_mesh == 0)
+    {
+      opengl.shader_mesh = shaders.shader_mesh;
+      opengl.shader_overlay_lines = shaders.shader_overlay_lines;
+      opengl.shader_overlay_points = shaders.shader_overlay_points;
+      opengl.shader_stroke_points = shaders.shader_stroke_points;
+      opengl.init_buffers();
+      instance.lod[l].dirty = ViewerData::DIRTY_ALL;
+    }
+    core.model = model*instance.transform;
+    core.draw(instance.lod[l],opengl,false);
+  }
+  core.model = model;
+}
+
+IGL_INLINE void igl::viewer::ViewerScene::free()
+{
+  for(auto & instance : instances)
+  {
+    for(auto & opengl : instance.opengl)
+    {
+      if(opengl.vao_mesh != 0)
+      {
+        opengl.free_buffers();
+        opengl = OpenGL_state();
+      }
+    }
+  }
+}
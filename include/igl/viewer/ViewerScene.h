@@ -0,0 +1,116 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 agent <agent@local>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_VIEWER_VIEWER_SCENE_H
+#define IGL_VIEWER_VIEWER_SCENE_H
+
+#include <igl/viewer/OpenGL_state.h>
+#include <igl/viewer/ViewerCore.h>
+#include <igl/viewer/ViewerData.h>
+
+#include <igl/igl_inline.h>
+#include <Eigen/Core>
+#include <Eigen/StdVector>
+#include <vector>
+
+namespace igl
+{
+namespace viewer
+{
+
+// Collection of independent mesh instances drawn on top of Viewer::data.
+// Each instance has its own transformation and a chain of levels of detail,
+// each level with its own ViewerData (and therefore its own dirty flags) and
+// its own OpenGL buffers: changing one instance (or its transformation)
+// never re-uploads the others. Instances outside of the view frustum are
+// skipped and the finest level whose faces each cover at least
+// lod_pixels_per_face pixels on average is drawn.
+class ViewerScene
+{
+public:
+  struct Instance
+  {
+    // Levels of detail, finest first
+    std::vector<ViewerData> lod;
+    // OpenGL buffers of each level, created when a level is first drawn
+    std::vector<OpenGL_state> opengl;
+    // Transformation applied before ViewerCore::model
+    Eigen::Matrix4f transform;
+    // Whether to draw this instance at all
+    bool visible;
+    // Object space bounding box of lod[0].V (see update_bounding_box)
+    Eigen::Vector3f bbox_min;
+    Eigen::Vector3f bbox_max;
+    // Level chosen by the last call to select, -1 if culled
+    int current_lod;
+    Instance():
+      transform(Eigen::Matrix4f::Identity()),
+      visible(true),
+      bbox_min(0,0,0),
+      bbox_max(0,0,0),
+      current_lod(-1)
+    {}
+    public:
+      EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+  };
+
+  std::vector<Instance,Eigen::aligned_allocator<Instance> > instances;
+
+  // Minimum average number of pixels covered by a face of the drawn level
+  // (see select)
+  float lod_pixels_per_face;
+
+  IGL_INLINE ViewerScene();
+
+  // Add an instance of a mesh and precompute its levels of detail with
+  // igl::decimate, each level having a quarter of the faces of the previous
+  // one. Meshes that are not edge-manifold only get one level.
+  //
+  // Inputs:
+  //   V  #V by 3 list of vertex positions
+  //   F  #F by 3 list of triangle indices into V
+  //   num_levels  maximum number of levels of detail (at least 1)
+  // Returns index of new instance
+  IGL_INLINE int add_mesh(
+    const Eigen::MatrixXd & V,
+    const Eigen::MatrixXi & F,
+    const int num_levels = 4);
+
+  // Recompute instances[i].bbox_min/max after changing instances[i].lod[0].V
+  IGL_INLINE void update_bounding_box(const int i);
+
+  // Set current_lod of every instance: -1 if the instance is not visible or
+  // its transformed bounding box lies outside of the view frustum, otherwise
+  // the finest level whose faces cover on average at least
+  // lod_pixels_per_face pixels of the bounding sphere's projection (or the
+  // coarsest level if none does).
+  //
+  // Inputs:
+  //   core  viewer core whose view, proj, model and viewport are up to date
+  //     (see ViewerCore::compute_matrices)
+  IGL_INLINE void select(const ViewerCore & core);
+
+  // Select and draw the levels of all instances
+  //
+  // Inputs:
+  //   core  viewer core (matrices are recomputed; core.model is restored)
+  //   shaders  initialized OpenGL state whose shader programs are shared by
+  //     the buffers of all instances (e.g. Viewer::opengl)
+  IGL_INLINE void draw(ViewerCore & core, const OpenGL_state & shaders);
+
+  // Release the OpenGL buffers of all instances (shaders are not owned)
+  IGL_INLINE void free();
+};
+
+}
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "ViewerScene.cpp"
+#endif
+
+#endif
@@ -0,0 +1,94 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 agent <agent@local>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "software_render.h"
+#include <igl/PI.h>
+#include <igl/frustum.h>
+#include <igl/look_at.h>
+#include <igl/ortho.h>
+#include <igl/quat_to_mat.h>
+#include <igl/software_render.h>
+#include <cmath>
+
+IGL_INLINE void igl::viewer::software_render(
+  const ViewerData & data,
+  const ViewerCore & core,
+  Eigen::Matrix<unsigned char,Eigen::Dynamic,Eigen::Dynamic>& R,
+  Eigen::Matrix<unsigned char,Eigen::Dynamic,Eigen::Dynamic>& G,
+  Eigen::Matrix<unsigned char,Eigen::Dynamic,Eigen::Dynamic>& B,
+  Eigen::Matrix<unsigned char,Eigen::Dynamic,Eigen::Dynamic>& A)
+{
+  using namespace Eigen;
+  const int width = R.rows();
+  const int height = R.cols();
+  if(width == 0 || height == 0)
+  {
+    return;
+  }
+
+  // Same matrices as ViewerCore::draw
+  Matrix4f model = Matrix4f::Identity();
+  Matrix4f view = Matrix4f::Identity();
+  Matrix4f proj = Matrix4f::Identity();
+  look_at(core.camera_eye,core.camera_center,core.camera_up,view);
+  if(core.orthographic)
+  {
+    float length = (core.camera_eye - core.camera_center).norm();
+    float h = tan(core.camera_view_angle/360.0 * igl::PI) * (length);
+    ortho(
+      -h*width/height,h*width/height,-h,h,
+      core.camera_dnear,core.camera_dfar,proj);
+  }else
+  {
+    float fH = tan(core.camera_view_angle / 360.0 * igl::PI) * core.camera_dnear;
+    float fW = fH * (double)width/(double)height;
+    frustum(-fW,fW,-fH,fH,core.camera_dnear,core.camera_dfar,proj);
+  }
+  {
+    float mat[16];
+    igl::quat_to_mat(core.trackball_angle.coeffs().data(), mat);
+    for (unsigned i=0;i<4;++i)
+      for (unsigned j=0;j<4;++j)
+        model(i,j) = mat[i+4*j];
+    model.topLeftCorner(3,3)*=core.camera_zoom;
+    model.topLeftCorner(3,3)*=core.model_zoom;
+    model.col(3).head(3) += model.topLeftCorner(3,3)*core.model_translation;
+  }
+
+  igl::software_render_params params;
+  params.face_based = data.face_based;
+  params.show_faces = core.show_faces;
+  params.show_lines = core.show_lines;
+  params.show_overlay = core.show_overlay;
+  params.depth_test = core.depth_test;
+  params.overlay_depth = core.show_overlay_depth;
+  params.invert_normals = core.invert_normals;
+  // The mesh shader lights from -light_position (in view coordinates)
+  params.light_position = (view*Vector4f(
+    -core.light_position(0),-core.light_position(1),-core.light_position(2),
+    1)).head<3>();
+  params.lighting_factor = core.lighting_factor;
+  params.shininess = core.shininess;
+  params.background_color = core.background_color.head<3>();
+  params.line_color = core.line_color.head<3>();
+  params.line_width = core.line_width;
+  params.overlay_line_width = core.overlay_line_width;
+  params.point_size = core.point_size;
+  if(data.face_based)
+  {
+    igl::software_render(
+      data.V,data.F,data.F_normals,
+      data.F_material_ambient,data.F_material_diffuse,data.F_material_specular,
+      data.lines,data.points,view*model,proj,params,R,G,B,A);
+  }else
+  {
+    igl::software_render(
+      data.V,data.F,data.V_normals,
+      data.V_material_ambient,data.V_material_diffuse,data.V_material_specular,
+      data.lines,data.points,view*model,proj,params,R,G,B,A);
+  }
+}
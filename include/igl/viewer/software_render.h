@@ -0,0 +1,50 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 agent <agent@local>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_VIEWER_SOFTWARE_RENDER_H
+#define IGL_VIEWER_SOFTWARE_RENDER_H
+#include <igl/igl_inline.h>
+#include <igl/viewer/ViewerCore.h>
+#include <igl/viewer/ViewerData.h>
+#include <Eigen/Core>
+
+namespace igl
+{
+  namespace viewer
+  {
+    // SOFTWARE_RENDER Render data as seen by core into an image, like
+    // ViewerCore::draw_buffer, but with igl::software_render instead of
+    // OpenGL: this computes the same model-view and projection matrices as
+    // ViewerCore::draw and passes data's mesh, normals, materials and overlays
+    // with core's shading options. Textures, labels and strokes are not
+    // drawn.
+    //
+    // Inputs:
+    //   data  mesh, normals, colors, overlay lines and points
+    //   core  camera (look_at, frustum or ortho, trackball and zoom),
+    //     lighting and visualization options; core.viewport is ignored
+    //   R,G,B,A  width by height images
+    // Outputs:
+    //   R,G,B,A  rendered image, first column is the bottom row (as in
+    //     draw_buffer and png::writePNG); background has alpha 0
+    //
+    // See also: igl::software_render
+    IGL_INLINE void software_render(
+      const ViewerData & data,
+      const ViewerCore & core,
+      Eigen::Matrix<unsigned char,Eigen::Dynamic,Eigen::Dynamic>& R,
+      Eigen::Matrix<unsigned char,Eigen::Dynamic,Eigen::Dynamic>& G,
+      Eigen::Matrix<unsigned char,Eigen::Dynamic,Eigen::Dynamic>& B,
+      Eigen::Matrix<unsigned char,Eigen::Dynamic,Eigen::Dynamic>& A);
+  }
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "software_render.cpp"
+#endif
+
+#endif
@@ -22,6 +22,8 @@ namespace igl
   // Outputs:
   //   GV  side(0)*side(1)*side(2) by 3 list of cell center positions
   //   side  3-long list of dimension of voxel grid
+  //
+  // See also: voxelize
   template <
     typename Scalar,
     typename DerivedGV,
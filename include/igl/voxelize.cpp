@@ -0,0 +1,577 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 agent <agent@local>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "voxelize.h"
+#include "parallel_for.h"
+#include "point_simplex_squared_distance.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace igl
+{
+  namespace voxelize_helper
+  {
+    // Vertex positions in cell units (cell centers at integer coordinates)
+    // and faces, row-major so that each triangle is contiguous
+    typedef Eigen::Matrix<double,Eigen::Dynamic,3,Eigen::RowMajor> MatrixX3dR;
+    typedef Eigen::Matrix<int,Eigen::Dynamic,3,Eigen::RowMajor> MatrixX3iR;
+
+    // A crossing of a row with a face at t along the row. sign is the sign
+    // of the face's normal along the row. Of the 8 perturbed copies of a cell
+    // center on the row (see face_crossings), k cross the face and k_before
+    // of those do so before the center if t is exactly the center's
+    // coordinate.
+    struct Crossing
+    {
+      double t;
+      int sign;
+      int k;
+      int k_before;
+      bool operator<(const Crossing & that) const
+      {
+        return t < that.t;
+      }
+    };
+
+    // Call func(row,crossing) for each row of cell centers along axis a (row
+    // iu+side(u)*iv, u = a+1, v = a+2 mod 3) crossing triangle f.
+    //
+    // Ties are broken by Simulation of Simplicity, symmetrized: every cell
+    // center c is replaced by the 8 points c+(s0*e,s1*e^2,s2*e^3) for an
+    // infinitesimal e > 0 and signs s0,s1,s2 = +/-1. None of these is on an
+    // edge, vertex or face plane, so each is inside exactly one of the
+    // triangles around a shared edge or vertex (or on either side of a
+    // silhouette), and a crossing at exactly the center's coordinate is
+    // either before or after it. Edge functions are evaluated with their
+    // endpoints in a canonical (lexicographic) order so that all triangles
+    // with the same projected edge compute the exact same value.
+    template <typename Func>
+    IGL_INLINE void face_crossings(
+      const MatrixX3dR & P,
+      const MatrixX3iR & F,
+      const Eigen::Vector3i & side,
+      const int a,
+      const int f,
+      const Func & func)
+    {
+      const int u = (a+1)%3;
+      const int v = (a+2)%3;
+      const int i[3] = {F(f,0),F(f,1),F(f,2)};
+      // Normal (its a-th coordinate is the projected area)
+      double n[3];
+      for(int d = 0;d<3;d++)
+      {
+        const int du = (d+1)%3;
+        const int dv = (d+2)%3;
+        n[d] =
+          (P(i[1],du)-P(i[0],du))*(P(i[2],dv)-P(i[0],dv))-
+          (P(i[1],dv)-P(i[0],dv))*(P(i[2],du)-P(i[0],du));
+      }
+      if(n[a] == 0)
+      {
+        return;
+      }
+      const int sign = n[a] > 0 ? 1 : -1;
+      // A perturbed center is on the positive side of the plane iff the first
+      // nonzero n[d] has the sign of its perturbation s_d, and its crossing is
+      // then before it iff that side is towards +a.
+      const int first = n[0] != 0 ? 0 : (n[1] != 0 ? 1 : 2);
+      const double min_u = std::min(std::min(P(i[0],u),P(i[1],u)),P(i[2],u));
+      const double max_u = std::max(std::max(P(i[0],u),P(i[1],u)),P(i[2],u));
+      const double min_v = std::min(std::min(P(i[0],v),P(i[1],v)),P(i[2],v));
+      const double max_v = std::max(std::max(P(i[0],v),P(i[1],v)),P(i[2],v));
+      const int u0 = std::max(0,int(std::ceil(min_u)));
+      const int u1 = std::min(side(u)-1,int(std::floor(max_u)));
+      const int v0 = std::max(0,int(std::ceil(min_v)));
+      const int v1 = std::min(side(v)-1,int(std::floor(max_v)));
+      for(int iv = v0;iv<=v1;iv++)
+      {
+        for(int iu = u0;iu<=u1;iu++)
+        {
+          // Edge functions (positive inside if sign > 0) and, for centers on
+          // an edge, which of the 4 perturbations (bit 0: s_u < 0, bit 1:
+          // s_v < 0) are inside
+          double e[3];
+          int inside = 0xF;
+          for(int k = 0;k<3 && inside;k++)
+          {
+            // Edge opposite corner k
+            int p = i[(k+1)%3];
+            int q = i[(k+2)%3];
+            const bool flip =
+              P(p,u) > P(q,u) || (P(p,u) == P(q,u) && P(p,v) > P(q,v));
+            if(flip)
+            {
+              std::swap(p,q);
+            }
+            const double du = P(q,u)-P(p,u);
+            const double dv = P(q,v)-P(p,v);
+            const double E = du*(iv-P(p,v))-dv*(iu-P(p,u));
+            e[k] = flip ? -E : E;
+            if(e[k] != 0)
+            {
+              if((e[k] > 0) != (sign > 0))
+              {
+                inside = 0;
+              }
+              continue;
+            }
+            // Sign of E at c+(s_u*e_u,s_v*e_v) is that of the derivative of E
+            // along the larger of e_u and e_v (the one of the lower axis), or
+            // the other one if that is 0. Both are 0 only if the edge projects
+            // to a point, and then n[a] = 0.
+            const bool u_first = u < v ? dv != 0 : du == 0;
+            const double D = (flip ? -1 : 1)*(u_first ? -dv : du);
+            for(int s = 0;s<4;s++)
+            {
+              const int s_d = (u_first ? s&1 : s&2) ? -1 : 1;
+              if((s_d*D > 0) != (sign > 0))
+              {
+                inside &= ~(1<<s);
+              }
+            }
+          }
+          if(!inside)
+          {
+            continue;
+          }
+          Crossing crossing;
+          const double sum = e[0]+e[1]+e[2];
+          crossing.t = sum == 0 ? P(i[0],a) :
+            (e[0]*P(i[0],a)+e[1]*P(i[1],a)+e[2]*P(i[2],a))/sum;
+          crossing.sign = sign;
+          crossing.k = 0;
+          crossing.k_before = 0;
+          for(int s = 0;s<8;s++)
+          {
+            // bit 0: s_u < 0, bit 1: s_v < 0, bit 2: s_a < 0
+            if(inside & (1<<(s&3)))
+            {
+              crossing.k++;
+              const int bit = first == u ? 1 : (first == v ? 2 : 4);
+              const int s_first = (s&bit) ? -1 : 1;
+              crossing.k_before += (s_first*n[first] > 0) == (sign > 0);
+            }
+          }
+          func(iu+side(u)*iv,crossing);
+        }
+      }
+    }
+
+    // Add to W2[c] the sum over both directions along axis a and over the 8
+    // perturbed copies of cell c (see face_crossings) of the signed number of
+    // crossings of the ray from c. After all 3 axes, W2[c] is 48 times the
+    // winding number estimate at c.
+    IGL_INLINE void accumulate_crossings(
+      const MatrixX3dR & P,
+      const MatrixX3iR & F,
+      const Eigen::Vector3i & side,
+      const int a,
+      std::vector<std::int16_t> & W2)
+    {
+      const int u = (a+1)%3;
+      const int v = (a+2)%3;
+      const int m = F.rows();
+      const int num_rows = side(u)*side(v);
+      // Count, then write crossings of each face
+      std::vector<int> offset(m+1,0);
+      parallel_for(m,[&](const int f)
+      {
+        int count = 0;
+        face_crossings(P,F,side,a,f,
+          [&count](const int,const Crossing &){ count++; });
+        offset[f+1] = count;
+      },1000);
+      for(int f = 0;f<m;f++)
+      {
+        offset[f+1] += offset[f];
+      }
+      const int num_crossings = offset[m];
+      std::vector<int> row(num_crossings);
+      std::vector<Crossing> crossing(num_crossings);
+      parallel_for(m,[&](const int f)
+      {
+        int k = offset[f];
+        face_crossings(P,F,side,a,f,
+          [&](const int r,const Crossing & c)
+          {
+            row[k] = r;
+            crossing[k] = c;
+            k++;
+          });
+      },1000);
+      // Bucket by row
+      std::vector<int> row_offset(num_rows+1,0);
+      for(int k = 0;k<num_crossings;k++)
+      {
+        row_offset[row[k]+1]++;
+      }
+      for(int r = 0;r<num_rows;r++)
+      {
+        row_offset[r+1] += row_offset[r];
+      }
+      std::vector<Crossing> sorted(num_crossings);
+      {
+        std::vector<int> next(row_offset.begin(),row_offset.end()-1);
+        for(int k = 0;k<num_crossings;k++)
+        {
+          sorted[next[row[k]]++] = crossing[k];
+        }
+      }
+      // Sweep each row
+      parallel_for(num_rows,[&](const int r)
+      {
+        const int begin = row_offset[r];
+        const int end = row_offset[r+1];
+        if(begin == end)
+        {
+          return;
+        }
+        std::sort(sorted.begin()+begin,sorted.begin()+end);
+        int total = 0;
+        for(int k = begin;k<end;k++)
+        {
+          total += sorted[k].sign*sorted[k].k;
+        }
+        int coord[3];
+        coord[u] = r%side(u);
+        coord[v] = r/side(u);
+        // Sums of signs of crossings (of the perturbed centers) before the
+        // center: strictly before, and at the center
+        int lt = 0;
+        int k_lt = begin;
+        for(int x = 0;x<side(a);x++)
+        {
+          while(k_lt < end && sorted[k_lt].t < x)
+          {
+            lt += sorted[k_lt].sign*sorted[k_lt].k;
+            k_lt++;
+          }
+          int eq = 0;
+          for(int k = k_lt;k < end && sorted[k].t == x;k++)
+          {
+            eq += sorted[k].sign*sorted[k].k_before;
+          }
+          // Ray towards +inf exits through positive crossings after x, ray
+          // towards -inf through negative crossings before x
+          const int w2 = (total-lt-eq) - (lt+eq);
+          if(w2 != 0)
+          {
+            coord[a] = x;
+            W2[coord[0]+side(0)*(coord[1]+side(1)*coord[2])] += w2;
+          }
+        }
+      },100);
+    }
+
+    // Call func(b,c,sqr_d) for each cell c (in block b) closer than band
+    // cells to the mesh, with sqr_d its squared distance in cell units
+    template <typename Func>
+    IGL_INLINE void narrow_band(
+      const MatrixX3dR & P,
+      const MatrixX3iR & F,
+      const Eigen::Vector3i & side,
+      const int band,
+      const Func & func)
+    {
+      const int bs = 8;
+      const Eigen::Vector3i num_blocks = (side.array()+bs-1)/bs;
+      const int m = F.rows();
+      // Cells within band of the bounding box of each face
+      Eigen::Matrix<int,Eigen::Dynamic,6,Eigen::RowMajor> R(m,6);
+      std::vector<int> offset(m+1,0);
+      parallel_for(m,[&](const int f)
+      {
+        int count = 1;
+        for(int d = 0;d<3;d++)
+        {
+          const double lo = std::min(std::min(P(F(f,0),d),P(F(f,1),d)),P(F(f,2),d));
+          const double hi = std::max(std::max(P(F(f,0),d),P(F(f,1),d)),P(F(f,2),d));
+          R(f,d) = int(std::max(0.,std::ceil(lo-band)));
+          R(f,3+d) = int(std::min(double(side(d)-1),std::floor(hi+band)));
+          count *= R(f,3+d) < R(f,d) ? 0 : R(f,3+d)/bs-R(f,d)/bs+1;
+        }
+        offset[f+1] = count;
+      },1000);
+      for(int f = 0;f<m;f++)
+      {
+        offset[f+1] += offset[f];
+      }
+      const int num_pairs = offset[m];
+      std::vector<int> pair_block(num_pairs);
+      parallel_for(m,[&](const int f)
+      {
+        int k = offset[f];
+        for(int bz = R(f,2)/bs;k<offset[f+1] && bz<=R(f,5)/bs;bz++)
+        {
+          for(int by = R(f,1)/bs;by<=R(f,4)/bs;by++)
+          {
+            for(int bx = R(f,0)/bs;bx<=R(f,3)/bs;bx++)
+            {
+              pair_block[k++] = bx+num_blocks(0)*(by+num_blocks(1)*bz);
+            }
+          }
+        }
+      },1000);
+      // Faces of each block (in order)
+      const int nb = num_blocks.prod();
+      std::vector<int> block_offset(nb+1,0);
+      for(int k = 0;k<num_pairs;k++)
+      {
+        block_offset[pair_block[k]+1]++;
+      }
+      for(int b = 0;b<nb;b++)
+      {
+        block_offset[b+1] += block_offset[b];
+      }
+      std::vector<int> block_faces(num_pairs);
+      {
+        std::vector<int> next(block_offset.begin(),block_offset.end()-1);
+        for(int f = 0;f<m;f++)
+        {
+          for(int k = offset[f];k<offset[f+1];k++)
+          {
+            block_faces[next[pair_block[k]]++] = f;
+          }
+        }
+      }
+      const double max_sqr_d = double(band)*double(band);
+      parallel_for(nb,[&](const int b)
+      {
+        if(block_offset[b] == block_offset[b+1])
+        {
+          return;
+        }
+        const int b0[3] = {
+          bs*(b%num_blocks(0)),
+          bs*((b/num_blocks(0))%num_blocks(1)),
+          bs*(b/(num_blocks(0)*num_blocks(1)))};
+        int b1[3];
+        for(int d = 0;d<3;d++)
+        {
+          b1[d] = std::min(b0[d]+bs,side(d))-1;
+        }
+        double best[bs*bs*bs];
+        std::fill(best,best+bs*bs*bs,max_sqr_d);
+        for(int k = block_offset[b];k<block_offset[b+1];k++)
+        {
+          const int f = block_faces[k];
+          Eigen::RowVector3d fmin = P.row(F(f,0));
+          Eigen::RowVector3d fmax = P.row(F(f,0));
+          for(int c = 1;c<3;c++)
+          {
+            fmin = fmin.cwiseMin(P.row(F(f,c)));
+            fmax = fmax.cwiseMax(P.row(F(f,c)));
+          }
+          for(int z = std::max(b0[2],R(f,2));z<=std::min(b1[2],R(f,5));z++)
+          {
+            for(int y = std::max(b0[1],R(f,1));y<=std::min(b1[1],R(f,4));y++)
+            {
+              for(int x = std::max(b0[0],R(f,0));x<=std::min(b1[0],R(f,3));x++)
+              {
+                double & best_c =
+                  best[(x-b0[0])+bs*((y-b0[1])+bs*(z-b0[2]))];
+                const Eigen::RowVector3d p(x,y,z);
+                // Skip if the bounding box of f is already too far
+                if((p-p.cwiseMax(fmin).cwiseMin(fmax)).squaredNorm() >=
+                  best_c)
+                {
+                  continue;
+                }
+                double sqr_d;
+                Eigen::RowVector3d c;
+                point_simplex_squared_distance<3>(p,P,F,f,sqr_d,c);
+                best_c = std::min(best_c,sqr_d);
+              }
+            }
+          }
+        }
+        for(int z = b0[2];z<=b1[2];z++)
+        {
+          for(int y = b0[1];y<=b1[1];y++)
+          {
+            for(int x = b0[0];x<=b1[0];x++)
+            {
+              const double sqr_d =
+                best[(x-b0[0])+bs*((y-b0[1])+bs*(z-b0[2]))];
+              if(sqr_d < max_sqr_d)
+              {
+                func(b,x+side(0)*(y+side(1)*z),sqr_d);
+              }
+            }
+          }
+        }
+      },1);
+    }
+
+    template <
+      typename DerivedV,
+      typename DerivedF,
+      typename Derivedside,
+      typename Derivedcorner>
+    IGL_INLINE void grid_units(
+      const Eigen::MatrixBase<DerivedV> & V,
+      const Eigen::MatrixBase<DerivedF> & F,
+      const Eigen::MatrixBase<Derivedside> & side,
+      const Eigen::MatrixBase<Derivedcorner> & corner,
+      const typename DerivedV::Scalar h,
+      MatrixX3dR & P,
+      MatrixX3iR & RF,
+      Eigen::Vector3i & iside)
+    {
+      assert(V.cols() == 3 && "V should be 3D");
+      assert(F.cols() == 3 && "F should contain triangles");
+      P.resize(V.rows(),3);
+      for(int d = 0;d<3;d++)
+      {
+        P.col(d) =
+          (V.col(d).template cast<double>().array()-double(corner(d)))/
+          double(h);
+      }
+      RF = F.template cast<int>();
+      for(int d = 0;d<3;d++)
+      {
+        iside(d) = side(d);
+      }
+    }
+
+    // 48 times the winding number estimate of each cell (see
+    // accumulate_crossings). A cell is occupied if W2 > 24, i.e., if its
+    // winding number is above 0.5.
+    IGL_INLINE void crossings(
+      const MatrixX3dR & P,
+      const MatrixX3iR & F,
+      const Eigen::Vector3i & side,
+      std::vector<std::int16_t> & W2)
+    {
+      W2.assign(side.prod(),0);
+      for(int a = 0;a<3;a++)
+      {
+        accumulate_crossings(P,F,side,a,W2);
+      }
+    }
+  }
+}
+
+template <
+  typename DerivedV,
+  typename DerivedF,
+  typename Derivedside,
+  typename Derivedcorner,
+  typename DerivedW,
+  typename DerivedS>
+IGL_INLINE void igl::voxelize(
+  const Eigen::MatrixBase<DerivedV> & V,
+  const Eigen::MatrixBase<DerivedF> & F,
+  const Eigen::MatrixBase<Derivedside> & side,
+  const Eigen::MatrixBase<Derivedcorner> & corner,
+  const typename DerivedV::Scalar h,
+  const int band,
+  Eigen::PlainObjectBase<DerivedW> & W,
+  Eigen::PlainObjectBase<DerivedS> & S)
+{
+  using namespace voxelize_helper;
+  typedef typename DerivedW::Scalar WScalar;
+  typedef typename DerivedS::Scalar SScalar;
+  MatrixX3dR P;
+  MatrixX3iR RF;
+  Eigen::Vector3i iside;
+  grid_units(V,F,side,corner,h,P,RF,iside);
+  const int n = iside.prod();
+  std::vector<std::int16_t> W2;
+  crossings(P,RF,iside,W2);
+  W.resize(n,1);
+  S.resize(n,1);
+  const SScalar max_d = SScalar(band)*SScalar(h);
+  parallel_for(n,[&](const int c)
+  {
+    W(c) = WScalar(W2[c])/WScalar(48);
+    S(c) = W2[c] > 24 ? -max_d : max_d;
+  },10000);
+  narrow_band(P,RF,iside,band,[&](const int,const int c,const double sqr_d)
+  {
+    const SScalar d = SScalar(std::sqrt(sqr_d)*double(h));
+    S(c) = W2[c] > 24 ? -d : d;
+  });
+}
+
+template <
+  typename DerivedV,
+  typename DerivedF,
+  typename Derivedside,
+  typename Derivedcorner,
+  typename DerivedI,
+  typename DerivedB,
+  typename DerivedSB>
+IGL_INLINE void igl::voxelize(
+  const Eigen::MatrixBase<DerivedV> & V,
+  const Eigen::MatrixBase<DerivedF> & F,
+  const Eigen::MatrixBase<Derivedside> & side,
+  const Eigen::MatrixBase<Derivedcorner> & corner,
+  const typename DerivedV::Scalar h,
+  const int band,
+  Eigen::PlainObjectBase<DerivedI> & I,
+  Eigen::PlainObjectBase<DerivedB> & B,
+  Eigen::PlainObjectBase<DerivedSB> & SB)
+{
+  using namespace voxelize_helper;
+  MatrixX3dR P;
+  MatrixX3iR RF;
+  Eigen::Vector3i iside;
+  grid_units(V,F,side,corner,h,P,RF,iside);
+  const int n = iside.prod();
+  std::vector<std::int16_t> W2;
+  crossings(P,RF,iside,W2);
+  {
+    int num_occupied = 0;
+    for(int c = 0;c<n;c++)
+    {
+      num_occupied += W2[c] > 24;
+    }
+    I.resize(num_occupied,1);
+    for(int c = 0,k = 0;c<n;c++)
+    {
+      if(W2[c] > 24)
+      {
+        I(k++) = c;
+      }
+    }
+  }
+  // Collect band cells block by block, then sort by cell index
+  const int bs = 8;
+  const int nb = ((iside.array()+bs-1)/bs).prod();
+  std::vector<std::vector<std::pair<int,double> > > block_cells(nb);
+  narrow_band(P,RF,iside,band,[&](const int b,const int c,const double sqr_d)
+  {
+    const double d = std::sqrt(sqr_d)*double(h);
+    block_cells[b].push_back(std::make_pair(c,W2[c] > 24 ? -d : d));
+  });
+  std::vector<std::pair<int,double> > cells;
+  for(auto & bc : block_cells)
+  {
+    cells.insert(cells.end(),bc.begin(),bc.end());
+    std::vector<std::pair<int,double> >().swap(bc);
+  }
+  std::sort(cells.begin(),cells.end());
+  B.resize(cells.size(),1);
+  SB.resize(cells.size(),1);
+  for(int k = 0;k<(int)cells.size();k++)
+  {
+    B(k) = cells[k].first;
+    SB(k) = cells[k].second;
+  }
+}
+
+#ifdef IGL_STATIC_LIBRARY
+// Explicit template instantiation
+template void igl::voxelize<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, 1, 3, 1, 1, 3>, Eigen::Matrix<double, 1, 3, 1, 1, 3>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, 1, 3, 1, 1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> > const&, Eigen::Matrix<double, -1, -1, 0, -1, -1>::Scalar, int, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&);
+template void igl::voxelize<Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, 1, 3, 1, 1, 3>, Eigen::Matrix<float, 1, 3, 1, 1, 3>, Eigen::Matrix<float, -1, 1, 0, -1, 1>, Eigen::Matrix<float, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, 1, 3, 1, 1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<float, 1, 3, 1, 1, 3> > const&, Eigen::Matrix<float, -1, -1, 0, -1, -1>::Scalar, int, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, 1, 0, -1, 1> >&);
+template void igl::voxelize<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, 1, 3, 1, 1, 3>, Eigen::Matrix<double, 1, 3, 1, 1, 3>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, 1, 3, 1, 1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> > const&, Eigen::Matrix<double, -1, -1, 0, -1, -1>::Scalar, int, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&);
+#endif
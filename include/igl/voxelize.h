@@ -0,0 +1,107 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 agent <agent@local>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_VOXELIZE_H
+#define IGL_VOXELIZE_H
+#include "igl_inline.h"
+#include <Eigen/Core>
+namespace igl
+{
+  // VOXELIZE Rasterize a triangle mesh onto a regular voxel grid (e.g., from
+  // igl::voxel_grid), computing a winding number and a narrow band signed
+  // distance at every cell center without querying a tree per cell:
+  //
+  //   - The triangles are scan converted along the rows of the grid in each
+  //     axis direction (in parallel over triangles and then over rows). Each
+  //     cell gets the average of the signed number of crossings of the rays
+  //     from its center in the 6 axis directions. This is the exact (integer)
+  //     winding number for closed, possibly self-intersecting, meshes and a 6
+  //     direction estimate of the generalized winding number (the average
+  //     over all directions) for open meshes and soups.
+  //   - Centers exactly on the mesh are handled by symbolic perturbation:
+  //     W is the average over the 8 points c+(+/-e,+/-e^2,+/-e^3) for an
+  //     infinitesimal e, so shared edges and vertices (e.g., the center of
+  //     a triangle fan) are counted exactly once. For meshes whose faces lie
+  //     on grid planes this is the generalized winding number (e.g., 0.5 on
+  //     a face, 0.25 on an edge of a box), so such cells are not occupied.
+  //     Ties are decided in floating point: exactly for grid aligned
+  //     meshes, otherwise up to rounding.
+  //   - The sums of crossings (48 times W) are kept as 16-bit integers per
+  //     cell, so |W| must stay below 682. A cell is occupied if W > 0.5.
+  //   - Rasterization samples cell centers only: it is not conservative (no
+  //     cell is marked just because a triangle touches it). A thin shell (or
+  //     any feature thinner than a cell) may cover no cell center and then
+  //     leaves no occupied cell. The cells it touches are the cells within
+  //     sqrt(3)/2 cells of it, so they are all in the narrow band (B below)
+  //     as soon as band >= 1.
+  //   - Cells within band cells of the mesh get their exact distance to the
+  //     closest triangle: triangles are binned into blocks of 8^3 cells and
+  //     the blocks are processed in parallel.
+  //
+  // Inputs:
+  //   V  #V by 3 list of mesh vertex positions
+  //   F  #F by 3 list of triangle indices into V
+  //   side  3-long list of number of cells along each axis
+  //   corner  3-long position of the center of cell 0 (e.g., GV.row(0))
+  //   h  cell size (e.g., GV(1,0)-GV(0,0)): cell x+side(0)*(y+side(1)*z) is
+  //     centered at corner + h*(x,y,z)
+  //   band  width of the narrow band in cells
+  // Outputs:
+  //   W  side(0)*side(1)*side(2) list of winding numbers (occupancy is
+  //     W > 0.5)
+  //   S  side(0)*side(1)*side(2) list of signed distances, negative inside,
+  //     clamped to [-band*h, band*h]
+  //
+  // See also: voxel_grid, winding_number, signed_distance
+  template <
+    typename DerivedV,
+    typename DerivedF,
+    typename Derivedside,
+    typename Derivedcorner,
+    typename DerivedW,
+    typename DerivedS>
+  IGL_INLINE void voxelize(
+    const Eigen::MatrixBase<DerivedV> & V,
+    const Eigen::MatrixBase<DerivedF> & F,
+    const Eigen::MatrixBase<Derivedside> & side,
+    const Eigen::MatrixBase<Derivedcorner> & corner,
+    const typename DerivedV::Scalar h,
+    const int band,
+    Eigen::PlainObjectBase<DerivedW> & W,
+    Eigen::PlainObjectBase<DerivedS> & S);
+  // Sparse version: only the occupied cells and the cells in the narrow band
+  // are output (only the 16-bit sums of crossings are stored on the full
+  // grid while rasterizing).
+  //
+  // Outputs:
+  //   I  #I list of indices of occupied cells (W > 0.5) in increasing order
+  //   B  #B list of indices of cells closer than band*h to the mesh in
+  //     increasing order
+  //   SB  #B list of signed distances at B, negative inside
+  template <
+    typename DerivedV,
+    typename DerivedF,
+    typename Derivedside,
+    typename Derivedcorner,
+    typename DerivedI,
+    typename DerivedB,
+    typename DerivedSB>
+  IGL_INLINE void voxelize(
+    const Eigen::MatrixBase<DerivedV> & V,
+    const Eigen::MatrixBase<DerivedF> & F,
+    const Eigen::MatrixBase<Derivedside> & side,
+    const Eigen::MatrixBase<Derivedcorner> & corner,
+    const typename DerivedV::Scalar h,
+    const int band,
+    Eigen::PlainObjectBase<DerivedI> & I,
+    Eigen::PlainObjectBase<DerivedB> & B,
+    Eigen::PlainObjectBase<DerivedSB> & SB);
+}
+#ifndef IGL_STATIC_LIBRARY
+#  include "voxelize.cpp"
+#endif
+#endif
@@ -7,6 +7,7 @@
 // obtain one at http://mozilla.org/MPL/2.0/.
 #include "writeDMAT.h"
 #include "list_to_matrix.h"
+#include "write_formatted_rows.h"
 #include <Eigen/Core>
 
 #include <cstdio>
@@ -27,14 +28,18 @@ IGL_INLINE bool igl::writeDMAT(
   {
     // first line contains number of rows and number of columns
     fprintf(fp,"%d %d\n",(int)W.cols(),(int)W.rows());
-    // Loop over columns slowly
-    for(int j = 0;j < W.cols();j++)
+    // One coefficient per line in column-major order: loop over columns
+    // slowly, down rows quickly
+    const size_t m = W.rows();
+    const auto & format_w = [&W,m](const size_t k, std::string & buf)
     {
-      // loop over rows (down columns) quickly
-      for(int i = 0;i < W.rows();i++)
-      {
-        fprintf(fp,"%0.17lg\n",(double)W(i,j));
-      }
+      append_real(W(k%m,k/m),buf);
+      buf += '\n';
+    };
+    if(!write_formatted_rows(fp,m*W.cols(),format_w))
+    {
+      fclose(fp);
+      return false;
     }
   }else
   {
@@ -6,11 +6,8 @@
 // v. 2.0. If a copy of the MPL was not distributed with this file, You can
 // obtain one at http://mozilla.org/MPL/2.0/.
 #include "writeOBJ.h"
+#include "write_formatted_rows.h"
 
-#include <iostream>
-#include <limits>
-#include <iomanip>
-#include <fstream>
 #include <cstdio>
 #include <cassert>
 
@@ -36,86 +33,134 @@ IGL_INLINE bool igl::writeOBJ(
     printf("IOError: %s could not be opened for writing...",str.c_str());
     return false;
   }
+  const bool ret = writeOBJ(obj_file,V,F,CN,FN,TC,FTC);
+  return (fclose(obj_file) == 0) && ret;
+}
+
+template <typename DerivedV, typename DerivedF>
+IGL_INLINE bool igl::writeOBJ(
+  const std::string str,
+  const Eigen::MatrixBase<DerivedV>& V,
+  const Eigen::MatrixBase<DerivedF>& F)
+{
+  FILE * obj_file = fopen(str.c_str(),"w");
+  if(NULL==obj_file)
+  {
+    fprintf(stderr,"IOError: writeOBJ() could not open %s\n",str.c_str());
+    return false;
+  }
+  const bool ret = writeOBJ(obj_file,V,F);
+  return (fclose(obj_file) == 0) && ret;
+}
+
+template <
+  typename DerivedV, 
+  typename DerivedF,
+  typename DerivedCN, 
+  typename DerivedFN,
+  typename DerivedTC, 
+  typename DerivedFTC>
+IGL_INLINE bool igl::writeOBJ(
+  FILE * obj_file,
+  const Eigen::MatrixBase<DerivedV>& V,
+  const Eigen::MatrixBase<DerivedF>& F,
+  const Eigen::MatrixBase<DerivedCN>& CN,
+  const Eigen::MatrixBase<DerivedFN>& FN,
+  const Eigen::MatrixBase<DerivedTC>& TC,
+  const Eigen::MatrixBase<DerivedFTC>& FTC)
+{
+  const bool write_N = CN.rows() >0;
+  const bool write_texture_coords = TC.rows() >0;
   // Loop over V
-  for(int i = 0;i<(int)V.rows();i++)
+  const auto & format_v = [&V](const size_t i, std::string & buf)
   {
-    fprintf(obj_file,"v");
+    buf += 'v';
     for(int j = 0;j<(int)V.cols();++j)
     {
-      fprintf(obj_file," %0.17g", V(i,j));
+      buf += ' ';
+      append_real(V(i,j),buf);
     }
-    fprintf(obj_file,"\n");
+    buf += '\n';
+  };
+  if(!write_formatted_rows(obj_file,V.rows(),format_v))
+  {
+    return false;
   }
-  bool write_N = CN.rows() >0;
-
   if(write_N)
   {
-    for(int i = 0;i<(int)CN.rows();i++)
+    const auto & format_vn = [&CN](const size_t i, std::string & buf)
+    {
+      buf += "vn";
+      for(int j = 0;j<3;++j)
+      {
+        buf += ' ';
+        append_real(CN(i,j),buf);
+      }
+      buf += '\n';
+    };
+    if(!write_formatted_rows(obj_file,CN.rows(),format_vn))
     {
-      fprintf(obj_file,"vn %0.17g %0.17g %0.17g\n",
-              CN(i,0),
-              CN(i,1),
-              CN(i,2)
-              );
+      return false;
     }
     fprintf(obj_file,"\n");
   }
-
-  bool write_texture_coords = TC.rows() >0;
-
   if(write_texture_coords)
   {
-    for(int i = 0;i<(int)TC.rows();i++)
+    const auto & format_vt = [&TC](const size_t i, std::string & buf)
     {
-      fprintf(obj_file, "vt %0.17g %0.17g\n",TC(i,0),TC(i,1));
+      buf += "vt";
+      for(int j = 0;j<2;++j)
+      {
+        buf += ' ';
+        append_real(TC(i,j),buf);
+      }
+      buf += '\n';
+    };
+    if(!write_formatted_rows(obj_file,TC.rows(),format_vt))
+    {
+      return false;
     }
     fprintf(obj_file,"\n");
   }
-
   // loop over F
-  for(int i = 0;i<(int)F.rows();++i)
+  const auto & format_f = 
+    [&F,&FN,&FTC,write_N,write_texture_coords](
+      const size_t i, std::string & buf)
   {
-    fprintf(obj_file,"f");
+    buf += 'f';
     for(int j = 0; j<(int)F.cols();++j)
     {
       // OBJ is 1-indexed
-      fprintf(obj_file," %u",F(i,j)+1);
-
+      buf += ' ';
+      append_integer(F(i,j)+1,buf);
       if(write_texture_coords)
-        fprintf(obj_file,"/%u",FTC(i,j)+1);
+      {
+        buf += '/';
+        append_integer(FTC(i,j)+1,buf);
+      }
       if(write_N)
       {
-        if (write_texture_coords)
-          fprintf(obj_file,"/%u",FN(i,j)+1);
-        else
-          fprintf(obj_file,"//%u",FN(i,j)+1);
+        buf += write_texture_coords ? "/" : "//";
+        append_integer(FN(i,j)+1,buf);
       }
     }
-    fprintf(obj_file,"\n");
-  }
-  fclose(obj_file);
-  return true;
+    buf += '\n';
+  };
+  return write_formatted_rows(obj_file,F.rows(),format_f);
 }
 
 template <typename DerivedV, typename DerivedF>
 IGL_INLINE bool igl::writeOBJ(
-  const std::string str,
+  FILE * obj_file,
   const Eigen::MatrixBase<DerivedV>& V,
   const Eigen::MatrixBase<DerivedF>& F)
 {
-  using namespace std;
-  using namespace Eigen;
   assert(V.cols() == 3 && "V should have 3 columns");
-  ofstream s(str);
-  if(!s.is_open())
-  {
-    fprintf(stderr,"IOError: writeOBJ() could not open %s\n",str.c_str());
-    return false;
-  }
-  s<<
-    V.format(IOFormat(FullPrecision,DontAlignCols," ","\n","v ","","","\n"))<<
-    (F.array()+1).format(IOFormat(FullPrecision,DontAlignCols," ","\n","f ","","","\n"));
-  return true;
+  const Eigen::Matrix<typename DerivedV::Scalar,0,3> CN;
+  const Eigen::Matrix<typename DerivedF::Scalar,0,3> FN;
+  const Eigen::Matrix<typename DerivedV::Scalar,0,2> TC;
+  const Eigen::Matrix<typename DerivedF::Scalar,0,3> FTC;
+  return writeOBJ(obj_file,V,F,CN,FN,TC,FTC);
 }
 
 #ifdef IGL_STATIC_LIBRARY
@@ -133,4 +178,5 @@ template bool igl::writeOBJ<Eigen::Matrix<double, -1, -1, 1, -1, -1>, Eigen::Mat
 template bool igl::writeOBJ<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 1, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(std::basic_string<char, std::char_traits<char>, std::allocator<char> >, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 1, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&);
 template bool igl::writeOBJ<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(std::basic_string<char, std::char_traits<char>, std::allocator<char> >, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&);
 template bool igl::writeOBJ<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(std::basic_string<char, std::char_traits<char>, std::allocator<char> >, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&);
+template bool igl::writeOBJ<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(FILE*, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&);
 #endif
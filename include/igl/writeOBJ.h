@@ -12,6 +12,7 @@
 //  return type changed from void to bool  Alec 20 Sept 2011
 
 #include <Eigen/Core>
+#include <cstdio>
 #include <string>
 
 namespace igl 
@@ -49,6 +50,32 @@ namespace igl
     const std::string str,
     const Eigen::MatrixBase<DerivedV>& V,
     const Eigen::MatrixBase<DerivedF>& F);
+  // Write to an already opened file (e.g., a pipe into a compressor). The
+  // file is not closed.
+  //
+  // Inputs:
+  //   obj_file  pointer to file open for writing
+  //   ...
+  template <
+    typename DerivedV, 
+    typename DerivedF,
+    typename DerivedCN, 
+    typename DerivedFN,
+    typename DerivedTC, 
+    typename DerivedFTC>
+  IGL_INLINE bool writeOBJ(
+    FILE * obj_file,
+    const Eigen::MatrixBase<DerivedV>& V,
+    const Eigen::MatrixBase<DerivedF>& F,
+    const Eigen::MatrixBase<DerivedCN>& CN,
+    const Eigen::MatrixBase<DerivedFN>& FN,
+    const Eigen::MatrixBase<DerivedTC>& TC,
+    const Eigen::MatrixBase<DerivedFTC>& FTC);
+  template <typename DerivedV, typename DerivedF>
+  IGL_INLINE bool writeOBJ(
+    FILE * obj_file,
+    const Eigen::MatrixBase<DerivedV>& V,
+    const Eigen::MatrixBase<DerivedF>& F);
 
 }
 
@@ -6,8 +6,9 @@
 // v. 2.0. If a copy of the MPL was not distributed with this file, You can
 // obtain one at http://mozilla.org/MPL/2.0/.
 #include "writeOFF.h"
+#include "write_formatted_rows.h"
+#include <cassert>
 #include <cstdio>
-#include <fstream>
 
 // write mesh to an ascii off file
 template <typename DerivedV, typename DerivedF>
@@ -16,21 +17,14 @@ IGL_INLINE bool igl::writeOFF(
   const Eigen::PlainObjectBase<DerivedV>& V,
   const Eigen::PlainObjectBase<DerivedF>& F)
 {
-  using namespace std;
-  using namespace Eigen;
-  assert(V.cols() == 3 && "V should have 3 columns");
-  ofstream s(fname);
-  if(!s.is_open())
+  FILE * off_file = fopen(fname.c_str(),"w");
+  if(NULL==off_file)
   {
     fprintf(stderr,"IOError: writeOFF() could not open %s\n",fname.c_str());
     return false;
   }
-
-  s<<
-    "OFF\n"<<V.rows()<<" "<<F.rows()<<" 0\n"<<
-    V.format(IOFormat(FullPrecision,DontAlignCols," ","\n","","","","\n"))<<
-    (F.array()).format(IOFormat(FullPrecision,DontAlignCols," ","\n","3 ","","","\n"));
-  return true;
+  const bool ret = writeOFF(off_file,V,F);
+  return (fclose(off_file) == 0) && ret;
 }
 
 // write mesh and colors-by-vertex to an ascii off file
@@ -41,37 +35,97 @@ IGL_INLINE bool igl::writeOFF(
   const Eigen::PlainObjectBase<DerivedF>& F,
   const Eigen::PlainObjectBase<DerivedC>& C)
 {
-  using namespace std;
-  using namespace Eigen;
-  assert(V.cols() == 3 && "V should have 3 columns");
-  assert(C.cols() == 3 && "C should have 3 columns");
-
   if(V.rows() != C.rows())
   {
     fprintf(stderr,"IOError: writeOFF() Only color per vertex supported. V and C should have same size.\n");
     return false;
   }
-
-  ofstream s(fname);
-  if(!s.is_open())
+  FILE * off_file = fopen(fname.c_str(),"w");
+  if(NULL==off_file)
   {
     fprintf(stderr,"IOError: writeOFF() could not open %s\n",fname.c_str());
     return false;
   }
+  const bool ret = writeOFF(off_file,V,F,C);
+  return (fclose(off_file) == 0) && ret;
+}
 
-  //Check if RGB values are in the range [0..1] or [0..255]
-  int rgbScale = (C.maxCoeff() <= 1.0)?255:1;
-  Eigen::MatrixXd RGB = rgbScale * C;
+template <typename DerivedV, typename DerivedF>
+IGL_INLINE bool igl::writeOFF(
+  FILE * off_file,
+  const Eigen::PlainObjectBase<DerivedV>& V,
+  const Eigen::PlainObjectBase<DerivedF>& F)
+{
+  assert(V.cols() == 3 && "V should have 3 columns");
+  fprintf(off_file,"OFF\n%d %d 0\n",(int)V.rows(),(int)F.rows());
+  const auto & format_v = [&V](const size_t i, std::string & buf)
+  {
+    for(int j = 0;j<(int)V.cols();j++)
+    {
+      if(j>0) buf += ' ';
+      append_real(V(i,j),buf);
+    }
+    buf += '\n';
+  };
+  const auto & format_f = [&F](const size_t i, std::string & buf)
+  {
+    append_integer((int)F.cols(),buf);
+    for(int j = 0;j<(int)F.cols();j++)
+    {
+      buf += ' ';
+      append_integer(F(i,j),buf);
+    }
+    buf += '\n';
+  };
+  return 
+    write_formatted_rows(off_file,V.rows(),format_v) &&
+    write_formatted_rows(off_file,F.rows(),format_f);
+}
 
-  s<< "COFF\n"<<V.rows()<<" "<<F.rows()<<" 0\n";
-  for (unsigned i=0; i< V.rows(); i++)
+template <typename DerivedV, typename DerivedF, typename DerivedC>
+IGL_INLINE bool igl::writeOFF(
+  FILE * off_file,
+  const Eigen::PlainObjectBase<DerivedV>& V,
+  const Eigen::PlainObjectBase<DerivedF>& F,
+  const Eigen::PlainObjectBase<DerivedC>& C)
+{
+  assert(V.cols() == 3 && "V should have 3 columns");
+  assert(C.cols() == 3 && "C should have 3 columns");
+  if(V.rows() != C.rows())
   {
-    s <<V.row(i).format(IOFormat(FullPrecision,DontAlignCols," "," ","","",""," "));
-    s << unsigned(RGB(i,0)) << " " << unsigned(RGB(i,1)) << " " << unsigned(RGB(i,2)) << " 255\n";
+    fprintf(stderr,"IOError: writeOFF() Only color per vertex supported. V and C should have same size.\n");
+    return false;
   }
-
-  s<<(F.array()).format(IOFormat(FullPrecision,DontAlignCols," ","\n","3 ","","","\n"));
-  return true;
+  //Check if RGB values are in the range [0..1] or [0..255]
+  const double rgbScale = (C.maxCoeff() <= 1.0)?255:1;
+  fprintf(off_file,"COFF\n%d %d 0\n",(int)V.rows(),(int)F.rows());
+  const auto & format_v = [&V,&C,rgbScale](const size_t i, std::string & buf)
+  {
+    for(int j = 0;j<(int)V.cols();j++)
+    {
+      append_real(V(i,j),buf);
+      buf += ' ';
+    }
+    for(int j = 0;j<3;j++)
+    {
+      append_integer((unsigned)(rgbScale*C(i,j)),buf);
+      buf += ' ';
+    }
+    buf += "255\n";
+  };
+  const auto & format_f = [&F](const size_t i, std::string & buf)
+  {
+    append_integer((int)F.cols(),buf);
+    for(int j = 0;j<(int)F.cols();j++)
+    {
+      buf += ' ';
+      append_integer(F(i,j),buf);
+    }
+    buf += '\n';
+  };
+  return 
+    write_formatted_rows(off_file,V.rows(),format_v) &&
+    write_formatted_rows(off_file,F.rows(),format_f);
 }
 
 #ifdef IGL_STATIC_LIBRARY
@@ -89,4 +143,5 @@ template bool igl::writeOFF<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Mat
 template bool igl::writeOFF<Eigen::Matrix<double, -1, 3, 1, -1, 3>, Eigen::Matrix<int, -1, 3, 1, -1, 3> >(std::basic_string<char, std::char_traits<char>, std::allocator<char> >, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 3, 1, -1, 3> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 3, 1, -1, 3> > const&);
 template bool igl::writeOFF<Eigen::Matrix<double, -1, 3, 1, -1, 3>, Eigen::Matrix<int, -1, 3, 1, -1, 3>, Eigen::Matrix<double, -1, 3, 1, -1, 3> >(std::basic_string<char, std::char_traits<char>, std::allocator<char> >, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 3, 1, -1, 3> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 3, 1, -1, 3> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 3, 1, -1, 3> > const&);
 template bool igl::writeOFF<Eigen::Matrix<double, -1, 3, 1, -1, 3>, Eigen::Matrix<unsigned int, -1, 3, 1, -1, 3>, Eigen::Matrix<double, -1, 3, 1, -1, 3> >(std::basic_string<char, std::char_traits<char>, std::allocator<char> >, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 3, 1, -1, 3> > const&, Eigen::PlainObjectBase<Eigen::Matrix<unsigned int, -1, 3, 1, -1, 3> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 3, 1, -1, 3> > const&);
+template bool igl::writeOFF<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(FILE*, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&);
 #endif
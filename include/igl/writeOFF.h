@@ -10,6 +10,7 @@
 #include "igl_inline.h"
 
 #include <Eigen/Core>
+#include <cstdio>
 #include <string>
 
 namespace igl 
@@ -41,6 +42,23 @@ namespace igl
     const std::string str,
     const Eigen::PlainObjectBase<DerivedV>& V,
     const Eigen::PlainObjectBase<DerivedF>& F);
+  // Write to an already opened file (e.g., a pipe into a compressor). The
+  // file is not closed.
+  //
+  // Inputs:
+  //   off_file  pointer to file open for writing
+  //   ...
+  template <typename DerivedV, typename DerivedF, typename DerivedC>
+  IGL_INLINE bool writeOFF(
+    FILE * off_file,
+    const Eigen::PlainObjectBase<DerivedV>& V,
+    const Eigen::PlainObjectBase<DerivedF>& F,
+    const Eigen::PlainObjectBase<DerivedC>& C);
+  template <typename DerivedV, typename DerivedF>
+  IGL_INLINE bool writeOFF(
+    FILE * off_file,
+    const Eigen::PlainObjectBase<DerivedV>& V,
+    const Eigen::PlainObjectBase<DerivedF>& F);
 }
 
 #ifndef IGL_STATIC_LIBRARY
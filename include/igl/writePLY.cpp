@@ -105,15 +105,20 @@ IGL_INLINE bool igl::writePLY(
   }
 
   const char * elem_names[] = {"vertex","face"};
+  // ply.h writes one property at a time, so give stdio a large buffer (must
+  // outlive ply_close)
+  std::vector<char> fp_buffer(1<<22);
   FILE * fp = fopen(filename.c_str(),"w");
   if(fp==NULL)
   {
     return false;
   }
+  setvbuf(fp,&fp_buffer[0],_IOFBF,fp_buffer.size());
   PlyFile * ply = ply_write(fp, 2,elem_names,
       (ascii ? PLY_ASCII : PLY_BINARY_LE));
   if(ply==NULL)
   {
+    fclose(fp);
     return false;
   }
 
@@ -0,0 +1,160 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 agent <agent@local>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_WRITE_FORMATTED_ROWS_H
+#define IGL_WRITE_FORMATTED_ROWS_H
+#include "igl_inline.h"
+#include <cstdio>
+#include <string>
+
+namespace igl
+{
+  // WRITE_FORMATTED_ROWS Format a sequence of text rows (e.g., the "v ..." or
+  // "f ..." lines of an .obj file) into large in-memory blocks and write the
+  // blocks to a file in order. Blocks are formatted in parallel, so that the
+  // cost of printing numbers is spread across all available threads while the
+  // output remains identical to a serial loop:
+  //
+  //     for(size_t i = 0;i<n;i++)
+  //     {
+  //       std::string buf;
+  //       format_row(i,buf);
+  //       fwrite(buf.data(),1,buf.size(),fp);
+  //     }
+  //
+  // Inputs:
+  //   fp  file open for writing (could be a pipe, e.g., `popen("gzip >
+  //     out.obj.gz","w")`, to write directly to a compressed stream)
+  //   n  number of rows
+  //   format_row  function handle taking row index i and a std::string
+  //     buffer, appending the text of row i (including line break) to the
+  //     buffer. Must be safe to call concurrently for different i.
+  //   block_size  number of rows per block {16384}
+  // Returns true on success, false on write error
+  template <typename FormatRowFunctionType>
+  inline bool write_formatted_rows(
+    FILE * fp,
+    const size_t n,
+    const FormatRowFunctionType & format_row,
+    const size_t block_size = 16384);
+  // Append the decimal representation of an integer to a buffer
+  //
+  // Inputs:
+  //   x  integer value
+  //   buf  buffer
+  // Outputs:
+  //   buf  buffer with x appended
+  template <typename Integer>
+  inline void append_integer(const Integer x, std::string & buf);
+  // Append a decimal representation of a floating point value to a buffer
+  // that reads back (strtod) to exactly the same value. Uses
+  // std::numeric_limits<Scalar>::max_digits10 significant digits (17 for
+  // double, 9 for float), except for integral values, which are printed
+  // without a decimal point.
+  //
+  // Inputs:
+  //   x  floating point value
+  //   buf  buffer
+  // Outputs:
+  //   buf  buffer with x appended
+  template <typename Scalar>
+  inline void append_real(const Scalar x, std::string & buf);
+}
+
+// Implementation
+
+#include "default_num_threads.h"
+#include "parallel_for.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+template <typename FormatRowFunctionType>
+inline bool igl::write_formatted_rows(
+  FILE * fp,
+  const size_t n,
+  const FormatRowFunctionType & format_row,
+  const size_t block_size)
+{
+  if(n == 0)
+  {
+    return true;
+  }
+  const size_t bs = std::max(block_size,(size_t)1);
+  const size_t num_blocks = (n+bs-1)/bs;
+  // Format a bounded number of blocks at a time so that memory usage stays
+  // proportional to the number of threads rather than to the output size
+  const size_t batch =
+    std::min(num_blocks,(size_t)4*(size_t)default_num_threads());
+  std::vector<std::string> buffers(batch);
+  for(size_t b0 = 0;b0<num_blocks;b0+=batch)
+  {
+    const int nb = (int)(std::min(num_blocks,b0+batch)-b0);
+    parallel_for(nb,[&](const int k)
+    {
+      std::string & buf = buffers[k];
+      buf.clear();
+      const size_t i0 = (b0+k)*bs;
+      const size_t i1 = std::min(n,i0+bs);
+      for(size_t i = i0;i<i1;i++)
+      {
+        format_row(i,buf);
+      }
+    },2);
+    for(int k = 0;k<nb;k++)
+    {
+      if(fwrite(buffers[k].data(),1,buffers[k].size(),fp) != buffers[k].size())
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+template <typename Integer>
+inline void igl::append_integer(const Integer x, std::string & buf)
+{
+  typedef typename std::make_unsigned<Integer>::type Unsigned;
+  char tmp[24];
+  char * end = tmp+sizeof(tmp);
+  char * p = end;
+  const bool negative = x < 0;
+  // Negate in unsigned arithmetic to handle the most negative value
+  Unsigned u = negative ? Unsigned(0)-Unsigned(x) : Unsigned(x);
+  do
+  {
+    *--p = char('0'+(u%10));
+    u /= 10;
+  } while(u != 0);
+  if(negative)
+  {
+    *--p = '-';
+  }
+  buf.append(p,end-p);
+}
+
+template <typename Scalar>
+inline void igl::append_real(const Scalar x, std::string & buf)
+{
+  // Integral values (common for colors, grids and counts) are printed exactly
+  // and much faster than through printf. Negative zero keeps its sign.
+  if(x == std::floor(x) && std::abs(x) < Scalar(1e15) &&
+    !(x == 0 && std::signbit(x)))
+  {
+    append_integer((long long)x,buf);
+    return;
+  }
+  char tmp[40];
+  const int len = snprintf(
+    tmp,sizeof(tmp),"%.*g",std::numeric_limits<Scalar>::max_digits10,(double)x);
+  buf.append(tmp,len);
+}
+
+#endif
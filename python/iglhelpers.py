@@ -11,8 +11,7 @@ import pyigl as igl
 
 def p2e(m):
     if isinstance(m, np.ndarray):
-        if not m.flags['C_CONTIGUOUS']:
-            raise TypeError("p2e only support C-contiguous order")
+        # Any memory layout (C, Fortran or strided) is copied in a single pass
         if m.dtype.type == np.int32:
             return igl.eigen.MatrixXi(m)
         elif m.dtype.type == np.float64:
@@ -40,12 +39,23 @@ def p2e(m):
     raise TypeError("p2e only support numpy.array or scipy.sparse")
 
 
-def e2p(m):
+def e2p(m, copy=True):
+    # Dense matrices are returned as independent C ordered copies by default.
+    # With copy=False they are returned as Fortran ordered views sharing the
+    # memory of m, which they keep alive: the view is only valid as long as m
+    # is not resized (e.g. reused as an output argument) and writes to the
+    # view change m. Sparse matrices are always copied.
     if isinstance(m, igl.eigen.MatrixXd):
+        if not copy:
+            return np.array(m, dtype='float64', copy=False)
         return np.array(m, dtype='float64', order='C')
     elif isinstance(m, igl.eigen.MatrixXi):
+        if not copy:
+            return np.array(m, dtype='int32', copy=False)
         return np.array(m, dtype='int32', order='C')
     elif isinstance(m, igl.eigen.MatrixXb):
+        if not copy:
+            return np.array(m, dtype='bool', copy=False)
         return np.array(m, dtype='bool', order='C')
     elif isinstance(m, igl.eigen.SparseMatrixd):
         coo = np.array(m.toCOO())
@@ -8,6 +8,8 @@
 #include <Eigen/Geometry>
 #include <Eigen/Dense>
 #include <Eigen/Sparse>
+#include <cstring>
+#include <cstdint>
 
 
 #include "../python_shared.h"
@@ -34,20 +36,30 @@ py::class_<Type> bind_eigen_2(py::module &m, const char *name) {
             py::buffer_info info = b.request();
             if (info.format != py::format_descriptor<Scalar>::format())
                 throw std::runtime_error("Incompatible buffer format!");
-            if (info.ndim == 1) {
-                new (&m) Type(info.shape[0], 1);
-                memcpy(m.data(), info.ptr, sizeof(Scalar) * m.size());
-            } else if (info.ndim == 2) {
-                if (info.strides[0] == sizeof(Scalar)) {
-                    new (&m) Type(info.shape[0], info.shape[1]);
-                    memcpy(m.data(), info.ptr, sizeof(Scalar) * m.size());
-                } else {
-                    new (&m) Type(info.shape[1], info.shape[0]);
-                    memcpy(m.data(), info.ptr, sizeof(Scalar) * m.size());
-                    m.transposeInPlace();
-                }
-            } else {
+            if (info.ndim != 1 && info.ndim != 2)
                 throw std::runtime_error("Incompatible buffer dimension!");
+            const Eigen::Index rows = info.shape[0];
+            const Eigen::Index cols = info.ndim == 2 ? info.shape[1] : 1;
+            const ptrdiff_t rbytes = (ptrdiff_t) info.strides[0];
+            const ptrdiff_t cbytes = info.ndim == 2 ? (ptrdiff_t) info.strides[1] : rows * rbytes;
+            const ptrdiff_t size = (ptrdiff_t) sizeof(Scalar);
+            if (rbytes % size == 0 && cbytes % size == 0 &&
+                (uintptr_t) info.ptr % alignof(Scalar) == 0) {
+                /* Wrap the buffer with its strides (in scalars) so that C,
+                   Fortran, sliced and reversed arrays are all copied in a
+                   single pass */
+                typedef Eigen::Stride<Eigen::Dynamic, Eigen::Dynamic> Strides;
+                typedef Eigen::Map<const Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>, Eigen::Unaligned, Strides> StridedMap;
+                new (&m) Type(StridedMap((const Scalar *) info.ptr, rows, cols, Strides(cbytes / size, rbytes / size)));
+            } else {
+                /* Byte strides that are not a multiple of the scalar size
+                   (e.g., a field of a packed structured array): copy element
+                   by element */
+                new (&m) Type(rows, cols);
+                const char * data = (const char *) info.ptr;
+                for (Eigen::Index j = 0; j < cols; ++j)
+                    for (Eigen::Index i = 0; i < rows; ++i)
+                        std::memcpy(&m(i, j), data + i * rbytes + j * cbytes, sizeof(Scalar));
             }
         })
         .def("__init__", [](Type &m, std::vector<std::vector< Scalar> >& b) {
@@ -19,6 +19,7 @@ m.def("mesh_boolean", []
   Eigen::MatrixXi& J
 )
 {
+  py::gil_scoped_release release;
   return igl::copyleft::cgal::mesh_boolean(VA, FA, VB, FB, type, VC, FC, J);
 }, __doc_igl_copyleft_cgal_mesh_boolean,
 py::arg("VA"), py::arg("FA"), py::arg("VB"), py::arg("FB"), py::arg("type"), py::arg("VC"), py::arg("FC"), py::arg("J"));
@@ -36,6 +37,7 @@ m.def("mesh_boolean", []
   Eigen::MatrixXi& J
 )
 {
+  py::gil_scoped_release release;
   return igl::copyleft::cgal::mesh_boolean(VA, FA, VB, FB, type_str, VC, FC, J);
 }, __doc_igl_copyleft_cgal_mesh_boolean,
 py::arg("VA"), py::arg("FA"), py::arg("VB"), py::arg("FB"), py::arg("type_str"), py::arg("VC"), py::arg("FC"), py::arg("J"));
@@ -51,6 +53,7 @@ m.def("mesh_boolean", []
   Eigen::MatrixXi& FC
 )
 {
+  py::gil_scoped_release release;
   return igl::copyleft::cgal::mesh_boolean(VA, FA, VB, FB, type, VC, FC);
 }, __doc_igl_copyleft_cgal_mesh_boolean,
 py::arg("VA"), py::arg("FA"), py::arg("VB"), py::arg("FB"), py::arg("type"), py::arg("VC"), py::arg("FC"));
@@ -52,6 +52,7 @@ m.def("arap_precomputation", []
   if (b.size() != 0)
     bt = b;
 
+  py::gil_scoped_release release;
   return igl::arap_precomputation(V,F,dim,bt,data);
 }, __doc_igl_arap_precomputation,
 py::arg("V"), py::arg("F"), py::arg("dim"), py::arg("b"), py::arg("data"));
@@ -63,6 +64,7 @@ m.def("arap_solve", []
   Eigen::MatrixXd& U
 )
 {
+  py::gil_scoped_release release;
   return igl::arap_solve(bc,data,U);
 }, __doc_igl_arap_solve,
 py::arg("bc"), py::arg("data"), py::arg("U"));
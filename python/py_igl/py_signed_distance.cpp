@@ -27,11 +27,8 @@ m.def("signed_distance", []
   Eigen::MatrixXd& N
 )
 {
-  Eigen::VectorXd Sv;
-  Eigen::VectorXi Iv;
-  igl::signed_distance(P, V, F, sign_type, Sv, Iv, C, N);
-  S = Sv;
-  I = Iv;
+  py::gil_scoped_release release;
+  igl::signed_distance(P, V, F, sign_type, S, I, C, N);
 }, __doc_igl_signed_distance,
 py::arg("P"), py::arg("V"), py::arg("F"), py::arg("sign_type"), py::arg("S"), py::arg("I"), py::arg("C"), py::arg("N"));
 
@@ -73,11 +70,8 @@ m.def("signed_distance_pseudonormal", []
   Eigen::VectorXi EMAPv;
   if (EMAP.size() != 0)
     EMAPv = EMAP;
-  Eigen::VectorXd Sv;
-  Eigen::VectorXi Iv;
-  igl::signed_distance_pseudonormal(P, V, F, tree, FN, VN, EN, EMAPv, Sv, Iv, C, N);
-  S = Sv;
-  I = Iv;
+  py::gil_scoped_release release;
+  igl::signed_distance_pseudonormal(P, V, F, tree, FN, VN, EN, EMAPv, S, I, C, N);
 }, __doc_igl_signed_distance_pseudonormal,
 py::arg("P"), py::arg("V"), py::arg("F"), py::arg("tree"), py::arg("FN"), py::arg("VN"), py::arg("EN"), py::arg("EMAP"), py::arg("S"), py::arg("I"), py::arg("C"), py::arg("N"));
 
@@ -0,0 +1,57 @@
+# This file is part of libigl, a simple c++ geometry processing library.
+#
+# Copyright (C) 2026 agent <agent@local>
+#
+# This Source Code Form is subject to the terms of the Mozilla Public License
+# v. 2.0. If a copy of the MPL was not distributed with this file, You can
+# obtain one at http://mozilla.org/MPL/2.0/.
+#
+# Run from python/tests after building pyigl:
+#   python -m unittest test_p2e
+import sys, os
+import unittest
+
+# Add the igl library to the modules search path
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), ".."))
+import numpy as np
+from iglhelpers import *
+
+
+class TestBufferConstructor(unittest.TestCase):
+    def check(self, a):
+        e = e2p(p2e(a))
+        self.assertEqual(e.shape, a.shape if a.ndim == 2 else (a.shape[0], 1))
+        self.assertTrue(np.array_equal(e, a.reshape(e.shape)))
+
+    def test_c_order(self):
+        self.check(np.arange(12, dtype='float64').reshape(3, 4))
+
+    def test_fortran_order(self):
+        self.check(np.asfortranarray(np.arange(12, dtype='float64').reshape(3, 4)))
+
+    def test_sliced(self):
+        a = np.arange(60, dtype='float64').reshape(6, 10)
+        self.check(a[1::2, ::3])
+        self.check(a[:, 4])
+
+    def test_negative_stride(self):
+        a = np.arange(12, dtype='float64').reshape(4, 3)
+        self.check(a[::-1])
+        self.check(a[:, ::-1])
+        self.check(a[::-1, ::-1])
+        self.check(np.arange(5, dtype='float64')[::-1])
+
+    def test_int(self):
+        a = np.arange(12, dtype='int32').reshape(3, 4)
+        self.check(a)
+        self.check(np.asfortranarray(a)[::-1])
+
+    def test_unaligned_stride(self):
+        # Byte stride of 12 is not a multiple of sizeof(double)
+        s = np.zeros(5, dtype=np.dtype([('a', 'i4'), ('x', 'f8')], align=False))
+        s['x'] = np.arange(5)
+        self.check(s['x'])
+
+
+if __name__ == '__main__':
+    unittest.main()
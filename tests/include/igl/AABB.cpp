@@ -0,0 +1,281 @@
+#include <test_common.h>
+#include <igl/AABB.h>
+#include <igl/Hit.h>
+#include <igl/doublearea.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+// Single precision trees should answer queries like double precision ones,
+// up to rounding of the (float) input mesh and queries.
+
+namespace
+{
+  void bunny(Eigen::MatrixXd & V, Eigen::MatrixXi & F, double & diag)
+  {
+    test_common::load_mesh("bunny.off",V,F);
+    diag = (V.colwise().maxCoeff()-V.colwise().minCoeff()).norm();
+  }
+}
+
+TEST(AABB, float_squared_distance_matches_double)
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  double diag;
+  bunny(V,F,diag);
+  const Eigen::MatrixXf Vf = V.cast<float>();
+
+  // Query points in a box twice the size of the bounding box
+  std::srand(0);
+  const Eigen::RowVector3d mid = 0.5*(V.colwise().maxCoeff()+V.colwise().minCoeff());
+  const Eigen::RowVector3d ext = V.colwise().maxCoeff()-V.colwise().minCoeff();
+  Eigen::MatrixXd P = Eigen::MatrixXd::Random(1000,3);
+  P = (P.array().rowwise()*ext.array()).matrix().rowwise()+mid;
+  // Round the queries to float so that both trees see the same points
+  const Eigen::MatrixXf Pf = P.cast<float>();
+  P = Pf.cast<double>();
+
+  igl::AABB<Eigen::MatrixXd,3> tree;
+  tree.init(V,F);
+  igl::AABB<Eigen::MatrixXf,3> treef;
+  treef.init(Vf,F);
+
+  Eigen::VectorXd sqrD;
+  Eigen::VectorXi I;
+  Eigen::MatrixXd C;
+  tree.squared_distance(V,F,P,sqrD,I,C);
+  Eigen::VectorXf sqrDf;
+  Eigen::VectorXi If;
+  Eigen::MatrixXf Cf;
+  treef.squared_distance(Vf,F,Pf,sqrDf,If,Cf);
+
+  ASSERT_EQ(sqrDf.size(),P.rows());
+  ASSERT_EQ(If.size(),P.rows());
+  ASSERT_EQ(Cf.rows(),P.rows());
+  for(int p = 0;p<P.rows();p++)
+  {
+    // Distances (not squared) agree to a fraction of the mesh size
+    EXPECT_NEAR(std::sqrt(double(sqrDf(p))),std::sqrt(sqrD(p)),1e-6*diag) << p;
+    // The float closest point is at the float distance (the closest face
+    // may differ where several faces are equally close)
+    EXPECT_NEAR(
+      (Cf.row(p)-Pf.row(p)).cast<double>().squaredNorm(),
+      double(sqrDf(p)),
+      1e-6*diag*diag) << p;
+    ASSERT_GE(If(p),0);
+    ASSERT_LT(If(p),F.rows());
+  }
+}
+
+TEST(AABB, float_intersect_ray_matches_double)
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  double diag;
+  bunny(V,F,diag);
+  const Eigen::MatrixXf Vf = V.cast<float>();
+
+  igl::AABB<Eigen::MatrixXd,3> tree;
+  tree.init(V,F);
+  igl::AABB<Eigen::MatrixXf,3> treef;
+  treef.init(Vf,F);
+
+  // Shoot rays from outside of the mesh at face barycenters. The
+  // ray-triangle test culls nearly degenerate triangles (in both
+  // precisions), so only aim at faces of at least median area.
+  Eigen::VectorXd dblA;
+  igl::doublearea(V,F,dblA);
+  Eigen::VectorXd sorted_dblA = dblA;
+  std::sort(sorted_dblA.data(),sorted_dblA.data()+sorted_dblA.size());
+  const double median_dblA = sorted_dblA(sorted_dblA.size()/2);
+  std::srand(0);
+  const Eigen::RowVector3d mid = 0.5*(V.colwise().maxCoeff()+V.colwise().minCoeff());
+  int num_rays = 0;
+  for(int f = 0;f<F.rows();f += 97)
+  {
+    if(dblA(f) < median_dblA)
+    {
+      continue;
+    }
+    Eigen::RowVector3d dir = Eigen::RowVector3d::Random().normalized();
+    const Eigen::RowVector3d target =
+      (V.row(F(f,0))+V.row(F(f,1))+V.row(F(f,2)))/3.0;
+    const Eigen::RowVector3f sf = (mid+2.0*diag*dir).cast<float>();
+    const Eigen::RowVector3f df = (target.cast<float>()-sf);
+    const Eigen::RowVector3d s = sf.cast<double>();
+    const Eigen::RowVector3d d = df.cast<double>();
+
+    igl::Hit hit,hitf;
+    const bool is_hit = tree.intersect_ray(V,F,s,d,hit);
+    ASSERT_EQ(treef.intersect_ray(Vf,F,sf,df,hitf),is_hit) << f;
+    if(!is_hit)
+    {
+      continue;
+    }
+    // Ray parameter along a direction of length ~2*diag
+    EXPECT_NEAR(hitf.t,hit.t,1e-5) << f;
+
+    std::vector<igl::Hit> hits,hitsf;
+    ASSERT_TRUE(tree.intersect_ray(V,F,s,d,hits)) << f;
+    ASSERT_TRUE(treef.intersect_ray(Vf,F,sf,df,hitsf)) << f;
+    ASSERT_EQ(hitsf.size(),hits.size()) << f;
+    // Hits are reported in traversal order
+    const auto by_t = [](const igl::Hit & a, const igl::Hit & b)
+    {
+      return a.t < b.t;
+    };
+    std::sort(hits.begin(),hits.end(),by_t);
+    std::sort(hitsf.begin(),hitsf.end(),by_t);
+    for(int h = 0;h<(int)hits.size();h++)
+    {
+      EXPECT_NEAR(hitsf[h].t,hits[h].t,1e-5) << f << " " << h;
+    }
+    num_rays++;
+  }
+  EXPECT_GT(num_rays,20);
+}
+
+namespace
+{
+  // Every box of tree contains the boxes of its children, and leaf boxes
+  // contain their primitive
+  void expect_boxes_contain(
+    const igl::AABB<Eigen::MatrixXd,3> & tree,
+    const Eigen::MatrixXd & V,
+    const Eigen::MatrixXi & F)
+  {
+    if(tree.is_leaf())
+    {
+      for(int c = 0;c<F.cols();c++)
+      {
+        const Eigen::Vector3d v = V.row(F(tree.m_primitive,c)).transpose();
+        EXPECT_TRUE(tree.m_box.contains(v)) << tree.m_primitive;
+      }
+      return;
+    }
+    for(const auto * child : {tree.m_left,tree.m_right})
+    {
+      if(child)
+      {
+        EXPECT_TRUE(tree.m_box.contains(child->m_box));
+        expect_boxes_contain(*child,V,F);
+      }
+    }
+  }
+}
+
+TEST(AABB, refit_matches_rebuild)
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  double diag;
+  bunny(V,F,diag);
+  igl::AABB<Eigen::MatrixXd,3> tree;
+  tree.init(V,F);
+
+  // Twist around the y-axis and stretch along it
+  const double min_y = V.col(1).minCoeff();
+  Eigen::MatrixXd U = V;
+  for(int i = 0;i<V.rows();i++)
+  {
+    const double a = 3.*(V(i,1)-min_y)/diag;
+    U(i,0) = cos(a)*V(i,0) - sin(a)*V(i,2);
+    U(i,2) = sin(a)*V(i,0) + cos(a)*V(i,2);
+    U(i,1) = 1.5*V(i,1);
+  }
+  tree.refit(U,F);
+  expect_boxes_contain(tree,U,F);
+  igl::AABB<Eigen::MatrixXd,3> rebuild;
+  rebuild.init(U,F);
+
+  // Queries around the deformed mesh
+  std::srand(0);
+  const Eigen::RowVector3d mid =
+    0.5*(U.colwise().maxCoeff()+U.colwise().minCoeff());
+  const Eigen::RowVector3d ext = U.colwise().maxCoeff()-U.colwise().minCoeff();
+  Eigen::MatrixXd P = Eigen::MatrixXd::Random(1000,3);
+  P = (P.array().rowwise()*ext.array()).matrix().rowwise()+mid;
+
+  Eigen::VectorXd sqrD,rsqrD;
+  Eigen::VectorXi I,rI;
+  Eigen::MatrixXd C,rC;
+  tree.squared_distance(U,F,P,sqrD,I,C);
+  rebuild.squared_distance(U,F,P,rsqrD,rI,rC);
+  for(int p = 0;p<P.rows();p++)
+  {
+    // closest points may differ only on ties
+    EXPECT_NEAR(sqrD(p),rsqrD(p),1e-12*diag*diag) << p;
+    EXPECT_LT((C.row(p)-rC.row(p)).norm(),1e-6*diag) << p;
+  }
+
+  // First hits of rays through the query points
+  for(int p = 0;p<P.rows();p++)
+  {
+    const Eigen::RowVector3d dir = Eigen::RowVector3d::Random().normalized();
+    const Eigen::RowVector3d origin = P.row(p) - diag*dir;
+    igl::Hit hit,rhit;
+    const bool has_hit = tree.intersect_ray(U,F,origin,dir,hit);
+    ASSERT_EQ(has_hit,rebuild.intersect_ray(U,F,origin,dir,rhit)) << p;
+    if(has_hit)
+    {
+      EXPECT_NEAR(hit.t,rhit.t,1e-12*diag) << p;
+    }
+  }
+}
+
+
+TEST(AABB, batched_squared_distance_matches_per_point)
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  double diag;
+  bunny(V,F,diag);
+  igl::AABB<Eigen::MatrixXd,3> tree;
+  tree.init(V,F);
+
+  // Random points around the mesh, followed by a coherent grid and the mesh
+  // vertices (zero distance)
+  std::srand(0);
+  const Eigen::RowVector3d mid =
+    0.5*(V.colwise().maxCoeff()+V.colwise().minCoeff());
+  const Eigen::RowVector3d ext = V.colwise().maxCoeff()-V.colwise().minCoeff();
+  const int g = 10;
+  Eigen::MatrixXd P(1000+g*g*g+V.rows(),3);
+  P.topRows(1000) = Eigen::MatrixXd::Random(1000,3);
+  for(int i = 0;i<g*g*g;i++)
+  {
+    P.row(1000+i) <<
+      2.*(i%g)/(g-1)-1., 2.*((i/g)%g)/(g-1)-1., 2.*(i/(g*g))/(g-1)-1.;
+  }
+  P.topRows(1000+g*g*g) =
+    (P.topRows(1000+g*g*g).array().rowwise()*ext.array()).matrix().rowwise()
+    +mid;
+  P.bottomRows(V.rows()) = V;
+
+  // Sizes 0, 1 and all
+  for(const int n : {0,1,int(P.rows())})
+  {
+    const Eigen::MatrixXd Pn = P.topRows(n);
+    Eigen::VectorXd sqrD;
+    Eigen::VectorXi I;
+    Eigen::MatrixXd C;
+    tree.squared_distance(V,F,Pn,sqrD,I,C);
+    ASSERT_EQ(sqrD.size(),n);
+    ASSERT_EQ(I.size(),n);
+    ASSERT_EQ(C.rows(),n);
+    ASSERT_EQ(C.cols(),3);
+    for(int p = 0;p<n;p++)
+    {
+      int i;
+      Eigen::RowVector3d c;
+      const double sqr_d = tree.squared_distance(V,F,Pn.row(p).eval(),i,c);
+      EXPECT_NEAR(sqrD(p),sqr_d,1e-12*diag*diag) << p;
+      // The closest primitive may differ only on ties
+      EXPECT_LT((C.row(p)-c).norm(),1e-6*diag) << p;
+      ASSERT_GE(I(p),0);
+      ASSERT_LT(I(p),F.rows());
+    }
+  }
+}
@@ -0,0 +1,162 @@
+#include <test_common.h>
+#include <igl/UnionFind.h>
+#include <algorithm>
+#include <queue>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+  // Random graph on n nodes: pairs of nodes and a hidden parity per node.
+  // Nodes are grouped into runs so that there are many nontrivial sets.
+  void random_graph(
+    const int n,
+    const int num_edges,
+    std::vector<std::pair<int,int> > & E,
+    std::vector<bool> & S)
+  {
+    std::mt19937 gen(0);
+    std::uniform_int_distribution<int> node(0,n-1);
+    std::uniform_int_distribution<int> offset(-50,50);
+    std::bernoulli_distribution coin(0.5);
+    S.resize(n);
+    for(int i = 0;i<n;i++)
+    {
+      S[i] = coin(gen);
+    }
+    E.resize(num_edges);
+    for(auto & e : E)
+    {
+      e.first = node(gen);
+      e.second = std::max(0,std::min(n-1,e.first+offset(gen)));
+    }
+  }
+
+  // Labels of the connected components of E, numbered in order of their
+  // smallest node (breadth first search)
+  void bfs_labels(
+    const int n,
+    const std::vector<std::pair<int,int> > & E,
+    Eigen::VectorXi & C)
+  {
+    std::vector<std::vector<int> > adj(n);
+    for(const auto & e : E)
+    {
+      adj[e.first].push_back(e.second);
+      adj[e.second].push_back(e.first);
+    }
+    C.setConstant(n,-1);
+    int id = 0;
+    for(int s = 0;s<n;s++)
+    {
+      if(C(s) >= 0)
+      {
+        continue;
+      }
+      std::queue<int> Q;
+      Q.push(s);
+      C(s) = id;
+      while(!Q.empty())
+      {
+        const int i = Q.front();
+        Q.pop();
+        for(const int j : adj[i])
+        {
+          if(C(j) < 0)
+          {
+            C(j) = id;
+            Q.push(j);
+          }
+        }
+      }
+      id++;
+    }
+  }
+}
+
+TEST(UnionFind, concurrent_unions)
+{
+  const int n = 200000;
+  std::vector<std::pair<int,int> > E;
+  std::vector<bool> S;
+  random_graph(n,150000,E,S);
+  igl::UnionFind U(n);
+  // Every thread merges every edge (in a different order) so that the same
+  // sets are merged concurrently from many threads
+  const int num_threads = 8;
+  std::vector<int> num_conflicts(num_threads,0);
+  std::vector<std::thread> threads;
+  for(int t = 0;t<num_threads;t++)
+  {
+    threads.emplace_back([&,t]()
+    {
+      for(int k = 0;k<(int)E.size();k++)
+      {
+        const auto & e = E[(k*(2*t+1)+t*7919)%E.size()];
+        if(!U.unite(e.first,e.second,S[e.first]!=S[e.second]))
+        {
+          num_conflicts[t]++;
+        }
+      }
+    });
+  }
+  for(auto & thread : threads)
+  {
+    thread.join();
+  }
+  for(const int c : num_conflicts)
+  {
+    EXPECT_EQ(c,0);
+  }
+
+  Eigen::VectorXi C,counts,bfsC;
+  U.labels(C,counts);
+  bfs_labels(n,E,bfsC);
+  ASSERT_EQ(C.size(),n);
+  ASSERT_EQ(counts.size(),bfsC.maxCoeff()+1);
+  for(int i = 0;i<n;i++)
+  {
+    ASSERT_EQ(C(i),bfsC(i)) << i;
+  }
+  EXPECT_EQ(counts.sum(),n);
+  // Roots are the smallest elements and parities are relative to them
+  std::vector<int> first(counts.size(),-1);
+  for(int i = 0;i<n;i++)
+  {
+    if(first[C(i)] < 0)
+    {
+      first[C(i)] = i;
+    }
+    bool parity;
+    ASSERT_EQ(U.find(i,parity),first[C(i)]) << i;
+    ASSERT_EQ(parity,S[i]!=S[first[C(i)]]) << i;
+  }
+}
+
+TEST(UnionFind, parity_conflicts)
+{
+  // Closing a cycle with an odd number of "flipped" constraints (as around a
+  // Moebius strip) contradicts the others and must be rejected
+  igl::UnionFind U(5);
+  EXPECT_TRUE(U.unite(0,1,true));
+  EXPECT_TRUE(U.unite(1,2,true));
+  EXPECT_TRUE(U.unite(2,3,false));
+  EXPECT_TRUE(U.unite(3,4,true));
+  EXPECT_FALSE(U.unite(4,0,false));
+  EXPECT_TRUE(U.unite(4,0,true));
+  EXPECT_TRUE(U.unite(2,4,true));
+  EXPECT_FALSE(U.unite(2,4,false));
+  bool parity;
+  const bool expected[5] = {false,true,false,false,true};
+  for(int i = 0;i<5;i++)
+  {
+    EXPECT_EQ(U.find(i,parity),0);
+    EXPECT_EQ(parity,expected[i]) << i;
+  }
+  Eigen::VectorXi C,counts;
+  U.labels(C,counts);
+  EXPECT_EQ(counts.size(),1);
+  EXPECT_EQ(counts(0),5);
+}
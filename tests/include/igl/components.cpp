@@ -0,0 +1,96 @@
+#include <test_common.h>
+#include <igl/components.h>
+#include <igl/adjacency_matrix.h>
+#include <algorithm>
+#include <numeric>
+#include <queue>
+#include <random>
+#include <vector>
+
+// igl::components merges vertices with igl::UnionFind. It should label
+// components exactly like the breadth first search it replaced (in order of
+// their first vertex).
+
+namespace
+{
+  // The original igl::components
+  void bfs_components(
+    const Eigen::SparseMatrix<int> & A,
+    Eigen::VectorXi & C,
+    Eigen::VectorXi & counts)
+  {
+    const int n = A.rows();
+    C.setConstant(n,-1);
+    std::vector<int> vcounts;
+    for(int k = 0;k<n;k++)
+    {
+      if(C(k) >= 0)
+      {
+        continue;
+      }
+      vcounts.push_back(0);
+      std::queue<int> Q;
+      Q.push(k);
+      while(!Q.empty())
+      {
+        const int f = Q.front();
+        Q.pop();
+        if(C(f) >= 0)
+        {
+          continue;
+        }
+        C(f) = vcounts.size()-1;
+        vcounts.back()++;
+        for(Eigen::SparseMatrix<int>::InnerIterator it(A,f);it;++it)
+        {
+          if(C(it.index()) < 0 && it.value())
+          {
+            Q.push(it.index());
+          }
+        }
+      }
+    }
+    counts = Eigen::Map<Eigen::VectorXi>(vcounts.data(),vcounts.size());
+  }
+}
+
+TEST(components, matches_bfs)
+{
+  // Truck (many components) with shuffled vertex indices and unreferenced
+  // vertices
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::load_mesh("truck.obj",V,F);
+  std::vector<int> P(V.rows()+100);
+  std::iota(P.begin(),P.end(),0);
+  std::mt19937 gen(0);
+  std::shuffle(P.begin(),P.end(),gen);
+  for(int f = 0;f<F.rows();f++)
+  {
+    for(int c = 0;c<F.cols();c++)
+    {
+      F(f,c) = P[F(f,c)];
+    }
+  }
+  Eigen::SparseMatrix<int> A;
+  igl::adjacency_matrix(F,A);
+  A.conservativeResize(P.size(),P.size());
+  // Explicit zeros do not connect vertices
+  A.coeffRef(P[0],P[1]) = 0;
+  A.coeffRef(P[1],P[0]) = 0;
+
+  Eigen::VectorXi C,counts,bfsC,bfs_counts;
+  igl::components(A,C,counts);
+  bfs_components(A,bfsC,bfs_counts);
+  EXPECT_GT(bfs_counts.size(),100);
+  ASSERT_EQ(C.size(),A.rows());
+  EXPECT_EQ(C,bfsC);
+  EXPECT_EQ(counts,bfs_counts);
+
+  // From faces: only the referenced vertices
+  Eigen::SparseMatrix<int> AF;
+  igl::adjacency_matrix(F,AF);
+  bfs_components(AF,bfsC,bfs_counts);
+  igl::components(F,C);
+  EXPECT_EQ(C,bfsC);
+}
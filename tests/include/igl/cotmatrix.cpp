@@ -0,0 +1,39 @@
+#include <test_common.h>
+#include <igl/cotmatrix.h>
+
+TEST(cotmatrix, float_matches_double)
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::load_mesh("bunny.off",V,F);
+  const Eigen::MatrixXf Vf = V.cast<float>();
+  Eigen::SparseMatrix<double> L;
+  igl::cotmatrix(V,F,L);
+  Eigen::SparseMatrix<float> Lf;
+  igl::cotmatrix(Vf,F,Lf);
+  ASSERT_EQ(Lf.rows(),L.rows());
+  ASSERT_EQ(Lf.cols(),L.cols());
+  const Eigen::SparseMatrix<double> D = Lf.cast<double>()-L;
+  double max_L = 0;
+  for(int k = 0;k<L.outerSize();k++)
+  {
+    for(Eigen::SparseMatrix<double>::InnerIterator it(L,k);it;++it)
+    {
+      max_L = std::max(max_L,std::abs(it.value()));
+    }
+  }
+  double max_D = 0;
+  for(int k = 0;k<D.outerSize();k++)
+  {
+    for(Eigen::SparseMatrix<double>::InnerIterator it(D,k);it;++it)
+    {
+      max_D = std::max(max_D,std::abs(it.value()));
+    }
+  }
+  // Cotangents of nearly degenerate angles amplify rounding, so compare
+  // relative to the largest entry
+  EXPECT_LT(max_D,1e-4*max_L);
+  // Rows still sum to zero
+  const Eigen::VectorXf row_sums = Lf*Eigen::VectorXf::Ones(Lf.cols());
+  EXPECT_LT(row_sums.cwiseAbs().maxCoeff(),1e-4*max_L);
+}
@@ -0,0 +1,21 @@
+#include <test_common.h>
+#include <igl/cotmatrix_entries.h>
+
+TEST(cotmatrix_entries, float_matches_double)
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::load_mesh("bunny.off",V,F);
+  const Eigen::MatrixXf Vf = V.cast<float>();
+  Eigen::MatrixXd C;
+  igl::cotmatrix_entries(V,F,C);
+  Eigen::MatrixXf Cf;
+  igl::cotmatrix_entries(Vf,F,Cf);
+  ASSERT_EQ(Cf.rows(),C.rows());
+  ASSERT_EQ(Cf.cols(),C.cols());
+  // Half cotangents: relative to the largest one (nearly degenerate angles
+  // amplify rounding)
+  EXPECT_LT(
+    (Cf.cast<double>()-C).cwiseAbs().maxCoeff(),
+    1e-4*C.cwiseAbs().maxCoeff());
+}
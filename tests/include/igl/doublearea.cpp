@@ -0,0 +1,56 @@
+#include <test_common.h>
+#include <igl/doublearea.h>
+
+TEST(doublearea, float_matches_double)
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::load_mesh("bunny.off",V,F);
+  const Eigen::MatrixXf Vf = V.cast<float>();
+  Eigen::VectorXd A;
+  igl::doublearea(V,F,A);
+  Eigen::VectorXf Af;
+  igl::doublearea(Vf,F,Af);
+  // Float input, double output
+  Eigen::VectorXd Afd;
+  igl::doublearea(Vf,F,Afd);
+  ASSERT_EQ(Af.size(),A.size());
+  ASSERT_EQ(Afd.size(),A.size());
+  // Relative to the largest area
+  const double tol = 1e-5*A.maxCoeff();
+  EXPECT_LT((Af.cast<double>()-A).cwiseAbs().maxCoeff(),tol);
+  EXPECT_LT((Afd-A).cwiseAbs().maxCoeff(),tol);
+  EXPECT_NEAR(Af.cast<double>().sum(),A.sum(),1e-5*A.sum());
+}
+
+TEST(doublearea, float_quads_match_double)
+{
+  // 10 by 10 grid of unit quads, bent along x
+  const int n = 11;
+  Eigen::MatrixXd V(n*n,3);
+  for(int i = 0;i<n;i++)
+  {
+    for(int j = 0;j<n;j++)
+    {
+      V.row(i*n+j) << i, j, 0.1*i*i;
+    }
+  }
+  Eigen::MatrixXi Q((n-1)*(n-1),4);
+  for(int i = 0;i<n-1;i++)
+  {
+    for(int j = 0;j<n-1;j++)
+    {
+      Q.row(i*(n-1)+j) << i*n+j, (i+1)*n+j, (i+1)*n+j+1, i*n+j+1;
+    }
+  }
+  const Eigen::MatrixXf Vf = V.cast<float>();
+  Eigen::VectorXd A;
+  igl::doublearea(V,Q,A);
+  Eigen::VectorXf Af;
+  igl::doublearea(Vf,Q,Af);
+  ASSERT_EQ(A.size(),Q.rows());
+  ASSERT_EQ(Af.size(),Q.rows());
+  EXPECT_LT((Af.cast<double>()-A).cwiseAbs().maxCoeff(),1e-5*A.maxCoeff());
+  // Flat quads in the first column have twice area 2*sqrt(1+0.1^2)
+  EXPECT_NEAR(A(0),2.0*std::sqrt(1.0+0.01),1e-12);
+}
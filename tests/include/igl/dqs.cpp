@@ -0,0 +1,58 @@
+#include <test_common.h>
+#include <igl/dqs.h>
+#include <Eigen/Geometry>
+#include <Eigen/StdVector>
+#include <cstdlib>
+
+TEST(dqs, sparse_weights_match_dense)
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::load_mesh("bunny.off",V,F);
+  // k=3 random weights per vertex among m=5 handles, the last one unused
+  // (negative index) on every other vertex
+  const int m = 5, k = 3;
+  std::srand(0);
+  Eigen::MatrixXd W = Eigen::MatrixXd::Random(V.rows(),k).cwiseAbs();
+  Eigen::MatrixXi WI(V.rows(),k);
+  Eigen::MatrixXd Wdense = Eigen::MatrixXd::Zero(V.rows(),m);
+  for(int i = 0;i<V.rows();i++)
+  {
+    for(int j = 0;j<k;j++)
+    {
+      WI(i,j) = (i+2*j)%m;
+    }
+    if(i%2)
+    {
+      WI(i,k-1) = -1;
+      W(i,k-1) = 0;
+    }
+    W.row(i) /= W.row(i).sum();
+    for(int j = 0;j<k;j++)
+    {
+      if(WI(i,j) >= 0)
+      {
+        Wdense(i,WI(i,j)) += W(i,j);
+      }
+    }
+  }
+  // Random rigid transformations
+  std::vector<
+    Eigen::Quaterniond,Eigen::aligned_allocator<Eigen::Quaterniond> > vQ;
+  std::vector<Eigen::Vector3d> vT;
+  for(int c = 0;c<m;c++)
+  {
+    vQ.push_back(Eigen::Quaterniond(
+      Eigen::AngleAxisd(3.0*c/m,Eigen::Vector3d::Random().normalized())));
+    vT.push_back(Eigen::Vector3d::Random());
+  }
+
+  Eigen::MatrixXd U_dense;
+  igl::dqs(V,Wdense,vQ,vT,U_dense);
+  Eigen::MatrixXd U;
+  igl::dqs(V,W,WI,vQ,vT,U);
+  ASSERT_EQ(U.rows(),V.rows());
+  ASSERT_EQ(U.cols(),3);
+  EXPECT_LT(
+    (U-U_dense).cwiseAbs().maxCoeff(),1e-12*U_dense.cwiseAbs().maxCoeff());
+}
@@ -0,0 +1,115 @@
+#include <test_common.h>
+#include <igl/eigs.h>
+#include <igl/cotmatrix.h>
+#include <igl/massmatrix.h>
+#include <Eigen/Dense>
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+  // Compare k eigen pairs of (A,B) computed by igl::eigs to those of the
+  // dense generalized solver. The mesh is large enough (3*(k+10) < #V) for
+  // eigs to use its iterative solver.
+  void check_against_dense(
+    const Eigen::SparseMatrix<double> & A,
+    const Eigen::SparseMatrix<double> & B,
+    const int k,
+    const igl::EigsType type)
+  {
+    Eigen::MatrixXd U;
+    Eigen::VectorXd S;
+    ASSERT_TRUE(igl::eigs(A,B,k,type,U,S));
+    ASSERT_EQ(U.rows(),A.rows());
+    ASSERT_EQ(U.cols(),k);
+    ASSERT_EQ(S.size(),k);
+
+    const Eigen::MatrixXd dA = A;
+    const Eigen::MatrixXd dB = B;
+    Eigen::GeneralizedSelfAdjointEigenSolver<Eigen::MatrixXd> es(dA,dB);
+    ASSERT_EQ(es.info(),Eigen::Success);
+    // Dense pairs in the same order as eigs: descending eigen values
+    const int n = A.rows();
+    std::vector<int> I(n);
+    for(int i = 0;i<n;i++) I[i] = i;
+    const Eigen::VectorXd & E = es.eigenvalues();
+    std::stable_sort(I.begin(),I.end(),[&](int a,int b)
+    {
+      return type == igl::EIGS_TYPE_SM ?
+        std::abs(E(a)) < std::abs(E(b)) : std::abs(E(a)) > std::abs(E(b));
+    });
+    I.resize(k);
+    std::sort(I.begin(),I.end(),[&](int a,int b){ return E(a) > E(b); });
+    Eigen::VectorXd SD(k);
+    Eigen::MatrixXd UD(n,k);
+    for(int i = 0;i<k;i++)
+    {
+      SD(i) = E(I[i]);
+      UD.col(i) = es.eigenvectors().col(I[i]);
+    }
+
+    const double scale = SD.cwiseAbs().maxCoeff();
+    EXPECT_LT((S-SD).cwiseAbs().maxCoeff(),1e-8*scale);
+    // B-orthonormal
+    const Eigen::MatrixXd G = U.transpose()*(B*U);
+    EXPECT_LT((G-Eigen::MatrixXd::Identity(k,k)).cwiseAbs().maxCoeff(),1e-8);
+    // Same invariant subspace
+    const Eigen::MatrixXd C = UD.transpose()*(B*U);
+    EXPECT_LT(
+      (C.transpose()*C-Eigen::MatrixXd::Identity(k,k)).cwiseAbs().maxCoeff(),
+      1e-6);
+    // Same eigen vectors (up to sign) where eigen values are well separated
+    for(int i = 0;i<k;i++)
+    {
+      const double gap = std::min(
+        i>0 ? std::abs(SD(i)-SD(i-1)) : scale,
+        i+1<k ? std::abs(SD(i)-SD(i+1)) : scale);
+      if(gap > 1e-3*scale)
+      {
+        EXPECT_NEAR(std::abs(C(i,i)),1.0,1e-6) << i;
+      }
+    }
+  }
+}
+
+TEST(eigs, smallest_match_dense)
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::load_mesh("decimated-knight.off",V,F);
+  Eigen::SparseMatrix<double> L,M;
+  igl::cotmatrix(V,F,L);
+  igl::massmatrix(V,F,igl::MASSMATRIX_TYPE_DEFAULT,M);
+  const Eigen::SparseMatrix<double> A = -L;
+  check_against_dense(A,M,10,igl::EIGS_TYPE_SM);
+  check_against_dense(A,M,50,igl::EIGS_TYPE_SM);
+}
+
+TEST(eigs, largest_match_dense)
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::load_mesh("decimated-knight.off",V,F);
+  Eigen::SparseMatrix<double> L,M;
+  igl::cotmatrix(V,F,L);
+  igl::massmatrix(V,F,igl::MASSMATRIX_TYPE_DEFAULT,M);
+  const Eigen::SparseMatrix<double> A = -L;
+  check_against_dense(A,M,10,igl::EIGS_TYPE_LM);
+}
+
+TEST(eigs, deterministic)
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::load_mesh("decimated-knight.off",V,F);
+  Eigen::SparseMatrix<double> L,M;
+  igl::cotmatrix(V,F,L);
+  igl::massmatrix(V,F,igl::MASSMATRIX_TYPE_DEFAULT,M);
+  const Eigen::SparseMatrix<double> A = -L;
+  Eigen::MatrixXd U1,U2;
+  Eigen::VectorXd S1,S2;
+  ASSERT_TRUE(igl::eigs(A,M,10,igl::EIGS_TYPE_SM,U1,S1));
+  ASSERT_TRUE(igl::eigs(A,M,10,igl::EIGS_TYPE_SM,U2,S2));
+  EXPECT_EQ(S1,S2);
+  EXPECT_EQ(U1,U2);
+}
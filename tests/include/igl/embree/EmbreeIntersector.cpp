@@ -0,0 +1,179 @@
+#include <test_common.h>
+#include <igl/embree/EmbreeIntersector.h>
+#include <igl/Hit.h>
+#include <Eigen/Geometry>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+  // Rays from outside the bounding box through random points inside it
+  void random_rays(
+    const Eigen::MatrixXd & V,
+    const int n,
+    igl::embree::EmbreeIntersector::PointMatrixType & O,
+    igl::embree::EmbreeIntersector::PointMatrixType & D)
+  {
+    const Eigen::RowVector3d min_V = V.colwise().minCoeff();
+    const Eigen::RowVector3d ext_V = V.colwise().maxCoeff()-min_V;
+    std::srand(0);
+    O.resize(n,3);
+    D.resize(n,3);
+    for(int r = 0;r<n;r++)
+    {
+      const Eigen::RowVector3d t = 
+        0.5*(Eigen::RowVector3d::Random().array()+1);
+      const Eigen::RowVector3d target = min_V + t.cwiseProduct(ext_V);
+      const Eigen::RowVector3d dir = 
+        Eigen::RowVector3d::Random().normalized();
+      O.row(r) = (target - 2.*ext_V.norm()*dir).cast<float>();
+      D.row(r) = dir.cast<float>();
+    }
+  }
+
+  // Twist V around the z-axis, by an angle growing with z
+  Eigen::MatrixXd twist(const Eigen::MatrixXd & V)
+  {
+    const double min_z = V.col(2).minCoeff();
+    const double ext_z = V.col(2).maxCoeff()-min_z;
+    Eigen::MatrixXd U = V;
+    for(int i = 0;i<V.rows();i++)
+    {
+      const double a = (V(i,2)-min_z)/ext_z;
+      U(i,0) = cos(a)*V(i,0) - sin(a)*V(i,1);
+      U(i,1) = sin(a)*V(i,0) + cos(a)*V(i,1);
+    }
+    return U;
+  }
+
+  // Both intersectors report the same first hits and the same lists of all
+  // hits
+  void expect_same_hits(
+    const igl::embree::EmbreeIntersector & A,
+    const igl::embree::EmbreeIntersector & B,
+    const igl::embree::EmbreeIntersector::PointMatrixType & O,
+    const igl::embree::EmbreeIntersector::PointMatrixType & D)
+  {
+    std::vector<igl::Hit> hitsA,hitsB;
+    const int num_hits = A.intersectRays(O,D,hitsA);
+    EXPECT_EQ(B.intersectRays(O,D,hitsB),num_hits);
+    EXPECT_GT(num_hits,0);
+    for(int r = 0;r<O.rows();r++)
+    {
+      ASSERT_EQ(hitsA[r].id,hitsB[r].id) << r;
+      ASSERT_EQ(hitsA[r].gid,hitsB[r].gid) << r;
+      if(hitsA[r].id >= 0)
+      {
+        EXPECT_FLOAT_EQ(hitsA[r].t,hitsB[r].t) << r;
+      }
+      std::vector<igl::Hit> allA,allB;
+      int num_rays;
+      A.intersectRay(O.row(r),D.row(r),allA,num_rays);
+      B.intersectRay(O.row(r),D.row(r),allB,num_rays);
+      ASSERT_EQ(allA.size(),allB.size()) << r;
+      for(int h = 0;h<(int)allA.size();h++)
+      {
+        EXPECT_EQ(allA[h].id,allB[h].id) << r;
+        EXPECT_EQ(allA[h].gid,allB[h].gid) << r;
+      }
+    }
+  }
+}
+
+TEST(EmbreeIntersector, all_hits_and_first_hit_agree)
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::load_mesh("fertility.off",V,F);
+  igl::embree::EmbreeIntersector ei;
+  ei.init(V.cast<float>(),F);
+  igl::embree::EmbreeIntersector::PointMatrixType O,D;
+  random_rays(V,200,O,D);
+  std::vector<igl::Hit> first;
+  ei.intersectRays(O,D,first);
+  for(int r = 0;r<O.rows();r++)
+  {
+    // ordinary queries before and after the first all-hits query (which
+    // builds the filtered scene) give the same result
+    igl::Hit hit;
+    const bool has_hit = ei.intersectRay(O.row(r),D.row(r),hit);
+    ASSERT_EQ(has_hit,first[r].id >= 0);
+    std::vector<igl::Hit> hits;
+    int num_rays;
+    ei.intersectRay(O.row(r),D.row(r),hits,num_rays);
+    ASSERT_EQ(hits.empty(),!has_hit);
+    // closed mesh: even number of crossings
+    EXPECT_EQ(hits.size()%2,0u);
+    for(int h = 1;h<(int)hits.size();h++)
+    {
+      EXPECT_LE(hits[h-1].t,hits[h].t);
+    }
+    if(has_hit)
+    {
+      EXPECT_EQ(hits[0].id,hit.id);
+      EXPECT_FLOAT_EQ(hits[0].t,hit.t);
+      igl::Hit again;
+      ASSERT_TRUE(ei.intersectRay(O.row(r),D.row(r),again));
+      EXPECT_EQ(again.id,hit.id);
+    }
+  }
+}
+
+TEST(EmbreeIntersector, refit_matches_rebuild)
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::load_mesh("fertility.off",V,F);
+  igl::embree::EmbreeIntersector refit;
+  refit.init(V.cast<float>(),F,false,true);
+  igl::embree::EmbreeIntersector::PointMatrixType O,D;
+  random_rays(V,200,O,D);
+  // Query once (including all hits) so that update() has to refit both the
+  // ordinary and the all-hits scene
+  {
+    std::vector<igl::Hit> hits;
+    int num_rays;
+    refit.intersectRays(O,D,hits);
+    refit.intersectRay(O.row(0),D.row(0),hits,num_rays);
+  }
+  const Eigen::MatrixXd U = twist(V);
+  refit.update(U.cast<float>());
+  igl::embree::EmbreeIntersector rebuild;
+  rebuild.init(U.cast<float>(),F);
+  random_rays(U,200,O,D);
+  expect_same_hits(refit,rebuild,O,D);
+}
+
+TEST(EmbreeIntersector, update_instance_matches_rebuild)
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::load_mesh("fertility.off",V,F);
+  const igl::embree::EmbreeIntersector::PointMatrixType Vf = V.cast<float>();
+  const igl::embree::EmbreeIntersector::FaceMatrixType Ff = F;
+  const float ext = (V.colwise().maxCoeff()-V.colwise().minCoeff()).norm();
+  // Two instances of the mesh side by side
+  std::vector<
+    Eigen::Affine3f,Eigen::aligned_allocator<Eigen::Affine3f> > T(2);
+  T[0] = Eigen::Affine3f::Identity();
+  T[1] = Eigen::Translation3f(ext,0,0)*Eigen::AngleAxisf(0.5f,Eigen::Vector3f::UnitZ());
+  igl::embree::EmbreeIntersector moved;
+  moved.initInstances({&Vf},{&Ff},{0,0},T,{-1,-1});
+  igl::embree::EmbreeIntersector::PointMatrixType O,D;
+  Eigen::MatrixXd W(2*V.rows(),3);
+  W << V, V.rowwise()+Eigen::RowVector3d(ext,0,0);
+  random_rays(W,200,O,D);
+  {
+    std::vector<igl::Hit> hits;
+    int num_rays;
+    moved.intersectRays(O,D,hits);
+    moved.intersectRay(O.row(0),D.row(0),hits,num_rays);
+  }
+  T[1] = Eigen::Translation3f(0.5f*ext,0.5f*ext,0)*
+    Eigen::AngleAxisf(-1.f,Eigen::Vector3f::UnitX());
+  moved.updateInstance(1,T[1]);
+  igl::embree::EmbreeIntersector rebuild;
+  rebuild.initInstances({&Vf},{&Ff},{0,0},T,{-1,-1});
+  expect_same_hits(moved,rebuild,O,D);
+}
@@ -0,0 +1,29 @@
+#include <test_common.h>
+#include <igl/embree/ambient_occlusion.h>
+#include <igl/ambient_occlusion.h>
+#include <igl/AABB.h>
+#include <igl/per_vertex_normals.h>
+#include <cstdlib>
+
+TEST(embree_ambient_occlusion, matches_aabb)
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::load_mesh("fertility.off",V,F);
+  Eigen::MatrixXd N;
+  igl::per_vertex_normals(V,F,N);
+  igl::AABB<Eigen::MatrixXd,3> tree;
+  tree.init(V,F);
+  const int num_samples = 64;
+  // Both draw the same sample directions
+  Eigen::VectorXd S_embree,S_aabb;
+  std::srand(0);
+  igl::embree::ambient_occlusion(V,F,V,N,num_samples,S_embree);
+  std::srand(0);
+  igl::ambient_occlusion(tree,V,F,V,N,num_samples,S_aabb);
+  ASSERT_EQ(S_embree.size(),V.rows());
+  ASSERT_EQ(S_aabb.size(),V.rows());
+  // Only rays grazing the surface may disagree
+  EXPECT_LT((S_embree-S_aabb).cwiseAbs().mean(),0.01);
+  EXPECT_LT((S_embree-S_aabb).cwiseAbs().maxCoeff(),0.1);
+}
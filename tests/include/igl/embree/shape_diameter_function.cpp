@@ -0,0 +1,28 @@
+#include <test_common.h>
+#include <igl/embree/shape_diameter_function.h>
+#include <igl/shape_diameter_function.h>
+#include <igl/AABB.h>
+#include <igl/per_vertex_normals.h>
+#include <cstdlib>
+
+TEST(embree_shape_diameter_function, matches_aabb)
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::load_mesh("fertility.off",V,F);
+  Eigen::MatrixXd N;
+  igl::per_vertex_normals(V,F,N);
+  igl::AABB<Eigen::MatrixXd,3> tree;
+  tree.init(V,F);
+  const int num_samples = 64;
+  // Both draw the same sample directions
+  Eigen::VectorXd S_embree,S_aabb;
+  std::srand(0);
+  igl::embree::shape_diameter_function(V,F,V,N,num_samples,S_embree);
+  std::srand(0);
+  igl::shape_diameter_function(tree,V,F,V,N,num_samples,S_aabb);
+  ASSERT_EQ(S_embree.size(),V.rows());
+  ASSERT_EQ(S_aabb.size(),V.rows());
+  const double scale = S_aabb.cwiseAbs().maxCoeff();
+  EXPECT_LT((S_embree-S_aabb).cwiseAbs().mean(),0.01*scale);
+}
@@ -0,0 +1,46 @@
+#include <test_common.h>
+#include <igl/embree/unproject_onto_mesh.h>
+#include <igl/embree/EmbreeIntersector.h>
+
+TEST(embree_unproject_onto_mesh, deformed_matches_rebuild)
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::load_mesh("fertility.off",V,F);
+  // Fit into the unit cube so that identity model and projection matrices
+  // view the whole mesh
+  V = (V.rowwise()-0.5*(V.colwise().maxCoeff()+V.colwise().minCoeff()))/
+    (V.colwise().maxCoeff()-V.colwise().minCoeff()).maxCoeff();
+  const Eigen::Matrix4f model = Eigen::Matrix4f::Identity();
+  const Eigen::Matrix4f proj = Eigen::Matrix4f::Identity();
+  const Eigen::Vector4f viewport(0,0,100,100);
+  igl::embree::EmbreeIntersector deformed;
+  deformed.init(V.cast<float>(),F,false,true);
+  // Squash and shear
+  Eigen::MatrixXd U = V;
+  U.col(1) *= 0.5;
+  U.col(0) += 0.3*V.col(1);
+  igl::embree::EmbreeIntersector rebuild;
+  rebuild.init(U.cast<float>(),F);
+  int num_hits = 0;
+  for(int x = 0;x<100;x+=5)
+  {
+    for(int y = 0;y<100;y+=5)
+    {
+      const Eigen::Vector2f pos(x+0.5f,y+0.5f);
+      int fid,rfid;
+      Eigen::Vector3f bc,rbc;
+      const bool hit = igl::embree::unproject_onto_mesh(
+        pos,U,F,model,proj,viewport,deformed,fid,bc);
+      ASSERT_EQ(hit,igl::embree::unproject_onto_mesh(
+        pos,F,model,proj,viewport,rebuild,rfid,rbc));
+      if(hit)
+      {
+        num_hits++;
+        EXPECT_EQ(fid,rfid);
+        EXPECT_LT((bc-rbc).cwiseAbs().maxCoeff(),1e-5);
+      }
+    }
+  }
+  EXPECT_GT(num_hits,0);
+}
@@ -0,0 +1,82 @@
+#include <test_common.h>
+#include <igl/facet_components.h>
+#include <igl/triangle_triangle_adjacency.h>
+#include <algorithm>
+#include <queue>
+#include <random>
+#include <vector>
+
+// igl::facet_components merges faces with igl::UnionFind. It should label
+// components exactly like the breadth first search it replaced (in order of
+// their first face).
+
+namespace
+{
+  // The original igl::facet_components
+  void bfs_facet_components(
+    const std::vector<std::vector<std::vector<int> > > & TT,
+    Eigen::VectorXi & C,
+    Eigen::VectorXi & counts)
+  {
+    const int m = TT.size();
+    C.setConstant(m,-1);
+    std::vector<int> vcounts;
+    for(int g = 0;g<m;g++)
+    {
+      if(C(g) >= 0)
+      {
+        continue;
+      }
+      vcounts.push_back(0);
+      std::queue<int> Q;
+      Q.push(g);
+      while(!Q.empty())
+      {
+        const int f = Q.front();
+        Q.pop();
+        if(C(f) >= 0)
+        {
+          continue;
+        }
+        C(f) = vcounts.size()-1;
+        vcounts.back()++;
+        for(const auto & c : TT[f])
+        {
+          for(const auto & n : c)
+          {
+            if(C(n) < 0)
+            {
+              Q.push(n);
+            }
+          }
+        }
+      }
+    }
+    counts = Eigen::Map<Eigen::VectorXi>(vcounts.data(),vcounts.size());
+  }
+}
+
+TEST(facet_components, matches_bfs)
+{
+  // Truck (many components, some non-manifold edges) with shuffled faces
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::load_mesh("truck.obj",V,F);
+  std::mt19937 gen(0);
+  for(int f = F.rows()-1;f>0;f--)
+  {
+    const int g = std::uniform_int_distribution<int>(0,f)(gen);
+    F.row(f).swap(F.row(g));
+  }
+  std::vector<std::vector<std::vector<int> > > TT,TTi;
+  igl::triangle_triangle_adjacency(F,TT,TTi);
+
+  Eigen::VectorXi C,counts,bfsC,bfs_counts;
+  bfs_facet_components(TT,bfsC,bfs_counts);
+  EXPECT_GT(bfs_counts.size(),50);
+  igl::facet_components(TT,C,counts);
+  EXPECT_EQ(C,bfsC);
+  EXPECT_EQ(counts,bfs_counts);
+  igl::facet_components(F,C);
+  EXPECT_EQ(C,bfsC);
+}
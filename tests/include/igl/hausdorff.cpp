@@ -0,0 +1,109 @@
+#include <test_common.h>
+#include <igl/hausdorff.h>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+  // Axis aligned cube [0,s]^3 triangulated with outward facing triangles
+  void cube(const double s, Eigen::MatrixXd & V, Eigen::MatrixXi & F)
+  {
+    V.resize(8,3);
+    V<<
+      0,0,0,
+      0,0,1,
+      0,1,0,
+      0,1,1,
+      1,0,0,
+      1,0,1,
+      1,1,0,
+      1,1,1;
+    V *= s;
+    F.resize(12,3);
+    F<<
+      1,7,5,
+      1,3,7,
+      1,4,3,
+      1,2,4,
+      3,8,7,
+      3,4,8,
+      5,7,8,
+      5,8,6,
+      1,5,6,
+      1,6,2,
+      2,6,8,
+      2,8,4;
+    F.array() -= 1;
+  }
+}
+
+TEST(hausdorff, translated_cube)
+{
+  Eigen::MatrixXd VA,VB;
+  Eigen::MatrixXi FA,FB;
+  cube(1,VA,FA);
+  cube(1,VB,FB);
+  VB.col(0).array() += 0.3;
+  const double inf = std::numeric_limits<double>::infinity();
+  const double eps = 1e-6;
+  double l,u;
+  igl::hausdorff(VA,FA,VB,FB,eps,inf,l,u);
+  EXPECT_LE(l,0.3+1e-12);
+  EXPECT_GE(u,0.3-1e-12);
+  EXPECT_LE(u-l,eps);
+}
+
+TEST(hausdorff, nested_cubes)
+{
+  // Big cube [-0.5,1.5]^3 around unit cube: h(small,big) = 0.5 and
+  // h(big,small) = sqrt(3)/2 (at the corners)
+  Eigen::MatrixXd VA,VB;
+  Eigen::MatrixXi FA,FB;
+  cube(2,VA,FA);
+  VA.array() -= 0.5;
+  cube(1,VB,FB);
+  const double exact = 0.5*std::sqrt(3.);
+  const double inf = std::numeric_limits<double>::infinity();
+  const double eps = 1e-6;
+  double d;
+  igl::hausdorff(VA,FA,VB,FB,d);
+  EXPECT_NEAR(d,exact,1e-12);
+  double l,u;
+  igl::hausdorff(VA,FA,VB,FB,eps,inf,l,u);
+  EXPECT_LE(l,exact+1e-12);
+  EXPECT_GE(u,exact-1e-12);
+  EXPECT_LE(u-l,eps);
+  // Same in the other order: the larger direction is then looked at second
+  igl::hausdorff(VB,FB,VA,FA,eps,inf,l,u);
+  EXPECT_LE(l,exact+1e-12);
+  EXPECT_GE(u,exact-1e-12);
+  EXPECT_LE(u-l,eps);
+}
+
+TEST(hausdorff, threshold_early_exit)
+{
+  Eigen::MatrixXd VA,VB;
+  Eigen::MatrixXi FA,FB;
+  cube(2,VA,FA);
+  VA.array() -= 0.5;
+  cube(1,VB,FB);
+  const double exact = 0.5*std::sqrt(3.);
+  const double eps = 1e-6;
+  double l,u;
+  // Distance from A alone exceeds threshold: B is not looked at, so nothing
+  // bounds the distance from above
+  igl::hausdorff(VA,FA,VB,FB,eps,0.6,l,u);
+  EXPECT_GT(l,0.6);
+  EXPECT_LE(l,exact+1e-12);
+  EXPECT_EQ(u,std::numeric_limits<double>::infinity());
+  // Threshold exceeded only by the second direction: bounds stay valid
+  igl::hausdorff(VB,FB,VA,FA,eps,0.6,l,u);
+  EXPECT_GT(l,0.6);
+  EXPECT_LE(l,exact+1e-12);
+  EXPECT_GE(u,exact-1e-12);
+  // Distance is below threshold: stop once that is certain
+  igl::hausdorff(VA,FA,VB,FB,eps,1.0,l,u);
+  EXPECT_LE(l,exact+1e-12);
+  EXPECT_GE(u,exact-1e-12);
+  EXPECT_LE(u,1.0);
+}
@@ -0,0 +1,111 @@
+#include <test_common.h>
+#include <igl/heat_geodesics.h>
+
+namespace
+{
+  // Batched queries should match one single query per column
+  void check_batched(
+    const Eigen::MatrixXd & V,
+    const Eigen::MatrixXi & F,
+    const igl::HeatGeodesicsBoundaryType boundary_type)
+  {
+    igl::HeatGeodesicsData<double> data;
+    const double t = 1e-3;
+    ASSERT_TRUE(igl::heat_geodesics_precompute(V,F,t,boundary_type,data));
+    // 3 queries: one source, two sources, one source
+    Eigen::VectorXi gamma(4);
+    gamma << 0, V.rows()/3, 2*V.rows()/3, V.rows()-1;
+    Eigen::VectorXi NQ(4);
+    NQ << 0, 1, 3, 4;
+    Eigen::MatrixXd D;
+    igl::heat_geodesics_solve(data,gamma,NQ,D);
+    ASSERT_EQ(D.rows(),V.rows());
+    ASSERT_EQ(D.cols(),3);
+    for(int q = 0;q<3;q++)
+    {
+      const Eigen::VectorXi gq = gamma.segment(NQ(q),NQ(q+1)-NQ(q));
+      Eigen::VectorXd Dq;
+      igl::heat_geodesics_solve(data,gq,Dq);
+      ASSERT_EQ(Dq.size(),V.rows());
+      EXPECT_LT((D.col(q)-Dq).cwiseAbs().maxCoeff(),1e-12);
+      // distances are (roughly) zero at the sources and positive away from
+      // them
+      for(int g = 0;g<gq.size();g++)
+      {
+        EXPECT_LT(std::abs(Dq(gq(g))),1e-2);
+      }
+      EXPECT_GT(Dq.maxCoeff(),0.1);
+    }
+  }
+}
+
+TEST(heat_geodesics, batched_matches_single_closed)
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::load_mesh("bunny.off",V,F);
+  // scale to unit bounding box so that t and the tolerances are meaningful
+  V = (V.rowwise()-V.colwise().minCoeff())/
+    (V.colwise().maxCoeff()-V.colwise().minCoeff()).maxCoeff();
+  check_batched(V,F,igl::HEAT_GEODESICS_BOUNDARY_NEUMANN);
+}
+
+TEST(heat_geodesics, batched_matches_single_boundary)
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::load_mesh("camelhead.off",V,F);
+  V = (V.rowwise()-V.colwise().minCoeff())/
+    (V.colwise().maxCoeff()-V.colwise().minCoeff()).maxCoeff();
+  check_batched(V,F,igl::HEAT_GEODESICS_BOUNDARY_NEUMANN);
+  check_batched(V,F,igl::HEAT_GEODESICS_BOUNDARY_DIRICHLET);
+  check_batched(V,F,igl::HEAT_GEODESICS_BOUNDARY_AVERAGE);
+}
+
+TEST(heat_geodesics, planar_grid_matches_euclidean)
+{
+  // Regular n by n triangle grid of the unit square: geodesic distance is
+  // Euclidean distance
+  const int n = 41;
+  const double h = 1.0/(n-1);
+  Eigen::MatrixXd V(n*n,3);
+  for(int j = 0;j<n;j++)
+  {
+    for(int i = 0;i<n;i++)
+    {
+      V.row(i+j*n) << i*h, j*h, 0;
+    }
+  }
+  Eigen::MatrixXi F(2*(n-1)*(n-1),3);
+  for(int j = 0;j<n-1;j++)
+  {
+    for(int i = 0;i<n-1;i++)
+    {
+      const int a = i+j*n, b = a+1, c = a+n, d = c+1;
+      const int f = 2*(i+j*(n-1));
+      F.row(f+0) << a, b, d;
+      F.row(f+1) << a, d, c;
+    }
+  }
+  // source at the center of the square
+  const int s = (n/2)+(n/2)*n;
+  Eigen::VectorXi gamma(1);
+  gamma << s;
+  const Eigen::VectorXd exact =
+    (V.rowwise()-V.row(s)).rowwise().norm();
+  for(const auto boundary_type :
+    {igl::HEAT_GEODESICS_BOUNDARY_NEUMANN,
+     igl::HEAT_GEODESICS_BOUNDARY_DIRICHLET,
+     igl::HEAT_GEODESICS_BOUNDARY_AVERAGE})
+  {
+    igl::HeatGeodesicsData<double> data;
+    ASSERT_TRUE(igl::heat_geodesics_precompute(V,F,h*h,boundary_type,data));
+    Eigen::VectorXd D;
+    igl::heat_geodesics_solve(data,gamma,D);
+    ASSERT_EQ(D.size(),V.rows());
+    const Eigen::VectorXd E = (D-exact).cwiseAbs();
+    // Mean error within 1.5% and max error within 10% of the largest distance
+    EXPECT_LT(E.mean(),0.015*exact.maxCoeff()) << boundary_type;
+    EXPECT_LT(E.maxCoeff(),0.1*exact.maxCoeff()) << boundary_type;
+  }
+}
@@ -0,0 +1,49 @@
+#include <test_common.h>
+#include <igl/lbs.h>
+#include <igl/lbs_matrix.h>
+#include <cstdlib>
+
+TEST(lbs, sparse_weights_match_lbs_matrix)
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::load_mesh("bunny.off",V,F);
+  // k=3 random weights per vertex among m=5 handles, the last one unused
+  // (negative index) on every other vertex
+  const int m = 5, k = 3;
+  std::srand(0);
+  Eigen::MatrixXd W = Eigen::MatrixXd::Random(V.rows(),k).cwiseAbs();
+  Eigen::MatrixXi WI(V.rows(),k);
+  Eigen::MatrixXd Wdense = Eigen::MatrixXd::Zero(V.rows(),m);
+  for(int i = 0;i<V.rows();i++)
+  {
+    for(int j = 0;j<k;j++)
+    {
+      WI(i,j) = (i+2*j)%m;
+    }
+    if(i%2)
+    {
+      WI(i,k-1) = -1;
+      W(i,k-1) = 0;
+    }
+    W.row(i) /= W.row(i).sum();
+    for(int j = 0;j<k;j++)
+    {
+      if(WI(i,j) >= 0)
+      {
+        Wdense(i,WI(i,j)) += W(i,j);
+      }
+    }
+  }
+  // Random affine transformations
+  const Eigen::MatrixXd T = Eigen::MatrixXd::Random(m*4,3);
+
+  Eigen::MatrixXd M;
+  igl::lbs_matrix(V,Wdense,M);
+  const Eigen::MatrixXd U_M = M*T;
+  Eigen::MatrixXd U;
+  igl::lbs(V,W,WI,T,U);
+  ASSERT_EQ(U.rows(),V.rows());
+  ASSERT_EQ(U.cols(),3);
+  EXPECT_LT((U-U_M).cwiseAbs().maxCoeff(),1e-12*U_M.cwiseAbs().maxCoeff());
+}
@@ -0,0 +1,55 @@
+#include <test_common.h>
+#include <igl/lbs_matrix.h>
+#include <cstdlib>
+
+TEST(lbs_matrix, float_matches_double)
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::load_mesh("bunny.off",V,F);
+  // Random partition of unity weights for 5 handles
+  const int m = 5;
+  std::srand(0);
+  Eigen::MatrixXd W = Eigen::MatrixXd::Random(V.rows(),m).cwiseAbs();
+  for(int i = 0;i<W.rows();i++)
+  {
+    W.row(i) /= W.row(i).sum();
+  }
+  const Eigen::MatrixXf Vf = V.cast<float>();
+  const Eigen::MatrixXf Wf = W.cast<float>();
+  const double tol = 1e-6*V.cwiseAbs().maxCoeff();
+
+  Eigen::MatrixXd M;
+  igl::lbs_matrix(V,W,M);
+  Eigen::MatrixXf Mf;
+  igl::lbs_matrix(Vf,Wf,Mf);
+  ASSERT_EQ(Mf.rows(),M.rows());
+  ASSERT_EQ(Mf.cols(),M.cols());
+  EXPECT_LT((Mf.cast<double>()-M).cwiseAbs().maxCoeff(),tol);
+
+  Eigen::MatrixXd MC;
+  igl::lbs_matrix_column(V,W,MC);
+  Eigen::MatrixXf MCf;
+  igl::lbs_matrix_column(Vf,Wf,MCf);
+  ASSERT_EQ(MCf.rows(),MC.rows());
+  ASSERT_EQ(MCf.cols(),MC.cols());
+  EXPECT_LT((MCf.cast<double>()-MC).cwiseAbs().maxCoeff(),tol);
+
+  Eigen::SparseMatrix<double> S;
+  igl::lbs_matrix_column(V,W,S);
+  Eigen::SparseMatrix<float> Sf;
+  igl::lbs_matrix_column(Vf,Wf,Sf);
+  EXPECT_LT(
+    (Eigen::MatrixXf(Sf).cast<double>()-Eigen::MatrixXd(S)).cwiseAbs().maxCoeff(),
+    tol);
+
+  // Sparse weights: all m weights of each vertex, indexed explicitly
+  Eigen::MatrixXi WI(V.rows(),m);
+  for(int i = 0;i<WI.rows();i++)
+  {
+    WI.row(i) = Eigen::RowVectorXi::LinSpaced(m,0,m-1);
+  }
+  Eigen::MatrixXf MIf;
+  igl::lbs_matrix_column(Vf,Wf,WI,MIf);
+  EXPECT_LT((MIf.cast<double>()-MC).cwiseAbs().maxCoeff(),tol);
+}
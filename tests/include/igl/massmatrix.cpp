@@ -0,0 +1,26 @@
+#include <test_common.h>
+#include <igl/massmatrix.h>
+
+TEST(massmatrix, float_matches_double)
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::load_mesh("bunny.off",V,F);
+  const Eigen::MatrixXf Vf = V.cast<float>();
+  const igl::MassMatrixType types[] = {
+    igl::MASSMATRIX_TYPE_BARYCENTRIC,
+    igl::MASSMATRIX_TYPE_VORONOI};
+  for(const auto type : types)
+  {
+    Eigen::SparseMatrix<double> M;
+    igl::massmatrix(V,F,type,M);
+    Eigen::SparseMatrix<float> Mf;
+    igl::massmatrix(Vf,F,type,Mf);
+    ASSERT_EQ(Mf.rows(),M.rows());
+    ASSERT_EQ(Mf.cols(),M.cols());
+    const Eigen::VectorXd m = M.diagonal();
+    const Eigen::VectorXd mf = Mf.diagonal().cast<double>();
+    EXPECT_LT((mf-m).cwiseAbs().maxCoeff(),1e-5*m.maxCoeff()) << type;
+    EXPECT_NEAR(mf.sum(),m.sum(),1e-5*m.sum()) << type;
+  }
+}
@@ -0,0 +1,312 @@
+#include <test_common.h>
+#include <igl/orientable_patches.h>
+#include <igl/bfs_orient.h>
+#include <igl/orient_outward.h>
+#include <igl/PI.h>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <queue>
+#include <random>
+#include <vector>
+
+// orientable_patches, bfs_orient and orient_outward merge patches with
+// igl::UnionFind. They should give the same output as the breadth first
+// searches they replaced (reimplemented below) on the face adjacency matrix
+// of orientable_patches(F,C,A).
+
+namespace
+{
+  // Knight, a cube with a fin on one of its edges (non-manifold edge), an
+  // isolated triangle and optionally a Moebius strip (piece 0 to 4). Each
+  // face is reversed at random (flipped) and the faces are shuffled.
+  void soup(
+    const bool moebius,
+    Eigen::MatrixXd & V,
+    Eigen::MatrixXi & F,
+    Eigen::VectorXi & flipped,
+    Eigen::VectorXi & piece)
+  {
+    Eigen::MatrixXd VK,VC;
+    Eigen::MatrixXi FK,FC;
+    test_common::load_mesh("decimated-knight.off",VK,FK);
+    test_common::load_mesh("cube.off",VC,FC);
+    const double s = (VK.colwise().maxCoeff()-VK.colwise().minCoeff()).norm();
+    std::vector<Eigen::RowVector3d> vv;
+    std::vector<Eigen::RowVector3i> ff;
+    std::vector<int> pp;
+    const auto add = [&](const Eigen::MatrixXd & Vi, const Eigen::MatrixXi & Fi,
+      const Eigen::RowVector3d & t)
+    {
+      const int offset = vv.size();
+      for(int i = 0;i<Vi.rows();i++)
+      {
+        vv.push_back(Vi.row(i)+t);
+      }
+      for(int f = 0;f<Fi.rows();f++)
+      {
+        ff.push_back(Fi.row(f).array()+offset);
+        pp.push_back(0);
+      }
+    };
+    add(VK,FK,Eigen::RowVector3d(0,0,0));
+    add(VC,FC,Eigen::RowVector3d(2.*s,0,0));
+    std::fill(pp.begin()+FK.rows(),pp.end(),1);
+    // Fin on the edge of the first cube face
+    {
+      const int a = VK.rows()+FC(0,0);
+      const int b = VK.rows()+FC(0,1);
+      vv.push_back(Eigen::RowVector3d(2.*s,3,0));
+      ff.push_back(Eigen::RowVector3i(a,b,vv.size()-1));
+      pp.push_back(2);
+    }
+    // Isolated triangle
+    vv.push_back(Eigen::RowVector3d(-2.*s,0,0));
+    vv.push_back(Eigen::RowVector3d(-2.*s,1,0));
+    vv.push_back(Eigen::RowVector3d(-2.*s,0,1));
+    ff.push_back(Eigen::RowVector3i(vv.size()-3,vv.size()-2,vv.size()-1));
+    pp.push_back(3);
+    if(moebius)
+    {
+      const int n = 24;
+      const int o = vv.size();
+      for(int i = 0;i<n;i++)
+      {
+        const double theta = 2.*igl::PI*i/n;
+        const Eigen::RowVector3d r(cos(theta),sin(theta),0);
+        const Eigen::RowVector3d w =
+          0.3*(cos(theta/2.)*r+sin(theta/2.)*Eigen::RowVector3d(0,0,1));
+        const Eigen::RowVector3d c = Eigen::RowVector3d(0,-2.*s,0)+r;
+        vv.push_back(c+w);
+        vv.push_back(c-w);
+      }
+      for(int i = 0;i<n;i++)
+      {
+        const int t0 = o+2*i;
+        const int b0 = o+2*i+1;
+        // The last quad connects top to bottom
+        const int t1 = i+1<n ? o+2*(i+1) : o+1;
+        const int b1 = i+1<n ? o+2*(i+1)+1 : o;
+        ff.push_back(Eigen::RowVector3i(t0,b0,t1));
+        ff.push_back(Eigen::RowVector3i(b0,b1,t1));
+        pp.push_back(4);
+        pp.push_back(4);
+      }
+    }
+    V.resize(vv.size(),3);
+    for(int i = 0;i<(int)vv.size();i++)
+    {
+      V.row(i) = vv[i];
+    }
+    std::mt19937 gen(0);
+    std::vector<int> order(ff.size());
+    std::iota(order.begin(),order.end(),0);
+    std::shuffle(order.begin(),order.end(),gen);
+    std::bernoulli_distribution coin(0.5);
+    F.resize(ff.size(),3);
+    flipped.resize(ff.size());
+    piece.resize(ff.size());
+    for(int f = 0;f<(int)ff.size();f++)
+    {
+      F.row(f) = ff[order[f]];
+      piece(f) = pp[order[f]];
+      flipped(f) = coin(gen);
+      if(flipped(f))
+      {
+        F.row(f) = F.row(f).reverse().eval();
+      }
+    }
+  }
+
+  // Breadth first search labels (the original igl::components)
+  void bfs_components(const Eigen::SparseMatrix<int> & A, Eigen::VectorXi & C)
+  {
+    const int n = A.rows();
+    C.setConstant(n,-1);
+    int id = 0;
+    for(int k = 0;k<n;k++)
+    {
+      if(C(k) >= 0)
+      {
+        continue;
+      }
+      std::queue<int> Q;
+      Q.push(k);
+      while(!Q.empty())
+      {
+        const int f = Q.front();
+        Q.pop();
+        if(C(f) >= 0)
+        {
+          continue;
+        }
+        C(f) = id;
+        for(Eigen::SparseMatrix<int>::InnerIterator it(A,f);it;++it)
+        {
+          if(C(it.index()) < 0 && it.value())
+          {
+            Q.push(it.index());
+          }
+        }
+      }
+      id++;
+    }
+  }
+
+  // The original igl::bfs_orient
+  void bfs_orient_reference(
+    const Eigen::MatrixXi & F,
+    Eigen::MatrixXi & FF,
+    Eigen::VectorXi & C)
+  {
+    Eigen::SparseMatrix<int> A;
+    Eigen::VectorXi unused;
+    igl::orientable_patches(F,unused,A);
+    bfs_components(A,C);
+    const int m = F.rows();
+    const int ES[3][2] = {{1,2},{2,0},{0,1}};
+    FF = F;
+    std::vector<bool> seen(m,false);
+    for(int c = 0;c<=C.maxCoeff();c++)
+    {
+      std::queue<int> Q;
+      for(int f = 0;f<m;f++)
+      {
+        if(C(f) == c)
+        {
+          Q.push(f);
+          break;
+        }
+      }
+      while(!Q.empty())
+      {
+        const int f = Q.front();
+        Q.pop();
+        if(seen[f])
+        {
+          continue;
+        }
+        seen[f] = true;
+        for(Eigen::SparseMatrix<int>::InnerIterator it(A,f);it;++it)
+        {
+          if(it.value() != 0 && it.row() != f)
+          {
+            const int n = it.row();
+            for(int efi = 0;efi<3;efi++)
+            {
+              for(int eni = 0;eni<3;eni++)
+              {
+                if(FF(f,ES[efi][0]) == FF(n,ES[eni][0]) &&
+                  FF(f,ES[efi][1]) == FF(n,ES[eni][1]))
+                {
+                  FF.row(n) = FF.row(n).reverse().eval();
+                }
+              }
+            }
+            Q.push(n);
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(orientable_patches, matches_bfs)
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  Eigen::VectorXi flipped,piece;
+  soup(true,V,F,flipped,piece);
+  Eigen::SparseMatrix<int> A;
+  Eigen::VectorXi CA,C,CI,I,bfsC;
+  igl::orientable_patches(F,CA,A);
+  bfs_components(A,bfsC);
+  igl::orientable_patches(F,C);
+  igl::orientable_patches(F,CI,I);
+  // knight, cube, fin, triangle, strip
+  EXPECT_EQ(bfsC.maxCoeff()+1,5);
+  ASSERT_EQ(CA.size(),F.rows());
+  ASSERT_EQ(C.size(),F.rows());
+  ASSERT_EQ(CI.size(),F.rows());
+  ASSERT_EQ(I.size(),F.rows());
+  for(int f = 0;f<F.rows();f++)
+  {
+    EXPECT_EQ(CA(f),bfsC(f)) << f;
+    EXPECT_EQ(C(f),bfsC(f)) << f;
+    EXPECT_EQ(CI(f),bfsC(f)) << f;
+  }
+}
+
+TEST(orientable_patches, relative_orientation)
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  Eigen::VectorXi flipped,piece;
+  soup(false,V,F,flipped,piece);
+  Eigen::VectorXi C,I;
+  igl::orientable_patches(F,C,I);
+  // Every face must be reversed iff it was flipped relative to the first face
+  // of its patch
+  std::vector<int> first(C.maxCoeff()+1,-1);
+  for(int f = 0;f<F.rows();f++)
+  {
+    if(first[C(f)] < 0)
+    {
+      first[C(f)] = f;
+    }
+    EXPECT_EQ(bool(I(f)),flipped(f) != flipped(first[C(f)])) << f;
+  }
+}
+
+TEST(bfs_orient, matches_bfs)
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  Eigen::VectorXi flipped,piece;
+  soup(false,V,F,flipped,piece);
+  Eigen::MatrixXi FF,refFF;
+  Eigen::VectorXi C,refC;
+  igl::bfs_orient(F,FF,C);
+  bfs_orient_reference(F,refFF,refC);
+  ASSERT_EQ(FF.rows(),F.rows());
+  for(int f = 0;f<F.rows();f++)
+  {
+    EXPECT_EQ(C(f),refC(f)) << f;
+    EXPECT_EQ(FF.row(f),refFF.row(f)) << f;
+  }
+  // In place
+  Eigen::MatrixXi G = F;
+  igl::bfs_orient(G,G,C);
+  EXPECT_EQ(G,refFF);
+}
+
+TEST(orient_outward, restores_closed_meshes)
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  Eigen::VectorXi flipped,piece;
+  soup(false,V,F,flipped,piece);
+  Eigen::MatrixXi FF,FO;
+  Eigen::VectorXi C,I;
+  igl::bfs_orient(F,FF,C);
+  igl::orient_outward(V,FF,C,FO,I);
+  ASSERT_EQ(I.size(),C.maxCoeff()+1);
+  // Same as reversing the patches with I one face at a time
+  for(int f = 0;f<F.rows();f++)
+  {
+    const Eigen::RowVector3i ref =
+      I(C(f)) ? Eigen::RowVector3i(FF.row(f).reverse()) : FF.row(f);
+    EXPECT_EQ(FO.row(f),ref) << f;
+  }
+  // The knight and the cube are closed and oriented outward: all their faces
+  // are back to their original orientation
+  for(int f = 0;f<F.rows();f++)
+  {
+    if(piece(f) < 2)
+    {
+      const Eigen::RowVector3i orig =
+        flipped(f) ? Eigen::RowVector3i(F.row(f).reverse()) : F.row(f);
+      EXPECT_EQ(FO.row(f),orig) << f;
+    }
+  }
+}
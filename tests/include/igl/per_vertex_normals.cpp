@@ -0,0 +1,25 @@
+#include <test_common.h>
+#include <igl/per_vertex_normals.h>
+
+TEST(per_vertex_normals, float_matches_double)
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::load_mesh("bunny.off",V,F);
+  const Eigen::MatrixXf Vf = V.cast<float>();
+  const igl::PerVertexNormalsWeightingType types[] = {
+    igl::PER_VERTEX_NORMALS_WEIGHTING_TYPE_UNIFORM,
+    igl::PER_VERTEX_NORMALS_WEIGHTING_TYPE_AREA,
+    igl::PER_VERTEX_NORMALS_WEIGHTING_TYPE_ANGLE};
+  for(const auto type : types)
+  {
+    Eigen::MatrixXd N;
+    igl::per_vertex_normals(V,F,type,N);
+    Eigen::MatrixXf Nf;
+    igl::per_vertex_normals(Vf,F,type,Nf);
+    ASSERT_EQ(Nf.rows(),N.rows());
+    ASSERT_EQ(Nf.cols(),N.cols());
+    // Unit normals
+    EXPECT_LT((Nf.cast<double>()-N).cwiseAbs().maxCoeff(),5e-5) << type;
+  }
+}
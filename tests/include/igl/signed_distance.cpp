@@ -0,0 +1,39 @@
+#include <test_common.h>
+#include <igl/signed_distance.h>
+#include <cstdlib>
+
+TEST(signed_distance, float_matches_double)
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::load_mesh("bunny.off",V,F);
+  const Eigen::MatrixXf Vf = V.cast<float>();
+  const double diag = (V.colwise().maxCoeff()-V.colwise().minCoeff()).norm();
+  // Query points in a box twice the size of the bounding box, rounded to
+  // float so that both precisions see the same points
+  std::srand(0);
+  const Eigen::RowVector3d mid = 0.5*(V.colwise().maxCoeff()+V.colwise().minCoeff());
+  const Eigen::RowVector3d ext = V.colwise().maxCoeff()-V.colwise().minCoeff();
+  Eigen::MatrixXd P = Eigen::MatrixXd::Random(1000,3);
+  P = (P.array().rowwise()*ext.array()).matrix().rowwise()+mid;
+  const Eigen::MatrixXf Pf = P.cast<float>();
+  P = Pf.cast<double>();
+
+  const igl::SignedDistanceType types[] = {
+    igl::SIGNED_DISTANCE_TYPE_PSEUDONORMAL,
+    igl::SIGNED_DISTANCE_TYPE_WINDING_NUMBER};
+  for(const auto type : types)
+  {
+    Eigen::VectorXd S;
+    Eigen::VectorXi I;
+    Eigen::MatrixXd C,N;
+    igl::signed_distance(P,V,F,type,S,I,C,N);
+    Eigen::VectorXf Sf;
+    Eigen::VectorXi If;
+    Eigen::MatrixXf Cf,Nf;
+    igl::signed_distance(Pf,Vf,F,type,Sf,If,Cf,Nf);
+    ASSERT_EQ(Sf.size(),S.size());
+    // The sign may only differ where the distance is (nearly) zero
+    EXPECT_LT((Sf.cast<double>()-S).cwiseAbs().maxCoeff(),1e-6*diag) << type;
+  }
+}
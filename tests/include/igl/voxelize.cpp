@@ -0,0 +1,220 @@
+#include <test_common.h>
+#include <igl/voxelize.h>
+#include <igl/winding_number.h>
+#include <cmath>
+#include <vector>
+
+// On meshes whose faces lie on grid planes, cell centers fall exactly on
+// faces, edges and vertices. voxelize should then count every shared edge and
+// vertex once and give the generalized winding number, which for such meshes
+// is the average of the winding numbers just off the center in the 8 octants.
+
+namespace
+{
+  // Append the axis-aligned box [lo,hi] to V,F. Face 2*d+s is the face
+  // normal to axis d at lo (s=0) or hi (s=1), it is split into a fan of 4
+  // triangles around its center if fan(2*d+s) and into 2 triangles otherwise.
+  // reverse flips all faces (e.g., for a cavity).
+  void add_box(
+    const Eigen::RowVector3d & lo,
+    const Eigen::RowVector3d & hi,
+    const std::vector<bool> & fan,
+    const bool reverse,
+    std::vector<Eigen::RowVector3d> & V,
+    std::vector<Eigen::RowVector3i> & F)
+  {
+    for(int d = 0;d<3;d++)
+    {
+      const int u = (d+1)%3;
+      const int v = (d+2)%3;
+      for(int s = 0;s<2;s++)
+      {
+        // Counter-clockwise around +d
+        int c[4];
+        const double uv[4][2] = {
+          {lo(u),lo(v)},{hi(u),lo(v)},{hi(u),hi(v)},{lo(u),hi(v)}};
+        for(int k = 0;k<4;k++)
+        {
+          Eigen::RowVector3d x;
+          x(d) = s ? hi(d) : lo(d);
+          x(u) = uv[k][0];
+          x(v) = uv[k][1];
+          c[k] = V.size();
+          V.push_back(x);
+        }
+        // Outward is +d at hi and -d at lo
+        const bool flip = (s == 0) != reverse;
+        const auto add = [&](int a, int b, int e)
+        {
+          F.push_back(flip ?
+            Eigen::RowVector3i(a,e,b) : Eigen::RowVector3i(a,b,e));
+        };
+        if(fan[2*d+s])
+        {
+          const int m = V.size();
+          V.push_back(0.25*(V[c[0]]+V[c[1]]+V[c[2]]+V[c[3]]));
+          for(int k = 0;k<4;k++)
+          {
+            add(c[k],c[(k+1)%4],m);
+          }
+        }else
+        {
+          add(c[0],c[1],c[2]);
+          add(c[0],c[2],c[3]);
+        }
+      }
+    }
+  }
+
+  void to_matrices(
+    const std::vector<Eigen::RowVector3d> & vV,
+    const std::vector<Eigen::RowVector3i> & vF,
+    Eigen::MatrixXd & V,
+    Eigen::MatrixXi & F)
+  {
+    V.resize(vV.size(),3);
+    for(int i = 0;i<(int)vV.size();i++)
+    {
+      V.row(i) = vV[i];
+    }
+    F.resize(vF.size(),3);
+    for(int f = 0;f<(int)vF.size();f++)
+    {
+      F.row(f) = vF[f];
+    }
+  }
+
+  // Compare voxelize to the average of igl::winding_number in the 8 octants
+  // around each cell center, and the sparse occupied cells to the dense ones.
+  // Returns the number of occupied cells.
+  int expect_matches_winding_number(
+    const Eigen::MatrixXd & V,
+    const Eigen::MatrixXi & F,
+    const Eigen::RowVector3i & side,
+    const Eigen::RowVector3d & corner,
+    const double h)
+  {
+    Eigen::VectorXd W,S;
+    igl::voxelize(V,F,side,corner,h,2,W,S);
+    const int n = side.prod();
+    EXPECT_EQ(W.size(),n);
+    Eigen::MatrixXd O(8*n,3);
+    for(int c = 0;c<n;c++)
+    {
+      const Eigen::RowVector3d x = corner+h*Eigen::RowVector3d(
+        c%side(0),(c/side(0))%side(1),c/(side(0)*side(1)));
+      for(int o = 0;o<8;o++)
+      {
+        O.row(8*c+o) = x+1e-3*h*Eigen::RowVector3d(
+          o&1 ? -1 : 1, o&2 ? -1 : 1, o&4 ? -1 : 1);
+      }
+    }
+    Eigen::VectorXd WO;
+    igl::winding_number(V,F,O,WO);
+    int num_occupied = 0;
+    for(int c = 0;c<n;c++)
+    {
+      const double w = WO.segment(8*c,8).mean();
+      EXPECT_NEAR(W(c),w,1e-6) << c;
+      num_occupied += W(c) > 0.5;
+      // Cells on the mesh have S = -0 if occupied
+      EXPECT_EQ(std::signbit(S(c)),W(c) > 0.5) << c;
+    }
+    Eigen::VectorXi I,B;
+    Eigen::VectorXd SB;
+    igl::voxelize(V,F,side,corner,h,2,I,B,SB);
+    EXPECT_EQ(I.size(),num_occupied);
+    for(int k = 0;k<I.size();k++)
+    {
+      EXPECT_GT(W(I(k)),0.5) << I(k);
+    }
+    return num_occupied;
+  }
+}
+
+TEST(voxelize, fanned_cube_matches_winding_number)
+{
+  // Cube [-2,2]^3 with every face fanned around its center, cell centers on
+  // the integers: only the 3^3 centers strictly inside are occupied
+  std::vector<Eigen::RowVector3d> vV;
+  std::vector<Eigen::RowVector3i> vF;
+  add_box(
+    Eigen::RowVector3d(-2,-2,-2),Eigen::RowVector3d(2,2,2),
+    std::vector<bool>(6,true),false,vV,vF);
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  to_matrices(vV,vF,V,F);
+  const Eigen::RowVector3i side(7,7,7);
+  const Eigen::RowVector3d corner(-3,-3,-3);
+  EXPECT_EQ(expect_matches_winding_number(V,F,side,corner,1.),27);
+  Eigen::VectorXd W,S;
+  igl::voxelize(V,F,side,corner,1.,2,W,S);
+  // Face center (fan vertex), edge and corner of the cube
+  const auto cell = [&](int x, int y, int z)
+  {
+    return (x+3)+side(0)*((y+3)+side(1)*(z+3));
+  };
+  EXPECT_EQ(W(cell(0,0,0)),1.);
+  EXPECT_EQ(W(cell(0,0,2)),0.5);
+  EXPECT_EQ(W(cell(0,2,2)),0.25);
+  EXPECT_EQ(W(cell(2,2,2)),0.125);
+  EXPECT_EQ(W(cell(0,0,3)),0.);
+}
+
+TEST(voxelize, top_fanned_cube_matches_winding_number)
+{
+  // Only the top face is fanned around (0,0,2): the rows through the fan
+  // vertex must cross the top exactly once
+  std::vector<bool> fan(6,false);
+  fan[5] = true;
+  std::vector<Eigen::RowVector3d> vV;
+  std::vector<Eigen::RowVector3i> vF;
+  add_box(
+    Eigen::RowVector3d(-2,-2,-2),Eigen::RowVector3d(2,2,2),fan,false,vV,vF);
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  to_matrices(vV,vF,V,F);
+  const Eigen::RowVector3i side(7,7,7);
+  const Eigen::RowVector3d corner(-3,-3,-3);
+  EXPECT_EQ(expect_matches_winding_number(V,F,side,corner,1.),27);
+  Eigen::VectorXd W,S;
+  igl::voxelize(V,F,side,corner,1.,2,W,S);
+  EXPECT_EQ(W(3+side(0)*(3+side(1)*6)),0.);
+  EXPECT_EQ(W(3+side(0)*(3+side(1)*3)),1.);
+}
+
+TEST(voxelize, grid_aligned_cavity_and_overlap_match_winding_number)
+{
+  std::vector<Eigen::RowVector3d> vV;
+  std::vector<Eigen::RowVector3i> vF;
+  std::vector<bool> fan(6,false);
+  fan[0] = fan[3] = true;
+  // Hollow box: [-3,3]^3 minus [-1,1]^3
+  add_box(
+    Eigen::RowVector3d(-3,-3,-3),Eigen::RowVector3d(3,3,3),fan,false,vV,vF);
+  add_box(
+    Eigen::RowVector3d(-1,-1,-1),Eigen::RowVector3d(1,1,1),fan,true,vV,vF);
+  // Two overlapping boxes (self-intersecting, winding number 2 where they
+  // overlap)
+  add_box(
+    Eigen::RowVector3d(4,-2,-2),Eigen::RowVector3d(7,1,2),fan,false,vV,vF);
+  add_box(
+    Eigen::RowVector3d(5,-1,-1),Eigen::RowVector3d(9,2,1),
+    std::vector<bool>(6,true),false,vV,vF);
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  to_matrices(vV,vF,V,F);
+  // Integer centers
+  expect_matches_winding_number(
+    V,F,Eigen::RowVector3i(15,9,9),Eigen::RowVector3d(-4,-4,-4),1.);
+  // Half-integer centers too: cell size 0.5
+  expect_matches_winding_number(
+    V,F,Eigen::RowVector3i(29,17,17),Eigen::RowVector3d(-4,-4,-4),0.5);
+  Eigen::VectorXd W,S;
+  igl::voxelize(
+    V,F,Eigen::RowVector3i(15,9,9),Eigen::RowVector3d(-4,-4,-4),1.,2,W,S);
+  // Cavity, shell and overlap
+  EXPECT_EQ(W(4+15*(4+9*4)),0.);
+  EXPECT_EQ(W(2+15*(4+9*4)),1.);
+  EXPECT_EQ(W(10+15*(4+9*4)),2.);
+}
@@ -0,0 +1,34 @@
+#include <test_common.h>
+#include <igl/winding_number.h>
+#include <cstdlib>
+
+TEST(winding_number, float_matches_double)
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::load_mesh("bunny.off",V,F);
+  const Eigen::MatrixXf Vf = V.cast<float>();
+  // Query points in a box twice the size of the bounding box, rounded to
+  // float so that both precisions see the same points
+  std::srand(0);
+  const Eigen::RowVector3d mid = 0.5*(V.colwise().maxCoeff()+V.colwise().minCoeff());
+  const Eigen::RowVector3d ext = V.colwise().maxCoeff()-V.colwise().minCoeff();
+  Eigen::MatrixXd O = Eigen::MatrixXd::Random(1000,3);
+  O = (O.array().rowwise()*ext.array()).matrix().rowwise()+mid;
+  const Eigen::MatrixXf Of = O.cast<float>();
+  O = Of.cast<double>();
+
+  Eigen::VectorXd W;
+  igl::winding_number(V,F,O,W);
+  Eigen::VectorXf Wf;
+  igl::winding_number(Vf,F,Of,Wf);
+  ASSERT_EQ(Wf.size(),W.size());
+  // Winding numbers are O(1)
+  EXPECT_LT((Wf.cast<double>()-W).cwiseAbs().maxCoeff(),1e-4);
+  // Single point overload agrees with the batched one
+  for(int o = 0;o<O.rows();o += 50)
+  {
+    const Eigen::RowVector3f p = Of.row(o);
+    EXPECT_NEAR(igl::winding_number(Vf,F,p),Wf(o),1e-5) << o;
+  }
+}
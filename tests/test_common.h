@@ -0,0 +1,27 @@
+#ifndef IGL_TEST_COMMON_H
+#define IGL_TEST_COMMON_H
+#include <igl/read_triangle_mesh.h>
+#include <gtest/gtest.h>
+#include <Eigen/Core>
+#include <string>
+
+namespace test_common
+{
+  // Path of a mesh in tutorial/shared
+  inline std::string data_path(const std::string & filename)
+  {
+    return std::string(LIBIGL_TEST_DATA_DIR) + filename;
+  }
+  // Read a mesh from tutorial/shared, failing the current test on error
+  template <typename DerivedV, typename DerivedF>
+  inline void load_mesh(
+    const std::string & filename,
+    Eigen::PlainObjectBase<DerivedV> & V,
+    Eigen::PlainObjectBase<DerivedF> & F)
+  {
+    ASSERT_TRUE(igl::read_triangle_mesh(data_path(filename),V,F))
+      << "could not read " << filename;
+  }
+}
+
+#endif